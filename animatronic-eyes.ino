@@ -18,6 +18,7 @@
 #include <ESPmDNS.h>
 
 #include "config.h"
+#include "scheduler.h"
 #include "storage.h"
 #include "led_status.h"
 #include "wifi_manager.h"
@@ -27,9 +28,13 @@
 #include "mode_manager.h"
 #include "mode_player.h"
 #include "impulse_player.h"
+#include "clip_player.h"
+#include "content_index.h"
 #include "auto_impulse.h"
 #include "update_checker.h"
 #include "web_server.h"
+#include "latency_trace.h"
+#include "power_manager.h"
 
 void setup() {
     Serial.begin(SERIAL_BAUD);
@@ -56,6 +61,7 @@ void setup() {
     if (!LittleFS.begin(true)) {
         Serial.println("[LittleFS] Mount failed!");
     }
+    contentIndex.begin();     // One-time scan of /modes/ and /impulses/
 
     // Mode system - must init after eye controller, storage, and LittleFS
     autoBlink.begin();        // Auto-blink background system
@@ -71,6 +77,9 @@ void setup() {
     // Update checker - must init after WiFi and storage
     updateChecker.begin();
 
+    // Power saving - last, so idle waits only start once everything is up
+    powerManager.begin();
+
     Serial.println();
     Serial.println("Setup complete!");
     Serial.printf("Free heap after init: %d bytes\n", ESP.getFreeHeap());
@@ -81,14 +90,23 @@ void setup() {
 }
 
 void loop() {
+    uint32_t loopStartUs = micros();
+
     ledStatus.loop();
     wifiManager.loop();
     servoController.loop();
     eyeController.loop();
-    autoBlink.loop();
     modePlayer.loop();
     impulsePlayer.loop();
-    autoImpulse.loop();
-    updateChecker.loop();
+    clipPlayer.loop();
     webServer.loop();
+    contentIndex.loop();
+
+    // Timer-driven subsystems (auto-blink, auto-impulse, update check, state broadcast)
+    scheduler.run();
+
+    latencyTrace.recordLoop(loopStartUs, micros() - loopStartUs);
+
+    // Wait until the next deadline when nothing needs the CPU (not counted as loop time)
+    powerManager.idle();
 }
@@ -8,6 +8,7 @@
 #include "auto_blink.h"
 #include "eye_controller.h"
 #include "impulse_player.h"
+#include "clip_player.h"
 #include "storage.h"
 #include "web_server.h"
 
@@ -20,23 +21,29 @@ void AutoBlink::begin() {
     _intervalMin = config.blinkIntervalMin;
     _intervalMax = config.blinkIntervalMax;
 
+    setSeed(0);
+    _timer = scheduler.add([]() { autoBlink.onTimer(); });
     scheduleNextBlink();
 }
 
-void AutoBlink::loop() {
-    if (!isActive()) return;
-
-    // Don't trigger if eye controller is busy with another animation
-    if (eyeController.isAnimating()) return;
+void AutoBlink::setSeed(uint32_t seed) {
+    _rng.seed(seed != 0 ? seed : Prng::entropy(), PRNG_STREAM_AUTO_BLINK);
+}
 
-    // Skip blink during impulse (impulse has precedence)
-    if (impulsePlayer.isPlaying() || impulsePlayer.isPending()) return;
+void AutoBlink::onTimer() {
+    if (!isActive()) return;  // Re-armed when re-enabled/resumed
 
-    if (millis() >= _nextBlinkTime) {
-        WEB_LOG("AutoBlink", "Auto-triggered blink");
-        eyeController.startBlink(0);  // 0 = scaled duration based on lid position
-        scheduleNextBlink();
+    // Don't trigger if eye controller is busy with another animation,
+    // during impulse (impulse has precedence) or a baked clip (blinks are baked in) - retry shortly
+    if (eyeController.isAnimating() || impulsePlayer.isPlaying() || impulsePlayer.isPending() ||
+        clipPlayer.isPlaying()) {
+        scheduler.arm(_timer, SCHEDULER_RETRY_MS);
+        return;
     }
+
+    WEB_LOG("AutoBlink", "Auto-triggered blink");
+    eyeController.startBlink(0);  // 0 = scaled duration based on lid position
+    scheduleNextBlink();
 }
 
 bool AutoBlink::isActive() const {
@@ -52,9 +59,7 @@ bool AutoBlink::isActive() const {
 
 void AutoBlink::setEnabled(bool enabled) {
     _enabled = enabled;
-    if (enabled) {
-        scheduleNextBlink();
-    }
+    scheduleNextBlink();
 }
 
 void AutoBlink::setInterval(uint16_t minMs, uint16_t maxMs) {
@@ -72,6 +77,10 @@ void AutoBlink::resetTimer() {
 }
 
 void AutoBlink::scheduleNextBlink() {
-    unsigned long interval = random(_intervalMin, _intervalMax + 1);
-    _nextBlinkTime = millis() + interval;
+    if (!isActive()) {
+        scheduler.disarm(_timer);
+        return;
+    }
+    unsigned long interval = _rng.range(_intervalMin, _intervalMax);
+    scheduler.arm(_timer, interval);
 }
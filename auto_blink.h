@@ -9,15 +9,17 @@
 #define AUTO_BLINK_H
 
 #include <Arduino.h>
+#include "scheduler.h"
+#include "prng.h"
 
 // Auto-Blink - Periodic automatic blinking
 // Runs in both Follow and Auto modes for natural eye behavior
 // Uses non-blocking async blink from Eye Controller
+// Driven by a scheduler timer (no per-loop polling)
 
 class AutoBlink {
 public:
     void begin();
-    void loop();
 
     // Enable/disable auto-blink (persistent setting)
     void setEnabled(bool enabled);
@@ -30,8 +32,8 @@ public:
     bool isPaused() const { return _paused; }
 
     // Runtime override (temporary toggle, doesn't affect config)
-    void setRuntimeOverride(bool enabled) { _runtimeOverride = enabled; _hasRuntimeOverride = true; }
-    void clearRuntimeOverride() { _hasRuntimeOverride = false; }
+    void setRuntimeOverride(bool enabled) { _runtimeOverride = enabled; _hasRuntimeOverride = true; scheduleNextBlink(); }
+    void clearRuntimeOverride() { _hasRuntimeOverride = false; scheduleNextBlink(); }
     bool hasRuntimeOverride() const { return _hasRuntimeOverride; }
     bool getRuntimeOverride() const { return _runtimeOverride; }
 
@@ -46,6 +48,9 @@ public:
     // Reset timer (call after manual blink to avoid double-blink)
     void resetTimer();
 
+    // Interval randomness (0 = fresh hardware entropy)
+    void setSeed(uint32_t seed);
+
 private:
     bool _enabled = true;
     bool _paused = false;
@@ -53,9 +58,11 @@ private:
     bool _runtimeOverride = false;
     uint16_t _intervalMin = 2000;   // 2 seconds minimum
     uint16_t _intervalMax = 6000;   // 6 seconds maximum
-    unsigned long _nextBlinkTime = 0;
+    TimerId _timer = TIMER_INVALID;
+    Prng _rng;
 
     void scheduleNextBlink();
+    void onTimer();
 };
 
 extern AutoBlink autoBlink;
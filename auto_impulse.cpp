@@ -7,6 +7,7 @@
 
 #include "auto_impulse.h"
 #include "impulse_player.h"
+#include "clip_player.h"
 #include "web_server.h"
 #include "storage.h"
 
@@ -20,31 +21,47 @@ void AutoImpulse::begin() {
     _intervalMax = config.impulseIntervalMax;
     strncpy(_selection, config.impulseSelection, sizeof(_selection) - 1);
     _selection[sizeof(_selection) - 1] = '\0';
+    parseSelection();
 
+    setSeed(0);
+    _timer = scheduler.add([]() { autoImpulse.onTimer(); });
     scheduleNextImpulse();
 
-    // Preload first impulse from selection
+    // Warm the impulse cache with the whole selection, then preload the first pick
+    for (uint8_t i = 0; i < _entryCount; i++) {
+        impulsePlayer.warmCache(_entries[i].name);
+    }
     preloadFromSelection();
 }
 
-void AutoImpulse::loop() {
-    if (!isActive()) return;
+void AutoImpulse::setSeed(uint32_t seed) {
+    _rng.seed(seed != 0 ? seed : Prng::entropy(), PRNG_STREAM_AUTO_IMPULSE);
+}
+
+void AutoImpulse::onTimer() {
+    if (!isActive()) return;  // Re-armed when re-enabled/resumed
 
-    // Don't trigger if impulse player is busy
-    if (impulsePlayer.isPlaying() || impulsePlayer.isPending()) return;
+    // Don't trigger if impulse player is busy or a baked clip owns the pose - retry shortly
+    if (impulsePlayer.isPlaying() || impulsePlayer.isPending() || clipPlayer.isPlaying()) {
+        scheduler.arm(_timer, SCHEDULER_RETRY_MS);
+        return;
+    }
 
     // Ensure we have a preloaded impulse (recovery after mode switch)
     if (!impulsePlayer.isPreloaded()) {
         preloadFromSelection();
     }
 
-    if (millis() >= _nextImpulseTime) {
-        // Trigger the preloaded impulse (preload happens in stopPlayback)
-        WEB_LOG("AutoImpulse", "Auto-triggered impulse");
-        impulsePlayer.trigger();
-
-        scheduleNextImpulse();
+    // Trigger the preloaded impulse (preload happens in stopPlayback)
+    WEB_LOG("AutoImpulse", "Auto-triggered impulse");
+    if (impulsePlayer.trigger() && _preloadedId >= 0) {
+        // Start cooldown for the entry that was preloaded for us
+        _entries[_preloadedId].lastTriggered = millis();
+        _entries[_preloadedId].triggered = true;
     }
+    _preloadedId = -1;
+
+    scheduleNextImpulse();
 }
 
 bool AutoImpulse::isActive() const {
@@ -57,16 +74,16 @@ bool AutoImpulse::isActive() const {
     // Must be enabled
     if (!_enabled) return false;
 
-    // Must have at least one impulse selected
-    if (getSelectedCount() == 0) return false;
+    // Must have at least one impulse selected (parsed once in setSelection)
+    if (_entryCount == 0) return false;
 
     return true;
 }
 
 void AutoImpulse::setEnabled(bool enabled) {
     _enabled = enabled;
+    scheduleNextImpulse();
     if (enabled) {
-        scheduleNextImpulse();
         preloadFromSelection();
     }
 }
@@ -83,127 +100,137 @@ void AutoImpulse::setInterval(uint32_t minMs, uint32_t maxMs) {
 void AutoImpulse::setSelection(const char* selectionCsv) {
     strncpy(_selection, selectionCsv, sizeof(_selection) - 1);
     _selection[sizeof(_selection) - 1] = '\0';
+    parseSelection();
+
+    // Selection may have become empty (inactive) or non-empty (start timer)
+    if (!isActive() || !scheduler.isArmed(_timer)) {
+        scheduleNextImpulse();
+    }
 
     // Preload a new impulse from the updated selection
     preloadFromSelection();
 }
 
 bool AutoImpulse::isImpulseSelected(const char* impulseName) const {
-    if (_selection[0] == '\0') return false;
-
-    // Parse comma-separated list
-    char buffer[IMPULSE_SELECTION_STRLEN];
-    strncpy(buffer, _selection, sizeof(buffer) - 1);
-    buffer[sizeof(buffer) - 1] = '\0';
-
-    char* token = strtok(buffer, ",");
-    while (token != nullptr) {
-        // Trim whitespace
-        while (*token == ' ') token++;
-        char* end = token + strlen(token) - 1;
-        while (end > token && *end == ' ') *end-- = '\0';
-
-        if (strcmp(token, impulseName) == 0) {
+    for (uint8_t i = 0; i < _entryCount; i++) {
+        if (strcmp(_entries[i].name, impulseName) == 0) {
             return true;
         }
-        token = strtok(nullptr, ",");
     }
     return false;
 }
 
-int AutoImpulse::getSelectedCount() const {
-    if (_selection[0] == '\0') return 0;
-
-    int count = 0;
-    char buffer[IMPULSE_SELECTION_STRLEN];
-    strncpy(buffer, _selection, sizeof(buffer) - 1);
-    buffer[sizeof(buffer) - 1] = '\0';
-
-    char* token = strtok(buffer, ",");
-    while (token != nullptr) {
-        // Trim whitespace
-        while (*token == ' ') token++;
-        if (*token != '\0') {
-            count++;
-        }
-        token = strtok(nullptr, ",");
-    }
-    return count;
-}
-
 void AutoImpulse::resetTimer() {
     // Call this after a manual impulse to avoid immediate auto-impulse
     scheduleNextImpulse();
 }
 
 void AutoImpulse::scheduleNextImpulse() {
-    unsigned long interval = random(_intervalMin, _intervalMax + 1);
-    _nextImpulseTime = millis() + interval;
+    if (!isActive()) {
+        scheduler.disarm(_timer);
+        return;
+    }
+    unsigned long interval = _rng.range(_intervalMin, _intervalMax);
+    scheduler.arm(_timer, interval);
 }
 
 void AutoImpulse::preloadFromSelection() {
-    int count = getSelectedCount();
-    if (count == 0) return;
+    int id = pickEntry();
+    if (id < 0) return;  // Empty selection, or everything cooling down
+
+    if (impulsePlayer.preloadByName(_entries[id].name)) {
+        _preloadedId = id;
+    }
+}
 
-    // Build array of selected impulse names
+void AutoImpulse::parseSelection() {
+    // Parse CSV once - the only place the selection string is tokenized
     char buffer[IMPULSE_SELECTION_STRLEN];
     strncpy(buffer, _selection, sizeof(buffer) - 1);
     buffer[sizeof(buffer) - 1] = '\0';
 
-    // Count and collect names
-    char* names[MAX_IMPULSE_SELECTION];
-    int n = 0;
+    _entryCount = 0;
+    _preloadedId = -1;
+
+    char* saveptr = nullptr;
+    char* token = strtok_r(buffer, ",", &saveptr);
+    while (token != nullptr && _entryCount < MAX_IMPULSE_SELECTION) {
+        // Split "name:weight:cooldownMs"
+        char* weightStr = strchr(token, ':');
+        char* cooldownStr = nullptr;
+        if (weightStr) {
+            *weightStr++ = '\0';
+            cooldownStr = strchr(weightStr, ':');
+            if (cooldownStr) *cooldownStr++ = '\0';
+        }
 
-    char* token = strtok(buffer, ",");
-    while (token != nullptr && n < MAX_IMPULSE_SELECTION) {
         // Trim whitespace
         while (*token == ' ') token++;
         char* end = token + strlen(token) - 1;
         while (end > token && *end == ' ') *end-- = '\0';
 
-        if (*token != '\0') {
-            names[n++] = token;
+        long weight = weightStr ? atol(weightStr) : 1;
+        if (*token != '\0' && weight > 0) {
+            SelectionEntry& entry = _entries[_entryCount++];
+            strncpy(entry.name, token, sizeof(entry.name) - 1);
+            entry.name[sizeof(entry.name) - 1] = '\0';
+            entry.weight = (uint16_t)min(weight, 1000L);
+            entry.cooldownMs = cooldownStr ? (uint32_t)atol(cooldownStr) : 0;
+            entry.triggered = false;
         }
-        token = strtok(nullptr, ",");
+        token = strtok_r(nullptr, ",", &saveptr);
     }
 
+    buildAliasTable();
+}
+
+void AutoImpulse::buildAliasTable() {
+    // Vose alias method in integer math: each weight is scaled by n and compared
+    // against the total, so the table is exact (no float residue)
+    uint8_t n = _entryCount;
     if (n == 0) return;
 
-    // Select random from the list
-    int index = random(n);
-    impulsePlayer.preloadByName(names[index]);
-}
+    uint32_t total = 0;
+    uint32_t scaled[MAX_IMPULSE_SELECTION];
+    for (uint8_t i = 0; i < n; i++) {
+        total += _entries[i].weight;
+    }
 
-bool AutoImpulse::selectRandomFromSelection(char* buffer, size_t bufferSize) {
-    int count = getSelectedCount();
-    if (count == 0) return false;
+    uint8_t small[MAX_IMPULSE_SELECTION], large[MAX_IMPULSE_SELECTION];
+    uint8_t numSmall = 0, numLarge = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        scaled[i] = (uint32_t)_entries[i].weight * n;
+        _alias[i] = i;
+        if (scaled[i] < total) small[numSmall++] = i;
+        else large[numLarge++] = i;
+    }
 
-    // Build array of selected impulse names
-    char selBuf[IMPULSE_SELECTION_STRLEN];
-    strncpy(selBuf, _selection, sizeof(selBuf) - 1);
-    selBuf[sizeof(selBuf) - 1] = '\0';
+    while (numSmall > 0 && numLarge > 0) {
+        uint8_t s = small[--numSmall];
+        uint8_t l = large[--numLarge];
+        _aliasProb[s] = (uint32_t)(((uint64_t)scaled[s] << 16) / total);
+        _alias[s] = l;
+        scaled[l] -= total - scaled[s];  // Donate the rest of s's column
+        if (scaled[l] < total) small[numSmall++] = l;
+        else large[numLarge++] = l;
+    }
+    while (numLarge > 0) _aliasProb[large[--numLarge]] = 65536;
+    while (numSmall > 0) _aliasProb[small[--numSmall]] = 65536;
+}
 
-    char* names[MAX_IMPULSE_SELECTION];
-    int n = 0;
+int AutoImpulse::pickEntry() {
+    if (_entryCount == 0) return -1;
 
-    char* token = strtok(selBuf, ",");
-    while (token != nullptr && n < MAX_IMPULSE_SELECTION) {
-        // Trim whitespace
-        while (*token == ' ') token++;
-        char* end = token + strlen(token) - 1;
-        while (end > token && *end == ' ') *end-- = '\0';
+    // O(1) weighted pick; retry (bounded) when the pick is cooling down
+    unsigned long now = millis();
+    for (uint8_t attempt = 0; attempt < MAX_IMPULSE_SELECTION * 2; attempt++) {
+        uint8_t i = _rng.below(_entryCount);
+        uint8_t id = (_rng.below(65536) < _aliasProb[i]) ? i : _alias[i];
 
-        if (*token != '\0') {
-            names[n++] = token;
+        const SelectionEntry& entry = _entries[id];
+        if (!entry.triggered || entry.cooldownMs == 0 || now - entry.lastTriggered >= entry.cooldownMs) {
+            return id;
         }
-        token = strtok(nullptr, ",");
     }
-
-    if (n == 0) return false;
-
-    // Select random
-    int index = random(n);
-    strncpy(buffer, names[index], bufferSize - 1);
-    buffer[bufferSize - 1] = '\0';
-    return true;
+    return -1;
 }
@@ -10,15 +10,21 @@
 
 #include <Arduino.h>
 #include "storage.h"
+#include "scheduler.h"
+#include "prng.h"
 
 // Auto-Impulse - Periodic automatic impulse triggering
 // Runs in all modes (Follow and Auto), can be toggled locally in Follow mode
 // Selects from configured impulse selection list
+//
+// Selection CSV (storage/wire format): "name[:weight[:cooldownMs]],..."
+// e.g. "startle:3,distraction:1:60000". Parsed once into a fixed entry table;
+// picks are O(1) weighted (alias method), entries in cooldown are skipped.
+// Driven by a scheduler timer (no per-loop polling).
 
 class AutoImpulse {
 public:
     void begin();
-    void loop();
 
     // Enable/disable auto-impulse (persistent setting)
     void setEnabled(bool enabled);
@@ -31,8 +37,8 @@ public:
     bool isPaused() const { return _paused; }
 
     // Runtime override (temporary toggle, doesn't affect config)
-    void setRuntimeOverride(bool enabled) { _runtimeOverride = enabled; _hasRuntimeOverride = true; }
-    void clearRuntimeOverride() { _hasRuntimeOverride = false; }
+    void setRuntimeOverride(bool enabled) { _runtimeOverride = enabled; _hasRuntimeOverride = true; scheduleNextImpulse(); }
+    void clearRuntimeOverride() { _hasRuntimeOverride = false; scheduleNextImpulse(); }
     bool hasRuntimeOverride() const { return _hasRuntimeOverride; }
     bool getRuntimeOverride() const { return _runtimeOverride; }
 
@@ -48,7 +54,7 @@ public:
     void setSelection(const char* selectionCsv);
     const char* getSelection() const { return _selection; }
     bool isImpulseSelected(const char* impulseName) const;
-    int getSelectedCount() const;
+    int getSelectedCount() const { return _entryCount; }
 
     // Reset timer (call after manual impulse to avoid double-trigger)
     void resetTimer();
@@ -56,6 +62,9 @@ public:
     // Preload a random impulse from selection for instant trigger
     void preloadFromSelection();
 
+    // Interval and pick randomness (0 = fresh hardware entropy)
+    void setSeed(uint32_t seed);
+
 private:
     bool _enabled = true;
     bool _paused = false;
@@ -63,11 +72,31 @@ private:
     bool _runtimeOverride = false;
     uint32_t _intervalMin = 30000;    // 30 seconds minimum
     uint32_t _intervalMax = 120000;   // 2 minutes maximum
-    unsigned long _nextImpulseTime = 0;
+    TimerId _timer = TIMER_INVALID;
+    Prng _rng;
     char _selection[IMPULSE_SELECTION_STRLEN] = "";
 
+    // Parsed selection (index = impulse ID)
+    struct SelectionEntry {
+        char name[32];
+        uint16_t weight;            // Relative pick weight (default 1)
+        uint32_t cooldownMs;        // Minimum time between auto-triggers (0 = none)
+        unsigned long lastTriggered;
+        bool triggered;             // lastTriggered valid
+    };
+    SelectionEntry _entries[MAX_IMPULSE_SELECTION];
+    uint8_t _entryCount = 0;
+    int8_t _preloadedId = -1;       // Entry preloaded for the next auto-trigger
+
+    // Alias table for O(1) weighted pick (Vose)
+    uint32_t _aliasProb[MAX_IMPULSE_SELECTION];  // Keep-probability, 65536 = always
+    uint8_t _alias[MAX_IMPULSE_SELECTION];
+
     void scheduleNextImpulse();
-    bool selectRandomFromSelection(char* buffer, size_t bufferSize);
+    void onTimer();
+    void parseSelection();
+    void buildAliasTable();
+    int pickEntry();
 };
 
 extern AutoImpulse autoImpulse;
@@ -0,0 +1,566 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "backup.h"
+#include "storage.h"
+#include "web_server.h"
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+
+RestoreParser restoreParser;
+
+// ============================================================================
+// Backup
+// ============================================================================
+
+BackupWriter::BackupWriter() {
+    JsonDocument doc;
+    doc["version"] = FIRMWARE_VERSION;
+    doc["type"] = "animatronic-eyes-backup";
+
+    // Device ID
+    uint64_t chipId = ESP.getEfuseMac();
+    char deviceId[8];
+    snprintf(deviceId, sizeof(deviceId), "%06X", (uint32_t)(chipId & 0xFFFFFF));
+    doc["device"] = deviceId;
+
+    // Config section
+    JsonObject config = doc["config"].to<JsonObject>();
+
+    // Servo config
+    JsonArray servos = config["servo"].to<JsonArray>();
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        ServoConfig sc = storage.getServoConfig(i);
+        JsonObject s = servos.add<JsonObject>();
+        s["pin"] = sc.pin;
+        s["min"] = sc.min;
+        s["center"] = sc.center;
+        s["max"] = sc.max;
+        s["invert"] = sc.invert;
+    }
+
+    // WiFi config
+    JsonObject wifi = config["wifi"].to<JsonObject>();
+    for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+        WifiNetwork net = storage.getWifiNetwork(i);
+        if (net.configured) {
+            JsonObject netObj = wifi[String("network") + String(i)].to<JsonObject>();
+            netObj["ssid"] = net.ssid;
+            netObj["password"] = net.password;
+        }
+    }
+    WifiTiming timing = storage.getWifiTiming();
+    JsonObject wifiTiming = wifi["timing"].to<JsonObject>();
+    wifiTiming["graceMs"] = timing.graceMs;
+    wifiTiming["retries"] = timing.retries;
+    wifiTiming["retryDelayMs"] = timing.retryDelayMs;
+    wifiTiming["apScanMs"] = timing.apScanMs;
+    wifiTiming["keepAP"] = timing.keepAP;
+
+    // AP config
+    ApConfig apConfig = storage.getApConfig();
+    JsonObject ap = config["ap"].to<JsonObject>();
+    ap["ssidPrefix"] = apConfig.ssidPrefix;
+    ap["password"] = apConfig.password;
+
+    // LED config
+    LedConfig ledConfig = storage.getLedConfig();
+    JsonObject led = config["led"].to<JsonObject>();
+    led["enabled"] = ledConfig.enabled;
+    led["pin"] = ledConfig.pin;
+    led["brightness"] = ledConfig.brightness;
+
+    // mDNS config
+    MdnsConfig mdnsConfig = storage.getMdnsConfig();
+    JsonObject mdns = config["mdns"].to<JsonObject>();
+    mdns["enabled"] = mdnsConfig.enabled;
+    mdns["hostname"] = mdnsConfig.hostname;
+
+    // Mode config
+    ModeConfig modeConfig = storage.getModeConfig();
+    JsonObject mode = config["mode"].to<JsonObject>();
+    mode["default"] = modeConfig.defaultMode;
+    mode["autoBlink"] = modeConfig.autoBlink;
+    mode["blinkIntervalMin"] = modeConfig.blinkIntervalMin;
+    mode["blinkIntervalMax"] = modeConfig.blinkIntervalMax;
+    mode["rememberLastMode"] = modeConfig.rememberLastMode;
+    mode["mirrorPreview"] = modeConfig.mirrorPreview;
+    mode["transitionMs"] = modeConfig.transitionMs;
+
+    // Impulse config
+    ImpulseConfig impulseConfig = storage.getImpulseConfig();
+    JsonObject impulse = config["impulse"].to<JsonObject>();
+    impulse["autoImpulse"] = impulseConfig.autoImpulse;
+    impulse["impulseIntervalMin"] = impulseConfig.impulseIntervalMin;
+    impulse["impulseIntervalMax"] = impulseConfig.impulseIntervalMax;
+    impulse["impulseSelection"] = impulseConfig.impulseSelection;
+
+    // Left open: modes and impulses are streamed after it
+    serializeJson(doc, _pending);
+    _pending.remove(_pending.length() - 1);
+}
+
+BackupWriter::~BackupWriter() {
+    if (_file) _file.close();
+    if (_dir) _dir.close();
+}
+
+size_t BackupWriter::fill(uint8_t* buffer, size_t maxLen) {
+    size_t written = 0;
+    while (written < maxLen) {
+        if (_pendingPos < _pending.length()) {
+            size_t n = min(maxLen - written, (size_t)(_pending.length() - _pendingPos));
+            memcpy(buffer + written, _pending.c_str() + _pendingPos, n);
+            _pendingPos += n;
+            written += n;
+            continue;
+        }
+        if (_file) {
+            size_t n = _file.read(buffer + written, maxLen - written);
+            if (n > 0) {
+                written += n;
+                continue;
+            }
+            _file.close();
+        }
+        if (!advance()) {
+            if (written == 0) WEB_LOG("WebServer", "Backup sent (%u bytes)", (unsigned)_sent);
+            break;
+        }
+    }
+    _sent += written;
+    return written;
+}
+
+bool BackupWriter::advance() {
+    _pendingPos = 0;
+    switch (_stage) {
+        case Stage::CONFIG:
+            _pending = String(",\n\"modes\":{");  // Releases the header buffer
+            _dir = LittleFS.open("/modes");
+            _firstEntry = true;
+            _stage = Stage::MODES;
+            return true;
+        case Stage::MODES:
+        case Stage::IMPULSES:
+            if (_dir && _dir.isDirectory() && nextEntry()) return true;
+            if (_dir) _dir.close();
+            if (_stage == Stage::MODES) {
+                _pending = "\n},\n\"impulses\":{";
+                _dir = LittleFS.open("/impulses");
+                _firstEntry = true;
+                _stage = Stage::IMPULSES;
+            } else {
+                _pending = "\n}\n}\n";
+                _stage = Stage::END;
+            }
+            return true;
+        case Stage::END:
+            _pending = "";
+            _stage = Stage::DONE;
+            return false;
+        case Stage::DONE:
+            return false;
+    }
+    return false;
+}
+
+bool BackupWriter::nextEntry() {
+    for (File file = _dir.openNextFile(); file; file = _dir.openNextFile()) {
+        String name = file.name();
+        if (file.isDirectory() || !name.endsWith(".json")) continue;
+
+        // Only valid JSON is copied - a broken file would break the whole backup.
+        // An empty filter checks the syntax without keeping anything.
+        JsonDocument filter;
+        JsonDocument skipped;
+        DeserializationError err = deserializeJson(skipped, file, DeserializationOption::Filter(filter));
+        if (err) {
+            WEB_LOG("WebServer", "Backup: skipped %s (%s)", name.c_str(), err.c_str());
+            continue;
+        }
+        file.seek(0);
+
+        // Key is the file name without .json
+        _pending = _firstEntry ? "\n\"" : ",\n\"";
+        _pending += name.substring(0, name.length() - 5);
+        _pending += "\":";
+        _firstEntry = false;
+        _file = file;
+        return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// Restore
+// ============================================================================
+
+void RestoreParser::begin() {
+    end();
+    _depth = 0;
+    _started = false;
+    _done = false;
+    _inString = false;
+    _escape = false;
+    memset(_tracked, 0, sizeof(_tracked));
+    _capture = Capture::NONE;
+    _typeOk = false;
+    _sections = 0;
+    _files = 0;
+    _error = nullptr;
+    _section = (char*)malloc(BACKUP_SECTION_MAX_BYTES);
+    if (!_section) _error = "out of memory";
+}
+
+void RestoreParser::end() {
+    if (_file) {
+        // Aborted mid-file (connection dropped) - the previous file stays in place
+        _file.close();
+        LittleFS.remove(_tempPath);
+    }
+    free(_section);
+    _section = nullptr;
+}
+
+bool RestoreParser::fail(const char* error) {
+    if (!_error) _error = error;
+    if (_file) {
+        // Don't leave a truncated file behind (the previous one stays in place)
+        _file.close();
+        LittleFS.remove(_tempPath);
+    }
+    _capture = Capture::NONE;
+    return false;
+}
+
+bool RestoreParser::feed(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len && !_error; i++) {
+        char c = (char)data[i];
+
+        if (!_started || _done) {
+            if (isspace((unsigned char)c)) continue;
+            if (_done) return fail("data after the backup");
+            if (c != '{') return fail("not a JSON object");
+            _started = true;
+            _depth = 1;
+            _tracked[1] = true;
+            _member[1] = MemberState::KEY;
+            continue;
+        }
+
+        if (_inString) {
+            bool inKey = _depth <= 2 && _tracked[_depth] && _member[_depth] == MemberState::IN_KEY;
+            if (_escape) {
+                _escape = false;
+            } else if (c == '\\') {
+                _escape = true;
+            } else if (c == '"') {
+                _inString = false;
+                if (inKey) {
+                    _key[_depth][_keyLen] = '\0';
+                    _member[_depth] = MemberState::COLON;
+                    continue;
+                }
+            }
+            if (inKey) {
+                if (_keyLen < sizeof(_key[0]) - 1) {
+                    _key[_depth][_keyLen++] = c;
+                } else {
+                    _keyOverflow = true;
+                }
+            } else {
+                emit(c);
+            }
+            continue;
+        }
+
+        // Member structure of a followed object: keys, ':' and ',' are consumed here,
+        // everything else belongs to the current value
+        bool member = _depth <= 2 && _tracked[_depth];
+        switch (c) {
+            case '"':
+                _inString = true;
+                if (member && _member[_depth] == MemberState::KEY) {
+                    _member[_depth] = MemberState::IN_KEY;
+                    _keyLen = 0;
+                    _keyOverflow = false;
+                } else {
+                    emit(c);
+                }
+                break;
+            case ':':
+                if (member && _member[_depth] == MemberState::COLON) {
+                    _member[_depth] = MemberState::VALUE;
+                    startValue(_depth);
+                } else {
+                    emit(c);
+                }
+                break;
+            case ',':
+                if (member && _member[_depth] == MemberState::VALUE) {
+                    endValue(_depth);
+                    _member[_depth] = MemberState::KEY;
+                } else {
+                    emit(c);
+                }
+                break;
+            case '{':
+            case '[':
+                emit(c);
+                if (_depth == UINT8_MAX) return fail("nesting too deep");
+                _depth++;
+                if (_depth <= 2) {
+                    // config / modes / impulses (not captured as a whole) are followed
+                    _tracked[_depth] = c == '{' && _capture == Capture::NONE;
+                    _member[_depth] = MemberState::KEY;
+                }
+                break;
+            case '}':
+            case ']':
+                if (member && _member[_depth] == MemberState::VALUE) endValue(_depth);
+                _depth--;
+                if (_depth == 0) {
+                    _done = true;
+                } else {
+                    emit(c);
+                }
+                break;
+            default:
+                emit(c);
+                break;
+        }
+    }
+    return !_error;
+}
+
+void RestoreParser::emit(char c) {
+    switch (_capture) {
+        case Capture::SECTION:
+            if (_sectionLen >= BACKUP_SECTION_MAX_BYTES) {
+                fail("config section too large");
+                return;
+            }
+            _section[_sectionLen++] = c;
+            break;
+        case Capture::FILE:
+            if (!_fileStarted && isspace((unsigned char)c)) return;
+            _fileStarted = true;
+            if (_file.write((uint8_t)c) != 1) fail("file write failed");
+            break;
+        case Capture::NONE:
+        case Capture::SKIP:
+            break;
+    }
+}
+
+void RestoreParser::startValue(uint8_t depth) {
+    _sectionLen = 0;
+    const char* key = _key[depth];
+
+    if (depth == 1) {
+        bool container = strcmp(key, "config") == 0 || strcmp(key, "modes") == 0 ||
+                         strcmp(key, "impulses") == 0;
+        if (container && !_typeOk) {
+            fail("invalid backup type");
+        } else if (container) {
+            _capture = Capture::NONE;  // Members are handled one by one
+        } else if (strcmp(key, "type") == 0 || strcmp(key, "version") == 0) {
+            _capture = Capture::SECTION;
+        } else {
+            _capture = Capture::SKIP;
+        }
+        return;
+    }
+
+    const char* parent = _key[1];
+    if (strcmp(parent, "config") == 0) {
+        _capture = Capture::SECTION;
+        return;
+    }
+
+    // Mode / impulse file
+    if (_keyOverflow || key[0] == '\0' || strpbrk(key, "/\\.")) {
+        fail("invalid file name");
+        return;
+    }
+    char dir[16];
+    snprintf(dir, sizeof(dir), "/%s", parent);
+    if (!LittleFS.exists(dir)) {
+        LittleFS.mkdir(dir);
+    }
+    snprintf(_filePath, sizeof(_filePath), "%s/%s.json", dir, key);
+    snprintf(_tempPath, sizeof(_tempPath), "%s.tmp", _filePath);
+    _file = LittleFS.open(_tempPath, "w");
+    if (!_file) {
+        fail("cannot write file");
+        return;
+    }
+    _fileStarted = false;
+    _capture = Capture::FILE;
+}
+
+void RestoreParser::endValue(uint8_t depth) {
+    Capture capture = _capture;
+    _capture = Capture::NONE;
+
+    if (capture == Capture::SECTION) {
+        if (depth == 1) {
+            applyTopLevel(_key[1]);
+        } else {
+            applyConfigSection(_key[2]);
+        }
+    } else if (capture == Capture::FILE) {
+        _file.close();
+        if (commitFile()) {
+            _files++;
+            WEB_LOG("WebServer", "Restored %s", _filePath);
+        }
+    }
+}
+
+bool RestoreParser::commitFile() {
+    // The lexer only tracks nesting - check the body is valid JSON before it
+    // replaces a working mode/impulse (empty filter: syntax only, nothing kept)
+    File file = LittleFS.open(_tempPath, "r");
+    if (!file) return fail("cannot write file");
+    JsonDocument filter;
+    JsonDocument skipped;
+    DeserializationError err = deserializeJson(skipped, file, DeserializationOption::Filter(filter));
+    file.close();
+    if (err) {
+        WEB_LOG("WebServer", "Restore: %s is not valid JSON (%s)", _filePath, err.c_str());
+        LittleFS.remove(_tempPath);
+        return fail("invalid mode/impulse file");
+    }
+
+    LittleFS.remove(_filePath);
+    if (!LittleFS.rename(_tempPath, _filePath)) {
+        LittleFS.remove(_tempPath);
+        return fail("cannot write file");
+    }
+    return true;
+}
+
+void RestoreParser::applyTopLevel(const char* key) {
+    JsonDocument doc;
+    if (deserializeJson(doc, _section, _sectionLen)) {
+        fail("JSON parse error");
+        return;
+    }
+
+    if (strcmp(key, "type") == 0) {
+        // Validate backup type
+        const char* type = doc.as<const char*>();
+        if (!type || strcmp(type, "animatronic-eyes-backup") != 0) {
+            fail("invalid backup type");
+            return;
+        }
+        _typeOk = true;
+    } else if (strcmp(key, "version") == 0) {
+        const char* version = doc.as<const char*>();
+        WEB_LOG("WebServer", "Restoring backup from version %s", version ? version : "?");
+    }
+}
+
+void RestoreParser::applyConfigSection(const char* key) {
+    JsonDocument doc;
+    if (deserializeJson(doc, _section, _sectionLen)) {
+        fail("JSON parse error");
+        return;
+    }
+    _sections++;
+
+    if (strcmp(key, "servo") == 0) {
+        // Restore servo config
+        JsonArray servos = doc.as<JsonArray>();
+        for (size_t i = 0; i < servos.size() && i < NUM_SERVOS; i++) {
+            JsonObject s = servos[i];
+            storage.setServoPin(i, s["pin"] | DEFAULT_PIN_LEFT_EYE_X);
+            storage.setServoCalibration(i,
+                s["min"] | DEFAULT_SERVO_MIN,
+                s["center"] | DEFAULT_SERVO_CENTER,
+                s["max"] | DEFAULT_SERVO_MAX);
+            storage.setServoInvert(i, s["invert"] | false);
+        }
+    } else if (strcmp(key, "wifi") == 0) {
+        // Restore WiFi config
+        JsonObject wifi = doc.as<JsonObject>();
+        for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
+            String netKey = "network" + String(i);
+            if (wifi.containsKey(netKey)) {
+                JsonObject net = wifi[netKey].as<JsonObject>();
+                storage.setWifiNetwork(i,
+                    net["ssid"] | "",
+                    net["password"] | "");
+            }
+        }
+        if (wifi.containsKey("timing")) {
+            JsonObject t = wifi["timing"].as<JsonObject>();
+            WifiTiming timing;
+            timing.graceMs = t["graceMs"] | DEFAULT_WIFI_GRACE_MS;
+            timing.retries = t["retries"] | DEFAULT_WIFI_RETRIES;
+            timing.retryDelayMs = t["retryDelayMs"] | DEFAULT_WIFI_RETRY_DELAY_MS;
+            timing.apScanMs = t["apScanMs"] | DEFAULT_WIFI_AP_SCAN_MS;
+            timing.keepAP = t["keepAP"] | DEFAULT_WIFI_KEEP_AP;
+            storage.setWifiTiming(timing);
+        }
+    } else if (strcmp(key, "ap") == 0) {
+        // Restore AP config
+        JsonObject ap = doc.as<JsonObject>();
+        ApConfig apConfig;
+        strncpy(apConfig.ssidPrefix, ap["ssidPrefix"] | DEFAULT_AP_SSID_PREFIX, sizeof(apConfig.ssidPrefix) - 1);
+        strncpy(apConfig.password, ap["password"] | DEFAULT_AP_PASSWORD, sizeof(apConfig.password) - 1);
+        storage.setApConfig(apConfig);
+    } else if (strcmp(key, "led") == 0) {
+        // Restore LED config
+        JsonObject led = doc.as<JsonObject>();
+        LedConfig ledConfig;
+        ledConfig.enabled = led["enabled"] | DEFAULT_LED_ENABLED;
+        ledConfig.pin = led["pin"] | DEFAULT_LED_PIN;
+        ledConfig.brightness = led["brightness"] | DEFAULT_LED_BRIGHTNESS;
+        storage.setLedConfig(ledConfig);
+    } else if (strcmp(key, "mdns") == 0) {
+        // Restore mDNS config
+        JsonObject mdns = doc.as<JsonObject>();
+        MdnsConfig mdnsConfig;
+        mdnsConfig.enabled = mdns["enabled"] | DEFAULT_MDNS_ENABLED;
+        strncpy(mdnsConfig.hostname, mdns["hostname"] | DEFAULT_MDNS_HOSTNAME, sizeof(mdnsConfig.hostname) - 1);
+        storage.setMdnsConfig(mdnsConfig);
+    } else if (strcmp(key, "mode") == 0) {
+        // Restore Mode config
+        JsonObject mode = doc.as<JsonObject>();
+        ModeConfig modeConfig;
+        strncpy(modeConfig.defaultMode, mode["default"] | DEFAULT_MODE, sizeof(modeConfig.defaultMode) - 1);
+        modeConfig.autoBlink = mode["autoBlink"] | DEFAULT_AUTO_BLINK;
+        modeConfig.blinkIntervalMin = mode["blinkIntervalMin"] | DEFAULT_BLINK_INTERVAL_MIN;
+        modeConfig.blinkIntervalMax = mode["blinkIntervalMax"] | DEFAULT_BLINK_INTERVAL_MAX;
+        modeConfig.rememberLastMode = mode["rememberLastMode"] | false;
+        modeConfig.mirrorPreview = mode["mirrorPreview"] | DEFAULT_MIRROR_PREVIEW;
+        modeConfig.transitionMs = constrain(mode["transitionMs"] | DEFAULT_MODE_TRANSITION_MS, 0, MAX_MODE_TRANSITION_MS);
+        storage.setModeConfig(modeConfig);
+    } else if (strcmp(key, "impulse") == 0) {
+        // Restore Impulse config
+        JsonObject impulse = doc.as<JsonObject>();
+        ImpulseConfig impulseConfig;
+        impulseConfig.autoImpulse = impulse["autoImpulse"] | DEFAULT_AUTO_IMPULSE;
+        impulseConfig.impulseIntervalMin = impulse["impulseIntervalMin"] | DEFAULT_IMPULSE_INTERVAL_MIN;
+        impulseConfig.impulseIntervalMax = impulse["impulseIntervalMax"] | DEFAULT_IMPULSE_INTERVAL_MAX;
+        strncpy(impulseConfig.impulseSelection, impulse["impulseSelection"] | DEFAULT_IMPULSE_SELECTION, sizeof(impulseConfig.impulseSelection) - 1);
+        storage.setImpulseConfig(impulseConfig);
+    } else {
+        _sections--;  // Unknown section (newer firmware), ignored
+    }
+}
+
+bool RestoreParser::finish() {
+    if (_error) return false;
+    if (!_done) return fail("incomplete JSON");
+    if (!_typeOk) return fail("invalid backup type");
+    WEB_LOG("WebServer", "Restore applied %u config sections, %u files", _sections, _files);
+    return true;
+}
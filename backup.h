@@ -0,0 +1,105 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef BACKUP_H
+#define BACKUP_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "config.h"
+
+// Backup / Restore - Streamed /api/backup and /api/restore
+// Backup layout: {"version", "type", "device", "config": {...},
+//                 "modes": {"<name>": <file>, ...}, "impulses": {"<name>": <file>, ...}}
+//
+// BackupWriter produces the document chunk by chunk for a chunked HTTP response:
+// the small header + config part is serialized up front, mode and impulse files
+// are copied from LittleFS as they are (each checked to be valid JSON first).
+//
+// RestoreParser consumes the upload chunk by chunk. A small lexer follows the
+// document structure; each config section (servo, wifi, ap, ...) is buffered
+// alone (up to BACKUP_SECTION_MAX_BYTES) and applied as soon as it is complete,
+// and each mode/impulse file is written straight to LittleFS. "type" must come
+// before any section (backups always start with it).
+//
+// Heap use of either direction is bounded by one config section / one file
+// buffer, not by the size of the backup.
+
+class BackupWriter {
+public:
+    BackupWriter();
+    ~BackupWriter();
+
+    // AwsResponseFiller body: next bytes of the document, 0 when done
+    size_t fill(uint8_t* buffer, size_t maxLen);
+    size_t getBytesSent() const { return _sent; }
+
+private:
+    enum class Stage : uint8_t { CONFIG, MODES, IMPULSES, END, DONE };
+
+    Stage _stage = Stage::CONFIG;
+    String _pending;            // Next literal bytes (header/config, separators, keys)
+    size_t _pendingPos = 0;
+    File _dir;                  // Directory being listed (MODES / IMPULSES)
+    File _file;                 // File being copied
+    bool _firstEntry = true;
+    size_t _sent = 0;
+
+    bool advance();             // Set up the next piece; false at the end
+    bool nextEntry();           // Next valid .json file of _dir
+};
+
+class RestoreParser {
+public:
+    void begin();
+    bool feed(const uint8_t* data, size_t len);  // false once the restore failed
+    bool finish();                               // After the last chunk: complete and valid?
+    void end();                                  // Free the section buffer
+    const char* getError() const { return _error; }
+
+private:
+    enum class MemberState : uint8_t { KEY, IN_KEY, COLON, VALUE };
+    enum class Capture : uint8_t { NONE, SKIP, SECTION, FILE };
+
+    // Lexer (objects at depth 1 and 2 are followed member by member)
+    uint8_t _depth = 0;
+    bool _started = false;
+    bool _done = false;
+    bool _inString = false;
+    bool _escape = false;
+    bool _tracked[3] = {};       // Object at depth 1 / 2 whose members are handled
+    MemberState _member[3] = {};
+    char _key[3][32] = {};       // Current member key at depth 1 / 2
+    uint8_t _keyLen = 0;
+    bool _keyOverflow = false;
+
+    // Current member value
+    Capture _capture = Capture::NONE;
+    char* _section = nullptr;    // BACKUP_SECTION_MAX_BYTES
+    size_t _sectionLen = 0;
+    File _file;
+    char _filePath[64] = "";
+    char _tempPath[72] = "";     // _filePath + ".tmp" until the content is validated
+    bool _fileStarted = false;   // Leading whitespace skipped
+
+    bool _typeOk = false;
+    uint16_t _sections = 0;
+    uint16_t _files = 0;
+    const char* _error = nullptr;
+
+    bool fail(const char* error);
+    void emit(char c);
+    void startValue(uint8_t depth);
+    void endValue(uint8_t depth);
+    void applyTopLevel(const char* key);
+    void applyConfigSection(const char* key);
+    bool commitFile();
+};
+
+extern RestoreParser restoreParser;
+
+#endif // BACKUP_H
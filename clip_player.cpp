@@ -0,0 +1,321 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "clip_player.h"
+#include "web_server.h"
+#include "power_manager.h"
+
+ClipPlayer clipPlayer;
+
+// Integer units per logical unit, in channel order
+static const float CHANNEL_SCALE[CLIP_CHANNELS] = {100, 100, 100, 10000, 100, 100};
+
+static void poseToValues(const EyePose& pose, int32_t* values) {
+    const float channels[CLIP_CHANNELS] = {
+        pose.gazeX, pose.gazeY, pose.gazeZ, pose.coupling, pose.lidLeft, pose.lidRight
+    };
+    for (int i = 0; i < CLIP_CHANNELS; i++) {
+        values[i] = lroundf(channels[i] * CHANNEL_SCALE[i]);
+    }
+}
+
+static void writeLE16(uint8_t* p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static void writeLE32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (v >> (8 * i)) & 0xFF;
+}
+
+static uint32_t readLE32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void ClipPlayer::loop() {
+    // Deferred requests from the web server
+    Request request = _request;
+    if (request != Request::NONE) {
+        _request = Request::NONE;
+        switch (request) {
+            case Request::PLAY:   play(_requestName); break;
+            case Request::RECORD: startRecording(_requestName, _requestDurationMs); break;
+            case Request::STOP:
+                stop();
+                if (_recording) finishRecording();
+                break;
+            case Request::NONE:   break;
+        }
+    }
+
+    unsigned long now = millis();
+    if (_recording) recordFrames(now);
+
+    if (!_playing || _paused) return;
+
+    // Frames run on the clip's own timeline; after a stall the skipped frames are
+    // decoded (the deltas are cumulative) and only the current one is applied
+    uint32_t elapsedMs = now - _startMs;
+    if (_frame < _frameCount) {
+        uint32_t due = (uint32_t)((uint64_t)elapsedMs * _rateHz / 1000);
+        if (due >= _frameCount) due = _frameCount - 1;
+        if (_frame > due) return;
+
+        while (_frame <= due) {
+            if (!decodeFrame()) {
+                WEB_LOG("Clip", "'%s' truncated at frame %lu", _name, (unsigned long)_frame);
+                stop();
+                return;
+            }
+            _frame++;
+        }
+        eyeController.setPose(framePose());
+    }
+
+    // The last frame is held for one frame period
+    if (_frame >= _frameCount && elapsedMs >= (uint64_t)_frameCount * 1000 / _rateHz) {
+        WEB_LOG("Clip", "Finished '%s'", _name);
+        stop();
+    }
+}
+
+bool ClipPlayer::play(const char* name) {
+    stop();
+
+    char path[64];
+    snprintf(path, sizeof(path), "/clips/%s.clip", name);
+    _file = LittleFS.open(path, "r");
+    if (!_file) {
+        WEB_LOG("Clip", "Not found: %s", path);
+        return false;
+    }
+
+    uint8_t header[CLIP_HEADER_SIZE];
+    if (_file.read(header, sizeof(header)) != sizeof(header) ||
+        memcmp(header, CLIP_MAGIC, 4) != 0 ||
+        header[4] != CLIP_VERSION || header[5] != CLIP_CHANNELS) {
+        WEB_LOG("Clip", "%s: not a version %d clip", path, CLIP_VERSION);
+        _file.close();
+        return false;
+    }
+    _rateHz = header[6] | (header[7] << 8);
+    _frameCount = readLE32(&header[8]);
+    if (_rateHz == 0 || _rateHz > CLIP_MAX_RATE_HZ || _frameCount == 0) {
+        WEB_LOG("Clip", "%s: invalid rate %u Hz / %lu frames", path, _rateHz, (unsigned long)_frameCount);
+        _file.close();
+        return false;
+    }
+
+    strncpy(_name, name, sizeof(_name) - 1);
+    _name[sizeof(_name) - 1] = '\0';
+    memset(_values, 0, sizeof(_values));
+    _ringHead = 0;
+    _ringCount = 0;
+    _fileDone = false;
+    refill();
+
+    _frame = 0;
+    _paused = false;
+    _playing = true;
+    _startMs = millis();
+    WEB_LOG("Clip", "Playing '%s' (%lu frames @ %u Hz, %lu bytes)",
+            _name, (unsigned long)_frameCount, _rateHz, (unsigned long)_file.size());
+    return true;
+}
+
+void ClipPlayer::stop() {
+    if (_file) _file.close();
+    _playing = false;
+    _paused = false;
+}
+
+void ClipPlayer::pause() {
+    if (_playing && !_paused) {
+        _pausedAt = millis();
+        _paused = true;
+    }
+}
+
+void ClipPlayer::resume() {
+    if (_paused) {
+        _startMs += millis() - _pausedAt;  // Shift the timeline past the pause
+        _paused = false;
+    }
+}
+
+void ClipPlayer::requestPlay(const char* name) {
+    strncpy(_requestName, name, sizeof(_requestName) - 1);
+    _requestName[sizeof(_requestName) - 1] = '\0';
+    _request = Request::PLAY;
+    powerManager.wake();
+}
+
+void ClipPlayer::requestRecord(const char* name, uint32_t durationMs) {
+    strncpy(_requestName, name, sizeof(_requestName) - 1);
+    _requestName[sizeof(_requestName) - 1] = '\0';
+    _requestDurationMs = durationMs;
+    _request = Request::RECORD;
+    powerManager.wake();
+}
+
+void ClipPlayer::requestStop() {
+    _request = Request::STOP;
+    powerManager.wake();
+}
+
+uint32_t ClipPlayer::msUntilNextFrame() const {
+    if (_request != Request::NONE) return 0;
+
+    uint32_t next = UINT32_MAX;
+    unsigned long now = millis();
+    if (_playing && !_paused) {
+        // Next frame, or the end of the last one
+        uint32_t frameMs = (uint32_t)((uint64_t)_frame * 1000 / _rateHz);
+        int32_t remaining = (int32_t)(_startMs + frameMs - now);
+        next = remaining > 0 ? remaining : 0;
+    }
+    if (_recording) {
+        uint32_t frameMs = (uint32_t)((uint64_t)_recordFrames * 1000 / CLIP_RECORD_RATE_HZ);
+        int32_t remaining = (int32_t)(_recordStartMs + frameMs - now);
+        next = min(next, (uint32_t)(remaining > 0 ? remaining : 0));
+    }
+    return next;
+}
+
+// Ring buffer
+
+void ClipPlayer::refill() {
+    while (!_fileDone && _ringCount < CLIP_RING_SIZE) {
+        uint16_t tail = (_ringHead + _ringCount) % CLIP_RING_SIZE;
+        uint16_t chunk = min((uint16_t)(CLIP_RING_SIZE - tail), (uint16_t)(CLIP_RING_SIZE - _ringCount));
+        size_t got = _file.read(&_ring[tail], chunk);
+        _ringCount += got;
+        if (got < chunk) _fileDone = true;
+    }
+}
+
+bool ClipPlayer::readVarint(uint32_t& value) {
+    value = 0;
+    for (uint8_t shift = 0; shift < 32; shift += 7) {
+        if (_ringCount == 0) return false;
+        uint8_t byte = _ring[_ringHead];
+        _ringHead = (_ringHead + 1) % CLIP_RING_SIZE;
+        _ringCount--;
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool ClipPlayer::decodeFrame() {
+    // Top up once per frame: a read only happens every ~CLIP_RING_SIZE / frame size frames
+    if (_ringCount < CLIP_MAX_FRAME_BYTES) refill();
+
+    for (int i = 0; i < CLIP_CHANNELS; i++) {
+        uint32_t zigzag;
+        if (!readVarint(zigzag)) return false;
+        _values[i] += (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+    }
+    return true;
+}
+
+EyePose ClipPlayer::framePose() const {
+    EyePose pose;
+    pose.gazeX = _values[0] / CHANNEL_SCALE[0];
+    pose.gazeY = _values[1] / CHANNEL_SCALE[1];
+    pose.gazeZ = _values[2] / CHANNEL_SCALE[2];
+    pose.coupling = _values[3] / CHANNEL_SCALE[3];
+    pose.lidLeft = _values[4] / CHANNEL_SCALE[4];
+    pose.lidRight = _values[5] / CHANNEL_SCALE[5];
+    return pose;
+}
+
+// Recorder
+
+bool ClipPlayer::startRecording(const char* name, uint32_t durationMs) {
+    if (_recording) finishRecording();
+
+    _recordBuffer = (uint8_t*)malloc(CLIP_RECORD_MAX_BYTES);
+    if (!_recordBuffer) {
+        WEB_LOG("Clip", "Not enough memory to record");
+        return false;
+    }
+
+    strncpy(_recordName, name, sizeof(_recordName) - 1);
+    _recordName[sizeof(_recordName) - 1] = '\0';
+    memcpy(_recordBuffer, CLIP_MAGIC, 4);
+    _recordBytes = CLIP_HEADER_SIZE;  // Header is filled in when done
+    _recordFrames = 0;
+    _recordMaxFrames = max((uint32_t)((uint64_t)durationMs * CLIP_RECORD_RATE_HZ / 1000), (uint32_t)1);
+    memset(_recordPrev, 0, sizeof(_recordPrev));
+    _recordStartMs = millis();
+    _recording = true;
+    WEB_LOG("Clip", "Recording '%s' for %lu ms", _recordName, (unsigned long)durationMs);
+    return true;
+}
+
+void ClipPlayer::recordFrames(unsigned long now) {
+    // Sample on the clip timeline; a stalled loop repeats the current pose
+    while (_recordFrames < _recordMaxFrames &&
+           now - _recordStartMs >= (uint64_t)_recordFrames * 1000 / CLIP_RECORD_RATE_HZ) {
+        if (_recordBytes + CLIP_MAX_FRAME_BYTES > CLIP_RECORD_MAX_BYTES) {
+            WEB_LOG("Clip", "Recording buffer full");
+            break;
+        }
+
+        int32_t values[CLIP_CHANNELS];
+        poseToValues(eyeController.getPose(), values);
+        for (int i = 0; i < CLIP_CHANNELS; i++) {
+            int32_t delta = values[i] - _recordPrev[i];
+            uint32_t zigzag = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+            while (zigzag >= 0x80) {
+                _recordBuffer[_recordBytes++] = (zigzag & 0x7F) | 0x80;
+                zigzag >>= 7;
+            }
+            _recordBuffer[_recordBytes++] = zigzag;
+            _recordPrev[i] = values[i];
+        }
+        _recordFrames++;
+    }
+
+    if (_recordFrames >= _recordMaxFrames || _recordBytes + CLIP_MAX_FRAME_BYTES > CLIP_RECORD_MAX_BYTES) {
+        finishRecording();
+    }
+}
+
+void ClipPlayer::finishRecording() {
+    _recording = false;
+
+    uint8_t* header = _recordBuffer;
+    header[4] = CLIP_VERSION;
+    header[5] = CLIP_CHANNELS;
+    writeLE16(&header[6], CLIP_RECORD_RATE_HZ);
+    writeLE32(&header[8], _recordFrames);
+    writeLE32(&header[12], 0);
+
+    char path[64];
+    snprintf(path, sizeof(path), "/clips/%s.clip", _recordName);
+    if (_recordFrames == 0) {
+        WEB_LOG("Clip", "Recording '%s' empty, not saved", _recordName);
+    } else {
+        if (!LittleFS.exists("/clips")) {
+            LittleFS.mkdir("/clips");
+        }
+        File file = LittleFS.open(path, "w");
+        size_t written = file ? file.write(_recordBuffer, _recordBytes) : 0;
+        if (file) file.close();
+        if (written == _recordBytes) {
+            WEB_LOG("Clip", "Saved %s (%lu frames, %lu bytes)",
+                    path, (unsigned long)_recordFrames, (unsigned long)_recordBytes);
+        } else {
+            WEB_LOG("Clip", "Failed to write %s", path);
+        }
+    }
+
+    free(_recordBuffer);
+    _recordBuffer = nullptr;
+}
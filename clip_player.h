@@ -0,0 +1,116 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef CLIP_PLAYER_H
+#define CLIP_PLAYER_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "config.h"
+#include "eye_controller.h"
+
+// Clip Player - Baked, frame-exact motion from /clips/<name>.clip
+// A clip is a fixed-rate stream of full poses (six channels), so playback does
+// not interpret anything: each frame is decoded in O(1) and applied with
+// EyeController::setPose(). The file is streamed through a small ring buffer,
+// the clip length is only limited by flash.
+//
+// File format (little-endian, written by tools/clip_tool.py and the recorder):
+//   Header (16 bytes):
+//     char[4]  magic "AECL"
+//     uint8    version (1)
+//     uint8    channel count (6: gazeX, gazeY, gazeZ, coupling, lidLeft, lidRight)
+//     uint16   frame rate in Hz
+//     uint32   frame count
+//     uint32   reserved (0)
+//   Frames: per channel, the change from the previous frame (first frame: from 0)
+//   as a zigzag varint. Values are integers: gaze/lids in 0.01 logical units,
+//   coupling in 0.0001. A channel that holds still costs one byte per frame.
+//
+// Clips are played by the "clip" sequence primitive (modes and impulses) or the
+// playClip command. Only one clip plays at a time; a new one replaces it.
+//
+// The recorder bakes whatever is running (mode, impulses, manual control): it
+// samples the commanded pose at the clip rate into RAM and writes the file when
+// done. Idle motion is added on top of the pose and is not part of the recording.
+
+#define CLIP_MAGIC "AECL"
+#define CLIP_VERSION 1
+#define CLIP_CHANNELS 6
+#define CLIP_HEADER_SIZE 16
+#define CLIP_MAX_FRAME_BYTES (CLIP_CHANNELS * 3)  // int16 delta: 17-bit zigzag -> 3 varint bytes
+
+class ClipPlayer {
+public:
+    void loop();
+
+    // Main loop only (opens the file)
+    bool play(const char* name);
+    void stop();
+    void pause();
+    void resume();
+
+    // Safe from async handlers - performed in loop()
+    void requestPlay(const char* name);
+    void requestRecord(const char* name, uint32_t durationMs);
+    void requestStop();
+
+    bool isPlaying() const { return _playing; }
+    bool isRecording() const { return _recording; }
+    const char* getClipName() const { return _name; }
+    uint32_t getFrame() const { return _frame; }
+    uint32_t getFrameCount() const { return _frameCount; }
+    uint32_t msUntilNextFrame() const;  // 0 = frame due, UINT32_MAX = idle
+
+private:
+    // Playback
+    bool _playing = false;
+    bool _paused = false;
+    char _name[32] = "";
+    File _file;
+    uint16_t _rateHz = 0;
+    uint32_t _frameCount = 0;
+    uint32_t _frame = 0;               // Next frame to decode
+    unsigned long _startMs = 0;        // Time of frame 0
+    unsigned long _pausedAt = 0;
+    int32_t _values[CLIP_CHANNELS];    // Last decoded frame (integer units)
+
+    // Ring buffer between LittleFS and the decoder
+    uint8_t _ring[CLIP_RING_SIZE];
+    uint16_t _ringHead = 0;            // Read position
+    uint16_t _ringCount = 0;           // Buffered bytes
+    bool _fileDone = false;
+
+    void refill();
+    bool readVarint(uint32_t& value);
+    bool decodeFrame();
+    EyePose framePose() const;
+
+    // Recorder
+    bool _recording = false;
+    char _recordName[32] = "";
+    uint8_t* _recordBuffer = nullptr;
+    uint32_t _recordBytes = 0;
+    uint32_t _recordFrames = 0;
+    uint32_t _recordMaxFrames = 0;
+    unsigned long _recordStartMs = 0;
+    int32_t _recordPrev[CLIP_CHANNELS];
+
+    bool startRecording(const char* name, uint32_t durationMs);
+    void recordFrames(unsigned long now);
+    void finishRecording();
+
+    // Deferred requests from async handlers
+    enum class Request : uint8_t { NONE, PLAY, RECORD, STOP };
+    volatile Request _request = Request::NONE;
+    char _requestName[32] = "";
+    uint32_t _requestDurationMs = 0;
+};
+
+extern ClipPlayer clipPlayer;
+
+#endif // CLIP_PLAYER_H
@@ -46,20 +46,40 @@
 #define DEFAULT_BLINK_INTERVAL_MIN 2000 // Minimum ms between auto-blinks
 #define DEFAULT_BLINK_INTERVAL_MAX 6000 // Maximum ms between auto-blinks
 #define DEFAULT_MIRROR_PREVIEW false    // Mirror eye preview (flip horizontal)
+#define DEFAULT_MODE_TRANSITION_MS 400  // Crossfade time into the next mode's first pose (0 = snap)
+#define MAX_MODE_TRANSITION_MS 5000     // Upper bound for the crossfade time
+#define MODE_LOADER_STACK_SIZE 6144     // Background mode parse task (ArduinoJson + LittleFS)
+#define MODE_LOADER_PRIORITY 1          // Low priority, pinned to core 0 (loop task runs on core 1)
+#define SEQUENCE_MAX_LATE_MS 250        // A wait ending later than this resyncs the step timeline
+#define SEQUENCE_MAX_DEPTH 8            // Nested repeat/call/choose blocks per track
+#define SEQUENCE_MAX_TRACKS 4           // Main track + up to 3 parallel tracks
 
 // Impulse System defaults
 #define DEFAULT_AUTO_IMPULSE true              // Enable automatic impulses
 #define DEFAULT_IMPULSE_INTERVAL_MIN 15000     // 15 seconds minimum
 #define DEFAULT_IMPULSE_INTERVAL_MAX 25000     // 25 seconds maximum
 #define DEFAULT_IMPULSE_SELECTION "startle,distraction"  // Default selected impulses
+#define IMPULSE_CACHE_SLOTS 6                  // Parsed impulses kept in RAM (LRU)
+#define IMPULSE_CACHE_BUDGET_BYTES 12288       // Soft budget of parsed impulse heap use (pinned entries may exceed)
+
+// Content index (/modes/ and /impulses/ scanned once at boot)
+#define CONTENT_INDEX_MAX_MODES 16
+#define CONTENT_INDEX_MAX_IMPULSES 16
 
 // Web server
 #define HTTP_PORT 80
 #define WEBSOCKET_PATH "/ws"
+#define UI_ASSET_MAX_AGE_S 31536000  // Browser cache lifetime of fingerprinted UI assets (app.js/style.css?v=<build>)
+#define BACKUP_SECTION_MAX_BYTES 2048  // Largest config section of a restore (servo, wifi, ...), see backup.h
 
 // LittleFS partition size (must match partition scheme)
 // "Default 4MB with spiffs" = 0x160000 (1441792 bytes)
 #define LITTLEFS_PARTITION_SIZE 0x160000
+#define UI_IMAGE_BLOCK_SIZE 4096   // LittleFS block = flash sector (mklittlefs -b 4096), erased one at a time
+#define UI_IMAGE_HEAD_BLOCKS 2     // Superblock pair, held in RAM and written last (see ui_image_update.h)
+
+// Delta firmware updates (/update with a patch from tools/delta_tool.py, see ota_delta.h)
+#define OTA_DELTA_BUFFER_BYTES 1024  // Scratch for source reads while rebuilding the image
 
 // Servo count
 #define NUM_SERVOS 6
@@ -89,8 +109,52 @@
 #define SERVO_SPEED_DEFAULT 100  // degrees per second
 #define SERVO_UPDATE_INTERVAL_MS 20  // Minimum ms between servo writes (prevents watchdog)
 
-// WebSocket broadcast interval
-#define WS_BROADCAST_INTERVAL_MS 100
+// Eye kinematics: 1 = integer Q15 gaze/lid -> servo transform, 0 = float reference path
+#ifndef EYE_KINEMATICS_FIXED_POINT
+#define EYE_KINEMATICS_FIXED_POINT 1
+#endif
+
+// Procedural idle motion (drift/tremor/micro-saccades layered on top of auto modes)
+#define IDLE_MOTION_FADE_MS 500      // Fade-in time when a mode enables idle motion
+#define IDLE_MOTION_MAX_STEP_MS 100  // Cap per-tick time step (after stalls or re-enable)
+
+// Baked clips (/clips/*.clip, see clip_player.h)
+#define CLIP_RING_SIZE 256            // Streaming buffer between LittleFS and the frame decoder
+#define CLIP_MAX_RATE_HZ 100          // Highest accepted clip frame rate
+#define CLIP_RECORD_RATE_HZ 50        // Recorder frame rate (servo update rate)
+#define CLIP_RECORD_MAX_BYTES 32768   // Recorder RAM buffer (~6-8 bytes per frame, ~90 s of motion)
+
+// Latency tracing (command-to-servo, exported via /api/trace)
+#define TRACE_RING_SIZE 256          // Recent trace events kept (~24 bytes each)
+#define TRACE_LOOP_STALL_US 10000    // Main loop iterations longer than this are traced as stalls
+#define TRACE_EXPORT_PIECE_BYTES 288 // /api/trace render buffer (one event or histogram at a time)
+
+// WebSocket state channels (clients subscribe per tab, see WebServer)
+#define WS_BROADCAST_INTERVAL_MS 100        // Mode-change polling when no client streams motion faster
+#define WS_BROADCAST_IDLE_INTERVAL_MS 1000  // Housekeeping interval with no clients connected
+#define WS_MOTION_MAX_HZ 50                 // Upper bound for a client's motion rate
+#define WS_MOTION_DEFAULT_HZ 10             // Motion rate until a client subscribes (previous fixed rate)
+#define WS_SYSTEM_INTERVAL_MS 1000          // WiFi/system/update/calibration refresh (also the UI heartbeat)
+#define WS_MAX_SUBSCRIBERS 8                // Subscription slots (AsyncWebSocket keeps at most 8 clients)
+#define WS_CLIENT_QUEUE_LIMIT 4             // Queued messages before a client's updates are held back (newest kept)
+#define WS_CLIENT_QUEUE_TARGET 1            // Deeper queue after a send halves that client's motion rate
+#define WS_MOTION_MIN_HZ 2                  // Slowest adaptive motion rate
+#define WS_BUFFER_POOL_SLOTS 8              // Shared message buffers for the fan-out (see ws_buffer_pool.h)
+#define WS_BUFFER_POOL_GRANULE 256          // Slot capacity rounding
+#define WS_REASSEMBLY_SLOTS 2               // Messages reassembled at once (fragmented or split across TCP packets)
+#define WS_REASSEMBLY_MAX_BYTES 8192        // Largest incoming message (a whole mode / calibration set)
+#define WS_REASSEMBLY_TIMEOUT_MS 5000       // Unfinished message older than this gives up its slot
+
+// Scheduler (central timer service for periodic subsystems)
+#define SCHEDULER_MAX_TIMERS 8       // Registered timers (one per subsystem)
+#define SCHEDULER_RETRY_MS 20        // Re-check delay when a due action is blocked (busy eye/player)
+
+// Power saving (main loop waits until the next deadline when idle)
+#define POWER_IDLE_SLEEP 1           // 1 = block loop task between deadlines, 0 = spin (previous behavior)
+#define POWER_MIN_SLEEP_MS 2         // Shorter waits aren't worth a context switch
+#define POWER_MAX_SLEEP_MS 250       // Cap so polled state machines (WiFi) still run regularly
+#define POWER_DFS_MIN_MHZ 80         // DFS floor while idle (0 = no DFS). 80 keeps APB/LEDC servo PWM stable
+#define POWER_LIGHT_SLEEP false      // Automatic light sleep - stops LEDC servo PWM on ESP32, opt-in only
 
 // NVS namespace
 #define NVS_NAMESPACE "animeyes"
@@ -103,6 +167,7 @@
 // Update Check
 #define UPDATE_CHECK_BOOT_DELAY_MS  30000     // 30s delay after boot before first check
 #define UPDATE_CHECK_JITTER_MS      1800000   // 30 min max random jitter
+#define UPDATE_CHECK_WIFI_RETRY_MS  10000     // Re-check delay when a check is due but WiFi is down
 #define GITHUB_VERSION_URL "https://raw.githubusercontent.com/Zappo-II/animatronic-eyes/main/data/version.json"
 #define GITHUB_RELEASES_URL "https://github.com/Zappo-II/animatronic-eyes/releases"
 
@@ -0,0 +1,123 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "content_index.h"
+#include "web_server.h"
+#include "power_manager.h"
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+
+ContentIndex contentIndex;
+
+void ContentIndex::begin() {
+    rebuild();
+}
+
+void ContentIndex::loop() {
+    if (_rebuildRequested) {
+        _rebuildRequested = false;
+        rebuild();
+    }
+}
+
+void ContentIndex::requestRebuild() {
+    _rebuildRequested = true;
+    powerManager.wake();
+}
+
+const ContentEntry* ContentIndex::getMode(uint8_t index) const {
+    return (index < _modeCount) ? &_modes[index] : nullptr;
+}
+
+const ContentEntry* ContentIndex::getImpulse(uint8_t index) const {
+    return (index < _impulseCount) ? &_impulses[index] : nullptr;
+}
+
+void ContentIndex::rebuild() {
+    uint32_t startUs = micros();
+    _modeCount = scanDirectory("/modes", _modes, CONTENT_INDEX_MAX_MODES);
+    _impulseCount = scanDirectory("/impulses", _impulses, CONTENT_INDEX_MAX_IMPULSES);
+    serializeMessages();
+    _generation++;
+    WEB_LOG("Content", "Indexed %u modes, %u impulses in %lu us",
+            _modeCount, _impulseCount, (unsigned long)(micros() - startUs));
+}
+
+uint8_t ContentIndex::scanDirectory(const char* dir, ContentEntry* entries, uint8_t maxEntries) {
+    File root = LittleFS.open(dir);
+    if (!root || !root.isDirectory()) {
+        return 0;
+    }
+
+    // Only the two metadata fields are materialized, sequences are skipped
+    JsonDocument filter;
+    filter["name"] = true;
+    filter["description"] = true;
+
+    uint8_t count = 0;
+    File file = root.openNextFile();
+    while (file) {
+        String fileName = file.name();
+        if (!file.isDirectory() && fileName.endsWith(".json")) {
+            if (count >= maxEntries) {
+                WEB_LOG("Content", "%s: index full, skipping %s", dir, fileName.c_str());
+            } else {
+                ContentEntry& entry = entries[count++];
+                memset(&entry, 0, sizeof(entry));
+                fileName = fileName.substring(0, fileName.length() - 5);  // Remove .json
+                strncpy(entry.name, fileName.c_str(), sizeof(entry.name) - 1);
+                entry.size = file.size();
+
+                JsonDocument doc;
+                DeserializationError error = deserializeJson(doc, file, DeserializationOption::Filter(filter));
+                if (error) {
+                    WEB_LOG("Content", "%s/%s.json: %s", dir, entry.name, error.c_str());
+                }
+                strncpy(entry.displayName, doc["name"] | entry.name, sizeof(entry.displayName) - 1);
+                strncpy(entry.description, doc["description"] | "", sizeof(entry.description) - 1);
+            }
+        }
+        file.close();
+        file = root.openNextFile();
+    }
+    root.close();
+
+    return count;
+}
+
+void ContentIndex::serializeMessages() {
+    uint8_t back = _front ^ 1;
+    JsonDocument doc;
+
+    doc["type"] = "availableModes";
+    JsonArray modes = doc["modes"].to<JsonArray>();
+    modes.add("follow");  // Always available
+    for (uint8_t i = 0; i < _modeCount; i++) {
+        JsonObject mode = modes.add<JsonObject>();
+        mode["name"] = _modes[i].name;
+        mode["displayName"] = _modes[i].displayName;
+        mode["description"] = _modes[i].description;
+        mode["size"] = _modes[i].size;
+    }
+    _modesMessage[back] = "";
+    serializeJson(doc, _modesMessage[back]);
+
+    doc.clear();
+    doc["type"] = "availableImpulses";
+    JsonArray impulses = doc["impulses"].to<JsonArray>();
+    for (uint8_t i = 0; i < _impulseCount; i++) {
+        JsonObject impulse = impulses.add<JsonObject>();
+        impulse["name"] = _impulses[i].name;
+        impulse["displayName"] = _impulses[i].displayName;
+        impulse["description"] = _impulses[i].description;
+        impulse["size"] = _impulses[i].size;
+    }
+    _impulsesMessage[back] = "";
+    serializeJson(doc, _impulsesMessage[back]);
+
+    _front = back;
+}
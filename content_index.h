@@ -0,0 +1,66 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef CONTENT_INDEX_H
+#define CONTENT_INDEX_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Content Index - In-RAM directory index of /modes/ and /impulses/
+// Both directories are scanned once at boot (name, display name, description,
+// file size), and the availableModes / availableImpulses WebSocket messages are
+// serialized once from that index. Clients connecting later get the cached
+// message without touching LittleFS. The files only change through
+// /api/upload-ui, /api/restore and the saveMode / saveImpulse commands, which
+// request a rebuild.
+
+struct ContentEntry {
+    char name[32];          // File name without .json (used to load/trigger)
+    char displayName[32];   // "name" field of the JSON (falls back to file name)
+    char description[96];   // "description" field of the JSON
+    uint32_t size;          // File size in bytes
+};
+
+class ContentIndex {
+public:
+    void begin();           // Initial scan (after LittleFS is mounted)
+    void loop();            // Performs a requested rebuild
+    void requestRebuild();  // Safe from async handlers
+
+    uint8_t getModeCount() const { return _modeCount; }
+    uint8_t getImpulseCount() const { return _impulseCount; }
+    uint32_t getGeneration() const { return _generation; }  // Bumped by every rebuild
+    const ContentEntry* getMode(uint8_t index) const;
+    const ContentEntry* getImpulse(uint8_t index) const;
+
+    // Pre-serialized WebSocket messages (valid until the next rebuild)
+    const String& getModesMessage() const { return _modesMessage[_front]; }
+    const String& getImpulsesMessage() const { return _impulsesMessage[_front]; }
+
+private:
+    ContentEntry _modes[CONTENT_INDEX_MAX_MODES];
+    ContentEntry _impulses[CONTENT_INDEX_MAX_IMPULSES];
+    uint8_t _modeCount = 0;
+    uint8_t _impulseCount = 0;
+    uint32_t _generation = 0;
+
+    // Messages are double-buffered: async senders keep reading the front pair
+    // while a rebuild serializes into the back pair
+    String _modesMessage[2];
+    String _impulsesMessage[2];
+    volatile uint8_t _front = 0;
+    volatile bool _rebuildRequested = false;
+
+    void rebuild();
+    static uint8_t scanDirectory(const char* dir, ContentEntry* entries, uint8_t maxEntries);
+    void serializeMessages();
+};
+
+extern ContentIndex contentIndex;
+
+#endif // CONTENT_INDEX_H
@@ -18,7 +18,8 @@ let state = {
     system: {},
     eye: {},
     mode: {},
-    impulse: {}
+    impulse: {},
+    clip: {}
 };
 
 // Configuration (fetched on-demand)
@@ -28,7 +29,7 @@ let config = {
     ap: {ssidPrefix: 'LookIntoMyEyes', hasPassword: true},
     led: {enabled: true, pin: 2},
     mdns: {enabled: true, hostname: 'animatronic-eyes'},
-    mode: {defaultMode: 'follow', autoBlink: true, blinkIntervalMin: 2000, blinkIntervalMax: 6000, rememberLastMode: false, mirrorPreview: false},
+    mode: {defaultMode: 'follow', autoBlink: true, blinkIntervalMin: 2000, blinkIntervalMax: 6000, rememberLastMode: false, mirrorPreview: false, transitionMs: 400},
     impulse: {autoImpulse: true, impulseIntervalMin: 30000, impulseIntervalMax: 120000, impulseSelection: 'startle,distraction'}
 };
 
@@ -248,6 +249,9 @@ function setupTabs() {
             // Save active tab
             localStorage.setItem('activeTab', tabId);
 
+            // Only receive the state channels this tab shows
+            subscribeForTab(tabId);
+
             // Fetch config when switching to Configuration tab
             if (tabId === 'configuration') {
                 requestConfig();
@@ -289,6 +293,20 @@ function setupTabs() {
     }
 }
 
+// State channels each tab needs (motion = live pose, mode = mode/impulse state,
+// system = wifi/system/update/calibration - system also keeps the heartbeat alive)
+const TAB_CHANNELS = {
+    control: { channels: ['motion', 'mode', 'system'], motionHz: 20 },
+    calibration: { channels: ['motion', 'system'], motionHz: 10 },
+    configuration: { channels: ['mode', 'system'] },
+    console: { channels: ['system'] }
+};
+
+function subscribeForTab(tabId) {
+    const subscription = TAB_CHANNELS[tabId] || TAB_CHANNELS.control;
+    send({ type: 'subscribe', ...subscription });
+}
+
 // WebSocket
 function connectWebSocket() {
     const protocol = location.protocol === 'https:' ? 'wss:' : 'ws:';
@@ -304,6 +322,8 @@ function connectWebSocket() {
         updateLockStatusIndicator();
         // Fetch config immediately so forms are populated correctly
         requestConfig();
+        // Narrow the default (all channels) to what the open tab needs
+        subscribeForTab(document.querySelector('.tab.active')?.dataset.tab);
     };
 
     ws.onclose = () => {
@@ -342,18 +362,38 @@ function connectWebSocket() {
 }
 
 function handleMessage(data) {
-    if (data.type === 'state') {
+    if (data.type === 'motion') {
+        // Live pose at the subscribed rate
+        Object.assign(state.eye, data.eye);
+        if (data.pos) {
+            data.pos.forEach((pos, i) => {
+                if (state.servos[i]) state.servos[i].pos = pos;
+            });
+        }
+        if (data.clipFrame !== undefined && state.clip) state.clip.frame = data.clipFrame;
+
+        updateEyeController();
+        updateCalibrationCards();
+    } else if (data.type === 'modeState') {
+        // Mode / impulse / clip state (sent on change)
+        Object.assign(state.eye, data.eye);
+        state.mode = data.mode || {};
+        state.impulse = data.impulse || {};
+        state.clip = data.clip || {};
+
+        updateUI();
+    } else if (data.type === 'systemState') {
         // Runtime state only (no config data)
         state.wifi = data.wifi;
         state.servos = data.servos;
         state.system = data.system;
-        state.eye = data.eye || {};
-        state.mode = data.mode || {};
-        state.impulse = data.impulse || {};
         state.update = data.update || {};
+        state.clients = data.clients || [];
+        Object.assign(state.eye, data.eye);
 
         // Update the Update Check UI
         updateUpdateCheckUI();
+        updateClientStats();
 
         // Initialize local calibration from server state on first load
         if (localCalibration.length === 0 && state.servos && state.servos.length > 0) {
@@ -430,6 +470,13 @@ function handleMessage(data) {
         }
 
         updateAdminLockUI();
+    } else if (data.type === 'contentSaved') {
+        // Reply to saveMode / saveImpulse (lists refresh on their own)
+        if (data.ok) {
+            showToast(`Saved ${data.path}`, 'success');
+        } else {
+            showToast(`Not saved: ${data.error}`, 'error');
+        }
     } else if (data.type === 'adminBlocked') {
         // Command was blocked due to admin lock
         showToast(`Action blocked: Admin lock is active`, 'error');
@@ -450,7 +497,7 @@ function handleConfigResponse(data) {
         ap: data.ap || {},
         led: data.led || {},
         mdns: data.mdns || {},
-        mode: data.mode || {defaultMode: 'follow', autoBlink: true, blinkIntervalMin: 2000, blinkIntervalMax: 6000, rememberLastMode: false, mirrorPreview: false},
+        mode: data.mode || {defaultMode: 'follow', autoBlink: true, blinkIntervalMin: 2000, blinkIntervalMax: 6000, rememberLastMode: false, mirrorPreview: false, transitionMs: 400},
         impulse: data.impulse || {autoImpulse: true, impulseIntervalMin: 30000, impulseIntervalMax: 120000, impulseSelection: 'startle,distraction'}
     };
     savedConfig = JSON.parse(JSON.stringify(config));
@@ -517,6 +564,7 @@ function populateConfigForms() {
     document.getElementById('mirrorPreview').checked = config.mode.mirrorPreview === true;
     document.getElementById('blinkIntervalMin').value = config.mode.blinkIntervalMin || 2000;
     document.getElementById('blinkIntervalMax').value = config.mode.blinkIntervalMax || 6000;
+    document.getElementById('modeTransitionMs').value = config.mode.transitionMs ?? 400;
     // Default mode dropdown is populated by populateModeDropdowns when state is received
     updateDefaultModeDropdownState();
 
@@ -653,7 +701,8 @@ function checkDirty(sectionName) {
                 document.getElementById('rememberLastMode').checked !== (savedConfig.mode.rememberLastMode === true) ||
                 document.getElementById('mirrorPreview').checked !== (savedConfig.mode.mirrorPreview === true) ||
                 parseInt(document.getElementById('blinkIntervalMin').value) !== (savedConfig.mode.blinkIntervalMin || 2000) ||
-                parseInt(document.getElementById('blinkIntervalMax').value) !== (savedConfig.mode.blinkIntervalMax || 6000);
+                parseInt(document.getElementById('blinkIntervalMax').value) !== (savedConfig.mode.blinkIntervalMax || 6000) ||
+                parseInt(document.getElementById('modeTransitionMs').value) !== (savedConfig.mode.transitionMs ?? 400);
             break;
         }
         case 'impulseSettings': {
@@ -882,6 +931,7 @@ function saveModeSettings() {
     const mirrorPreview = document.getElementById('mirrorPreview').checked;
     const blinkIntervalMin = parseInt(document.getElementById('blinkIntervalMin').value) || 2000;
     const blinkIntervalMax = parseInt(document.getElementById('blinkIntervalMax').value) || 6000;
+    const transitionMs = Math.min(Math.max(parseInt(document.getElementById('modeTransitionMs').value) || 0, 0), 5000);
 
     // Validate interval values
     if (blinkIntervalMin > blinkIntervalMax) {
@@ -895,6 +945,7 @@ function saveModeSettings() {
     send({ type: 'setRememberLastMode', enabled: rememberLastMode });
     send({ type: 'setMirrorPreview', enabled: mirrorPreview });
     send({ type: 'setBlinkInterval', min: blinkIntervalMin, max: blinkIntervalMax });
+    send({ type: 'setModeTransition', ms: transitionMs });
 
     // Update savedConfig
     savedConfig.mode.defaultMode = defaultMode;
@@ -903,6 +954,7 @@ function saveModeSettings() {
     savedConfig.mode.mirrorPreview = mirrorPreview;
     savedConfig.mode.blinkIntervalMin = blinkIntervalMin;
     savedConfig.mode.blinkIntervalMax = blinkIntervalMax;
+    savedConfig.mode.transitionMs = transitionMs;
 
     dirtyState.modeSettings = false;
     updateSectionState('modeSettings');
@@ -942,8 +994,18 @@ function getImpulseSelectionFromCheckboxes() {
     const container = document.getElementById('impulseSelection');
     if (!container) return '';
 
+    // Keep any ":weight:cooldownMs" options the entry was loaded with
     const checkboxes = container.querySelectorAll('input[type="checkbox"]:checked');
-    return Array.from(checkboxes).map(cb => cb.value).join(',');
+    return Array.from(checkboxes).map(cb => cb.dataset.entry || cb.value).join(',');
+}
+
+// Parse selection string into {name: entry} ("name[:weight[:cooldownMs]]")
+function parseImpulseSelection(selection) {
+    const entries = {};
+    (selection || '').split(',').map(s => s.trim()).filter(s => s).forEach(entry => {
+        entries[entry.split(':')[0].trim()] = entry;
+    });
+    return entries;
 }
 
 // Set checkboxes based on comma-separated selection string
@@ -951,10 +1013,11 @@ function setImpulseSelectionCheckboxes(selection) {
     const container = document.getElementById('impulseSelection');
     if (!container) return;
 
-    const selected = selection ? selection.split(',').map(s => s.trim()) : [];
+    const selected = parseImpulseSelection(selection);
 
     container.querySelectorAll('input[type="checkbox"]').forEach(cb => {
-        cb.checked = selected.includes(cb.value);
+        cb.checked = cb.value in selected;
+        cb.dataset.entry = selected[cb.value] || cb.value;
     });
 }
 
@@ -970,17 +1033,21 @@ function populateImpulseSelection(availableImpulses, currentSelection) {
         return;
     }
 
-    const selected = currentSelection ? currentSelection.split(',').map(s => s.trim()) : [];
+    const selected = parseImpulseSelection(currentSelection);
 
-    availableImpulses.forEach(impulseName => {
+    availableImpulses.forEach(impulse => {
+        // Impulse can be a string or object with name/displayName/description
+        const impulseName = typeof impulse === 'string' ? impulse : impulse.name;
         const label = document.createElement('label');
         const checkbox = document.createElement('input');
         checkbox.type = 'checkbox';
         checkbox.value = impulseName;
-        checkbox.checked = selected.includes(impulseName);
+        checkbox.checked = impulseName in selected;
+        checkbox.dataset.entry = selected[impulseName] || impulseName;
         checkbox.addEventListener('change', () => checkSectionDirty('impulseSettings'));
 
-        const displayName = impulseName.charAt(0).toUpperCase() + impulseName.slice(1);
+        const displayName = typeof impulse === 'string' ? capitalizeFirst(impulse) : (impulse.displayName || impulse.name);
+        if (impulse.description) label.title = impulse.description;
         label.appendChild(checkbox);
         label.appendChild(document.createTextNode(displayName));
         container.appendChild(label);
@@ -1034,6 +1101,7 @@ function revertSection(sectionName) {
             document.getElementById('mirrorPreview').checked = savedConfig.mode.mirrorPreview === true;
             document.getElementById('blinkIntervalMin').value = savedConfig.mode.blinkIntervalMin || 2000;
             document.getElementById('blinkIntervalMax').value = savedConfig.mode.blinkIntervalMax || 6000;
+            document.getElementById('modeTransitionMs').value = savedConfig.mode.transitionMs ?? 400;
             break;
         }
         case 'impulseSettings': {
@@ -1129,6 +1197,7 @@ function setupConfigSections() {
         {id: 'mirrorPreview', section: 'modeSettings'},
         {id: 'blinkIntervalMin', section: 'modeSettings'},
         {id: 'blinkIntervalMax', section: 'modeSettings'},
+        {id: 'modeTransitionMs', section: 'modeSettings'},
         {id: 'autoImpulseEnabled', section: 'impulseSettings'},
         {id: 'impulseIntervalMin', section: 'impulseSettings'},
         {id: 'impulseIntervalMax', section: 'impulseSettings'}
@@ -2478,6 +2547,25 @@ function send(obj) {
     }
 }
 
+function updateClientStats() {
+    const el = document.getElementById('wsClients');
+    if (!el) return;
+
+    if (!state.clients || state.clients.length === 0) {
+        el.innerHTML = '<div class="system-info-row"><span>Clients</span><span>-</span></div>';
+        return;
+    }
+
+    el.innerHTML = state.clients.map(c => {
+        const rate = c.motionHz ? c.motionHz + ' Hz' : 'no motion';
+        const queue = c.queue + ' queued (' + (c.queueBytes / 1024).toFixed(1) + ' KB)';
+        const lag = 'lag ' + c.lagMs + ' / ' + c.lagMaxMs + ' ms max';
+        const style = c.lagMs > 0 ? ' style="color:#f39c12"' : '';
+        return '<div class="system-info-row"><span>#' + c.id + ' ' + c.ip + '</span>' +
+            '<span' + style + '>' + rate + ', ' + queue + ', ' + c.dropped + ' dropped, ' + lag + '</span></div>';
+    }).join('');
+}
+
 async function fetchVersion() {
     try {
         const res = await fetch('/api/version');
@@ -2524,6 +2612,28 @@ async function fetchVersion() {
 
         html += '<div class="system-info-row"><span>Free Heap</span><span>' + (data.freeHeap / 1024).toFixed(1) + ' KB</span></div>';
 
+        if (data.power) {
+            const p = data.power;
+            html += '<div class="system-info-row"><span>CPU</span><span>' + p.cpuMhz + ' MHz' + (p.dfs ? ' (DFS' + (p.lightSleep ? ', light sleep' : '') + ')' : '') + '</span></div>';
+            html += '<div class="system-info-row"><span>Idle</span><span>' + p.idlePct + '% (wake +' + p.wakeLatencyUs + ' / ' + p.wakeLatencyMaxUs + ' µs max)</span></div>';
+        }
+
+        if (data.wsBuffers) {
+            const b = data.wsBuffers;
+            html += '<div class="system-info-row"><span>WS Buffers</span><span>' + b.inUse + '/' + b.slots + ' in use, ' + (b.allocBytes / 1024).toFixed(1) + ' KB allocated (' + b.misses + ' misses)</span></div>';
+        }
+
+        if (data.wsParse) {
+            const w = data.wsParse;
+            html += '<div class="system-info-row"><span>WS Parse</span><span>in-place ' + w.fastAvgUs.toFixed(1) + ' µs (' + w.fastCount + '), JSON ' + w.fullAvgUs.toFixed(1) + ' µs (' + w.fullCount + ')</span></div>';
+        }
+
+        if (data.wsReassembly) {
+            const r = data.wsReassembly;
+            const dropped = r.oversized + r.noSlot + r.expired;
+            html += '<div class="system-info-row"><span>WS Reassembly</span><span>' + r.completed + ' messages, ' + dropped + ' dropped (max ' + (r.maxBytes / 1024).toFixed(0) + ' KB)</span></div>';
+        }
+
         if (data.rebootRequired) {
             html += '<div class="system-info-row" style="color:#f39c12"><span>Status</span><span>Reboot required</span></div>';
         }
@@ -2546,7 +2656,17 @@ async function fetchVersion() {
     }
 }
 
-function uploadFile(fileInput, endpoint) {
+// CRC32 (IEEE, same as zlib) of a UI image, sent as its manifest
+function crc32(bytes) {
+    let crc = 0xFFFFFFFF;
+    for (let i = 0; i < bytes.length; i++) {
+        crc ^= bytes[i];
+        for (let k = 0; k < 8; k++) crc = (crc >>> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+    return (crc ^ 0xFFFFFFFF) >>> 0;
+}
+
+async function uploadFile(fileInput, endpoint) {
     const progressContainer = document.getElementById('uploadProgress');
     const progressFill = progressContainer.querySelector('.progress-fill');
     const progressText = progressContainer.querySelector('.progress-text');
@@ -2580,8 +2700,15 @@ function uploadFile(fileInput, endpoint) {
         setTimeout(() => progressContainer.classList.add('hidden'), 3000);
     };
 
+    // UI image: the device verifies size and CRC32 before it commits the image
+    let url = endpoint;
+    if (endpoint === '/api/upload-ui') {
+        const bytes = new Uint8Array(await file.arrayBuffer());
+        url += '?size=' + bytes.length + '&crc32=' + crc32(bytes).toString(16).padStart(8, '0');
+    }
+
     const xhr = new XMLHttpRequest();
-    xhr.open('POST', endpoint);
+    xhr.open('POST', url);
 
     xhr.upload.onprogress = (e) => {
         if (e.lengthComputable) {
@@ -3175,9 +3302,10 @@ function populateModeDropdowns(availableModes) {
 
     // Add auto modes (skip 'follow' as it's already in HTML)
     availableModes.forEach(mode => {
-        // Mode can be a string or object with name/displayName
+        // Mode can be a string or object with name/displayName/description
         const modeName = typeof mode === 'string' ? mode : mode.name;
         const displayName = typeof mode === 'string' ? capitalizeFirst(mode) : (mode.displayName || mode.name);
+        const description = typeof mode === 'string' ? '' : (mode.description || '');
 
         // Skip 'follow' - it's already in the static HTML
         if (modeName === 'follow') return;
@@ -3186,12 +3314,14 @@ function populateModeDropdowns(availableModes) {
         const opt1 = document.createElement('option');
         opt1.value = modeName;
         opt1.textContent = displayName;
+        opt1.title = description;
         modeSelect.appendChild(opt1);
 
         // Config tab selector
         const opt2 = document.createElement('option');
         opt2.value = modeName;
         opt2.textContent = displayName;
+        opt2.title = description;
         defaultModeSelect.appendChild(opt2);
     });
 
@@ -3211,11 +3341,13 @@ function updateModeSelectors() {
     if (!modeSelect || !state.mode) return;
 
     // Update Control tab mode selector to reflect current mode (skip if recently changed by user)
+    // While an auto mode loads in the background, show the mode being switched to
     if (Date.now() >= modeSelectorLockedUntil) {
-        if (state.mode.current === 'follow') {
+        const shownMode = state.mode.loading || state.mode.current;
+        if (shownMode === 'follow') {
             modeSelect.value = 'follow';
-        } else if (state.mode.current) {
-            modeSelect.value = state.mode.current;
+        } else if (shownMode) {
+            modeSelect.value = shownMode;
         }
     }
 
@@ -3345,7 +3477,10 @@ async function restoreBackup(file) {
         });
 
         if (!response.ok) {
-            throw new Error(await response.text());
+            const body = await response.text();
+            let error = body;
+            try { error = JSON.parse(body).error || body; } catch (_) {}
+            throw new Error(error);
         }
 
         showToast('Backup restored! Device will reboot...', 'success');
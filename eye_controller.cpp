@@ -8,14 +8,10 @@
 #include "eye_controller.h"
 #include "servo_controller.h"
 #include "web_server.h"
+#include "eye_kinematics.h"
 
 EyeController eyeController;
 
-// Float version of map() - Arduino's map() only works with integers!
-static float mapFloat(float x, float in_min, float in_max, float out_min, float out_max) {
-    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
-}
-
 void EyeController::begin() {
     // Apply initial state (centered gaze, open lids)
     applyGaze();
@@ -23,6 +19,22 @@ void EyeController::begin() {
 }
 
 void EyeController::loop() {
+    // Motion layers (pose transition, idle motion) advance once per motion tick,
+    // alongside blink animations - servo writes are throttled to this rate anyway
+    bool idleActive = isIdleMotionActive();
+    if (_transitionChannels || idleActive) {
+        unsigned long now = millis();
+        unsigned long dt = now - _lastMotionTick;
+        if (dt >= SERVO_UPDATE_INTERVAL_MS) {
+            _lastMotionTick = now;
+            if (dt > IDLE_MOTION_MAX_STEP_MS) dt = IDLE_MOTION_MAX_STEP_MS;
+
+            if (_transitionChannels) updateTransition(now);
+            if (idleActive) updateIdleMotion(now, dt);
+            applyGaze();
+        }
+    }
+
     // Process async animations (non-blocking)
     if (_animState == AnimState::IDLE) return;
 
@@ -35,17 +47,7 @@ void EyeController::loop() {
                 _animState = AnimState::BLINK_OPENING;
                 _animStartTime = millis();
                 // Open eyes back to previous position
-                switch (_blinkEye) {
-                    case BlinkEye::BOTH:
-                        setLids(_blinkPrevLeft, _blinkPrevRight);
-                        break;
-                    case BlinkEye::LEFT:
-                        setLeftLid(_blinkPrevLeft);
-                        break;
-                    case BlinkEye::RIGHT:
-                        setRightLid(_blinkPrevRight);
-                        break;
-                }
+                reopenBlink();
             }
             break;
 
@@ -70,6 +72,7 @@ void EyeController::loop() {
 // === Gaze Control ===
 
 void EyeController::setGaze(float x, float y, float z) {
+    cancelTransition(CHANNEL_GAZE);  // Explicit command wins over a transition of its channels
     _gazeX = constrain(x, -100.0f, 100.0f);
     _gazeY = constrain(y, -100.0f, 100.0f);
     _gazeZ = constrain(z, -100.0f, 100.0f);
@@ -77,16 +80,19 @@ void EyeController::setGaze(float x, float y, float z) {
 }
 
 void EyeController::setGazeX(float x) {
+    cancelTransition(CHANNEL_GAZE);
     _gazeX = constrain(x, -100.0f, 100.0f);
     applyGaze();
 }
 
 void EyeController::setGazeY(float y) {
+    cancelTransition(CHANNEL_GAZE);
     _gazeY = constrain(y, -100.0f, 100.0f);
     applyGaze();
 }
 
 void EyeController::setGazeZ(float z) {
+    cancelTransition(CHANNEL_GAZE);
     _gazeZ = constrain(z, -100.0f, 100.0f);
     applyGaze();
 }
@@ -94,18 +100,23 @@ void EyeController::setGazeZ(float z) {
 // === Eyelid Control ===
 
 void EyeController::setLids(float left, float right) {
-    _lidLeft = constrain(left, -100.0f, 100.0f);
-    _lidRight = constrain(right, -100.0f, 100.0f);
-    applyLids();
+    cancelTransition(CHANNEL_LIDS);
+    writeLids(left, right);
 }
 
 void EyeController::setLeftLid(float position) {
-    _lidLeft = constrain(position, -100.0f, 100.0f);
-    applyLids();
+    cancelTransition(CHANNEL_LIDS);
+    writeLids(position, _lidRight);
 }
 
 void EyeController::setRightLid(float position) {
-    _lidRight = constrain(position, -100.0f, 100.0f);
+    cancelTransition(CHANNEL_LIDS);
+    writeLids(_lidLeft, position);
+}
+
+void EyeController::writeLids(float left, float right) {
+    _lidLeft = constrain(left, -100.0f, 100.0f);
+    _lidRight = constrain(right, -100.0f, 100.0f);
     applyLids();
 }
 
@@ -167,7 +178,7 @@ void EyeController::startBlink(unsigned int durationMs) {
     _animStartTime = millis();
     _animState = AnimState::BLINK_CLOSING;
 
-    setLids(-100, -100);  // Close immediately
+    writeLids(-100, -100);  // Close immediately (a lid transition keeps running underneath)
 }
 
 void EyeController::startBlinkLeft(unsigned int durationMs) {
@@ -181,7 +192,7 @@ void EyeController::startBlinkLeft(unsigned int durationMs) {
     _animStartTime = millis();
     _animState = AnimState::BLINK_CLOSING;
 
-    setLeftLid(-100);
+    writeLids(-100, _lidRight);
 }
 
 void EyeController::startBlinkRight(unsigned int durationMs) {
@@ -195,7 +206,7 @@ void EyeController::startBlinkRight(unsigned int durationMs) {
     _animStartTime = millis();
     _animState = AnimState::BLINK_CLOSING;
 
-    setRightLid(-100);
+    writeLids(_lidLeft, -100);
 }
 
 void EyeController::startWait(unsigned int durationMs) {
@@ -206,24 +217,28 @@ void EyeController::startWait(unsigned int durationMs) {
     _animState = AnimState::WAITING;
 }
 
+void EyeController::reopenBlink() {
+    // Back to the lids from before the blink (or where a lid transition has moved them)
+    switch (_blinkEye) {
+        case BlinkEye::BOTH:
+            writeLids(_blinkPrevLeft, _blinkPrevRight);
+            break;
+        case BlinkEye::LEFT:
+            writeLids(_blinkPrevLeft, _lidRight);
+            break;
+        case BlinkEye::RIGHT:
+            writeLids(_lidLeft, _blinkPrevRight);
+            break;
+    }
+}
+
 bool EyeController::isAnimating() const {
     return _animState != AnimState::IDLE;
 }
 
 void EyeController::cancelAnimation() {
     if (_animState == AnimState::BLINK_CLOSING || _animState == AnimState::BLINK_OPENING) {
-        // Restore lid positions if we were mid-blink
-        switch (_blinkEye) {
-            case BlinkEye::BOTH:
-                setLids(_blinkPrevLeft, _blinkPrevRight);
-                break;
-            case BlinkEye::LEFT:
-                setLeftLid(_blinkPrevLeft);
-                break;
-            case BlinkEye::RIGHT:
-                setRightLid(_blinkPrevRight);
-                break;
-        }
+        reopenBlink();  // Restore lid positions if we were mid-blink
     }
     _animState = AnimState::IDLE;
 }
@@ -231,6 +246,7 @@ void EyeController::cancelAnimation() {
 // === Parameters ===
 
 void EyeController::setCoupling(float c) {
+    cancelTransition(CHANNEL_COUPLING);
     _coupling = constrain(c, -1.0f, 1.0f);
     applyGaze();  // Reapply with new coupling
 }
@@ -241,6 +257,7 @@ void EyeController::setMaxVergence(float v) {
 }
 
 void EyeController::center() {
+    cancelTransition(CHANNEL_GAZE | CHANNEL_LIDS);
     _gazeX = 0;
     _gazeY = 0;
     // Note: Z and coupling are intentionally not reset - user controls them independently
@@ -251,9 +268,10 @@ void EyeController::center() {
 }
 
 void EyeController::resetAll() {
-    // Full reset including Z and coupling - used for mode switching
-    // Cancel any ongoing animation first
+    // Full reset including Z and coupling - used for safe state (NONE mode)
+    // Cancel any ongoing animation or transition first
     _animState = AnimState::IDLE;
+    cancelTransition();
 
     _gazeX = 0;
     _gazeY = 0;
@@ -272,70 +290,334 @@ void EyeController::reapply() {
     applyLids();
 }
 
-// === Internal: Vergence Calculation ===
+// === Pose / Transitions ===
+
+EyePose EyeController::getPose() const {
+    EyePose pose;
+    pose.gazeX = _gazeX;
+    pose.gazeY = _gazeY;
+    pose.gazeZ = _gazeZ;
+    pose.coupling = _coupling;
+    pose.lidLeft = _lidLeft;
+    pose.lidRight = _lidRight;
+    return pose;
+}
 
-float EyeController::calculateVergence(float z) {
-    // z: -100 (very close) to +100 (far)
-    // Returns vergence offset to add/subtract from X
-    //
-    // At z=+100 (far): vergence = 0 (parallel eyes)
-    // At z=0 (medium): vergence = maxVergence / 2
-    // At z=-100 (close/nose): vergence = maxVergence (cross-eyed)
+void EyeController::setPose(const EyePose& pose) {
+    cancelTransition();
+    _gazeX = constrain(pose.gazeX, -100.0f, 100.0f);
+    _gazeY = constrain(pose.gazeY, -100.0f, 100.0f);
+    _gazeZ = constrain(pose.gazeZ, -100.0f, 100.0f);
+    _coupling = constrain(pose.coupling, -1.0f, 1.0f);
+    _lidLeft = constrain(pose.lidLeft, -100.0f, 100.0f);
+    _lidRight = constrain(pose.lidRight, -100.0f, 100.0f);
+    applyGaze();
+    applyLids();
+}
 
-    // Normalize Z from [-100, +100] to [0, 1] where 0=far, 1=close
-    float normalizedZ = (100.0f - z) / 200.0f;  // z=100 -> 0, z=-100 -> 1
+EyePose EyeController::neutralPose() {
+    EyePose pose = {0, 0, 0, 1.0f, 0, 0};
+    return pose;
+}
 
-    return _maxVergence * normalizedZ;
+void EyeController::startTransition(const EyePose& target, unsigned int durationMs,
+                                    Easing easing, uint8_t channels) {
+    channels &= CHANNEL_ALL;
+    if (channels == 0) return;
+
+    EyePose from = getPose();
+    EyePose to;
+    to.gazeX = constrain(target.gazeX, -100.0f, 100.0f);
+    to.gazeY = constrain(target.gazeY, -100.0f, 100.0f);
+    to.gazeZ = constrain(target.gazeZ, -100.0f, 100.0f);
+    to.coupling = constrain(target.coupling, -1.0f, 1.0f);
+    to.lidLeft = constrain(target.lidLeft, -100.0f, 100.0f);
+    to.lidRight = constrain(target.lidRight, -100.0f, 100.0f);
+
+    // Replaces a running transition of the same groups only
+    unsigned long now = millis();
+    for (uint8_t group = 0; group < TRANSITION_GROUPS; group++) {
+        if (!(channels & (1 << group))) continue;
+        Transition& transition = _transitions[group];
+        transition.from = from;
+        transition.to = to;
+        transition.startTime = now;
+        transition.duration = durationMs;
+        transition.easing = easing;
+    }
+    _transitionChannels |= channels;
+
+    if (durationMs == 0) {
+        // Jump straight to the target (same path, t = 1)
+        updateTransition(now);
+        applyGaze();
+    }
 }
 
-// === Internal: Logical to Servo Mapping ===
+void EyeController::cancelTransition(uint8_t channels) {
+    // The other channels keep blending
+    _transitionChannels &= ~channels;
+}
 
-void EyeController::setServoFromLogical(uint8_t servoIndex, float logical) {
-    // logical: -100 to +100
-    // Maps to servo's calibrated range (min/center/max)
+Easing EyeController::parseEasing(const char* name) {
+    if (name == nullptr) return Easing::EASE_IN_OUT;
+    if (strcmp(name, "linear") == 0) return Easing::LINEAR;
+    if (strcmp(name, "easeIn") == 0) return Easing::EASE_IN;
+    if (strcmp(name, "easeOut") == 0) return Easing::EASE_OUT;
+    return Easing::EASE_IN_OUT;
+}
 
-    const ServoConfig& config = servoController.getConfig(servoIndex);
+static float applyEasing(Easing easing, float t) {
+    switch (easing) {
+        case Easing::LINEAR:   return t;
+        case Easing::EASE_IN:  return t * t;
+        case Easing::EASE_OUT: return t * (2.0f - t);
+        default:               return t * t * (3.0f - 2.0f * t);  // Smoothstep, no velocity jump at either end
+    }
+}
+
+float EyeController::transitionProgress(uint8_t group, unsigned long now) {
+    // Eased 0..1 of one group's transition; the group ends once it reaches 1
+    const Transition& transition = _transitions[group];
+    unsigned long elapsed = now - transition.startTime;
+    if (elapsed < transition.duration) {
+        return applyEasing(transition.easing, (float)elapsed / (float)transition.duration);
+    }
+    _transitionChannels &= ~(1 << group);
+    return 1.0f;
+}
 
-    float position;
-    if (logical < 0) {
-        // Map -100..0 to min..center
-        position = mapFloat(logical, -100.0f, 0.0f, (float)config.min, (float)config.center);
+void EyeController::updateTransition(unsigned long now) {
+    if (_transitionChannels & CHANNEL_GAZE) {
+        const Transition& gaze = _transitions[0];
+        float t = transitionProgress(0, now);
+        _gazeX = gaze.from.gazeX + (gaze.to.gazeX - gaze.from.gazeX) * t;
+        _gazeY = gaze.from.gazeY + (gaze.to.gazeY - gaze.from.gazeY) * t;
+        _gazeZ = gaze.from.gazeZ + (gaze.to.gazeZ - gaze.from.gazeZ) * t;  // Z drives vergence
+    }
+    if (_transitionChannels & CHANNEL_COUPLING) {
+        const Transition& coupling = _transitions[1];
+        float t = transitionProgress(1, now);
+        _coupling = coupling.from.coupling + (coupling.to.coupling - coupling.from.coupling) * t;
+    }
+    // Gaze is applied by the caller (once per motion tick)
+
+    if (!(_transitionChannels & CHANNEL_LIDS)) return;
+
+    const Transition& lids = _transitions[2];
+    float t = transitionProgress(2, now);
+    float left = lids.from.lidLeft + (lids.to.lidLeft - lids.from.lidLeft) * t;
+    float right = lids.from.lidRight + (lids.to.lidRight - lids.from.lidRight) * t;
+    if (_animState == AnimState::BLINK_CLOSING) {
+        // Don't fight a closing blink - it reopens to the interpolated lids instead
+        _blinkPrevLeft = left;
+        _blinkPrevRight = right;
+        if (_blinkEye == BlinkEye::LEFT) _lidRight = right;
+        else if (_blinkEye == BlinkEye::RIGHT) _lidLeft = left;
     } else {
-        // Map 0..+100 to center..max
-        position = mapFloat(logical, 0.0f, 100.0f, (float)config.center, (float)config.max);
+        _lidLeft = left;
+        _lidRight = right;
     }
+    applyLids();
+}
 
-    servoController.setPosition(servoIndex, (uint8_t)constrain(position, 0.0f, 180.0f));
+// === Procedural Idle Motion ===
+// 1D gradient (Perlin) noise on an integer lattice. phase is Q16: the upper
+// 16 bits select the lattice cell, the lower 16 bits the position inside it.
+
+static inline int32_t idleGradient(uint32_t cell, uint32_t seed) {
+    // Integer hash -> gradient slope in Q15 (-1.0 .. +1.0)
+    uint32_t h = (cell + seed) * 0x9E3779B1u;
+    h ^= h >> 15;
+    h *= 0x85EBCA77u;
+    h ^= h >> 13;
+    return (int32_t)(h & 0xFFFF) - 32768;
 }
 
-// === Internal: Apply Gaze to Servos ===
+static int32_t idleNoiseQ15(uint32_t phase, uint32_t seed) {
+    uint32_t cell = phase >> 16;
+    int32_t t = (int32_t)((phase & 0xFFFF) >> 1);  // Q15 position in cell
+
+    // Contributions of the gradients at both ends of the cell (|v1 - v0| <= 1.0)
+    int32_t v0 = (idleGradient(cell, seed) * t) >> 15;
+    int32_t v1 = (idleGradient(cell + 1, seed) * (t - EYE_Q15_ONE)) >> 15;
+
+    // Smoothstep fade 3t^2 - 2t^3, unsigned because t^2 * (3 - 2t) can exceed 2^31
+    uint32_t t2 = ((uint32_t)t * (uint32_t)t) >> 15;
+    int32_t fade = (int32_t)((t2 * (uint32_t)(3 * EYE_Q15_ONE - 2 * t)) >> 15);
+
+    // 1D gradient noise peaks around +-0.5, scale to +-1.0
+    int32_t n = (v0 + (((v1 - v0) * fade) >> 15)) * 2;
+    return constrain(n, -EYE_Q15_ONE, EYE_Q15_ONE);
+}
+
+// Independent noise streams per layer/axis (large odd offsets decorrelate the hash)
+static const uint32_t IDLE_SEED_DRIFT[2]  = {0x68E31DA4u, 0xB5297A4Du};
+static const uint32_t IDLE_SEED_TREMOR[2] = {0x1B56C4E9u, 0x7F4A7C15u};
+
+static int32_t idleAmplitudeQ15(float amplitude) {
+    return (int32_t)(constrain(amplitude, 0.0f, 100.0f) * (EYE_Q15_ONE / 100.0f));
+}
+
+static uint32_t idleRateQ16(float frequency) {
+    return (uint32_t)(constrain(frequency, 0.0f, 30.0f) * 65536.0f);
+}
+
+void EyeController::setIdleMotion(const IdleMotionConfig& config, uint32_t seed) {
+    const IdleMotionAxis* drift[2] = {&config.drift.x, &config.drift.y};
+    const IdleMotionAxis* tremor[2] = {&config.tremor.x, &config.tremor.y};
+    const IdleMotionAxis* saccade[2] = {&config.saccade.x, &config.saccade.y};
+    unsigned long now = millis();
+    _idleRng.seed(seed, PRNG_STREAM_IDLE);
+
+    for (int axis = 0; axis < 2; axis++) {
+        _idleDrift[axis].amplitude = idleAmplitudeQ15(drift[axis]->amplitude);
+        _idleDrift[axis].rate = idleRateQ16(drift[axis]->frequency);
+        _idleDrift[axis].phase = _idleRng.next();  // Different path per seed
+        _idleTremor[axis].amplitude = idleAmplitudeQ15(tremor[axis]->amplitude);
+        _idleTremor[axis].rate = idleRateQ16(tremor[axis]->frequency);
+        _idleTremor[axis].phase = _idleRng.next();
+
+        float rate = constrain(saccade[axis]->frequency, 0.0f, 10.0f);
+        _idleSaccadeAmplitude[axis] = idleAmplitudeQ15(saccade[axis]->amplitude);
+        _idleSaccadeIntervalMs[axis] = (rate > 0) ? (uint32_t)(1000.0f / rate) : 0;
+        _idleSaccadeNext[axis] = now + _idleSaccadeIntervalMs[axis];
+        _idleSaccadeOffset[axis] = 0;
+    }
+
+    _idleGain = 0;
+    _idleTickUs = 0;
+    _idleTickMaxUs = 0;
+    _idleEnabled = true;
+}
+
+void EyeController::clearIdleMotion() {
+    if (!_idleEnabled) return;
+
+    _idleEnabled = false;
+    _idleOffsetX = 0;
+    _idleOffsetY = 0;
+    applyGaze();
+    WEB_LOG("Eye", "Idle motion off (tick max %lu us)", (unsigned long)_idleTickMaxUs);
+}
+
+void EyeController::setIdleMotionPaused(bool paused) {
+    if (paused == _idlePaused) return;
+
+    _idlePaused = paused;
+    if (paused && _idleEnabled) {
+        // Hand back exact positions for manual control/calibration
+        _idleOffsetX = 0;
+        _idleOffsetY = 0;
+        applyGaze();
+    } else {
+        _idleGain = 0;  // Fade back in on resume
+    }
+}
+
+void EyeController::updateIdleMotion(unsigned long now, unsigned long dt) {
+    // Fixed work per tick: 4 noise evaluations + 2 saccade checks
+    uint32_t startUs = micros();
+
+    if (_idleGain < EYE_Q15_ONE) {
+        _idleGain += (int32_t)(EYE_Q15_ONE * dt / IDLE_MOTION_FADE_MS);
+        if (_idleGain > EYE_Q15_ONE) _idleGain = EYE_Q15_ONE;
+    }
+
+    int32_t offset[2];
+    for (int axis = 0; axis < 2; axis++) {
+        IdleNoiseAxis& drift = _idleDrift[axis];
+        IdleNoiseAxis& tremor = _idleTremor[axis];
+        drift.phase += drift.rate * dt / 1000;
+        tremor.phase += tremor.rate * dt / 1000;
+
+        int32_t sum = ((drift.amplitude * idleNoiseQ15(drift.phase, IDLE_SEED_DRIFT[axis])) >> 15)
+                    + ((tremor.amplitude * idleNoiseQ15(tremor.phase, IDLE_SEED_TREMOR[axis])) >> 15);
+
+        // Micro-saccade: jump to a new small offset at jittered intervals (50-150% of mean)
+        if (_idleSaccadeIntervalMs[axis] > 0 && (long)(now - _idleSaccadeNext[axis]) >= 0) {
+            _idleSaccadeOffset[axis] = (_idleSaccadeAmplitude[axis] * _idleRng.range(-32768, 32767)) >> 15;
+            _idleSaccadeNext[axis] = now + _idleSaccadeIntervalMs[axis] * _idleRng.range(50, 150) / 100;
+        }
+        sum += _idleSaccadeOffset[axis];
+
+        sum = constrain(sum, -EYE_Q15_ONE, EYE_Q15_ONE);
+        offset[axis] = (sum * _idleGain) >> 15;
+    }
+    _idleOffsetX = offset[0];
+    _idleOffsetY = offset[1];
+
+    _idleTickUs = micros() - startUs;
+    if (_idleTickUs > _idleTickMaxUs) _idleTickMaxUs = _idleTickUs;
+}
+
+// === Internal: Gaze Kinematics (eye_kinematics.h) ===
+
+EyeGazeInput EyeController::gazeInput() const {
+    EyeGazeInput in;
+    in.gazeX = _gazeX;
+    in.gazeY = _gazeY;
+    in.gazeZ = _gazeZ;
+    in.coupling = _coupling;
+    in.maxVergence = _maxVergence;
+    in.maxVerticalDivergence = _maxVerticalDivergence;
+    in.idleOffsetX = _idleOffsetX;
+    in.idleOffsetY = _idleOffsetY;
+    return in;
+}
+
+#if EYE_KINEMATICS_FIXED_POINT
+
+// === Internal: Logical to Servo Mapping (Q15) ===
+
+void EyeController::setServoFromQ15(uint8_t servoIndex, int32_t logical) {
+    // logical: -EYE_Q15_ONE to +EYE_Q15_ONE (= -100 to +100)
+    const ServoConfig& config = servoController.getConfig(servoIndex);
+    servoController.setPosition(servoIndex, eyeServoFromQ15(logical, config.min, config.center, config.max),
+                                _commandOriginUs);
+}
+
+// === Internal: Apply Gaze to Servos (Q15) ===
 
 void EyeController::applyGaze() {
-    // Calculate vergence offset based on Z (depth)
-    float vergenceOffset = calculateVergence(_gazeZ);
+    int32_t eyes[EYE_GAZE_TARGETS];
+    eyeGazeQ15(gazeInput(), eyes);
+
+    setServoFromQ15(SERVO_LEFT_EYE_X, eyes[EYE_LEFT_X]);
+    setServoFromQ15(SERVO_LEFT_EYE_Y, eyes[EYE_LEFT_Y]);
+    setServoFromQ15(SERVO_RIGHT_EYE_X, eyes[EYE_RIGHT_X]);
+    setServoFromQ15(SERVO_RIGHT_EYE_Y, eyes[EYE_RIGHT_Y]);
+}
+
+// === Internal: Apply Lids to Servos (Q15) ===
+
+void EyeController::applyLids() {
+    setServoFromQ15(SERVO_LEFT_EYELID, eyeToQ15(_lidLeft, 100.0f));
+    setServoFromQ15(SERVO_RIGHT_EYELID, eyeToQ15(_lidRight, 100.0f));
+}
 
-    // Apply coupling to vergence
-    // coupling > 0: eyes converge (normal)
-    // coupling = 0: eyes move independently (no vergence effect)
-    // coupling < 0: eyes diverge (wall-eyed)
-    float leftXOffset = vergenceOffset * _coupling;
-    float rightXOffset = -vergenceOffset * _coupling;
+#else
 
-    // Calculate per-eye X positions
-    float leftEyeX = constrain(_gazeX + leftXOffset, -100.0f, 100.0f);
-    float rightEyeX = constrain(_gazeX + rightXOffset, -100.0f, 100.0f);
+// === Internal: Logical to Servo Mapping ===
 
-    // Y: apply vertical divergence when coupling is negative (Feldman mode)
-    // Fixed offset that doesn't depend on gaze, scales with negative coupling
-    float verticalDivergence = (_coupling < 0) ? _maxVerticalDivergence * (-_coupling) : 0;
-    float leftEyeY = constrain(_gazeY + verticalDivergence, -100.0f, 100.0f);
-    float rightEyeY = constrain(_gazeY - verticalDivergence, -100.0f, 100.0f);
+void EyeController::setServoFromLogical(uint8_t servoIndex, float logical) {
+    // logical: -100 to +100
+    // Maps to servo's calibrated range (min/center/max)
+    const ServoConfig& config = servoController.getConfig(servoIndex);
+    servoController.setPosition(servoIndex, eyeServoFromLogical(logical, config.min, config.center, config.max),
+                                _commandOriginUs);
+}
+
+// === Internal: Apply Gaze to Servos ===
 
-    // Apply to servos
-    setServoFromLogical(SERVO_LEFT_EYE_X, leftEyeX);
-    setServoFromLogical(SERVO_LEFT_EYE_Y, leftEyeY);
-    setServoFromLogical(SERVO_RIGHT_EYE_X, rightEyeX);
-    setServoFromLogical(SERVO_RIGHT_EYE_Y, rightEyeY);
+void EyeController::applyGaze() {
+    float eyes[EYE_GAZE_TARGETS];
+    eyeGazeFloat(gazeInput(), eyes);
+
+    setServoFromLogical(SERVO_LEFT_EYE_X, eyes[EYE_LEFT_X]);
+    setServoFromLogical(SERVO_LEFT_EYE_Y, eyes[EYE_LEFT_Y]);
+    setServoFromLogical(SERVO_RIGHT_EYE_X, eyes[EYE_RIGHT_X]);
+    setServoFromLogical(SERVO_RIGHT_EYE_Y, eyes[EYE_RIGHT_Y]);
 }
 
 // === Internal: Apply Lids to Servos ===
@@ -344,3 +626,5 @@ void EyeController::applyLids() {
     setServoFromLogical(SERVO_LEFT_EYELID, _lidLeft);
     setServoFromLogical(SERVO_RIGHT_EYELID, _lidRight);
 }
+
+#endif // EYE_KINEMATICS_FIXED_POINT
@@ -11,11 +11,44 @@
 #include <Arduino.h>
 #include "config.h"
 #include "servo_controller.h"
+#include "prng.h"
+#include "eye_kinematics.h"
 
 // Eye Controller - Abstraction layer for logical gaze/lid control
 // Translates logical coordinates (-100 to +100) into calibrated servo positions
 // Handles vergence (eye convergence) and coupling (linked/independent/divergent)
 
+// Complete logical eye state (used for save/restore and transitions)
+struct EyePose {
+    float gazeX;
+    float gazeY;
+    float gazeZ;
+    float coupling;
+    float lidLeft;
+    float lidRight;
+};
+
+// Easing curves for timed transitions (mode switch crossfade, "move" primitive)
+enum class Easing { LINEAR, EASE_IN, EASE_OUT, EASE_IN_OUT };
+
+// Procedural idle motion, added on top of the commanded gaze
+// Each layer has a per-axis amplitude (logical units) and frequency (Hz)
+struct IdleMotionAxis {
+    float amplitude;
+    float frequency;
+};
+
+struct IdleMotionLayer {
+    IdleMotionAxis x;
+    IdleMotionAxis y;
+};
+
+struct IdleMotionConfig {
+    IdleMotionLayer drift;    // Slow wandering (coherent noise, ~0.1-0.5 Hz)
+    IdleMotionLayer tremor;   // Fine jitter (coherent noise, ~5-15 Hz)
+    IdleMotionLayer saccade;  // Small jumps at random intervals (frequency = average rate)
+};
+
 class EyeController {
 public:
     void begin();
@@ -73,6 +106,44 @@ public:
     // Re-apply current state to servos (used when returning from Calibration)
     void reapply();
 
+    // Latency tracing: arrival time of the external command being handled (0 = none).
+    // Servo targets set meanwhile carry it as their origin; otherwise the time of change is used.
+    void setCommandOrigin(uint32_t originUs) { _commandOriginUs = originUs; }
+
+    // Pose snapshot/restore (gaze, Z, coupling, lids)
+    EyePose getPose() const;
+    void setPose(const EyePose& pose);
+    static EyePose neutralPose();  // State after resetAll()
+
+    // Timed transition to a pose (non-blocking, interpolated every motion tick)
+    // Only the selected channels move. Each channel group (gaze, coupling, lids) runs
+    // its own transition, so a move of one group leaves the others' moves running
+    // (parallel tracks). Gaze, lid and coupling setters (and setPose, center,
+    // resetAll) cancel the channels they set; the others keep blending.
+    // A closing blink reopens to the interpolated lid position
+    static const uint8_t CHANNEL_GAZE = 0x01;      // X, Y, Z (vergence)
+    static const uint8_t CHANNEL_COUPLING = 0x02;
+    static const uint8_t CHANNEL_LIDS = 0x04;
+    static const uint8_t CHANNEL_ALL = 0x07;
+    void startTransition(const EyePose& target, unsigned int durationMs,
+                         Easing easing = Easing::EASE_IN_OUT, uint8_t channels = CHANNEL_ALL);
+    void cancelTransition(uint8_t channels = CHANNEL_ALL);
+    bool isTransitioning(uint8_t channels = CHANNEL_ALL) const {
+        return (_transitionChannels & channels) != 0;
+    }
+
+    // Easing name from JSON ("linear", "easeIn", "easeOut", "easeInOut"), default easeInOut
+    static Easing parseEasing(const char* name);
+
+    // Procedural idle motion (set per mode by ModePlayer, paused during manual control)
+    // Start phases and micro-saccades are drawn from a generator seeded with seed
+    void setIdleMotion(const IdleMotionConfig& config, uint32_t seed);
+    void clearIdleMotion();
+    void setIdleMotionPaused(bool paused);
+    bool isIdleMotionActive() const { return _idleEnabled && !_idlePaused; }
+    uint32_t getIdleTickUs() const { return _idleTickUs; }        // Cost of last idle tick
+    uint32_t getIdleTickMaxUs() const { return _idleTickMaxUs; }  // Peak since enabled
+
     // Getters for UI feedback
     float getGazeX() const { return _gazeX; }
     float getGazeY() const { return _gazeY; }
@@ -93,6 +164,8 @@ private:
     float _maxVergence = 50.0; // Max horizontal vergence offset at Z=-100
     float _maxVerticalDivergence = 50.0; // Max vertical divergence when coupling=-1 (Feldman mode)
 
+    uint32_t _commandOriginUs = 0;
+
     // === Async Animation State Machine ===
     enum class AnimState { IDLE, BLINK_CLOSING, BLINK_OPENING, WAITING };
     enum class BlinkEye { BOTH, LEFT, RIGHT };
@@ -106,15 +179,66 @@ private:
     float _blinkPrevLeft = 0;
     float _blinkPrevRight = 0;
 
-    // Calculate vergence offset based on Z depth
-    float calculateVergence(float z);
+    // Pose transition state (independent of blink/wait state machine), one per
+    // channel group - index = bit position of the CHANNEL_* flag
+    struct Transition {
+        EyePose from;                   // Only the group's own fields are used
+        EyePose to;
+        unsigned long startTime = 0;
+        unsigned long duration = 0;
+        Easing easing = Easing::EASE_IN_OUT;
+    };
+    static const uint8_t TRANSITION_GROUPS = 3;
+    Transition _transitions[TRANSITION_GROUPS];
+    uint8_t _transitionChannels = 0;    // Groups with a running transition
+
+    void updateTransition(unsigned long now);
+    float transitionProgress(uint8_t group, unsigned long now);
+
+    // Lid write without cancelling a lid transition (blink close/reopen)
+    void writeLids(float left, float right);
+    void reopenBlink();
+
+    // Motion tick for transition and idle layers (SERVO_UPDATE_INTERVAL_MS)
+    unsigned long _lastMotionTick = 0;
+
+    // Idle motion state - integer only (amplitudes Q15 where 32768 = 100 logical)
+    struct IdleNoiseAxis {
+        int32_t amplitude;   // Q15
+        uint32_t rate;       // Noise lattice cells per second, Q16
+        uint32_t phase;      // Noise lattice position, Q16
+    };
+    bool _idleEnabled = false;
+    bool _idlePaused = false;
+    int32_t _idleGain = 0;               // Q15 fade-in
+    IdleNoiseAxis _idleDrift[2];         // [0] = X, [1] = Y
+    IdleNoiseAxis _idleTremor[2];
+    int32_t _idleSaccadeAmplitude[2];    // Q15
+    uint32_t _idleSaccadeIntervalMs[2];  // Mean interval (0 = off)
+    unsigned long _idleSaccadeNext[2];
+    int32_t _idleSaccadeOffset[2];
+    Prng _idleRng;
+    int32_t _idleOffsetX = 0;            // Q15 offset added to gaze X
+    int32_t _idleOffsetY = 0;            // Q15 offset added to gaze Y
+    uint32_t _idleTickUs = 0;
+    uint32_t _idleTickMaxUs = 0;
+
+    void updateIdleMotion(unsigned long now, unsigned long dt);
 
     // Calculate blink duration based on lid travel distance
     unsigned int calculateBlinkDuration(float lidLeft, float lidRight);
 
+#if EYE_KINEMATICS_FIXED_POINT
+    // Map Q15 logical coordinate (-32768 to +32768 = -100 to +100) to servo position
+    void setServoFromQ15(uint8_t servoIndex, int32_t logical);
+#else
     // Map logical coordinate (-100 to +100) to servo position
     // Uses servo's calibration (min/center/max) and invert flag
     void setServoFromLogical(uint8_t servoIndex, float logical);
+#endif
+
+    // Current gaze state as kinematics input
+    EyeGazeInput gazeInput() const;
 
     // Apply current gaze state to eye servos (X/Y with vergence)
     void applyGaze();
@@ -0,0 +1,125 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef EYE_KINEMATICS_H
+#define EYE_KINEMATICS_H
+
+#include <stdint.h>
+
+// Eye Kinematics - Logical gaze/lid coordinates to servo angles
+// Per-eye targets from gaze, Z (vergence), coupling and vertical divergence, then
+// the calibration mapping (min/center/max) of each servo. EyeController uses the
+// Q15 integer path (EYE_KINEMATICS_FIXED_POINT 1) or the float reference path.
+// Plain C++, both paths are also built by the host check (make bench-kinematics).
+
+// Q15 fixed point: EYE_Q15_ONE represents 100 logical units (or 1.0 for coupling).
+// Products of two Q15 values stay below 2^31, so plain int32_t math is sufficient.
+#define EYE_Q15_ONE 32768
+
+struct EyeGazeInput {
+    float gazeX;                  // -100 to +100
+    float gazeY;
+    float gazeZ;
+    float coupling;               // -1.0 to +1.0
+    float maxVergence;            // Horizontal vergence offset at Z=-100
+    float maxVerticalDivergence;  // Vertical divergence at coupling=-1
+    int32_t idleOffsetX;          // Idle motion offsets, Q15
+    int32_t idleOffsetY;
+};
+
+// Per-eye logical targets, in this order
+enum EyeGazeTarget { EYE_LEFT_X, EYE_LEFT_Y, EYE_RIGHT_X, EYE_RIGHT_Y, EYE_GAZE_TARGETS };
+
+static inline int32_t eyeToQ15(float value, float unit) {
+    // Round to nearest so the fixed path tracks the float reference within 1 LSB
+    float scaled = value * (EYE_Q15_ONE / unit);
+    return (int32_t)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+}
+
+static inline int32_t eyeClampQ15(int32_t value) {
+    if (value < -EYE_Q15_ONE) return -EYE_Q15_ONE;
+    if (value > EYE_Q15_ONE) return EYE_Q15_ONE;
+    return value;
+}
+
+static inline float eyeClampLogical(float value) {
+    return value < -100.0f ? -100.0f : (value > 100.0f ? 100.0f : value);
+}
+
+// === Q15 ===
+
+// Targets as Q15 logical coordinates (-EYE_Q15_ONE to +EYE_Q15_ONE)
+static inline void eyeGazeQ15(const EyeGazeInput& in, int32_t out[EYE_GAZE_TARGETS]) {
+    // Same transform as eyeGazeFloat(), in Q15 integer math
+    int32_t gazeX = eyeClampQ15(eyeToQ15(in.gazeX, 100.0f) + in.idleOffsetX);
+    int32_t gazeY = eyeClampQ15(eyeToQ15(in.gazeY, 100.0f) + in.idleOffsetY);
+    int32_t gazeZ = eyeToQ15(in.gazeZ, 100.0f);
+    int32_t coupling = eyeToQ15(in.coupling, 1.0f);
+
+    // Vergence: maxVergence * (100 - z) / 200
+    int32_t normalizedZ = (EYE_Q15_ONE - gazeZ) >> 1;
+    int32_t vergenceOffset = (eyeToQ15(in.maxVergence, 100.0f) * normalizedZ) >> 15;
+
+    // Coupling scales vergence (negative = diverge)
+    int32_t xOffset = (vergenceOffset * coupling) >> 15;
+    out[EYE_LEFT_X] = eyeClampQ15(gazeX + xOffset);
+    out[EYE_RIGHT_X] = eyeClampQ15(gazeX - xOffset);
+
+    // Vertical divergence only when coupling is negative (Feldman mode)
+    int32_t verticalDivergence = (coupling < 0)
+        ? (eyeToQ15(in.maxVerticalDivergence, 100.0f) * -coupling) >> 15 : 0;
+    out[EYE_LEFT_Y] = eyeClampQ15(gazeY + verticalDivergence);
+    out[EYE_RIGHT_Y] = eyeClampQ15(gazeY - verticalDivergence);
+}
+
+static inline uint8_t eyeServoFromQ15(int32_t logical, uint8_t min, uint8_t center, uint8_t max) {
+    // position = center + logical * (center - min) for negative,
+    //            center + logical * (max - center) for positive
+    int32_t span = (logical < 0) ? ((int32_t)center - min) : ((int32_t)max - center);
+    int32_t position = (((int32_t)center << 15) + logical * span) >> 15;
+    return (uint8_t)(position < 0 ? 0 : (position > 180 ? 180 : position));
+}
+
+// === Float reference ===
+
+static inline void eyeGazeFloat(const EyeGazeInput& in, float out[EYE_GAZE_TARGETS]) {
+    float gazeX = eyeClampLogical(in.gazeX + in.idleOffsetX * (100.0f / EYE_Q15_ONE));
+    float gazeY = eyeClampLogical(in.gazeY + in.idleOffsetY * (100.0f / EYE_Q15_ONE));
+
+    // Vergence offset based on Z (depth)
+    // At z=+100 (far): 0 (parallel eyes), z=0: maxVergence / 2, z=-100 (nose): maxVergence
+    float normalizedZ = (100.0f - in.gazeZ) / 200.0f;
+    float vergenceOffset = in.maxVergence * normalizedZ;
+
+    // Apply coupling to vergence
+    // coupling > 0: eyes converge (normal)
+    // coupling = 0: eyes move independently (no vergence effect)
+    // coupling < 0: eyes diverge (wall-eyed)
+    out[EYE_LEFT_X] = eyeClampLogical(gazeX + vergenceOffset * in.coupling);
+    out[EYE_RIGHT_X] = eyeClampLogical(gazeX - vergenceOffset * in.coupling);
+
+    // Y: apply vertical divergence when coupling is negative (Feldman mode)
+    // Fixed offset that doesn't depend on gaze, scales with negative coupling
+    float verticalDivergence = (in.coupling < 0) ? in.maxVerticalDivergence * (-in.coupling) : 0;
+    out[EYE_LEFT_Y] = eyeClampLogical(gazeY + verticalDivergence);
+    out[EYE_RIGHT_Y] = eyeClampLogical(gazeY - verticalDivergence);
+}
+
+// Float version of map() - Arduino's map() only works with integers!
+static inline float eyeMapFloat(float x, float inMin, float inMax, float outMin, float outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+static inline uint8_t eyeServoFromLogical(float logical, uint8_t min, uint8_t center, uint8_t max) {
+    // Map -100..0 to min..center, 0..+100 to center..max
+    float position = (logical < 0)
+        ? eyeMapFloat(logical, -100.0f, 0.0f, (float)min, (float)center)
+        : eyeMapFloat(logical, 0.0f, 100.0f, (float)center, (float)max);
+    return (uint8_t)(position < 0.0f ? 0.0f : (position > 180.0f ? 180.0f : position));
+}
+
+#endif // EYE_KINEMATICS_H
@@ -9,19 +9,37 @@
 #include "eye_controller.h"
 #include "auto_blink.h"
 #include "auto_impulse.h"
+#include "clip_player.h"
 #include "web_server.h"
 #include <LittleFS.h>
 
 ImpulsePlayer impulsePlayer;
 
 void ImpulsePlayer::begin() {
+    setSeed(0);
     // Initial preload handled by autoImpulse.begin()
 }
 
+void ImpulsePlayer::setSeed(uint32_t seed) {
+    _rng.seed(seed != 0 ? seed : Prng::entropy(), PRNG_STREAM_IMPULSE);
+}
+
+uint32_t ImpulsePlayer::msUntilNextStep() const {
+    if (_pending) return 0;
+    if (!_playing) return UINT32_MAX;
+    return msUntilNextTrackStep(_tracks);
+}
+
 void ImpulsePlayer::loop() {
-    // Handle pending state (waiting for blink to finish before starting)
+    // Files changed (UI upload / restore) - drop cached impulses
+    if (_invalidateRequested) {
+        _invalidateRequested = false;
+        dropCache();
+    }
+
+    // Handle pending state (waiting for blink or mode transition to finish before starting)
     if (_pending) {
-        if (!eyeController.isAnimating()) {
+        if (!eyeController.isAnimating() && !eyeController.isTransitioning()) {
             _pending = false;
             startPlayback();
         }
@@ -30,65 +48,99 @@ void ImpulsePlayer::loop() {
 
     if (!_playing) return;
 
-    // Check if waiting for a timed delay
-    if (_waitUntil > 0) {
-        if (millis() < _waitUntil) {
-            return;  // Still waiting
+    // Parallel tracks first; the main track resumes once all of them are done
+    bool tracksRunning = false;
+    for (uint8_t i = 1; i < SEQUENCE_MAX_TRACKS; i++) {
+        if (_tracks[i].active) {
+            runTrack(_tracks[i]);
+            tracksRunning |= _tracks[i].active;
         }
-        _waitUntil = 0;
-        advanceStep();  // Wait complete, move to next step
-        return;  // Execute next step on next loop iteration
     }
 
-    // Check if waiting for animation (blink) to complete
-    if (_waitingForAnimation) {
-        if (eyeController.isAnimating()) {
-            return;  // Still animating
+    SequenceTrack& main = _tracks[0];
+    if (main.wait == TrackWait::JOIN) {
+        if (tracksRunning) return;
+        main.wait = TrackWait::NONE;
+        main.timelineMs = _joinMs;
+    }
+    runTrack(main);
+}
+
+void ImpulsePlayer::runTrack(SequenceTrack& track) {
+    // Absolute step timeline, same scheme as ModePlayer::runTrack
+    switch (track.wait) {
+        case TrackWait::TIME: {
+            unsigned long now = millis();
+            if (!Scheduler::isDue(now, track.timelineMs)) return;  // Still waiting
+            if (now - track.timelineMs > SEQUENCE_MAX_LATE_MS) {
+                track.timelineMs = now;  // Stalled - resync instead of bursting steps
+            }
+            break;
         }
-        _waitingForAnimation = false;
-        advanceStep();  // Animation complete, move to next step
-        return;  // Execute next step on next loop iteration
+        case TrackWait::BLINK:
+            if (eyeController.isAnimating()) return;  // Still animating
+            track.timelineMs = millis();
+            break;
+        case TrackWait::TRANSITION:
+            if (eyeController.isTransitioning(track.moveChannels)) return;  // Move still running
+            track.timelineMs = millis();
+            break;
+        case TrackWait::CLIP:
+            if (clipPlayer.isPlaying()) return;  // Baked clip still running
+            track.timelineMs = millis();
+            break;
+        case TrackWait::JOIN:
+            return;
+        case TrackWait::NONE:
+            break;
+    }
+    track.wait = TrackWait::NONE;
+
+    JsonObject step = track.cursor.next(_sequences, track.rng);
+    if (step.isNull()) {
+        if (&track == &_tracks[0]) {
+            stopPlayback();  // Sequence complete - restore state and stop
+        } else {
+            track.active = false;
+            if (Scheduler::isDue(track.timelineMs, _joinMs)) {
+                _joinMs = track.timelineMs;  // Latest end so far
+            }
+        }
+        return;
     }
 
-    // Execute current step
-    if (_currentStep < _stepCount) {
-        JsonObject step = _sequence[_currentStep].as<JsonObject>();
-        executeStep(step);
+    if (_triggerUs != 0) {
+        _triggerLatencyUs = micros() - _triggerUs;
+        if (_triggerLatencyUs > _triggerLatencyMaxUs) _triggerLatencyMaxUs = _triggerLatencyUs;
+        _triggerUs = 0;
+    }
 
-        // Advance immediately only if not waiting
-        // (wait/blink steps set flags and will advance when complete)
-        if (_waitUntil == 0 && !_waitingForAnimation) {
-            advanceStep();
-        }
+    if (step.containsKey("parallel")) {
+        startParallel(track, step["parallel"].as<JsonArray>());
+    } else {
+        executeStep(step, track);
     }
 }
 
+void ImpulsePlayer::startParallel(SequenceTrack& main, JsonArray tracks) {
+    uint8_t index = 1;
+    for (JsonArray steps : tracks) {
+        if (index >= SEQUENCE_MAX_TRACKS) break;  // Rejected at compile time
+        startParallelTrack(_tracks[index++], main, steps, PRNG_STREAM_IMPULSE);
+    }
+    _joinMs = main.timelineMs;
+    main.wait = TrackWait::JOIN;
+}
+
 bool ImpulsePlayer::trigger() {
     // If already playing, ignore
     if (_playing || _pending) return false;
 
     // If preloaded, use it
     if (_preloaded) {
-        // Mark as consumed (sequence still valid until we preload next)
+        // Mark as consumed (entry stays pinned as the playing impulse)
         _preloaded = false;
-
-        // Copy preloaded name to current
-        strncpy(_currentImpulseName, _preloadedName, sizeof(_currentImpulseName) - 1);
-        _currentImpulseName[sizeof(_currentImpulseName) - 1] = '\0';
-
-        // Use preloaded sequence directly
-        _sequence = _preloadedSequence;
-        _stepCount = _preloadedStepCount;
-
-        // Check if we need to wait for blink to finish
-        if (eyeController.isAnimating()) {
-            _pending = true;
-            WEB_LOG("Impulse", "Impulse '%s' pending (waiting for animation)", _currentImpulseName);
-            return true;
-        }
-
-        // Start immediately (preload next after playback completes in stopPlayback)
-        return startPlayback();
+        return startFromCache(_preloadedName);
     }
 
     // No preloaded impulse - this shouldn't happen normally
@@ -105,21 +157,31 @@ bool ImpulsePlayer::triggerByName(const char* impulseName) {
         return trigger();  // Use the preloaded one
     }
 
-    // Load the requested impulse
-    if (!loadImpulse(impulseName, _playDoc, _sequence, _stepCount)) {
-        return false;
-    }
+    return startFromCache(impulseName);
+}
 
-    strncpy(_currentImpulseName, impulseName, sizeof(_currentImpulseName) - 1);
+bool ImpulsePlayer::startFromCache(const char* impulseName) {
+    uint32_t triggerUs = micros();
+
+    // Cache hit for the preloaded/recent impulses, file load otherwise
+    CacheEntry* entry = acquire(impulseName);
+    if (!entry) return false;
+
+    strncpy(_currentImpulseName, entry->name, sizeof(_currentImpulseName) - 1);
     _currentImpulseName[sizeof(_currentImpulseName) - 1] = '\0';
+    _sequence = entry->sequence;
+    _sequences = entry->sequences;
+    _stepCount = entry->stepCount;
+    _triggerUs = triggerUs ? triggerUs : 1;
 
-    // Check if we need to wait for blink to finish
-    if (eyeController.isAnimating()) {
+    // Check if we need to wait for blink or transition to finish
+    if (eyeController.isAnimating() || eyeController.isTransitioning()) {
         _pending = true;
         WEB_LOG("Impulse", "Impulse '%s' pending (waiting for animation)", _currentImpulseName);
         return true;
     }
 
+    // Start immediately (preload next after playback completes in stopPlayback)
     return startPlayback();
 }
 
@@ -129,10 +191,17 @@ bool ImpulsePlayer::startPlayback() {
     // Save current eye state
     saveState();
 
-    _currentStep = 0;
     _playing = true;
-    _waitingForAnimation = false;
-    _waitUntil = 0;
+    for (SequenceTrack& track : _tracks) {
+        track.active = false;
+        track.cursor.clear();
+    }
+    SequenceTrack& main = _tracks[0];
+    main.cursor.begin(_sequence);
+    main.rng.seed(_rng.next(), PRNG_STREAM_IMPULSE);  // Nth impulse since setSeed, same trace
+    main.active = true;
+    main.wait = TrackWait::NONE;
+    main.timelineMs = millis();
 
     WEB_LOG("Impulse", "Playing '%s' (%d steps)", _currentImpulseName, _stepCount);
     return true;
@@ -143,6 +212,13 @@ void ImpulsePlayer::stop() {
 }
 
 void ImpulsePlayer::stopPlayback() {
+    // Release the playing entry if it was invalidated while pinned
+    for (CacheEntry& entry : _cache) {
+        if (entry.stale && strcmp(entry.name, _currentImpulseName) == 0) {
+            clearEntry(entry);
+        }
+    }
+
     if (_playing) {
         // Restore saved state
         restoreState();
@@ -154,31 +230,135 @@ void ImpulsePlayer::stopPlayback() {
         autoImpulse.preloadFromSelection();
     }
 
+    if (isWaitingForClip()) clipPlayer.stop();
     _playing = false;
     _pending = false;
-    _waitingForAnimation = false;
-    _waitUntil = 0;
+    for (SequenceTrack& track : _tracks) {
+        track.active = false;
+        track.wait = TrackWait::NONE;
+    }
     _currentImpulseName[0] = '\0';
 }
 
 bool ImpulsePlayer::preloadByName(const char* impulseName) {
     _preloaded = false;
-    _preloadedDoc.clear();
 
-    if (!loadImpulse(impulseName, _preloadedDoc, _preloadedSequence, _preloadedStepCount)) {
+    CacheEntry* entry = acquire(impulseName);
+    if (!entry) {
         return false;
     }
 
-    strncpy(_preloadedName, impulseName, sizeof(_preloadedName) - 1);
+    strncpy(_preloadedName, entry->name, sizeof(_preloadedName) - 1);
     _preloadedName[sizeof(_preloadedName) - 1] = '\0';
 
     _preloaded = true;
     return true;
 }
 
-bool ImpulsePlayer::loadImpulse(const char* impulseName, JsonDocument& doc, JsonArray& sequence, int& stepCount) {
-    doc.clear();
-    stepCount = 0;
+bool ImpulsePlayer::warmCache(const char* impulseName) {
+    return acquire(impulseName) != nullptr;
+}
+
+void ImpulsePlayer::invalidateCache() {
+    // Deferred to loop() - may be called from async handlers while an impulse plays
+    _invalidateRequested = true;
+}
+
+size_t ImpulsePlayer::getCacheBytes() const {
+    size_t total = 0;
+    for (const CacheEntry& entry : _cache) {
+        if (entry.name[0] != '\0') total += entry.bytes;
+    }
+    return total;
+}
+
+ImpulsePlayer::CacheEntry* ImpulsePlayer::findCached(const char* impulseName) {
+    for (CacheEntry& entry : _cache) {
+        if (entry.name[0] != '\0' && !entry.stale && strcmp(entry.name, impulseName) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool ImpulsePlayer::isPinned(const CacheEntry& entry) const {
+    if (_preloaded && strcmp(entry.name, _preloadedName) == 0) return true;
+    if ((_playing || _pending) && strcmp(entry.name, _currentImpulseName) == 0) return true;
+    return false;
+}
+
+ImpulsePlayer::CacheEntry* ImpulsePlayer::findVictim(const CacheEntry* keep) {
+    // Free slot first, then least recently used unpinned entry
+    CacheEntry* victim = nullptr;
+    for (CacheEntry& entry : _cache) {
+        if (&entry == keep) continue;
+        if (entry.name[0] == '\0') return &entry;
+        if (isPinned(entry)) continue;
+        if (!victim || (int32_t)(entry.lastUsed - victim->lastUsed) < 0) {
+            victim = &entry;
+        }
+    }
+    return victim;
+}
+
+ImpulsePlayer::CacheEntry* ImpulsePlayer::acquire(const char* impulseName) {
+    CacheEntry* entry = findCached(impulseName);
+    if (entry) {
+        _cacheHits++;
+        entry->lastUsed = ++_useCounter;
+        return entry;
+    }
+
+    _cacheMisses++;
+    entry = findVictim(nullptr);
+    if (!entry) {
+        WEB_LOG("Impulse", "Cache full (all entries pinned), cannot load '%s'", impulseName);
+        return nullptr;
+    }
+    clearEntry(*entry);
+
+    if (!loadImpulse(impulseName, *entry)) {
+        clearEntry(*entry);
+        return nullptr;
+    }
+    entry->lastUsed = ++_useCounter;
+
+    // Enforce byte budget by evicting other unpinned entries (LRU first)
+    while (getCacheBytes() > IMPULSE_CACHE_BUDGET_BYTES) {
+        CacheEntry* victim = findVictim(entry);
+        if (!victim || victim->name[0] == '\0') break;  // Only pinned/free left
+        clearEntry(*victim);
+    }
+
+    return entry;
+}
+
+void ImpulsePlayer::clearEntry(CacheEntry& entry) {
+    entry.doc.clear();
+    entry.sequence = JsonArray();
+    entry.sequences = JsonObject();
+    entry.stepCount = 0;
+    entry.bytes = 0;
+    entry.stale = false;
+    entry.name[0] = '\0';
+}
+
+void ImpulsePlayer::dropCache() {
+    _preloaded = false;
+    for (CacheEntry& entry : _cache) {
+        if (entry.name[0] == '\0') continue;
+        if (isPinned(entry)) {
+            entry.stale = true;  // Playing right now - drop when playback ends
+        } else {
+            clearEntry(entry);
+        }
+    }
+    WEB_LOG("Impulse", "Impulse cache invalidated");
+}
+
+bool ImpulsePlayer::loadImpulse(const char* impulseName, CacheEntry& entry) {
+    entry.doc.clear();
+    entry.stepCount = 0;
 
     // Build path: /impulses/<impulseName>.json
     char path[64];
@@ -190,7 +370,12 @@ bool ImpulsePlayer::loadImpulse(const char* impulseName, JsonDocument& doc, Json
         return false;
     }
 
-    DeserializationError error = deserializeJson(doc, file);
+    // Charge the parsed + compiled document (called impulses are inlined), not the
+    // source file. ArduinoJson 7 has no memoryUsage(), so measure the heap delta;
+    // never below the file size in case another task freed memory meanwhile.
+    size_t fileBytes = file.size();
+    uint32_t heapBefore = ESP.getFreeHeap();
+    DeserializationError error = deserializeJson(entry.doc, file);
     file.close();
 
     if (error) {
@@ -199,193 +384,138 @@ bool ImpulsePlayer::loadImpulse(const char* impulseName, JsonDocument& doc, Json
     }
 
     // Extract sequence array
-    if (!doc.containsKey("sequence")) {
+    if (!entry.doc.containsKey("sequence")) {
         WEB_LOG("Impulse", "Impulse missing 'sequence' array");
         return false;
     }
 
-    sequence = doc["sequence"].as<JsonArray>();
-    stepCount = sequence.size();
+    entry.sequence = entry.doc["sequence"].as<JsonArray>();
+    entry.stepCount = entry.sequence.size();
 
-    if (stepCount == 0) {
+    if (entry.stepCount == 0) {
         WEB_LOG("Impulse", "Impulse has empty sequence");
         return false;
     }
 
-    return true;
-}
-
-int ImpulsePlayer::getAvailableImpulseCount() {
-    int count = 0;
-    File root = LittleFS.open("/impulses");
-    if (!root || !root.isDirectory()) {
-        return 0;
-    }
-
-    File file = root.openNextFile();
-    while (file) {
-        if (!file.isDirectory()) {
-            String name = file.name();
-            if (name.endsWith(".json")) {
-                count++;
-            }
-        }
-        file = root.openNextFile();
-    }
-    root.close();
-    return count;
-}
-
-bool ImpulsePlayer::getAvailableImpulseName(int index, char* buffer, size_t bufferSize) {
-    File root = LittleFS.open("/impulses");
-    if (!root || !root.isDirectory()) {
+    // Validate repeat/call/choose/parallel blocks, inline called impulse files
+    if (!compileSequence(entry.doc, path)) {
         return false;
     }
+    entry.sequences = entry.doc["sequences"].as<JsonObject>();
 
-    int count = 0;
-    File file = root.openNextFile();
-    while (file) {
-        if (!file.isDirectory()) {
-            String name = file.name();
-            if (name.endsWith(".json")) {
-                if (count == index) {
-                    // Remove .json extension
-                    name = name.substring(0, name.length() - 5);
-                    strncpy(buffer, name.c_str(), bufferSize - 1);
-                    buffer[bufferSize - 1] = '\0';
-                    root.close();
-                    return true;
-                }
-                count++;
-            }
-        }
-        file = root.openNextFile();
-    }
-    root.close();
-    return false;
+    uint32_t heapAfter = ESP.getFreeHeap();
+    size_t docBytes = heapBefore > heapAfter ? heapBefore - heapAfter : 0;
+    entry.bytes = max(docBytes, fileBytes);
+
+    strncpy(entry.name, impulseName, sizeof(entry.name) - 1);
+    entry.name[sizeof(entry.name) - 1] = '\0';
+    return true;
 }
 
 void ImpulsePlayer::saveState() {
-    _savedState.gazeX = eyeController.getGazeX();
-    _savedState.gazeY = eyeController.getGazeY();
-    _savedState.gazeZ = eyeController.getGazeZ();
-    _savedState.coupling = eyeController.getCoupling();
-    _savedState.lidLeft = eyeController.getLidLeft();
-    _savedState.lidRight = eyeController.getLidRight();
+    _savedState = eyeController.getPose();
 }
 
 void ImpulsePlayer::restoreState() {
-    eyeController.setGaze(_savedState.gazeX, _savedState.gazeY, _savedState.gazeZ);
-    eyeController.setCoupling(_savedState.coupling);
-    eyeController.setLids(_savedState.lidLeft, _savedState.lidRight);
+    eyeController.setPose(_savedState);
 }
 
-void ImpulsePlayer::executeStep(JsonObject step) {
+void ImpulsePlayer::executeStep(JsonObject step, SequenceTrack& track) {
     // Each step can have one primitive
     if (step.containsKey("gaze")) {
-        execGaze(step["gaze"].as<JsonObject>());
+        execGaze(step["gaze"].as<JsonObject>(), track.rng);
     }
     else if (step.containsKey("lids")) {
-        execLids(step["lids"].as<JsonObject>());
+        execLids(step["lids"].as<JsonObject>(), track.rng);
     }
     else if (step.containsKey("blink")) {
-        execBlink(step["blink"]);
+        execBlink(step["blink"], track);
     }
     else if (step.containsKey("wait")) {
-        execWait(step["wait"]);
+        execWait(step["wait"], track);
     }
-}
-
-void ImpulsePlayer::advanceStep() {
-    _currentStep++;
-
-    if (_currentStep >= _stepCount) {
-        // Sequence complete - restore state and stop
-        stopPlayback();
+    else if (step.containsKey("move")) {
+        execMove(step["move"].as<JsonObject>(), track);
+    }
+    else if (step.containsKey("clip")) {
+        execClip(step["clip"], track);
     }
 }
 
-void ImpulsePlayer::execGaze(JsonObject params) {
-    float x = resolveValue(params["x"], eyeController.getGazeX());
-    float y = resolveValue(params["y"], eyeController.getGazeY());
-    float z = resolveValue(params["z"], eyeController.getGazeZ());
+void ImpulsePlayer::execGaze(JsonObject params, Prng& rng) {
+    float x = resolveValue(rng, params["x"], eyeController.getGazeX());
+    float y = resolveValue(rng, params["y"], eyeController.getGazeY());
+    float z = resolveValue(rng, params["z"], eyeController.getGazeZ());
 
     eyeController.setGaze(x, y, z);
 }
 
-void ImpulsePlayer::execLids(JsonObject params) {
-    float left = resolveValue(params["left"], eyeController.getLidLeft());
-    float right = resolveValue(params["right"], eyeController.getLidRight());
+void ImpulsePlayer::execLids(JsonObject params, Prng& rng) {
+    float left = resolveValue(rng, params["left"], eyeController.getLidLeft());
+    float right = resolveValue(rng, params["right"], eyeController.getLidRight());
 
     eyeController.setLids(left, right);
 }
 
-void ImpulsePlayer::execBlink(JsonVariant params) {
-    int duration = resolveIntValue(params, 150);
+void ImpulsePlayer::execBlink(JsonVariant params, SequenceTrack& track) {
+    int duration = resolveIntValue(track.rng, params, 150);
 
     eyeController.startBlink(duration);
     autoBlink.resetTimer();  // Avoid double-blink from auto-blink
 
-    _waitingForAnimation = true;
+    track.wait = TrackWait::BLINK;
 }
 
-void ImpulsePlayer::execWait(JsonVariant params) {
-    int ms = resolveIntValue(params, 0);
+void ImpulsePlayer::execMove(JsonObject params, SequenceTrack& track) {
+    // Unspecified values keep their current position; only named channels move
+    EyePose target = eyeController.getPose();
+    uint8_t channels = 0;
 
-    if (ms > 0) {
-        _waitUntil = millis() + ms;
+    if (params.containsKey("x") || params.containsKey("y") || params.containsKey("z")) {
+        target.gazeX = resolveValue(track.rng, params["x"], target.gazeX);
+        target.gazeY = resolveValue(track.rng, params["y"], target.gazeY);
+        target.gazeZ = resolveValue(track.rng, params["z"], target.gazeZ);
+        channels |= EyeController::CHANNEL_GAZE;
     }
-}
-
-float ImpulsePlayer::resolveValue(JsonVariant val, float defaultVal) {
-    if (val.isNull()) {
-        return defaultVal;
+    if (params.containsKey("coupling")) {
+        target.coupling = resolveValue(track.rng, params["coupling"], target.coupling);
+        channels |= EyeController::CHANNEL_COUPLING;
     }
-
-    // Direct numeric value
-    if (val.is<float>() || val.is<int>()) {
-        return val.as<float>();
+    if (params.containsKey("left") || params.containsKey("right")) {
+        target.lidLeft = resolveValue(track.rng, params["left"], target.lidLeft);
+        target.lidRight = resolveValue(track.rng, params["right"], target.lidRight);
+        channels |= EyeController::CHANNEL_LIDS;
     }
 
-    // Random range: {"random": [min, max]}
-    if (val.is<JsonObject>()) {
-        JsonObject obj = val.as<JsonObject>();
-        if (obj.containsKey("random")) {
-            JsonArray range = obj["random"].as<JsonArray>();
-            if (range.size() >= 2) {
-                float minVal = range[0].as<float>();
-                float maxVal = range[1].as<float>();
-                // Generate random float in range
-                return minVal + (random(10001) / 10000.0f) * (maxVal - minVal);
-            }
-        }
-    }
+    int duration = resolveIntValue(track.rng, params["duration"], 300);
+    Easing easing = EyeController::parseEasing(params["easing"].as<const char*>());
 
-    return defaultVal;
+    eyeController.startTransition(target, max(duration, 0), easing, channels);
+    track.moveChannels = channels;
+
+    track.wait = TrackWait::TRANSITION;  // Advance when the move completes
 }
 
-int ImpulsePlayer::resolveIntValue(JsonVariant val, int defaultVal) {
-    if (val.isNull()) {
-        return defaultVal;
+void ImpulsePlayer::execClip(JsonVariant params, SequenceTrack& track) {
+    // Replaces a running clip; a missing clip is skipped
+    const char* name = params | "";
+    if (clipPlayer.play(name)) {
+        track.wait = TrackWait::CLIP;
     }
+}
 
-    // Direct numeric value
-    if (val.is<int>()) {
-        return val.as<int>();
+bool ImpulsePlayer::isWaitingForClip() const {
+    for (const SequenceTrack& track : _tracks) {
+        if (track.active && track.wait == TrackWait::CLIP) return true;
     }
+    return false;
+}
 
-    // Random range: {"random": [min, max]}
-    if (val.is<JsonObject>()) {
-        JsonObject obj = val.as<JsonObject>();
-        if (obj.containsKey("random")) {
-            JsonArray range = obj["random"].as<JsonArray>();
-            if (range.size() >= 2) {
-                int minVal = range[0].as<int>();
-                int maxVal = range[1].as<int>();
-                return random(minVal, maxVal + 1);
-            }
-        }
-    }
+void ImpulsePlayer::execWait(JsonVariant params, SequenceTrack& track) {
+    int ms = resolveIntValue(track.rng, params, 0);
 
-    return defaultVal;
+    if (ms > 0) {
+        track.timelineMs += ms;  // From the previous deadline, not from now
+        track.wait = TrackWait::TIME;
+    }
 }
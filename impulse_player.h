@@ -10,11 +10,19 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include "eye_controller.h"
+#include "config.h"
+#include "prng.h"
+#include "sequence.h"
 
 // Impulse Player - One-shot animation sequences with state restore
 // Loads impulse definitions from /impulses/*.json and executes them
 // Saves eye state before playing, restores after completion
-// Supports primitives: gaze, lids, blink, wait (same as modes)
+// Supports primitives: gaze, lids, blink, wait, move, clip (same as modes)
+//
+// Parsed impulses live in a small LRU cache (IMPULSE_CACHE_SLOTS entries, soft
+// budget of IMPULSE_CACHE_BUDGET_BYTES of parsed documents). The preloaded and the playing
+// impulse are pinned; everything else is evicted least-recently-used first.
 
 class ImpulsePlayer {
 public:
@@ -34,51 +42,73 @@ public:
     bool isPreloaded() const { return _preloaded; }
     const char* getPreloadedName() const { return _preloadedName; }
 
+    // Cache
+    bool warmCache(const char* impulseName);  // Load into cache without preloading
+    void invalidateCache();                   // Files changed (safe from async context)
+    uint32_t getCacheHits() const { return _cacheHits; }
+    uint32_t getCacheMisses() const { return _cacheMisses; }
+    size_t getCacheBytes() const;
+
+    // Trigger-to-first-step latency (includes waiting for a running blink/transition)
+    uint32_t getTriggerLatencyUs() const { return _triggerLatencyUs; }
+    uint32_t getTriggerLatencyMaxUs() const { return _triggerLatencyMaxUs; }
+
+    // Random values of impulse steps (0 = fresh hardware entropy)
+    void setSeed(uint32_t seed);
+
     // State queries
     bool isPlaying() const { return _playing; }
     bool isPending() const { return _pending; }
+    uint32_t msUntilNextStep() const;  // 0 = needs loop now, UINT32_MAX = idle
     const char* getCurrentImpulseName() const { return _currentImpulseName; }
 
     // Stop current impulse (restores state, preloads next)
     void stop();
 
-    // Available impulses (from /impulses/ directory)
-    int getAvailableImpulseCount();
-    bool getAvailableImpulseName(int index, char* buffer, size_t bufferSize);
-
 private:
-    // Preloaded impulse (ready for instant trigger)
+    // Compiled impulse cache
+    struct CacheEntry {
+        char name[32] = "";          // "" = free slot
+        JsonDocument doc;
+        JsonArray sequence;
+        JsonObject sequences;        // Named sub-sequences and inlined impulse calls
+        int stepCount = 0;
+        size_t bytes = 0;            // Parsed + compiled heap use (budget accounting)
+        uint32_t lastUsed = 0;       // LRU stamp
+        bool stale = false;          // Invalidated while pinned - drop when released
+    };
+    CacheEntry _cache[IMPULSE_CACHE_SLOTS];
+    uint32_t _useCounter = 0;
+    uint32_t _cacheHits = 0;
+    uint32_t _cacheMisses = 0;
+    volatile bool _invalidateRequested = false;
+
+    // Preloaded impulse (ready for instant trigger, pinned in cache)
     bool _preloaded = false;
     char _preloadedName[32] = "";
-    JsonDocument _preloadedDoc;
-    JsonArray _preloadedSequence;
-    int _preloadedStepCount = 0;
 
     // Current playback state
     bool _playing = false;
     bool _pending = false;  // Waiting for blink to finish
     char _currentImpulseName[32] = "";
 
-    // Playback from preloaded or freshly loaded
-    JsonDocument _playDoc;  // Only used when not playing from preloaded
+    // Playback - sequence points into a pinned cache entry
     JsonArray _sequence;
+    JsonObject _sequences;
     int _stepCount = 0;
-    int _currentStep = 0;
 
-    // Execution state
-    bool _waitingForAnimation = false;
-    unsigned long _waitUntil = 0;
+    // Trigger latency measurement
+    uint32_t _triggerUs = 0;          // micros() at trigger (0 = measured)
+    uint32_t _triggerLatencyUs = 0;
+    uint32_t _triggerLatencyMaxUs = 0;
+
+    // Execution state: [0] = main track, others run a "parallel" step (same as ModePlayer)
+    SequenceTrack _tracks[SEQUENCE_MAX_TRACKS];
+    unsigned long _joinMs = 0;
+    Prng _rng;                        // Seeds each run's main track
 
     // Saved state for restore (static allocation, ~28 bytes)
-    struct SavedState {
-        float gazeX;
-        float gazeY;
-        float gazeZ;
-        float coupling;
-        float lidLeft;
-        float lidRight;
-    };
-    SavedState _savedState;
+    EyePose _savedState;
 
     // State management
     void saveState();
@@ -88,22 +118,31 @@ private:
     bool startPlayback();
     void stopPlayback();
 
-    // Load impulse from file into specified document
-    bool loadImpulse(const char* impulseName, JsonDocument& doc, JsonArray& sequence, int& stepCount);
+    // Cache management
+    CacheEntry* acquire(const char* impulseName);  // Lookup or load (LRU touch)
+    CacheEntry* findCached(const char* impulseName);
+    CacheEntry* findVictim(const CacheEntry* keep);
+    bool isPinned(const CacheEntry& entry) const;
+    void clearEntry(CacheEntry& entry);
+    void dropCache();
+    bool startFromCache(const char* impulseName);
+
+    // Load impulse from file into a cache entry
+    bool loadImpulse(const char* impulseName, CacheEntry& entry);
 
     // Step execution (reuses same logic as mode_player)
-    void executeStep(JsonObject step);
-    void advanceStep();
+    void runTrack(SequenceTrack& track);
+    void startParallel(SequenceTrack& main, JsonArray tracks);
+    void executeStep(JsonObject step, SequenceTrack& track);
 
     // Primitive executors
-    void execGaze(JsonObject params);
-    void execLids(JsonObject params);
-    void execBlink(JsonVariant params);
-    void execWait(JsonVariant params);
-
-    // Value resolution (handles random ranges)
-    float resolveValue(JsonVariant val, float defaultVal = 0);
-    int resolveIntValue(JsonVariant val, int defaultVal = 0);
+    void execGaze(JsonObject params, Prng& rng);
+    void execLids(JsonObject params, Prng& rng);
+    void execBlink(JsonVariant params, SequenceTrack& track);
+    void execWait(JsonVariant params, SequenceTrack& track);
+    void execMove(JsonObject params, SequenceTrack& track);
+    void execClip(JsonVariant params, SequenceTrack& track);
+    bool isWaitingForClip() const;  // A track is playing a baked clip
 };
 
 extern ImpulsePlayer impulsePlayer;
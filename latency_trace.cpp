@@ -0,0 +1,302 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "latency_trace.h"
+
+LatencyTrace latencyTrace;
+
+static const char* TRACE_CHANNEL_NAMES[NUM_SERVOS] = {
+    "Left Eye X",
+    "Left Eye Y",
+    "Left Eyelid",
+    "Right Eye X",
+    "Right Eye Y",
+    "Right Eyelid"
+};
+
+// Chrome trace thread IDs: 0 = main loop, 1-6 = servo channels, 7 = WebSocket
+#define TRACE_TID_LOOP 0
+#define TRACE_TID_SERVO_BASE 1
+#define TRACE_TID_WEBSOCKET (TRACE_TID_SERVO_BASE + NUM_SERVOS)
+
+void LatencyTrace::recordCommand(const char* type, uint32_t startUs, uint32_t durationUs) {
+    Event event = {};
+    event.kind = EventKind::COMMAND;
+    event.startUs = startUs;
+    event.durationUs = durationUs;
+    // Client-supplied string: keep only identifier characters so the JSON export stays valid
+    size_t n = 0;
+    for (const char* c = type; c && *c && n < sizeof(event.name) - 1; c++) {
+        if (isalnum((unsigned char)*c) || *c == '_') event.name[n++] = *c;
+    }
+    push(event);
+}
+
+void LatencyTrace::recordServoWrite(uint8_t channel, uint8_t position, uint32_t originUs, uint32_t writeUs) {
+    if (channel >= NUM_SERVOS) return;
+
+    uint32_t latencyUs = writeUs - originUs;  // Wrap-safe
+
+    Event event = {};
+    event.kind = EventKind::SERVO_WRITE;
+    event.startUs = originUs;
+    event.durationUs = latencyUs;
+    event.channel = channel;
+    event.position = position;
+
+    portENTER_CRITICAL(&_mux);
+    Histogram& h = _histograms[channel];
+    h.buckets[bucketFor(latencyUs)]++;
+    h.count++;
+    h.totalUs += latencyUs;
+    if (latencyUs > h.maxUs) h.maxUs = latencyUs;
+    portEXIT_CRITICAL(&_mux);
+
+    push(event);
+}
+
+void LatencyTrace::recordLoop(uint32_t startUs, uint32_t durationUs) {
+    if (durationUs > _loopMaxUs) _loopMaxUs = durationUs;
+
+    // Only stalls go into the ring - normal iterations would flush it in milliseconds
+    if (durationUs < TRACE_LOOP_STALL_US) return;
+
+    Event event = {};
+    event.kind = EventKind::LOOP_STALL;
+    event.startUs = startUs;
+    event.durationUs = durationUs;
+    push(event);
+}
+
+void LatencyTrace::recordParse(ParsePath path, uint32_t durationUs) {
+    portENTER_CRITICAL(&_mux);
+    Histogram& h = _parseHistograms[(uint8_t)path];
+    h.buckets[parseBucketFor(durationUs)]++;
+    h.count++;
+    h.totalUs += durationUs;
+    if (durationUs > h.maxUs) h.maxUs = durationUs;
+    portEXIT_CRITICAL(&_mux);
+}
+
+void LatencyTrace::clear() {
+    portENTER_CRITICAL(&_mux);
+    _head = 0;
+    _count = 0;  // _pushed keeps counting: a running export sees the events as gone
+    memset(_histograms, 0, sizeof(_histograms));
+    memset(_parseHistograms, 0, sizeof(_parseHistograms));
+    _loopMaxUs = 0;
+    portEXIT_CRITICAL(&_mux);
+}
+
+uint32_t LatencyTrace::getCount(uint8_t channel) const {
+    if (channel >= NUM_SERVOS) return 0;
+    return _histograms[channel].count;
+}
+
+uint32_t LatencyTrace::getMaxUs(uint8_t channel) const {
+    if (channel >= NUM_SERVOS) return 0;
+    return _histograms[channel].maxUs;
+}
+
+uint32_t LatencyTrace::getParseCount(ParsePath path) const {
+    return _parseHistograms[(uint8_t)path].count;
+}
+
+float LatencyTrace::getParseAvgUs(ParsePath path) const {
+    const Histogram& h = _parseHistograms[(uint8_t)path];
+    return h.count ? (float)h.totalUs / h.count : 0;
+}
+
+void LatencyTrace::push(const Event& event) {
+    portENTER_CRITICAL(&_mux);
+    _events[_head] = event;
+    _head = (_head + 1) % TRACE_RING_SIZE;
+    if (_count < TRACE_RING_SIZE) _count++;
+    _pushed++;
+    portEXIT_CRITICAL(&_mux);
+}
+
+bool LatencyTrace::readEvent(uint32_t sequence, Event& event) {
+    portENTER_CRITICAL(&_mux);
+    uint32_t age = _pushed - sequence;  // 1 = newest
+    bool available = age >= 1 && age <= _count;
+    if (available) event = _events[(_head + TRACE_RING_SIZE - age) % TRACE_RING_SIZE];
+    portEXIT_CRITICAL(&_mux);
+    return available;
+}
+
+uint8_t LatencyTrace::bucketFor(uint32_t us) {
+    if (us < 256) return 0;
+    uint8_t bucket = 32 - __builtin_clz(us) - 8;  // 256-511us -> 1, 512-1023us -> 2, ...
+    return (bucket < TRACE_HISTOGRAM_BUCKETS) ? bucket : TRACE_HISTOGRAM_BUCKETS - 1;
+}
+
+uint8_t LatencyTrace::parseBucketFor(uint32_t us) {
+    if (us < 2) return 0;
+    uint8_t bucket = 32 - __builtin_clz(us) - 1;  // 2-3us -> 1, 4-7us -> 2, ...
+    return (bucket < TRACE_HISTOGRAM_BUCKETS) ? bucket : TRACE_HISTOGRAM_BUCKETS - 1;
+}
+
+// === Chrome trace export ===
+
+TraceExport::TraceExport(LatencyTrace& trace, bool clearAfter)
+    : _trace(trace), _clearAfter(clearAfter) {}
+
+size_t TraceExport::fill(uint8_t* buffer, size_t maxLen) {
+    size_t written = 0;
+    while (written < maxLen) {
+        if (_piecePos == _pieceLen) {
+            _pieceLen = 0;
+            _piecePos = 0;
+            if (!render()) break;
+            continue;
+        }
+        size_t n = min(maxLen - written, _pieceLen - _piecePos);
+        memcpy(buffer + written, _piece + _piecePos, n);
+        _piecePos += n;
+        written += n;
+    }
+    return written;
+}
+
+int TraceExport::renderHistogram(const char* name, const LatencyTrace::Histogram& h, bool first) {
+    int len = snprintf(_piece, sizeof(_piece), "%s{\"name\":\"%s\",\"count\":%lu,\"avgUs\":%lu,\"maxUs\":%lu,\"histogram\":[",
+                       first ? "" : ",", name, (unsigned long)h.count,
+                       (unsigned long)(h.count ? h.totalUs / h.count : 0), (unsigned long)h.maxUs);
+    for (uint8_t b = 0; b < TRACE_HISTOGRAM_BUCKETS; b++) {
+        len += snprintf(_piece + len, sizeof(_piece) - len, "%s%lu", b ? "," : "", (unsigned long)h.buckets[b]);
+    }
+    len += snprintf(_piece + len, sizeof(_piece) - len, "]}");
+    return len;
+}
+
+bool TraceExport::render() {
+    int len = 0;
+    while (len == 0) {
+        switch (_stage) {
+            case Stage::HEADER:
+                // Metadata: name the process and one "thread" per event source
+                len = snprintf(_piece, sizeof(_piece),
+                               "{\"traceEvents\":[{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"animatronic-eyes\"}}");
+                _stage = Stage::THREADS;
+                _index = 0;
+                break;
+
+            case Stage::THREADS: {
+                const char* name;
+                int tid;
+                if (_index == 0) {
+                    name = "loop";
+                    tid = TRACE_TID_LOOP;
+                } else if (_index <= NUM_SERVOS) {
+                    name = TRACE_CHANNEL_NAMES[_index - 1];
+                    tid = TRACE_TID_SERVO_BASE + _index - 1;
+                } else {
+                    name = "websocket";
+                    tid = TRACE_TID_WEBSOCKET;
+                    // Events, oldest first: the ring as it is now
+                    portENTER_CRITICAL(&_trace._mux);
+                    _end = _trace._pushed;
+                    _next = _trace._pushed - _trace._count;
+                    portEXIT_CRITICAL(&_trace._mux);
+                    _stage = Stage::EVENTS;
+                }
+                len = snprintf(_piece, sizeof(_piece),
+                               ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                               tid, name);
+                _index++;
+                break;
+            }
+
+            case Stage::EVENTS: {
+                LatencyTrace::Event e;
+                if (_next == _end) {
+                    _stage = Stage::SUMMARY;
+                    break;
+                }
+                if (!_trace.readEvent(_next++, e)) break;  // Overwritten meanwhile
+
+                switch (e.kind) {
+                    case LatencyTrace::EventKind::COMMAND:
+                        len = snprintf(_piece, sizeof(_piece),
+                                       ",{\"name\":\"%s\",\"cat\":\"ws\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":1,\"tid\":%d}",
+                                       e.name, (unsigned long)e.startUs, (unsigned long)e.durationUs, TRACE_TID_WEBSOCKET);
+                        break;
+                    case LatencyTrace::EventKind::SERVO_WRITE:
+                        // Span from origin (command/motion tick) to the actual servo write
+                        len = snprintf(_piece, sizeof(_piece),
+                                       ",{\"name\":\"write %u\",\"cat\":\"servo\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":1,\"tid\":%d}",
+                                       e.position, (unsigned long)e.startUs, (unsigned long)e.durationUs,
+                                       TRACE_TID_SERVO_BASE + e.channel);
+                        break;
+                    case LatencyTrace::EventKind::LOOP_STALL:
+                        len = snprintf(_piece, sizeof(_piece),
+                                       ",{\"name\":\"stall\",\"cat\":\"loop\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":1,\"tid\":%d}",
+                                       (unsigned long)e.startUs, (unsigned long)e.durationUs, TRACE_TID_LOOP);
+                        break;
+                }
+                break;
+            }
+
+            case Stage::SUMMARY:
+                // Histograms and summary (ignored by trace viewers, useful for scripts)
+                len = snprintf(_piece, sizeof(_piece),
+                               "],\"displayTimeUnit\":\"ms\",\"otherData\":{\"nowUs\":%lu,\"loopMaxUs\":%lu,\"bucketUpperUs\":[",
+                               (unsigned long)micros(), (unsigned long)_trace._loopMaxUs);
+                for (uint8_t b = 0; b < TRACE_HISTOGRAM_BUCKETS - 1; b++) {
+                    len += snprintf(_piece + len, sizeof(_piece) - len, "%lu,", (unsigned long)(256UL << b));
+                }
+                len += snprintf(_piece + len, sizeof(_piece) - len, "null],\"channels\":[");  // Last bucket is open-ended
+                _stage = Stage::CHANNELS;
+                _index = 0;
+                break;
+
+            case Stage::CHANNELS: {
+                LatencyTrace::Histogram h;
+                portENTER_CRITICAL(&_trace._mux);
+                h = _trace._histograms[_index];
+                portEXIT_CRITICAL(&_trace._mux);
+                len = renderHistogram(TRACE_CHANNEL_NAMES[_index], h, _index == 0);
+                if (++_index == NUM_SERVOS) _stage = Stage::PARSE_SUMMARY;
+                break;
+            }
+
+            case Stage::PARSE_SUMMARY:
+                // WebSocket parse time, in-place vs. ArduinoJson
+                len = snprintf(_piece, sizeof(_piece), "],\"parseBucketUpperUs\":[");
+                for (uint8_t b = 0; b < TRACE_HISTOGRAM_BUCKETS - 1; b++) {
+                    len += snprintf(_piece + len, sizeof(_piece) - len, "%lu,", (unsigned long)(2UL << b));
+                }
+                len += snprintf(_piece + len, sizeof(_piece) - len, "null],\"parse\":[");
+                _stage = Stage::PARSE;
+                _index = 0;
+                break;
+
+            case Stage::PARSE: {
+                static const char* PARSE_NAMES[] = {"fast", "full"};
+                LatencyTrace::Histogram h;
+                portENTER_CRITICAL(&_trace._mux);
+                h = _trace._parseHistograms[_index];
+                portEXIT_CRITICAL(&_trace._mux);
+                len = renderHistogram(PARSE_NAMES[_index], h, _index == 0);
+                if (++_index == 2) _stage = Stage::END;
+                break;
+            }
+
+            case Stage::END:
+                len = snprintf(_piece, sizeof(_piece), "]}}");
+                _stage = Stage::DONE;
+                if (_clearAfter) _trace.clear();
+                break;
+
+            case Stage::DONE:
+                return false;
+        }
+    }
+    _pieceLen = min((size_t)len, sizeof(_piece) - 1);  // snprintf result may exceed a truncated piece
+    return true;
+}
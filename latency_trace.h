@@ -0,0 +1,114 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Latency Trace - Command-to-servo latency measurement
+// Every servo target change carries an origin timestamp (micros) from where it was
+// produced: WebSocket message arrival, or the EyeController motion tick for
+// autonomous movement. ServoController reports the actual write, which records the
+// end-to-end latency in a per-channel histogram and a ring of recent events.
+// /api/trace exports the ring as Chrome trace-event JSON (chrome://tracing, Perfetto),
+// produced piece by piece by a TraceExport cursor for a chunked response.
+// WebSocket message parse time is kept in two more histograms: the in-place path
+// for hot motion commands (ws_flat_message.h) and the ArduinoJson path.
+
+#define TRACE_HISTOGRAM_BUCKETS 12  // log2 buckets: <256us, <512us, ... <262ms, >=262ms
+                                    // Parse histograms: <2us, <4us, ... <2048us, >=2048us
+
+enum class ParsePath : uint8_t { FAST, FULL };  // In-place tokenizer / ArduinoJson
+
+class LatencyTrace {
+public:
+    // Event sources (safe from loop and async WebSocket context)
+    void recordCommand(const char* type, uint32_t startUs, uint32_t durationUs);
+    void recordServoWrite(uint8_t channel, uint8_t position, uint32_t originUs, uint32_t writeUs);
+    void recordLoop(uint32_t startUs, uint32_t durationUs);
+    void recordParse(ParsePath path, uint32_t durationUs);
+
+    void clear();
+
+    // Per-channel stats
+    uint32_t getCount(uint8_t channel) const;
+    uint32_t getMaxUs(uint8_t channel) const;
+
+    // Parse stats
+    uint32_t getParseCount(ParsePath path) const;
+    float getParseAvgUs(ParsePath path) const;
+
+private:
+    friend class TraceExport;
+
+    enum class EventKind : uint8_t { COMMAND, SERVO_WRITE, LOOP_STALL };
+
+    struct Event {
+        uint32_t startUs;
+        uint32_t durationUs;
+        EventKind kind;
+        uint8_t channel;    // Servo index (SERVO_WRITE)
+        uint8_t position;   // Position written (SERVO_WRITE)
+        char name[13];      // WebSocket command type (truncated)
+    };
+
+    struct Histogram {
+        uint32_t buckets[TRACE_HISTOGRAM_BUCKETS];
+        uint32_t count;
+        uint64_t totalUs;
+        uint32_t maxUs;
+    };
+
+    Event _events[TRACE_RING_SIZE];
+    uint16_t _head = 0;     // Next write slot
+    uint16_t _count = 0;
+    uint32_t _pushed = 0;   // Events ever pushed (sequence number of the next one)
+    Histogram _histograms[NUM_SERVOS] = {};
+    Histogram _parseHistograms[2] = {};  // Indexed by ParsePath
+    uint32_t _loopMaxUs = 0;
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+    void push(const Event& event);
+    bool readEvent(uint32_t sequence, Event& event);  // false once overwritten
+    static uint8_t bucketFor(uint32_t us);
+    static uint8_t parseBucketFor(uint32_t us);
+};
+
+// Chrome trace-event JSON export (events + histograms in "otherData"), one cursor
+// per /api/trace request. Each fill() renders pieces (a metadata record, one
+// event, one histogram) into a TRACE_EXPORT_PIECE_BYTES buffer, so heap use does
+// not grow with the ring. Events pushed after the export started are left out;
+// events overwritten before the cursor reaches them are skipped.
+class TraceExport {
+public:
+    TraceExport(LatencyTrace& trace, bool clearAfter);
+
+    // AwsResponseFiller body: next bytes of the document, 0 when done
+    size_t fill(uint8_t* buffer, size_t maxLen);
+
+private:
+    enum class Stage : uint8_t { HEADER, THREADS, EVENTS, SUMMARY, CHANNELS, PARSE_SUMMARY, PARSE, END, DONE };
+
+    LatencyTrace& _trace;
+    bool _clearAfter;
+    Stage _stage = Stage::HEADER;
+    uint8_t _index = 0;          // Thread / histogram within the stage
+    uint32_t _next = 0;          // Sequence number of the next event
+    uint32_t _end = 0;           // Events pushed when the export reached them
+    char _piece[TRACE_EXPORT_PIECE_BYTES];
+    size_t _pieceLen = 0;
+    size_t _piecePos = 0;
+
+    bool render();               // Next piece into _piece; false at the end
+    int renderHistogram(const char* name, const LatencyTrace::Histogram& h, bool first);
+};
+
+extern LatencyTrace latencyTrace;
+
+#endif // LATENCY_TRACE_H
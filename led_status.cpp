@@ -9,6 +9,7 @@
 #include "storage.h"
 #include "config.h"
 #include "web_server.h"
+#include "power_manager.h"
 
 // LEDC PWM configuration
 #define LED_PWM_FREQ 5000    // 5 kHz PWM frequency
@@ -144,9 +145,31 @@ void LedStatus::setPattern(LedPattern pattern) {
         _pattern = pattern;
         _blinkPhase = 0;
         _lastToggle = millis();
+        powerManager.wake();  // May be called from async context (OTA)
     }
 }
 
+uint32_t LedStatus::msUntilNextChange() const {
+    if (!_enabled || _pattern == LED_PATTERN_OFF) return _ledState ? 0 : UINT32_MAX;
+    if (_pattern == LED_PATTERN_SOLID) return _ledState ? UINT32_MAX : 0;
+
+    // Same periods as handlePattern()
+    unsigned long period;
+    switch (_pattern) {
+        case LED_PATTERN_SLOW_BLINK:      period = 1000; break;
+        case LED_PATTERN_DOUBLE_BLINK:
+            if (_ledState != (_blinkPhase % 2 == 0)) return 0;  // Phase output not applied yet
+            period = (_blinkPhase == 3) ? 1000 : 200;
+            break;
+        case LED_PATTERN_FAST_BLINK:      period = 200; break;
+        case LED_PATTERN_VERY_FAST_BLINK: period = 100; break;
+        default:                          period = 50; break;  // Strobe
+    }
+
+    unsigned long elapsed = millis() - _lastToggle;
+    return elapsed >= period ? 0 : period - elapsed;
+}
+
 LedPattern LedStatus::getPattern() {
     return _pattern;
 }
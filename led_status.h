@@ -27,6 +27,7 @@ public:
 
     void setPattern(LedPattern pattern);
     LedPattern getPattern();
+    uint32_t msUntilNextChange() const;  // For idle sleep (UINT32_MAX = steady)
 
     void setEnabled(bool enabled);
     bool isEnabled();
@@ -12,7 +12,7 @@
 #include "auto_impulse.h"
 #include "storage.h"
 #include "web_server.h"
-#include <LittleFS.h>
+#include "power_manager.h"
 
 extern AutoImpulse autoImpulse;
 
@@ -63,6 +63,8 @@ const char* ModeManager::getCurrentModeName() const {
 }
 
 bool ModeManager::setMode(Mode mode) {
+    _pendingAutoModeName[0] = '\0';  // Explicit switch cancels a loading auto mode
+
     if (mode == _currentMode && mode != Mode::AUTO) return true;
 
     // AUTO mode must use setAutoMode() to specify which mode
@@ -70,7 +72,7 @@ bool ModeManager::setMode(Mode mode) {
         return false;
     }
 
-    exitCurrentMode();
+    exitCurrentMode(EyeController::neutralPose());
 
     switch (mode) {
         case Mode::NONE:
@@ -97,12 +99,109 @@ bool ModeManager::setMode(Mode mode) {
 }
 
 bool ModeManager::setAutoMode(const char* modeName) {
+    _pendingAutoModeName[0] = '\0';
+
     if (!modePlayer.loadMode(modeName)) {
         setError("Failed to load mode");
         return false;
     }
 
-    exitCurrentMode();
+    enterAutoMode(modeName);
+    return true;
+}
+
+void ModeManager::requestMode(Mode mode) {
+    // AUTO needs a mode name - requestAutoMode()
+    if (mode == Mode::AUTO) return;
+
+    // Deferred to the main loop (may be called from the AsyncTCP task)
+    portENTER_CRITICAL(&_requestMux);
+    _requestedMode = mode;
+    _requestedAutoModeName[0] = '\0';
+    _modeRequested = true;
+    portEXIT_CRITICAL(&_requestMux);
+    powerManager.wake();
+}
+
+void ModeManager::requestAutoMode(const char* modeName) {
+    // Deferred to the main loop (may be called from the AsyncTCP task)
+    portENTER_CRITICAL(&_requestMux);
+    _requestedMode = Mode::AUTO;
+    strncpy(_requestedAutoModeName, modeName, sizeof(_requestedAutoModeName) - 1);
+    _requestedAutoModeName[sizeof(_requestedAutoModeName) - 1] = '\0';
+    _modeRequested = true;
+    portEXIT_CRITICAL(&_requestMux);
+    powerManager.wake();
+}
+
+void ModeManager::getPendingAutoModeName(char* name, size_t size) const {
+    portENTER_CRITICAL(&_requestMux);
+    const char* pending = _modeRequested ? _requestedAutoModeName : _pendingAutoModeName;
+    strncpy(name, pending, size - 1);
+    name[size - 1] = '\0';
+    portEXIT_CRITICAL(&_requestMux);
+}
+
+void ModeManager::serviceModeRequest() {
+    if (!_modeRequested) return;
+
+    portENTER_CRITICAL(&_requestMux);
+    Mode mode = _requestedMode;
+    strncpy(_pendingAutoModeName, _requestedAutoModeName, sizeof(_pendingAutoModeName));
+    _modeRequested = false;
+    portEXIT_CRITICAL(&_requestMux);
+
+    if (mode != Mode::AUTO) {
+        setMode(mode);  // Also cancels a loading auto mode
+        webServer.requestBroadcast();
+        return;
+    }
+
+    // A load already running is superseded when it completes (latest request wins)
+    if (modePlayer.isLoadPending()) return;
+
+    if (!modePlayer.requestLoad(_pendingAutoModeName)) {
+        WEB_LOG("Mode", "Failed to load mode '%s'", _pendingAutoModeName);
+        _pendingAutoModeName[0] = '\0';
+        setError("Failed to load mode");
+        webServer.requestBroadcast();
+    }
+}
+
+void ModeManager::onLoadComplete() {
+    // Cancelled by an explicit mode switch, or superseded by a newer request
+    if (_pendingAutoModeName[0] == '\0') {
+        modePlayer.discardLoad();
+        return;
+    }
+    if (strcmp(modePlayer.getPendingModeName(), _pendingAutoModeName) != 0) {
+        modePlayer.discardLoad();
+        if (!modePlayer.requestLoad(_pendingAutoModeName)) {
+            _pendingAutoModeName[0] = '\0';
+            setError("Failed to load mode");
+            webServer.requestBroadcast();
+        }
+        return;
+    }
+
+    char modeName[sizeof(_pendingAutoModeName)];
+    strncpy(modeName, _pendingAutoModeName, sizeof(modeName));
+    _pendingAutoModeName[0] = '\0';
+
+    if (modePlayer.isLoadFailed()) {
+        modePlayer.discardLoad();
+        WEB_LOG("Mode", "Failed to load mode '%s', keeping current mode", modeName);
+        setError("Failed to load mode");
+    } else {
+        modePlayer.commitLoad();  // Stops the old sequence and swaps buffers
+        enterAutoMode(modeName);
+    }
+    webServer.requestBroadcast();
+}
+
+void ModeManager::enterAutoMode(const char* modeName) {
+    // Blend straight into the new mode's prefetched first pose
+    exitCurrentMode(modePlayer.getEntryPose());
 
     _currentMode = Mode::AUTO;
     strncpy(_currentAutoModeName, modeName, sizeof(_currentAutoModeName) - 1);
@@ -121,7 +220,6 @@ bool ModeManager::setAutoMode(const char* modeName) {
     clearError();
 
     WEB_LOG("Mode", "Entered AUTO mode: %s", modeName);
-    return true;
 }
 
 void ModeManager::enterNoneMode() {
@@ -136,71 +234,22 @@ void ModeManager::enterFollowMode() {
     WEB_LOG("Mode", "Entered FOLLOW mode");
 }
 
-void ModeManager::exitCurrentMode() {
+void ModeManager::exitCurrentMode(const EyePose& nextPose) {
     if (_currentMode == Mode::AUTO) {
         modePlayer.stop();
     }
     _currentAutoModeName[0] = '\0';
 
-    // Full reset including Z and coupling when switching modes
-    eyeController.resetAll();
+    // Crossfade gaze, Z (vergence), coupling and lids into the next mode's pose
+    // (transitionMs = 0 snaps like a full reset)
+    ModeConfig config = storage.getModeConfig();
+    eyeController.startTransition(nextPose, config.transitionMs);
 
     // Clear any runtime overrides when changing modes
     autoBlink.clearRuntimeOverride();
     autoImpulse.clearRuntimeOverride();
 }
 
-int ModeManager::getAvailableModeCount() {
-    int count = 0;
-    File root = LittleFS.open("/modes");
-    if (!root || !root.isDirectory()) {
-        return 0;
-    }
-
-    File file = root.openNextFile();
-    while (file) {
-        if (!file.isDirectory()) {
-            String name = file.name();
-            if (name.endsWith(".json")) {
-                count++;
-            }
-        }
-        file = root.openNextFile();
-    }
-    root.close();
-
-    return count;
-}
-
-bool ModeManager::getAvailableModeName(int index, char* buffer, size_t bufferSize) {
-    int count = 0;
-    File root = LittleFS.open("/modes");
-    if (!root || !root.isDirectory()) {
-        return false;
-    }
-
-    File file = root.openNextFile();
-    while (file) {
-        if (!file.isDirectory()) {
-            String name = file.name();
-            if (name.endsWith(".json")) {
-                if (count == index) {
-                    // Remove .json extension
-                    name = name.substring(0, name.length() - 5);
-                    strncpy(buffer, name.c_str(), bufferSize - 1);
-                    buffer[bufferSize - 1] = '\0';
-                    root.close();
-                    return true;
-                }
-                count++;
-            }
-        }
-        file = root.openNextFile();
-    }
-    root.close();
-
-    return false;
-}
 
 void ModeManager::setError(const char* message) {
     _hasError = true;
@@ -9,6 +9,7 @@
 #define MODE_MANAGER_H
 
 #include <Arduino.h>
+#include "eye_controller.h"
 
 // Mode System States
 // NONE: Safe/error state - eyes centered, no movement
@@ -27,13 +28,18 @@ public:
     const char* getCurrentModeName() const;
     const char* getCurrentAutoModeName() const { return _currentAutoModeName; }
 
-    // Mode switching
+    // Mode switching (main loop)
     bool setMode(Mode mode);
-    bool setAutoMode(const char* modeName);
+    bool setAutoMode(const char* modeName);      // Blocking load (boot, fallback)
 
-    // Available auto modes (from /modes/ directory)
-    int getAvailableModeCount();
-    bool getAvailableModeName(int index, char* buffer, size_t bufferSize);
+    // Mode switch requests from any task (web handlers) - applied by the main
+    // loop between steps, latest request wins
+    void requestMode(Mode mode);                 // FOLLOW / NONE
+    void requestAutoMode(const char* modeName);  // Background load, current mode keeps running
+    void getPendingAutoModeName(char* name, size_t size) const;  // "" = no switch pending
+    bool hasModeRequest() const { return _modeRequested; }
+    void serviceModeRequest();                   // Called by ModePlayer (main loop): applies the request
+    void onLoadComplete();                       // Called by ModePlayer (main loop) when a load finishes
 
     // Error handling
     bool hasError() const { return _hasError; }
@@ -43,12 +49,19 @@ public:
 private:
     Mode _currentMode = Mode::NONE;
     char _currentAutoModeName[32] = "";
+    char _pendingAutoModeName[32] = "";  // Requested auto mode still loading ("" = none/cancelled)
+    // Handed over from requestMode()/requestAutoMode() to the main loop
+    volatile bool _modeRequested = false;
+    Mode _requestedMode = Mode::NONE;
+    char _requestedAutoModeName[32] = "";
+    mutable portMUX_TYPE _requestMux = portMUX_INITIALIZER_UNLOCKED;
     bool _hasError = false;
     char _errorMessage[64] = "";
 
     void enterNoneMode();
     void enterFollowMode();
-    void exitCurrentMode();
+    void enterAutoMode(const char* modeName);
+    void exitCurrentMode(const EyePose& nextPose);
     void setError(const char* message);
 };
 
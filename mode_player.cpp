@@ -8,13 +8,103 @@
 #include "mode_player.h"
 #include "eye_controller.h"
 #include "auto_blink.h"
+#include "clip_player.h"
 #include "web_server.h"
+#include "mode_manager.h"
+#include "power_manager.h"
 #include <LittleFS.h>
 
 ModePlayer modePlayer;
 
+// Parse one idle motion layer: {"x": {"amplitude": a, "frequency": f}, "y": {...}}
+static void parseIdleLayer(JsonVariant layer, IdleMotionLayer& out) {
+    out.x.amplitude = layer["x"]["amplitude"] | 0.0f;
+    out.x.frequency = layer["x"]["frequency"] | 0.0f;
+    out.y.amplitude = layer["y"]["amplitude"] | 0.0f;
+    out.y.frequency = layer["y"]["frequency"] | 0.0f;
+}
+
 bool ModePlayer::loadMode(const char* modeName) {
-    unload();
+    if (isLoadPending()) {
+        WEB_LOG("ModePlayer", "Cannot load '%s': background load in progress", modeName);
+        return false;
+    }
+
+    // Compile into the back slot; the current mode stays intact if this fails
+    CompiledMode& back = _modes[_front ^ 1];
+    if (!compile(back, modeName)) {
+        back.doc.clear();
+        return false;
+    }
+
+    _loadState = LoadState::READY;
+    commitLoad();
+    return true;
+}
+
+bool ModePlayer::requestLoad(const char* modeName) {
+    if (isLoadPending()) return false;
+
+    CompiledMode& back = _modes[_front ^ 1];
+    strncpy(back.name, modeName, sizeof(back.name) - 1);
+    back.name[sizeof(back.name) - 1] = '\0';
+
+    // Parse on a short-lived task so neither the main loop nor the AsyncTCP task stalls.
+    // Only the back slot is touched there; the main loop leaves it alone until READY/FAILED.
+    _loadState = LoadState::LOADING;
+    if (xTaskCreatePinnedToCore(loaderTask, "modeLoader", MODE_LOADER_STACK_SIZE, this,
+                                MODE_LOADER_PRIORITY, nullptr, 0) != pdPASS) {
+        WEB_LOG("ModePlayer", "Failed to start loader task");
+        _loadState = LoadState::IDLE;
+        return false;
+    }
+    return true;
+}
+
+void ModePlayer::loaderTask(void* param) {
+    ModePlayer* self = static_cast<ModePlayer*>(param);
+    CompiledMode& back = self->_modes[self->_front ^ 1];
+
+    char modeName[sizeof(back.name)];
+    strncpy(modeName, back.name, sizeof(modeName));
+
+    bool ok = self->compile(back, modeName);
+    self->_loadState = ok ? LoadState::READY : LoadState::FAILED;
+    powerManager.wake();  // Main loop picks up the result
+
+    vTaskDelete(nullptr);
+}
+
+void ModePlayer::commitLoad() {
+    if (_loadState != LoadState::READY) return;
+
+    stop();
+    _front ^= 1;
+    _mode = &_modes[_front];
+
+    // Release the previous mode's document
+    CompiledMode& old = _modes[_front ^ 1];
+    old.doc.clear();
+    old.loaded = false;
+    old.name[0] = '\0';
+
+    _loadState = LoadState::IDLE;
+}
+
+void ModePlayer::discardLoad() {
+    if (_loadState != LoadState::READY && _loadState != LoadState::FAILED) return;
+
+    CompiledMode& back = _modes[_front ^ 1];
+    back.doc.clear();
+    back.loaded = false;
+    back.name[0] = '\0';
+
+    _loadState = LoadState::IDLE;
+}
+
+bool ModePlayer::compile(CompiledMode& mode, const char* modeName) {
+    uint32_t startUs = micros();
+    mode.loaded = false;
 
     // Build path: /modes/<modeName>.json
     char path[64];
@@ -26,7 +116,9 @@ bool ModePlayer::loadMode(const char* modeName) {
         return false;
     }
 
-    DeserializationError error = deserializeJson(_modeDoc, file);
+    uint32_t parseStartUs = micros();
+    DeserializationError error = deserializeJson(mode.doc, file);
+    mode.parseUs = micros() - parseStartUs;
     file.close();
 
     if (error) {
@@ -35,210 +127,379 @@ bool ModePlayer::loadMode(const char* modeName) {
     }
 
     // Extract sequence array
-    if (!_modeDoc.containsKey("sequence")) {
+    if (!mode.doc.containsKey("sequence")) {
         WEB_LOG("ModePlayer", "Mode missing 'sequence' array");
         return false;
     }
 
-    _sequence = _modeDoc["sequence"].as<JsonArray>();
-    _stepCount = _sequence.size();
+    mode.sequence = mode.doc["sequence"].as<JsonArray>();
+    mode.stepCount = mode.sequence.size();
 
-    if (_stepCount == 0) {
+    if (mode.stepCount == 0) {
         WEB_LOG("ModePlayer", "Mode has empty sequence");
         return false;
     }
 
+    // Validate repeat/call/choose/parallel blocks, inline called impulse files
+    if (!compileSequence(mode.doc, path)) {
+        return false;
+    }
+    mode.sequences = mode.doc["sequences"].as<JsonObject>();
+
     // Extract mode properties
-    _loop = _modeDoc["loop"] | true;
-    _coupling = _modeDoc["coupling"] | 1.0f;
+    mode.loop = mode.doc["loop"] | true;
+    mode.coupling = mode.doc["coupling"] | 1.0f;
+
+    // Optional procedural idle motion layered on top of the sequence
+    mode.hasIdleMotion = mode.doc.containsKey("idle");
+    if (mode.hasIdleMotion) {
+        JsonVariant idle = mode.doc["idle"];
+        parseIdleLayer(idle["drift"], mode.idleMotion.drift);
+        parseIdleLayer(idle["tremor"], mode.idleMotion.tremor);
+        parseIdleLayer(idle["saccade"], mode.idleMotion.saccade);
+    }
+
+    // Seed: setSeed() override, then the mode's "seed", else fresh (reported for replay)
+    uint32_t seed = _seedOverride;
+    if (seed == 0) seed = mode.doc["seed"] | 0u;
+    mode.seed = (seed != 0) ? seed : Prng::entropy();
+
+    // Resolve the first pose now so a mode switch can blend into it without a load gap
+    prefetchEntryPose(mode);
 
     // Store mode name
-    strncpy(_modeName, modeName, sizeof(_modeName) - 1);
-    _modeName[sizeof(_modeName) - 1] = '\0';
+    strncpy(mode.name, modeName, sizeof(mode.name) - 1);
+    mode.name[sizeof(mode.name) - 1] = '\0';
 
-    _loaded = true;
+    mode.loadUs = micros() - startUs;
+    mode.loaded = true;
 
-    WEB_LOG("ModePlayer", "Loaded '%s' with %d steps (loop=%s)",
-            modeName, _stepCount, _loop ? "true" : "false");
+    WEB_LOG("ModePlayer", "Loaded '%s' with %d steps (loop=%s, entry=%d, seed=%lu) in %lu us (parse %lu us)",
+            modeName, mode.stepCount, mode.loop ? "true" : "false", mode.entrySteps,
+            (unsigned long)mode.seed, (unsigned long)mode.loadUs, (unsigned long)mode.parseUs);
 
     return true;
 }
 
+void ModePlayer::prefetchEntryPose(CompiledMode& mode) {
+    // Start from the neutral pose with the mode's coupling, same as a fresh start
+    mode.entryPose = EyeController::neutralPose();
+    mode.entryPose.coupling = mode.coupling;
+    mode.entrySteps = 0;
+
+    // Fold leading gaze/lids steps into the pose (random values are resolved once, here).
+    // Local generator: this may run on the loader task while the current mode plays.
+    Prng entryRng;
+    entryRng.seed(mode.seed, PRNG_STREAM_MODE_ENTRY);
+    while (mode.entrySteps < mode.stepCount) {
+        JsonObject step = mode.sequence[mode.entrySteps].as<JsonObject>();
+        if (step.containsKey("gaze")) {
+            JsonObject params = step["gaze"].as<JsonObject>();
+            mode.entryPose.gazeX = resolveValue(entryRng, params["x"], mode.entryPose.gazeX);
+            mode.entryPose.gazeY = resolveValue(entryRng, params["y"], mode.entryPose.gazeY);
+            mode.entryPose.gazeZ = resolveValue(entryRng, params["z"], mode.entryPose.gazeZ);
+        } else if (step.containsKey("lids")) {
+            JsonObject params = step["lids"].as<JsonObject>();
+            mode.entryPose.lidLeft = resolveValue(entryRng, params["left"], mode.entryPose.lidLeft);
+            mode.entryPose.lidRight = resolveValue(entryRng, params["right"], mode.entryPose.lidRight);
+        } else {
+            break;
+        }
+        mode.entrySteps++;
+    }
+
+    // A sequence of only pose steps has nothing to resume at - play it from the top
+    if (mode.entrySteps >= mode.stepCount) {
+        mode.entrySteps = 0;
+    }
+}
+
 void ModePlayer::unload() {
     stop();
-    _modeDoc.clear();
-    _loaded = false;
-    _stepCount = 0;
-    _modeName[0] = '\0';
+    _mode->doc.clear();
+    _mode->loaded = false;
+    _mode->stepCount = 0;
+    _mode->name[0] = '\0';
 }
 
 void ModePlayer::start() {
-    if (!_loaded) return;
+    if (!_mode->loaded) return;
 
-    _currentStep = 0;
     _playing = true;
     _paused = false;  // Clear any pause state from previous manual control
-    _waitingForAnimation = false;
-    _waitUntil = 0;
+    eyeController.setIdleMotionPaused(false);
+    _lateMs = 0;
+    _lateMaxMs = 0;
+
+    // Entry pose is applied by the mode-switch transition; the timeline starts once it is done
+    for (SequenceTrack& track : _tracks) {
+        track.active = false;
+        track.cursor.clear();
+    }
+    SequenceTrack& main = _tracks[0];
+    main.cursor.begin(_mode->sequence, _mode->entrySteps);
+    main.rng.seed(_mode->seed, PRNG_STREAM_MODE);  // Same seed, same step trace
+    main.active = true;
+    main.wait = TrackWait::TRANSITION;
+    main.moveChannels = EyeController::CHANNEL_ALL;
+    main.timelineMs = millis();
+
+    // Apply mode's coupling setting (unless the mode-switch transition is blending into it)
+    if (!eyeController.isTransitioning(EyeController::CHANNEL_COUPLING)) {
+        eyeController.setCoupling(_mode->coupling);
+    }
 
-    // Apply mode's coupling setting
-    eyeController.setCoupling(_coupling);
+    if (_mode->hasIdleMotion) {
+        eyeController.setIdleMotion(_mode->idleMotion, _mode->seed);
+    }
 
-    WEB_LOG("ModePlayer", "Started playback of '%s'", _modeName);
+    WEB_LOG("ModePlayer", "Started playback of '%s'", _mode->name);
 }
 
 void ModePlayer::stop() {
+    if (isWaitingForClip()) clipPlayer.stop();
     _playing = false;
-    _waitingForAnimation = false;
-    _waitUntil = 0;
+    for (SequenceTrack& track : _tracks) {
+        track.active = false;
+        track.wait = TrackWait::NONE;
+    }
+
+    // Coupling is restored by the mode-switch transition (ModeManager::exitCurrentMode)
+    eyeController.clearIdleMotion();
+
+    if (_mode->name[0] != '\0') {
+        WEB_LOG("ModePlayer", "Stopped playback of '%s'", _mode->name);
+    }
+}
 
-    // Reset coupling to default
-    eyeController.setCoupling(1.0f);
+void ModePlayer::pause() {
+    if (!_paused) _pausedAt = millis();
+    _paused = true;
+    eyeController.cancelTransition();  // Manual control / calibration takes over where the eyes are
+    if (isWaitingForClip()) clipPlayer.pause();
+    eyeController.setIdleMotionPaused(true);
+}
 
-    if (_modeName[0] != '\0') {
-        WEB_LOG("ModePlayer", "Stopped playback of '%s'", _modeName);
+void ModePlayer::resume() {
+    if (_paused) {
+        // Shift the timelines past the pause
+        unsigned long pausedMs = millis() - _pausedAt;
+        for (SequenceTrack& track : _tracks) {
+            track.timelineMs += pausedMs;
+        }
+        _joinMs += pausedMs;
+        if (isWaitingForClip()) clipPlayer.resume();
     }
+    _paused = false;
+    eyeController.setIdleMotionPaused(false);
+}
+
+uint32_t ModePlayer::msUntilNextStep() const {
+    if (_loadState == LoadState::READY || _loadState == LoadState::FAILED) return 0;  // Swap pending
+    if (modeManager.hasModeRequest()) return 0;
+    if (!_playing || !_mode->loaded || _paused) return UINT32_MAX;
+    return msUntilNextTrackStep(_tracks);
 }
 
 void ModePlayer::loop() {
-    if (!_playing || !_loaded || _paused) return;
+    // Mode switch requested by the web server - switches or starts the background load
+    modeManager.serviceModeRequest();
+
+    // Background load finished - ModeManager swaps it in here, between steps
+    if (_loadState == LoadState::READY || _loadState == LoadState::FAILED) {
+        modeManager.onLoadComplete();
+    }
 
-    // Check if waiting for a timed delay
-    if (_waitUntil > 0) {
-        if (millis() < _waitUntil) {
-            return;  // Still waiting
+    if (!_playing || !_mode->loaded || _paused) return;
+
+    // Parallel tracks first; the main track resumes once all of them are done
+    bool tracksRunning = false;
+    for (uint8_t i = 1; i < SEQUENCE_MAX_TRACKS; i++) {
+        if (_tracks[i].active) {
+            runTrack(_tracks[i]);
+            tracksRunning |= _tracks[i].active;
         }
-        _waitUntil = 0;
     }
 
-    // Check if waiting for animation (blink) to complete
-    if (_waitingForAnimation) {
-        if (eyeController.isAnimating()) {
-            return;  // Still animating
+    SequenceTrack& main = _tracks[0];
+    if (main.wait == TrackWait::JOIN) {
+        if (tracksRunning) return;
+        main.wait = TrackWait::NONE;
+        main.timelineMs = _joinMs;  // Continue from the track that finished last
+    }
+    runTrack(main);
+}
+
+void ModePlayer::runTrack(SequenceTrack& track) {
+    // Steps run on an absolute timeline: a wait ends at the previous deadline + its
+    // duration, so loop latency does not accumulate. Animations end when they end -
+    // the timeline re-anchors there.
+    switch (track.wait) {
+        case TrackWait::TIME: {
+            unsigned long now = millis();
+            if (!Scheduler::isDue(now, track.timelineMs)) return;  // Still waiting
+            _lateMs = now - track.timelineMs;
+            if (_lateMs > _lateMaxMs) _lateMaxMs = _lateMs;
+            if (_lateMs > SEQUENCE_MAX_LATE_MS) {
+                track.timelineMs = now;  // Stalled (file load, OTA) - resync instead of bursting steps
+            }
+            break;
         }
-        _waitingForAnimation = false;
+        case TrackWait::BLINK:
+            if (eyeController.isAnimating()) return;  // Still animating
+            track.timelineMs = millis();
+            break;
+        case TrackWait::TRANSITION:
+            if (eyeController.isTransitioning(track.moveChannels)) return;  // Mode-switch transition or move step
+            track.timelineMs = millis();
+            break;
+        case TrackWait::CLIP:
+            if (clipPlayer.isPlaying()) return;  // Baked clip still running
+            track.timelineMs = millis();
+            break;
+        case TrackWait::JOIN:
+            return;
+        case TrackWait::NONE:
+            break;
+    }
+    track.wait = TrackWait::NONE;
+
+    // One step per pass (blocks are entered by the cursor)
+    JsonObject step = track.cursor.next(_mode->sequences, track.rng);
+    if (step.isNull()) {
+        finishTrack(track);
+    } else if (step.containsKey("parallel")) {
+        startParallel(track, step["parallel"].as<JsonArray>());
+    } else {
+        executeStep(step, track);
     }
+}
 
-    // Execute current step
-    if (_currentStep < _stepCount) {
-        JsonObject step = _sequence[_currentStep].as<JsonObject>();
-        executeStep(step);
-        advanceStep();
+void ModePlayer::startParallel(SequenceTrack& main, JsonArray tracks) {
+    uint8_t index = 1;
+    for (JsonArray steps : tracks) {
+        if (index >= SEQUENCE_MAX_TRACKS) break;  // Rejected at compile time
+        startParallelTrack(_tracks[index++], main, steps, PRNG_STREAM_MODE);
     }
+    _joinMs = main.timelineMs;
+    main.wait = TrackWait::JOIN;
 }
 
-void ModePlayer::executeStep(JsonObject step) {
+void ModePlayer::finishTrack(SequenceTrack& track) {
+    if (&track != &_tracks[0]) {
+        track.active = false;
+        if (Scheduler::isDue(track.timelineMs, _joinMs)) {
+            _joinMs = track.timelineMs;  // Latest end so far
+        }
+        return;
+    }
+
+    if (_mode->loop) {
+        track.cursor.begin(_mode->sequence);  // Loop back to start
+    } else {
+        stop();  // Sequence complete
+    }
+}
+
+void ModePlayer::executeStep(JsonObject step, SequenceTrack& track) {
     // Each step can have one primitive
     if (step.containsKey("gaze")) {
-        execGaze(step["gaze"].as<JsonObject>());
+        execGaze(step["gaze"].as<JsonObject>(), track.rng);
     }
     else if (step.containsKey("lids")) {
-        execLids(step["lids"].as<JsonObject>());
+        execLids(step["lids"].as<JsonObject>(), track.rng);
     }
     else if (step.containsKey("blink")) {
-        execBlink(step["blink"]);
+        execBlink(step["blink"], track);
     }
     else if (step.containsKey("wait")) {
-        execWait(step["wait"]);
+        execWait(step["wait"], track);
     }
-}
-
-void ModePlayer::advanceStep() {
-    _currentStep++;
-
-    if (_currentStep >= _stepCount) {
-        if (_loop) {
-            _currentStep = 0;  // Loop back to start
-        } else {
-            stop();  // Sequence complete
-        }
+    else if (step.containsKey("move")) {
+        execMove(step["move"].as<JsonObject>(), track);
+    }
+    else if (step.containsKey("clip")) {
+        execClip(step["clip"], track);
     }
 }
 
-void ModePlayer::execGaze(JsonObject params) {
-    float x = resolveValue(params["x"], eyeController.getGazeX());
-    float y = resolveValue(params["y"], eyeController.getGazeY());
-    float z = resolveValue(params["z"], eyeController.getGazeZ());
+void ModePlayer::execGaze(JsonObject params, Prng& rng) {
+    float x = resolveValue(rng, params["x"], eyeController.getGazeX());
+    float y = resolveValue(rng, params["y"], eyeController.getGazeY());
+    float z = resolveValue(rng, params["z"], eyeController.getGazeZ());
 
     eyeController.setGaze(x, y, z);
 }
 
-void ModePlayer::execLids(JsonObject params) {
+void ModePlayer::execLids(JsonObject params, Prng& rng) {
+    // Drawn even when skipped - whether an auto-blink is running must not shift later values
+    float left = resolveValue(rng, params["left"], eyeController.getLidLeft());
+    float right = resolveValue(rng, params["right"], eyeController.getLidRight());
+
     // Don't override lid positions during blink animation (e.g., auto-blink)
     if (eyeController.isAnimating()) return;
 
-    float left = resolveValue(params["left"], eyeController.getLidLeft());
-    float right = resolveValue(params["right"], eyeController.getLidRight());
-
     eyeController.setLids(left, right);
 }
 
-void ModePlayer::execBlink(JsonVariant params) {
-    int duration = resolveIntValue(params, 150);
+void ModePlayer::execBlink(JsonVariant params, SequenceTrack& track) {
+    int duration = resolveIntValue(track.rng, params, 150);
 
     eyeController.startBlink(duration);
     autoBlink.resetTimer();  // Avoid double-blink from auto-blink
 
-    _waitingForAnimation = true;
+    track.wait = TrackWait::BLINK;
 }
 
-void ModePlayer::execWait(JsonVariant params) {
-    int ms = resolveIntValue(params, 0);
+void ModePlayer::execMove(JsonObject params, SequenceTrack& track) {
+    // Unspecified values keep their current position; only named channels move
+    EyePose target = eyeController.getPose();
+    uint8_t channels = 0;
 
-    if (ms > 0) {
-        _waitUntil = millis() + ms;
+    if (params.containsKey("x") || params.containsKey("y") || params.containsKey("z")) {
+        target.gazeX = resolveValue(track.rng, params["x"], target.gazeX);
+        target.gazeY = resolveValue(track.rng, params["y"], target.gazeY);
+        target.gazeZ = resolveValue(track.rng, params["z"], target.gazeZ);
+        channels |= EyeController::CHANNEL_GAZE;
     }
-}
-
-float ModePlayer::resolveValue(JsonVariant val, float defaultVal) {
-    if (val.isNull()) {
-        return defaultVal;
+    if (params.containsKey("coupling")) {
+        target.coupling = resolveValue(track.rng, params["coupling"], target.coupling);
+        channels |= EyeController::CHANNEL_COUPLING;
     }
-
-    // Direct numeric value
-    if (val.is<float>() || val.is<int>()) {
-        return val.as<float>();
+    if (params.containsKey("left") || params.containsKey("right")) {
+        target.lidLeft = resolveValue(track.rng, params["left"], target.lidLeft);
+        target.lidRight = resolveValue(track.rng, params["right"], target.lidRight);
+        channels |= EyeController::CHANNEL_LIDS;
     }
 
-    // Random range: {"random": [min, max]}
-    if (val.is<JsonObject>()) {
-        JsonObject obj = val.as<JsonObject>();
-        if (obj.containsKey("random")) {
-            JsonArray range = obj["random"].as<JsonArray>();
-            if (range.size() >= 2) {
-                float minVal = range[0].as<float>();
-                float maxVal = range[1].as<float>();
-                // Generate random float in range
-                return minVal + (random(10001) / 10000.0f) * (maxVal - minVal);
-            }
-        }
-    }
+    int duration = resolveIntValue(track.rng, params["duration"], 300);
+    Easing easing = EyeController::parseEasing(params["easing"].as<const char*>());
 
-    return defaultVal;
+    eyeController.startTransition(target, max(duration, 0), easing, channels);
+    track.moveChannels = channels;
+    track.wait = TrackWait::TRANSITION;  // Continue when the move completes
 }
 
-int ModePlayer::resolveIntValue(JsonVariant val, int defaultVal) {
-    if (val.isNull()) {
-        return defaultVal;
+void ModePlayer::execClip(JsonVariant params, SequenceTrack& track) {
+    // Replaces a running clip; a missing clip is skipped
+    const char* name = params | "";
+    if (clipPlayer.play(name)) {
+        track.wait = TrackWait::CLIP;
     }
+}
 
-    // Direct numeric value
-    if (val.is<int>()) {
-        return val.as<int>();
+bool ModePlayer::isWaitingForClip() const {
+    for (const SequenceTrack& track : _tracks) {
+        if (track.active && track.wait == TrackWait::CLIP) return true;
     }
+    return false;
+}
 
-    // Random range: {"random": [min, max]}
-    if (val.is<JsonObject>()) {
-        JsonObject obj = val.as<JsonObject>();
-        if (obj.containsKey("random")) {
-            JsonArray range = obj["random"].as<JsonArray>();
-            if (range.size() >= 2) {
-                int minVal = range[0].as<int>();
-                int maxVal = range[1].as<int>();
-                return random(minVal, maxVal + 1);
-            }
-        }
-    }
+void ModePlayer::execWait(JsonVariant params, SequenceTrack& track) {
+    int ms = resolveIntValue(track.rng, params, 0);
 
-    return defaultVal;
+    if (ms > 0) {
+        track.timelineMs += ms;  // From the previous deadline, not from now
+        track.wait = TrackWait::TIME;
+    }
 }
@@ -10,66 +10,122 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include "eye_controller.h"
+#include "prng.h"
+#include "sequence.h"
 
 // Mode Player - JSON sequence executor
 // Loads mode definitions from /modes/*.json and executes them
-// Supports primitives: gaze, lids, blink, wait
-// Supports random values and looping sequences
+// Supports primitives: gaze, lids, blink, wait, move, clip
+// Supports random values, looping sequences and procedural idle motion
+// Supports repeat/call/choose blocks and parallel tracks (see sequence.h)
+//
+// Double-buffered: a mode is parsed and compiled (entry pose, idle block) into the
+// back slot - synchronously via loadMode(), or on a background task via
+// requestLoad() while the front slot keeps playing. ModeManager swaps the slots
+// in the main loop, between steps, once the load is ready.
 
 class ModePlayer {
 public:
-    // Load a mode from /modes/<modeName>.json
+    // Load a mode from /modes/<modeName>.json (blocking, replaces the current mode)
     bool loadMode(const char* modeName);
     void unload();
 
+    // Background load into the back slot (returns false if a load is already running)
+    bool requestLoad(const char* modeName);
+    bool isLoadPending() const { return _loadState != LoadState::IDLE; }
+    bool isLoadReady() const { return _loadState == LoadState::READY; }
+    bool isLoadFailed() const { return _loadState == LoadState::FAILED; }
+    const char* getPendingModeName() const { return _modes[_front ^ 1].name; }
+    void commitLoad();          // Main loop: back slot becomes the current mode (stops playback)
+    void discardLoad();         // Main loop: drop a finished load; running loads are dropped when done
+
     // Playback control
     void start();
     void stop();
     void loop();
 
-    // Pause/resume (for calibration mode)
-    void pause() { _paused = true; }
-    void resume() { _paused = false; }
+    // Pause/resume (for calibration mode and manual control)
+    void pause();
+    void resume();
     bool isPaused() const { return _paused; }
 
     // State queries
     bool isPlaying() const { return _playing && !_paused; }
-    bool isLoaded() const { return _loaded; }
-    const char* getModeName() const { return _modeName; }
+    bool isLoaded() const { return _mode->loaded; }
+    uint32_t msUntilNextStep() const;  // 0 = needs loop now, UINT32_MAX = not playing
+    const char* getModeName() const { return _mode->name; }
+    uint32_t getLoadUs() const { return _mode->loadUs; }  // Parse + compile time of current mode
+    uint32_t getLateMs() const { return _lateMs; }         // Wait lateness (does not accumulate)
+    uint32_t getLateMaxMs() const { return _lateMaxMs; }
+
+    // Random seed of the current mode. setSeed() overrides the seed of modes loaded
+    // afterwards (0 = back to the mode's "seed" field or fresh hardware entropy).
+    uint32_t getSeed() const { return _mode->seed; }
+    void setSeed(uint32_t seed) { _seedOverride = seed; }
+
+    // Pose the mode starts from (leading gaze/lids steps resolved at load time)
+    const EyePose& getEntryPose() const { return _mode->entryPose; }
 
 private:
-    bool _loaded = false;
+    // One parsed + compiled mode
+    struct CompiledMode {
+        bool loaded = false;
+        char name[32] = "";
+        JsonDocument doc;
+        JsonArray sequence;
+        JsonObject sequences;           // Named sub-sequences and inlined impulse calls
+        int stepCount = 0;              // Top-level steps
+        bool loop = true;
+        float coupling = 1.0;           // Can override coupling per mode
+        bool hasIdleMotion = false;
+        IdleMotionConfig idleMotion;    // Optional "idle" block
+        EyePose entryPose;              // Prefetched - start() skips the steps it was built from
+        int entrySteps = 0;
+        uint32_t seed = 0;              // Entry pose, sequence and idle motion randomness
+        uint32_t parseUs = 0;           // deserializeJson time
+        uint32_t loadUs = 0;            // Open + parse + compile time
+    };
+
+    enum class LoadState : uint8_t { IDLE, LOADING, READY, FAILED };
+
+    CompiledMode _modes[2];
+    uint8_t _front = 0;
+    CompiledMode* _mode = &_modes[0];   // Front slot (playing)
+
+    volatile LoadState _loadState = LoadState::IDLE;
+
     bool _playing = false;
     bool _paused = false;
-    bool _loop = true;
-    char _modeName[32] = "";
-
-    // JSON document for mode storage
-    JsonDocument _modeDoc;
-    JsonArray _sequence;
-    int _stepCount = 0;
-    int _currentStep = 0;
+    uint32_t _seedOverride = 0;
 
-    // Execution state
-    bool _waitingForAnimation = false;
-    unsigned long _waitUntil = 0;
+    // Execution state: [0] = main track, others run the blocks of a "parallel" step.
+    // Each track has its own cursor, wait state and timeline.
+    SequenceTrack _tracks[SEQUENCE_MAX_TRACKS];
+    unsigned long _joinMs = 0;          // Latest end of the running parallel tracks
+    unsigned long _pausedAt = 0;
+    uint32_t _lateMs = 0;               // How late the last wait ended
+    uint32_t _lateMaxMs = 0;
 
-    // Mode parameters (from JSON)
-    float _coupling = 1.0;  // Can override coupling per mode
+    // Parse + compile into a slot (main loop or loader task)
+    bool compile(CompiledMode& mode, const char* modeName);
+    void prefetchEntryPose(CompiledMode& mode);
+    static void loaderTask(void* param);
 
     // Step execution
-    void executeStep(JsonObject step);
-    void advanceStep();
+    void runTrack(SequenceTrack& track);
+    void startParallel(SequenceTrack& main, JsonArray tracks);
+    void finishTrack(SequenceTrack& track);
+    void executeStep(JsonObject step, SequenceTrack& track);
 
     // Primitive executors
-    void execGaze(JsonObject params);
-    void execLids(JsonObject params);
-    void execBlink(JsonVariant params);
-    void execWait(JsonVariant params);
-
-    // Value resolution (handles random ranges)
-    float resolveValue(JsonVariant val, float defaultVal = 0);
-    int resolveIntValue(JsonVariant val, int defaultVal = 0);
+    void execGaze(JsonObject params, Prng& rng);
+    void execLids(JsonObject params, Prng& rng);
+    void execBlink(JsonVariant params, SequenceTrack& track);
+    void execWait(JsonVariant params, SequenceTrack& track);
+    void execMove(JsonObject params, SequenceTrack& track);
+    void execClip(JsonVariant params, SequenceTrack& track);
+    bool isWaitingForClip() const;  // A track is playing a baked clip
 };
 
 extern ModePlayer modePlayer;
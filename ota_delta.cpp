@@ -0,0 +1,211 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "ota_delta.h"
+#include <string.h>
+
+OtaDelta otaDelta;
+
+static const uint8_t CMD_ADD = 0x01;
+static const uint8_t CMD_INSERT = 0x02;
+
+static uint32_t readLe32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool OtaDelta::isPatch(const uint8_t* data, size_t len) {
+    return len >= 4 && memcmp(data, OTA_DELTA_MAGIC, 4) == 0;
+}
+
+void OtaDelta::begin(const OtaDeltaIo& io) {
+    _io = io;
+    _state = State::HEADER;
+    _error = nullptr;
+    _headerLen = 0;
+    _header = {};
+    _value = 0;
+    _shift = 0;
+    _sourcePos = 0;
+    _produced = 0;
+    _remaining = 0;
+    _literals = 0;
+    _zeroRun = 0;
+}
+
+bool OtaDelta::feed(const uint8_t* data, size_t len) {
+    while (len > 0) {
+        switch (_state) {
+            case State::HEADER: {
+                size_t n = OTA_DELTA_HEADER_BYTES - _headerLen;
+                if (n > len) n = len;
+                memcpy(_headerBytes + _headerLen, data, n);
+                _headerLen += n;
+                data += n;
+                len -= n;
+                if (_headerLen == OTA_DELTA_HEADER_BYTES && !parseHeader()) return false;
+                continue;
+            }
+
+            case State::COMMAND: {
+                uint8_t command = *data++;
+                len--;
+                if (command == CMD_ADD) _state = State::ADD_OFFSET;
+                else if (command == CMD_INSERT) _state = State::INSERT_LENGTH;
+                else return fail("Unknown patch command");
+                continue;
+            }
+
+            case State::ADD_OFFSET:
+            case State::ADD_LENGTH:
+            case State::ZERO_RUN:
+            case State::LITERAL_COUNT:
+            case State::INSERT_LENGTH: {
+                uint8_t byte = *data++;
+                len--;
+                if (!readVarint(byte)) {
+                    if (_state == State::FAILED) return false;
+                    continue;
+                }
+                uint32_t value = _value;
+                _value = 0;
+                _shift = 0;
+
+                if (_state == State::ADD_OFFSET) {
+                    int32_t delta = (int32_t)(value >> 1) ^ -(int32_t)(value & 1);  // Zigzag
+                    _sourcePos += delta;
+                    _state = State::ADD_LENGTH;
+                } else if (_state == State::ADD_LENGTH) {
+                    if (value == 0 || value > _header.targetSize - _produced) return fail("ADD past end of target");
+                    if (_sourcePos > _header.sourceSize || value > _header.sourceSize - _sourcePos) {
+                        return fail("ADD past end of source");
+                    }
+                    _remaining = value;
+                    _state = State::ZERO_RUN;
+                } else if (_state == State::ZERO_RUN) {
+                    if (value > _remaining) return fail("Zero run past end of ADD");
+                    _zeroRun = value;
+                    if (!copySource(value)) return false;
+                    _remaining -= value;
+                    _state = State::LITERAL_COUNT;
+                } else if (_state == State::LITERAL_COUNT) {
+                    if (value > _remaining) return fail("Diff past end of ADD");
+                    if (value == 0 && _zeroRun == 0) return fail("Empty diff run");
+                    _literals = value;
+                    _state = State::ADD_LITERALS;
+                    if (_literals == 0) {
+                        if (_remaining == 0) commandDone();
+                        else _state = State::ZERO_RUN;
+                    }
+                } else {
+                    if (value == 0 || value > _header.targetSize - _produced) return fail("INSERT past end of target");
+                    _remaining = value;
+                    _state = State::INSERT_LITERALS;
+                }
+                continue;
+            }
+
+            case State::ADD_LITERALS: {
+                // target = source + diff
+                size_t n = _literals;
+                if (n > len) n = len;
+                if (n > sizeof(_buffer)) n = sizeof(_buffer);
+                if (!_io.read(_io.context, _sourcePos, _buffer, n)) return fail("Source read failed");
+                for (size_t i = 0; i < n; i++) _buffer[i] += data[i];
+                if (!emit(_buffer, n)) return false;
+                _sourcePos += n;
+                _literals -= n;
+                _remaining -= n;
+                data += n;
+                len -= n;
+                if (_literals == 0) {
+                    if (_remaining == 0) commandDone();
+                    else _state = State::ZERO_RUN;
+                }
+                continue;
+            }
+
+            case State::INSERT_LITERALS: {
+                size_t n = _remaining;
+                if (n > len) n = len;
+                if (!emit(data, n)) return false;
+                _remaining -= n;
+                data += n;
+                len -= n;
+                if (_remaining == 0) commandDone();
+                continue;
+            }
+
+            case State::DONE:
+                return fail("Data after end of patch");
+
+            case State::FAILED:
+                return false;
+        }
+    }
+    return _state != State::FAILED;
+}
+
+bool OtaDelta::finish() {
+    if (_state == State::FAILED) return false;
+    if (_state != State::DONE) return fail("Patch truncated");
+    return true;
+}
+
+bool OtaDelta::fail(const char* error) {
+    if (!_error) _error = error;
+    _state = State::FAILED;
+    return false;
+}
+
+bool OtaDelta::readVarint(uint8_t byte) {
+    if (_shift > 28 || (_shift == 28 && (byte & 0x70))) {
+        fail("Varint overflow");
+        return false;
+    }
+    _value |= (uint32_t)(byte & 0x7F) << _shift;
+    _shift += 7;
+    return !(byte & 0x80);
+}
+
+bool OtaDelta::parseHeader() {
+    const uint8_t* h = _headerBytes;
+    if (!isPatch(h, OTA_DELTA_HEADER_BYTES)) return fail("Not a delta patch");
+    if (h[4] != OTA_DELTA_VERSION) return fail("Unsupported patch version");
+
+    _header.sourceSize = readLe32(h + 8);
+    memcpy(_header.sourceSha256, h + 12, 32);
+    _header.targetSize = readLe32(h + 44);
+    memcpy(_header.targetSha256, h + 48, 32);
+    if (_header.targetSize == 0) return fail("Empty target");
+
+    const char* error = _io.begin(_io.context, _header);
+    if (error) return fail(error);
+
+    _state = State::COMMAND;
+    return true;
+}
+
+bool OtaDelta::emit(const uint8_t* data, size_t len) {
+    if (!_io.write(_io.context, data, len)) return fail("Target write failed");
+    _produced += len;
+    return true;
+}
+
+bool OtaDelta::copySource(uint32_t len) {
+    while (len > 0) {
+        size_t n = len < sizeof(_buffer) ? len : sizeof(_buffer);
+        if (!_io.read(_io.context, _sourcePos, _buffer, n)) return fail("Source read failed");
+        if (!emit(_buffer, n)) return false;
+        _sourcePos += n;
+        len -= n;
+    }
+    return true;
+}
+
+void OtaDelta::commandDone() {
+    _state = _produced == _header.targetSize ? State::DONE : State::COMMAND;
+}
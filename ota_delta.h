@@ -0,0 +1,99 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef OTA_DELTA_H
+#define OTA_DELTA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+// OTA Delta - Streaming decoder for delta firmware updates on /update
+// A patch (tools/delta_tool.py, make build) rebuilds the new firmware image from
+// the running one. /update tells it from a full image by its magic.
+//
+// Format (little-endian header, varints are LEB128):
+//   "AEDP" u8 version u8[3] reserved
+//   u32 sourceSize  u8[32] sourceSha256     running image the patch applies to
+//   u32 targetSize  u8[32] targetSha256     image it produces
+//   commands until targetSize bytes are produced:
+//   0x01 ADD     zigzag varint source offset (relative to the end of the previous
+//                ADD), varint length, then (varint zeroRun, varint literalCount,
+//                literalCount bytes) pairs covering length: target = source + diff
+//                (mod 256), zeroRun = diff bytes that are 0 (copied unchanged)
+//   0x02 INSERT  varint length, length bytes
+//
+// The decoder takes the upload chunk by chunk and only needs OTA_DELTA_BUFFER_BYTES
+// of scratch. Source reads, target writes and the header check (source hash, open
+// target) go through OtaDeltaIo. Plain C++, also built by the host round-trip test.
+
+#define OTA_DELTA_MAGIC "AEDP"
+#define OTA_DELTA_VERSION 1
+#define OTA_DELTA_HEADER_BYTES 80
+
+struct OtaDeltaHeader {
+    uint32_t sourceSize;
+    uint8_t sourceSha256[32];
+    uint32_t targetSize;
+    uint8_t targetSha256[32];
+};
+
+struct OtaDeltaIo {
+    // Header parsed: check the source, prepare the target. nullptr = go, else error
+    const char* (*begin)(void* context, const OtaDeltaHeader& header);
+    bool (*read)(void* context, uint32_t offset, uint8_t* buffer, size_t len);   // Source image
+    bool (*write)(void* context, const uint8_t* data, size_t len);               // Target image
+    void* context;
+};
+
+class OtaDelta {
+public:
+    static bool isPatch(const uint8_t* data, size_t len);   // First chunk of an upload
+
+    void begin(const OtaDeltaIo& io);
+    bool feed(const uint8_t* data, size_t len);   // false once failed
+    bool finish();                                // After the last chunk: target complete?
+    const OtaDeltaHeader& getHeader() const { return _header; }
+    uint32_t getProduced() const { return _produced; }
+    const char* getError() const { return _error; }
+
+private:
+    enum class State : uint8_t {
+        HEADER, COMMAND,
+        ADD_OFFSET, ADD_LENGTH, ZERO_RUN, LITERAL_COUNT, ADD_LITERALS,
+        INSERT_LENGTH, INSERT_LITERALS,
+        DONE, FAILED
+    };
+
+    OtaDeltaIo _io = {};
+    State _state = State::HEADER;
+    const char* _error = nullptr;
+
+    uint8_t _headerBytes[OTA_DELTA_HEADER_BYTES];
+    size_t _headerLen = 0;
+    OtaDeltaHeader _header = {};
+
+    uint32_t _value = 0;         // Varint being read
+    uint8_t _shift = 0;
+    uint32_t _sourcePos = 0;     // Next source byte of the current / last ADD
+    uint32_t _produced = 0;
+    uint32_t _remaining = 0;     // Bytes left in the current command
+    uint32_t _literals = 0;      // Diff bytes left in the current pair
+    uint32_t _zeroRun = 0;
+    uint8_t _buffer[OTA_DELTA_BUFFER_BYTES];
+
+    bool fail(const char* error);
+    bool readVarint(uint8_t byte);
+    bool parseHeader();
+    bool emit(const uint8_t* data, size_t len);
+    bool copySource(uint32_t len);
+    void commandDone();
+};
+
+extern OtaDelta otaDelta;
+
+#endif // OTA_DELTA_H
@@ -0,0 +1,102 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "power_manager.h"
+#include "scheduler.h"
+#include "servo_controller.h"
+#include "eye_controller.h"
+#include "mode_player.h"
+#include "impulse_player.h"
+#include "clip_player.h"
+#include "led_status.h"
+#include "web_server.h"
+#include <esp_pm.h>
+
+PowerManager powerManager;
+
+void PowerManager::begin() {
+    // setup() runs in the Arduino loop task - that's the task idle() blocks
+    _loopTask = xTaskGetCurrentTaskHandle();
+    _windowStartUs = micros();
+
+#if POWER_DFS_MIN_MHZ > 0
+    // Dynamic frequency scaling: CPU drops to POWER_DFS_MIN_MHZ while the loop waits.
+    // Needs CONFIG_PM_ENABLE in the core; light sleep also needs tickless idle.
+    esp_pm_config_t pm = {};
+    pm.max_freq_mhz = getCpuFrequencyMhz();
+    pm.min_freq_mhz = POWER_DFS_MIN_MHZ;
+    pm.light_sleep_enable = POWER_LIGHT_SLEEP;
+
+    esp_err_t err = esp_pm_configure(&pm);
+    if (err == ESP_OK) {
+        _dfsActive = true;
+        _lightSleep = POWER_LIGHT_SLEEP;
+        WEB_LOG("Power", "DFS %d-%d MHz, light sleep %s",
+                pm.min_freq_mhz, pm.max_freq_mhz, _lightSleep ? "on" : "off");
+    } else {
+        WEB_LOG("Power", "DFS not available (err %d), idle waits only", err);
+    }
+#endif
+}
+
+uint32_t PowerManager::computeSleepMs() const {
+    // Work due right now - keep spinning
+    if (servoController.hasPendingWrites()) return 0;
+    if (eyeController.isAnimating() || eyeController.isTransitioning() ||
+        eyeController.isIdleMotionActive()) return 0;
+
+    // Otherwise sleep until the earliest deadline (capped so polled state
+    // machines like WiFi reconnect still run regularly)
+    uint32_t sleepMs = POWER_MAX_SLEEP_MS;
+    sleepMs = min(sleepMs, scheduler.msUntilNext());
+    sleepMs = min(sleepMs, ledStatus.msUntilNextChange());
+    sleepMs = min(sleepMs, modePlayer.msUntilNextStep());
+    sleepMs = min(sleepMs, impulsePlayer.msUntilNextStep());
+    sleepMs = min(sleepMs, clipPlayer.msUntilNextFrame());
+    return sleepMs;
+}
+
+void PowerManager::idle() {
+#if POWER_IDLE_SLEEP
+    uint32_t sleepMs = computeSleepMs();
+
+    if (sleepMs >= POWER_MIN_SLEEP_MS) {
+        uint32_t startUs = micros();
+        // Pending wake() notifications make this return immediately (no lost wakeups)
+        bool woken = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(sleepMs)) > 0;
+        uint32_t sleptUs = micros() - startUs;
+        _windowSleptUs += sleptUs;
+
+        if (!woken) {
+            // Timed out: how late did we come back vs. the deadline we asked for
+            int32_t lateUs = (int32_t)(sleptUs - sleepMs * 1000);
+            if (lateUs < 0) lateUs = 0;
+            _wakeCount++;
+            _wakeLatencyTotalUs += lateUs;
+            if ((uint32_t)lateUs > _wakeLatencyMaxUs) _wakeLatencyMaxUs = lateUs;
+        }
+    }
+
+    // Idle share over ~1s windows
+    uint32_t windowUs = micros() - _windowStartUs;
+    if (windowUs >= 1000000) {
+        _idlePercent = (uint8_t)min((uint64_t)_windowSleptUs * 100 / windowUs, (uint64_t)100);
+        _windowStartUs += windowUs;
+        _windowSleptUs = 0;
+    }
+#endif
+}
+
+void PowerManager::wake() {
+    if (_loopTask) {
+        xTaskNotifyGive(_loopTask);
+    }
+}
+
+uint32_t PowerManager::getWakeLatencyAvgUs() const {
+    return _wakeCount ? (uint32_t)(_wakeLatencyTotalUs / _wakeCount) : 0;
+}
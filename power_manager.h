@@ -0,0 +1,57 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Power Manager - Tickless idle for the main loop
+// At the end of each loop pass, computes the next time any subsystem needs the
+// CPU (scheduler timers, LED pattern, mode/impulse wait steps) and blocks the
+// loop task until then, so FreeRTOS idles the core (WAITI, lower DFS clock).
+// Anything that needs servicing now (pending servo writes, blink/transition/idle
+// motion ticks) keeps the loop spinning. Async handlers call wake() to cut the
+// wait short, so WebSocket commands are not delayed.
+//
+// Servo PWM (LEDC on the 80 MHz APB clock) and WiFi association stay up: DFS never
+// drops below 80 MHz, WiFi uses modem sleep. Automatic light sleep is opt-in
+// (POWER_LIGHT_SLEEP) because LEDC stops during light sleep on the ESP32.
+
+class PowerManager {
+public:
+    void begin();               // Configure DFS/light sleep, capture loop task
+    void idle();                // Call at the end of loop()
+    void wake();                // End the current wait early (safe from async context)
+
+    // Stats (for /api/version)
+    bool isDfsActive() const { return _dfsActive; }
+    bool isLightSleepEnabled() const { return _lightSleep; }
+    uint8_t getIdlePercent() const { return _idlePercent; }         // Share of last ~1s spent waiting
+    uint32_t getWakeLatencyAvgUs() const;                           // Oversleep past requested deadline
+    uint32_t getWakeLatencyMaxUs() const { return _wakeLatencyMaxUs; }
+
+private:
+    TaskHandle_t _loopTask = nullptr;
+    bool _dfsActive = false;
+    bool _lightSleep = false;
+
+    uint32_t _windowStartUs = 0;
+    uint32_t _windowSleptUs = 0;
+    uint8_t _idlePercent = 0;
+
+    uint32_t _wakeCount = 0;
+    uint64_t _wakeLatencyTotalUs = 0;
+    uint32_t _wakeLatencyMaxUs = 0;
+
+    uint32_t computeSleepMs() const;
+};
+
+extern PowerManager powerManager;
+
+#endif // POWER_MANAGER_H
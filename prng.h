@@ -0,0 +1,96 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef PRNG_H
+#define PRNG_H
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <stdint.h>
+uint32_t esp_random();  // Host tools provide their own (make seed-trace)
+#endif
+
+// Prng - Small seedable generator (xoshiro128**)
+// Every sequence player and auto-scheduler owns one instance, so a given seed
+// replays the same random values regardless of what else draws numbers.
+// Arduino random() reads the hardware RNG and cannot be replayed. 32-bit
+// shifts/rotates only, a few cycles per draw on the ESP32.
+//
+// The same seed feeds several generators; the stream id keeps their sequences
+// independent (mode playback vs. auto-blink timing, ...). Plain C++ apart from
+// entropy(); the host check (make seed-trace) replays step traces from it.
+
+enum PrngStream : uint32_t {
+    PRNG_STREAM_MODE_ENTRY = 1,   // Mode entry pose (resolved at load time)
+    PRNG_STREAM_MODE = 2,         // Mode sequence playback
+    PRNG_STREAM_IDLE = 3,         // Procedural idle motion (micro-saccades)
+    PRNG_STREAM_IMPULSE = 4,      // Impulse sequence playback
+    PRNG_STREAM_AUTO_BLINK = 5,   // Auto-blink intervals
+    PRNG_STREAM_AUTO_IMPULSE = 6  // Auto-impulse intervals and picks
+};
+
+class Prng {
+public:
+    // Same seed + stream = same sequence
+    void seed(uint32_t seed, uint32_t stream) {
+        uint32_t x = seed ^ (stream * 0x9E3779B9u);
+        for (int i = 0; i < 4; i++) {
+            _s[i] = splitMix32(x);
+        }
+        if ((_s[0] | _s[1] | _s[2] | _s[3]) == 0) _s[0] = 1;  // All-zero state never leaves zero
+    }
+
+    // Fresh non-zero seed from the hardware RNG (to be reported for replay)
+    static uint32_t entropy() {
+        uint32_t seed;
+        do { seed = esp_random(); } while (seed == 0);
+        return seed;
+    }
+
+    uint32_t next() {
+        uint32_t result = rotl(_s[1] * 5, 7) * 9;
+        uint32_t t = _s[1] << 9;
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = rotl(_s[3], 11);
+        return result;
+    }
+
+    // [0, bound) without modulo (multiply-shift)
+    uint32_t below(uint32_t bound) {
+        return (uint32_t)(((uint64_t)next() * bound) >> 32);
+    }
+
+    // [minVal, maxVal] inclusive (minVal if the range is empty)
+    int32_t range(int32_t minVal, int32_t maxVal) {
+        if (maxVal <= minVal) return minVal;
+        return minVal + (int32_t)below((uint32_t)(maxVal - minVal) + 1);
+    }
+
+    // [minVal, maxVal) with 24-bit resolution
+    float uniform(float minVal, float maxVal) {
+        return minVal + (next() >> 8) * (1.0f / 16777216.0f) * (maxVal - minVal);
+    }
+
+private:
+    uint32_t _s[4] = {1, 0, 0, 0};
+
+    static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    static uint32_t splitMix32(uint32_t& x) {
+        uint32_t z = (x += 0x9E3779B9u);
+        z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+        z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+        return z ^ (z >> 16);
+    }
+};
+
+#endif // PRNG_H
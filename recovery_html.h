@@ -0,0 +1,323 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+// Generated by tools/ui_tool.py from tools/recovery.html (make recovery) - do not edit
+// Embedded recovery UI, gzipped (15371 -> 4849 bytes)
+
+#ifndef RECOVERY_HTML_H
+#define RECOVERY_HTML_H
+
+#include <Arduino.h>
+
+static const uint8_t RECOVERY_HTML_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x3b, 0xd9, 0x76, 0xdb, 0x38,
+    0xb2, 0xef, 0xfa, 0x0a, 0x44, 0x73, 0x12, 0x52, 0x13, 0x89, 0x5a, 0xec, 0x78, 0x1c, 0xc9, 0x56,
+    0x8e, 0xe3, 0xd8, 0xd3, 0x9e, 0xc9, 0x76, 0x62, 0x7b, 0xb6, 0x9c, 0x74, 0x1f, 0x88, 0x04, 0x2d,
+    0xb6, 0x29, 0x82, 0x03, 0x52, 0x96, 0xd5, 0x1e, 0xbf, 0xde, 0x0f, 0xb8, 0x9f, 0x78, 0xbf, 0xe4,
+    0x56, 0x61, 0x21, 0x41, 0x6a, 0xb1, 0xd2, 0xd3, 0x73, 0x26, 0x0f, 0x11, 0x49, 0x14, 0x0a, 0x55,
+    0x85, 0xda, 0x01, 0x1f, 0x3d, 0x7b, 0xf7, 0xe9, 0xf4, 0xea, 0xef, 0x9f, 0xcf, 0xc8, 0x34, 0x9f,
+    0xc5, 0xe3, 0xc6, 0x11, 0xfe, 0x90, 0x98, 0x26, 0x37, 0xc7, 0x4d, 0x96, 0x34, 0xf1, 0x03, 0xa3,
+    0x01, 0xfc, 0xcc, 0x58, 0x4e, 0x89, 0x3f, 0xa5, 0x22, 0x63, 0xf9, 0x71, 0xf3, 0xfa, 0xea, 0xbc,
+    0x73, 0xd8, 0x34, 0x9f, 0x13, 0x3a, 0x63, 0xc7, 0xcd, 0xbb, 0x88, 0x2d, 0x52, 0x2e, 0xf2, 0x26,
+    0xf1, 0x79, 0x92, 0xb3, 0x04, 0xc0, 0x16, 0x51, 0x90, 0x4f, 0x8f, 0x03, 0x76, 0x17, 0xf9, 0xac,
+    0x23, 0x5f, 0xda, 0x24, 0x4a, 0xa2, 0x3c, 0xa2, 0x71, 0x27, 0xf3, 0x69, 0xcc, 0x8e, 0xfb, 0x5e,
+    0x0f, 0xd1, 0xe4, 0x51, 0x1e, 0xb3, 0xf1, 0x49, 0x12, 0xcd, 0x68, 0x2e, 0x78, 0x12, 0xf9, 0xe4,
+    0x6c, 0xc9, 0x32, 0xd2, 0x21, 0x5f, 0x98, 0xcf, 0xef, 0x98, 0x58, 0x1e, 0x75, 0x15, 0x48, 0xe3,
+    0x28, 0xcb, 0x97, 0xf8, 0xfb, 0xfb, 0x87, 0x09, 0xbf, 0xef, 0x64, 0xd1, 0x2f, 0x51, 0x72, 0x33,
+    0x9c, 0x70, 0x11, 0x30, 0xd1, 0x81, 0x2f, 0xa3, 0x19, 0x15, 0x37, 0x51, 0x32, 0xec, 0x8d, 0x52,
+    0x1a, 0x04, 0x38, 0xd6, 0x7b, 0x6c, 0x4c, 0x78, 0xb0, 0x7c, 0x08, 0x81, 0xa8, 0x4e, 0x48, 0x67,
+    0x51, 0xbc, 0x1c, 0x76, 0x68, 0x9a, 0xc6, 0xac, 0x93, 0x2d, 0xb3, 0x9c, 0xcd, 0xda, 0x6f, 0xe3,
+    0x28, 0xb9, 0xfd, 0x40, 0xfd, 0x4b, 0xf9, 0x7a, 0x0e, 0x70, 0xed, 0xe6, 0x25, 0xbb, 0xe1, 0x8c,
+    0x5c, 0x5f, 0x34, 0xdb, 0x5f, 0xf8, 0x84, 0xe7, 0xbc, 0x9d, 0xd1, 0x24, 0xeb, 0x64, 0x4c, 0x44,
+    0xe1, 0x68, 0x42, 0xfd, 0xdb, 0x1b, 0xc1, 0xe7, 0x49, 0x30, 0xfc, 0x5d, 0x9f, 0xf6, 0xe9, 0x80,
+    0x8d, 0x7c, 0x1e, 0x73, 0x31, 0xfc, 0x1d, 0x63, 0x6c, 0x34, 0x8b, 0x92, 0xce, 0x94, 0x45, 0x37,
+    0xd3, 0x7c, 0xd8, 0xef, 0xf5, 0xee, 0xa6, 0x05, 0x21, 0x83, 0x5e, 0x7a, 0xff, 0xd8, 0xf0, 0x50,
+    0x38, 0x34, 0x4a, 0x98, 0x78, 0x98, 0xd1, 0x7b, 0x25, 0x94, 0xe1, 0x41, 0x0f, 0xc6, 0x0a, 0xd2,
+    0x09, 0x9d, 0xe7, 0xfc, 0xb1, 0x31, 0xed, 0x3f, 0x18, 0xb4, 0xaf, 0xf7, 0x5f, 0x1d, 0xf4, 0xf4,
+    0x38, 0x70, 0x99, 0xe7, 0x7c, 0x06, 0xc8, 0x61, 0x8a, 0x64, 0x0a, 0x84, 0xc0, 0x86, 0x7d, 0xef,
+    0x15, 0x9b, 0x01, 0xfa, 0x6c, 0x3e, 0x91, 0x92, 0x32, 0x73, 0x0f, 0x0f, 0x0f, 0x6b, 0x13, 0xf7,
+    0x34, 0x1d, 0x54, 0x04, 0x0f, 0x15, 0x56, 0x0e, 0x06, 0xfd, 0x3d, 0x36, 0xd2, 0xb2, 0x14, 0x34,
+    0x88, 0xe6, 0xd9, 0xb0, 0x3f, 0x80, 0x55, 0x6c, 0x0e, 0x6a, 0xc8, 0x06, 0x25, 0x32, 0x32, 0x1d,
+    0xd4, 0x08, 0xb6, 0xa9, 0xeb, 0xb3, 0x59, 0x9d, 0x81, 0x57, 0x80, 0x2d, 0x88, 0xb2, 0x34, 0xa6,
+    0xcb, 0x61, 0x18, 0xb3, 0xfb, 0x11, 0x8d, 0xa3, 0x9b, 0xa4, 0x13, 0xc1, 0x26, 0x64, 0x43, 0x1f,
+    0x14, 0x88, 0x89, 0xd1, 0x0d, 0x4d, 0x87, 0x87, 0x72, 0x89, 0x05, 0x15, 0x09, 0x10, 0x51, 0x21,
+    0x59, 0xad, 0x33, 0xe8, 0x69, 0xa2, 0x87, 0xfd, 0xf4, 0x9e, 0x64, 0x3c, 0x8e, 0x02, 0x62, 0x48,
+    0xa8, 0x72, 0x73, 0x68, 0x31, 0x23, 0x97, 0x5f, 0x65, 0xc6, 0x22, 0xba, 0xe7, 0xbd, 0x96, 0x22,
+    0xd5, 0x2b, 0x93, 0x0c, 0x55, 0xf3, 0xa6, 0xca, 0x23, 0x0c, 0x47, 0x49, 0xc8, 0x2b, 0x54, 0xf5,
+    0xc2, 0xbd, 0xfd, 0xef, 0x5d, 0x5a, 0x7e, 0x5a, 0x5d, 0x1a, 0x71, 0x83, 0x39, 0x05, 0xec, 0x61,
+    0x8d, 0xd2, 0x15, 0xdb, 0x02, 0x5c, 0x1f, 0xc0, 0xf4, 0xea, 0x82, 0xfb, 0x35, 0x84, 0x87, 0x52,
+    0x3f, 0x62, 0x3a, 0x61, 0xf1, 0x83, 0x91, 0xfa, 0x24, 0xe6, 0xfe, 0x6d, 0x8d, 0x12, 0x24, 0x54,
+    0xb3, 0x48, 0x29, 0x5d, 0xa5, 0x29, 0x4a, 0xd2, 0x79, 0xfe, 0x35, 0x5f, 0xa6, 0x60, 0xf2, 0x61,
+    0x14, 0xb3, 0xe6, 0xb7, 0x07, 0xa5, 0xc4, 0xa0, 0xed, 0xcf, 0x4b, 0x16, 0x51, 0x6f, 0x36, 0x0a,
+    0x45, 0x92, 0x1c, 0xd0, 0x6c, 0xca, 0xb6, 0xed, 0x94, 0x6d, 0x54, 0xab, 0xc2, 0xf2, 0xe7, 0x22,
+    0x83, 0xe1, 0x94, 0x47, 0xa8, 0x28, 0xeb, 0xe8, 0x1a, 0x4e, 0xd1, 0x75, 0xd4, 0x24, 0xb7, 0xdf,
+    0x3b, 0xc4, 0x4d, 0x9b, 0xe4, 0x49, 0x21, 0x85, 0x28, 0x01, 0x07, 0xc0, 0x3a, 0x4a, 0x18, 0x36,
+    0x03, 0x64, 0xb0, 0x5f, 0x88, 0x75, 0x98, 0xf0, 0x84, 0xad, 0x21, 0xd2, 0xd2, 0x71, 0xd0, 0xf0,
+    0x2a, 0x51, 0xa3, 0x5c, 0x80, 0xd7, 0x00, 0x77, 0xc7, 0x93, 0x21, 0x8d, 0x63, 0xd2, 0xf3, 0x06,
+    0x99, 0x5a, 0xbb, 0x93, 0x0a, 0x70, 0x75, 0x62, 0xb9, 0x46, 0x9b, 0x0d, 0xdb, 0x61, 0x18, 0x56,
+    0x61, 0xd7, 0xb0, 0x13, 0x86, 0x07, 0x93, 0x83, 0x49, 0x0d, 0x0c, 0xd8, 0xa2, 0x93, 0x98, 0x55,
+    0x8d, 0xfb, 0xe0, 0xe0, 0xc0, 0x10, 0x97, 0xf0, 0xbc, 0x03, 0xd4, 0xf0, 0x05, 0x0b, 0xf4, 0xcc,
+    0x0c, 0x9c, 0x6c, 0x12, 0xd4, 0xc9, 0xd1, 0x3b, 0xb6, 0xba, 0x0b, 0x31, 0x0b, 0x73, 0xe9, 0x7e,
+    0xea, 0xd3, 0xb7, 0x09, 0x3c, 0x15, 0xfc, 0x46, 0xb0, 0x2c, 0x2b, 0xa4, 0x2e, 0xe5, 0xa9, 0x31,
+    0xe6, 0x3c, 0x95, 0x9b, 0x6a, 0xc1, 0x75, 0x26, 0x54, 0x3c, 0x68, 0x3f, 0x2a, 0xed, 0xf2, 0x49,
+    0x0b, 0x93, 0x0e, 0x11, 0x09, 0x08, 0x81, 0xb7, 0xe1, 0x34, 0x0a, 0x02, 0x96, 0xd8, 0x08, 0x41,
+    0x29, 0xe2, 0x87, 0xd2, 0x33, 0x3f, 0x1f, 0xad, 0x91, 0xbd, 0xd2, 0x64, 0x18, 0xb3, 0x76, 0x4e,
+    0x7e, 0x83, 0xbd, 0xdb, 0xcb, 0x6c, 0x6c, 0x39, 0xbb, 0xcf, 0x1f, 0xf0, 0xbf, 0x8e, 0xf4, 0x5a,
+    0xc6, 0x5f, 0x59, 0x0c, 0x1d, 0xae, 0x5a, 0xb4, 0x65, 0x58, 0xe8, 0xaa, 0x73, 0x9a, 0xcf, 0xb3,
+    0x87, 0x9a, 0x0c, 0x4a, 0x0d, 0xec, 0xad, 0xd8, 0xf4, 0xa1, 0xe5, 0x31, 0x51, 0x7e, 0x05, 0x12,
+    0x70, 0xfb, 0xbe, 0x6f, 0x4b, 0x57, 0x29, 0xb3, 0xcd, 0xe1, 0x80, 0xfd, 0x21, 0xd8, 0x1b, 0xac,
+    0xf5, 0x95, 0x6a, 0xc8, 0x10, 0xb7, 0xef, 0xd3, 0xf0, 0x55, 0xaf, 0x44, 0xcd, 0x84, 0xe0, 0x62,
+    0x0b, 0xe2, 0xa7, 0x9d, 0x70, 0xdd, 0x63, 0xc2, 0x1e, 0x65, 0x20, 0xd9, 0x8e, 0xf4, 0x9c, 0x95,
+    0x08, 0xf0, 0xf3, 0x3c, 0xcb, 0xa3, 0x70, 0xd9, 0xd1, 0x19, 0xc4, 0x30, 0x4b, 0x29, 0x64, 0x0e,
+    0x13, 0x96, 0x2f, 0x18, 0x4b, 0x6a, 0x92, 0xd9, 0xc5, 0xe3, 0xee, 0xe4, 0x64, 0x6d, 0x72, 0x08,
+    0xac, 0x98, 0x0c, 0xc3, 0x48, 0x64, 0x79, 0xc7, 0x9f, 0x46, 0x71, 0x60, 0xc5, 0xd1, 0xc7, 0x06,
+    0xad, 0x3b, 0xff, 0xa3, 0xae, 0x4e, 0x47, 0x8e, 0xba, 0x3a, 0x4f, 0xc2, 0x5c, 0x03, 0x7e, 0x82,
+    0xe8, 0x8e, 0xf8, 0x31, 0xcd, 0xb2, 0xe3, 0x66, 0x11, 0xf0, 0x65, 0x36, 0xd5, 0x1f, 0x9b, 0x94,
+    0x86, 0x7c, 0x00, 0xbf, 0x0e, 0xf3, 0xfa, 0xf0, 0x39, 0x35, 0xc0, 0x26, 0x7c, 0x37, 0xc7, 0xd7,
+    0x69, 0xcc, 0x69, 0x40, 0x80, 0x94, 0x19, 0x04, 0x20, 0x46, 0xb8, 0x80, 0x74, 0x84, 0xa0, 0x67,
+    0xcb, 0x8e, 0xba, 0xe9, 0xb8, 0x51, 0x59, 0x43, 0x87, 0xa8, 0x26, 0x89, 0x02, 0xc0, 0x21, 0xf7,
+    0x0d, 0x0c, 0x28, 0xc1, 0x45, 0x89, 0xa4, 0xf0, 0xb8, 0x69, 0xeb, 0x4d, 0x53, 0xe6, 0x51, 0x18,
+    0xcd, 0xec, 0x09, 0x7a, 0xe1, 0x4b, 0xf9, 0x36, 0x44, 0xd6, 0x10, 0x62, 0x4c, 0x8e, 0x50, 0x26,
+    0x36, 0xe0, 0x0c, 0x34, 0x8d, 0xde, 0x00, 0xe8, 0x7b, 0xa0, 0x10, 0x96, 0xf5, 0x3c, 0x0f, 0xa0,
+    0x01, 0x08, 0xe5, 0x00, 0x54, 0xd5, 0x88, 0x43, 0xb9, 0x16, 0x64, 0xac, 0x46, 0xdc, 0x92, 0x98,
+    0xf1, 0x47, 0x9e, 0x33, 0x6b, 0xe1, 0xab, 0x69, 0x94, 0x11, 0x61, 0xc4, 0x95, 0xc2, 0x92, 0x04,
+    0x3e, 0x64, 0x53, 0xbe, 0x48, 0xc8, 0x62, 0xca, 0x12, 0x92, 0x4f, 0x19, 0x99, 0x81, 0x6c, 0x51,
+    0x32, 0x3e, 0xb0, 0xcb, 0x73, 0x32, 0x61, 0x04, 0xe5, 0x06, 0x81, 0x25, 0xa3, 0x21, 0x8b, 0x97,
+    0xde, 0x5a, 0x92, 0x30, 0x5f, 0x91, 0xdb, 0x31, 0x18, 0xab, 0xac, 0x8f, 0x5c, 0x00, 0x91, 0xb0,
+    0x19, 0x83, 0xea, 0xde, 0xd9, 0xaa, 0xd1, 0x1c, 0x4b, 0x41, 0x8c, 0xcf, 0xf5, 0x8e, 0x68, 0x96,
+    0x4b, 0xe9, 0x84, 0x8b, 0x8e, 0x86, 0x6f, 0x8e, 0x3b, 0x66, 0x54, 0x2d, 0xfe, 0x14, 0xce, 0x0f,
+    0x8a, 0x87, 0x2f, 0xec, 0x9f, 0xf3, 0x48, 0xb0, 0x60, 0x05, 0x35, 0x26, 0x95, 0xf3, 0xe8, 0x57,
+    0xa3, 0x07, 0xd4, 0x7f, 0x51, 0x9f, 0x57, 0x30, 0xff, 0x7b, 0x58, 0x35, 0xc1, 0x19, 0xd9, 0x28,
+    0x14, 0xc0, 0x8f, 0xc4, 0x87, 0x8b, 0xef, 0x46, 0x7f, 0x2e, 0x18, 0x23, 0x3f, 0x30, 0x9a, 0xae,
+    0x0a, 0x1a, 0x46, 0x20, 0xc7, 0xa6, 0xe9, 0xee, 0x38, 0x15, 0x2d, 0x69, 0x40, 0x73, 0xd6, 0x11,
+    0x7c, 0xb1, 0xd6, 0x2a, 0x8a, 0xc8, 0xbb, 0xf7, 0xda, 0xef, 0x0f, 0x0a, 0x2e, 0xe5, 0x24, 0x72,
+    0x72, 0x47, 0xa3, 0x18, 0xe3, 0xea, 0x2a, 0x87, 0x0a, 0xeb, 0x46, 0x29, 0xae, 0x51, 0xbf, 0x8a,
+    0xb9, 0xa2, 0x43, 0xdd, 0xcd, 0x58, 0xc7, 0x27, 0x01, 0xc8, 0x92, 0xbc, 0x87, 0x09, 0xe4, 0xc4,
+    0xcf, 0xa3, 0x3b, 0xdb, 0x58, 0x2e, 0xf9, 0x8c, 0x11, 0xea, 0x63, 0xc8, 0xca, 0x08, 0x3a, 0x0c,
+    0x93, 0x07, 0x78, 0x6a, 0xe9, 0xaa, 0xfd, 0xc9, 0x68, 0xd3, 0xab, 0x27, 0xe0, 0x3a, 0xdb, 0x5e,
+    0x97, 0x88, 0xe3, 0x78, 0x67, 0x21, 0x00, 0x00, 0xff, 0x43, 0x9a, 0x64, 0xc2, 0x45, 0x54, 0xc2,
+    0x95, 0x02, 0x5b, 0x0b, 0xf0, 0xbe, 0x8a, 0xa3, 0x34, 0x42, 0xa9, 0xc3, 0x68, 0x93, 0x00, 0x6e,
+    0x9f, 0x4d, 0x79, 0x0c, 0x7e, 0xf9, 0xb8, 0x79, 0x86, 0x98, 0xc8, 0xe7, 0x8b, 0x8f, 0x4d, 0xb0,
+    0xda, 0xfb, 0x98, 0x25, 0x37, 0x50, 0x1d, 0x36, 0x0f, 0x60, 0x12, 0x02, 0xcf, 0xc0, 0x1d, 0x1e,
+    0x37, 0x93, 0xf9, 0x0c, 0x8a, 0x2c, 0xbf, 0x90, 0x44, 0x91, 0x5b, 0x5a, 0x91, 0xf1, 0x70, 0x6d,
+    0xb2, 0xbb, 0xb9, 0x06, 0xd8, 0x96, 0xd4, 0x20, 0x27, 0x93, 0x39, 0x38, 0xa3, 0xc4, 0x6c, 0x0e,
+    0xa4, 0x34, 0xc4, 0xca, 0xa7, 0x9a, 0x84, 0x27, 0x7e, 0x1c, 0xf9, 0xb7, 0xb0, 0xd3, 0x09, 0xee,
+    0x95, 0xdb, 0x2a, 0x88, 0xb3, 0x08, 0x22, 0xfd, 0x03, 0x74, 0x65, 0xd7, 0x12, 0xe4, 0xa8, 0xab,
+    0x50, 0xe2, 0xce, 0xa1, 0x9a, 0x68, 0x70, 0xab, 0x24, 0xab, 0x67, 0xe6, 0xcd, 0x31, 0xf8, 0x77,
+    0x88, 0x14, 0x09, 0xf3, 0x73, 0x72, 0x17, 0x51, 0x72, 0xf2, 0x99, 0xb8, 0xfd, 0xd7, 0x03, 0xaf,
+    0x7f, 0x70, 0xe8, 0xed, 0x7b, 0xfd, 0x56, 0xcd, 0xc1, 0xca, 0x2d, 0x35, 0xb2, 0x96, 0x11, 0xba,
+    0x59, 0x5b, 0x45, 0xe5, 0x86, 0x4f, 0x24, 0x24, 0xcd, 0x6d, 0x5a, 0x6a, 0x39, 0xc9, 0x13, 0xa5,
+    0x57, 0x96, 0x83, 0xac, 0x29, 0xaa, 0x54, 0x9f, 0xaa, 0x8e, 0x48, 0x6d, 0xea, 0x6b, 0x07, 0xbf,
+    0x5e, 0xc4, 0x45, 0xe6, 0x68, 0x09, 0x19, 0xe4, 0x47, 0x71, 0x31, 0x6f, 0x2a, 0x58, 0x78, 0xec,
+    0x74, 0x9d, 0xe6, 0xf8, 0x8f, 0x9c, 0xe4, 0x9c, 0x7c, 0x50, 0x8e, 0xde, 0x92, 0xed, 0xee, 0x48,
+    0x03, 0x08, 0x19, 0x18, 0x16, 0xde, 0x82, 0x2a, 0xcc, 0x53, 0xdc, 0x41, 0x94, 0xdd, 0x44, 0xbe,
+    0x75, 0x60, 0x52, 0x73, 0xfc, 0x4e, 0x43, 0x10, 0x05, 0xf2, 0xab, 0x56, 0x11, 0x6c, 0xc2, 0x79,
+    0x6e, 0xb0, 0xab, 0x37, 0x85, 0xfd, 0x8b, 0x7c, 0xb6, 0x90, 0xee, 0x24, 0x75, 0x9d, 0x02, 0x18,
+    0xdf, 0x4a, 0x5c, 0x6f, 0x12, 0x25, 0xad, 0xd5, 0x28, 0xa5, 0xbc, 0xa6, 0x86, 0xa6, 0x24, 0x61,
+    0x8b, 0x32, 0x6d, 0x80, 0x19, 0x40, 0x24, 0xca, 0x4f, 0xf9, 0x29, 0x19, 0x33, 0x55, 0x47, 0xc6,
+    0x3b, 0x9a, 0x88, 0x71, 0xe3, 0x54, 0x30, 0xfc, 0xbc, 0x88, 0xc0, 0xcc, 0xc8, 0x11, 0xd6, 0x9a,
+    0xe3, 0xcb, 0x5b, 0x96, 0xfb, 0x53, 0xf2, 0x7f, 0xff, 0xf3, 0xbf, 0xe4, 0xec, 0x1e, 0x5b, 0x3a,
+    0xe4, 0x94, 0xcf, 0x52, 0xc8, 0x3c, 0x40, 0x3a, 0x12, 0xdd, 0x51, 0x57, 0xc2, 0x81, 0xdd, 0x92,
+    0x13, 0x11, 0xcc, 0xa3, 0x84, 0x93, 0x8b, 0x77, 0x67, 0x0a, 0xdf, 0x75, 0xc6, 0xca, 0xb8, 0x8c,
+    0x04, 0xcb, 0x9c, 0x85, 0xb8, 0x32, 0x38, 0x83, 0x10, 0x64, 0x74, 0x16, 0xdd, 0x94, 0x8a, 0x5c,
+    0xe6, 0xd7, 0x59, 0xab, 0x4d, 0x98, 0x77, 0xe3, 0xe9, 0xb5, 0x69, 0xd9, 0x03, 0xea, 0xb0, 0x25,
+    0xcb, 0xa0, 0x04, 0xe6, 0x88, 0x45, 0x2f, 0xd9, 0x96, 0x6b, 0x80, 0xad, 0x50, 0x0d, 0xef, 0x05,
+    0x2c, 0xce, 0xa9, 0x21, 0x28, 0xa5, 0x48, 0x78, 0x28, 0xf8, 0x4c, 0x0f, 0xcf, 0xe8, 0x2d, 0xc8,
+    0x60, 0x0e, 0x89, 0x9c, 0x01, 0x71, 0xb1, 0xf7, 0x13, 0x41, 0xc8, 0xe2, 0x49, 0x2c, 0xe5, 0x82,
+    0xc4, 0x16, 0xe2, 0x8a, 0x72, 0xb2, 0xa0, 0x19, 0x10, 0x1f, 0x30, 0x89, 0xa6, 0x65, 0x76, 0x2a,
+    0xe4, 0x62, 0x66, 0xa2, 0x3c, 0x3e, 0xd7, 0x3d, 0xa0, 0x2c, 0x39, 0x0b, 0x00, 0xf9, 0x42, 0x21,
+    0x25, 0x4f, 0xf3, 0xe3, 0x26, 0x92, 0xdf, 0x56, 0x74, 0x5a, 0xa6, 0xa0, 0xa6, 0x41, 0xbe, 0x37,
+    0x8b, 0xb0, 0x65, 0xb6, 0xc1, 0xf7, 0x68, 0x84, 0x52, 0x89, 0x6a, 0xea, 0x60, 0x6b, 0x13, 0x52,
+    0x54, 0xd5, 0x09, 0x53, 0xa8, 0x14, 0x28, 0x8a, 0x0f, 0xeb, 0xe1, 0xb0, 0xde, 0x02, 0x6f, 0xb0,
+    0x6e, 0x04, 0x0b, 0x27, 0x9b, 0xb5, 0xd8, 0x78, 0x8d, 0x35, 0x41, 0xb7, 0x52, 0x1f, 0x15, 0x93,
+    0xe4, 0xcb, 0xb8, 0xf7, 0xbc, 0xaa, 0xf6, 0xf6, 0x3c, 0x95, 0x59, 0x16, 0x13, 0xf4, 0xeb, 0xf8,
+    0xbb, 0xec, 0x04, 0xf2, 0x91, 0x73, 0x4c, 0x8f, 0x9f, 0xb0, 0x93, 0x46, 0x61, 0x28, 0xef, 0xa3,
+    0x1c, 0x32, 0xde, 0xf3, 0x4b, 0x02, 0xc2, 0x86, 0xdc, 0x52, 0x27, 0xea, 0xd8, 0xea, 0x31, 0x99,
+    0xf6, 0x26, 0x13, 0x51, 0x49, 0xd9, 0x6d, 0x2c, 0x11, 0x84, 0x59, 0xc7, 0x9f, 0x01, 0x2d, 0xe5,
+    0x3b, 0xe9, 0xf8, 0x04, 0x8c, 0x8d, 0x76, 0x49, 0x27, 0x25, 0x83, 0x57, 0x07, 0xa4, 0x33, 0x21,
+    0xfb, 0xbd, 0xd7, 0xf0, 0x9b, 0x11, 0x48, 0x96, 0xc9, 0x3c, 0xb2, 0x54, 0xba, 0xb1, 0xa2, 0x62,
+    0x90, 0x33, 0x6d, 0x57, 0x31, 0x04, 0x58, 0x51, 0xb1, 0x5f, 0xa5, 0x5b, 0x80, 0xc9, 0xd6, 0xad,
+    0x8a, 0x7b, 0x7d, 0x52, 0xab, 0x60, 0xf2, 0x6f, 0xa1, 0x55, 0x8a, 0x9b, 0xef, 0xd4, 0x2a, 0x98,
+    0xf4, 0x7d, 0x5a, 0x05, 0x13, 0x76, 0xd4, 0x2a, 0xd8, 0xba, 0xe4, 0x06, 0x72, 0x8b, 0x5f, 0x74,
+    0xf2, 0x05, 0x6a, 0xf4, 0x4e, 0x7e, 0x21, 0xff, 0x80, 0x2f, 0x9b, 0xd4, 0xea, 0x6a, 0xca, 0xb2,
+    0x32, 0x01, 0x2b, 0xab, 0x11, 0x48, 0x3b, 0x60, 0x96, 0x67, 0x53, 0xf7, 0x1f, 0x8b, 0x9d, 0x8b,
+    0x28, 0x65, 0xd7, 0x17, 0x26, 0x00, 0xe1, 0x9b, 0xdc, 0x5d, 0xb3, 0xa0, 0x9d, 0x08, 0xf9, 0xbd,
+    0xbd, 0xd7, 0x83, 0x49, 0x73, 0xfc, 0x57, 0x00, 0x2a, 0x2c, 0xe7, 0x57, 0x45, 0xbd, 0x10, 0x78,
+    0xe6, 0x62, 0xf9, 0x05, 0xd8, 0xcf, 0xad, 0xdc, 0x68, 0xdd, 0x62, 0xe7, 0x0a, 0x94, 0x48, 0xd8,
+    0x4d, 0xd1, 0xb0, 0xd8, 0x96, 0xcc, 0x17, 0x51, 0x9a, 0x8f, 0x1b, 0x31, 0xcb, 0xa1, 0xee, 0xc3,
+    0xac, 0x17, 0x02, 0xd0, 0x31, 0x09, 0x69, 0x9c, 0xb1, 0x91, 0xfc, 0x8a, 0xb9, 0x16, 0x9f, 0xe7,
+    0x97, 0x92, 0xaa, 0x0c, 0xc6, 0x7a, 0xa3, 0x46, 0x83, 0x66, 0xcb, 0xc4, 0x27, 0xe1, 0x3c, 0x91,
+    0x5b, 0x41, 0xfc, 0x29, 0xf3, 0x6f, 0x65, 0xe2, 0xac, 0x0a, 0x5b, 0xb7, 0x45, 0x1e, 0x1a, 0x84,
+    0xe4, 0x40, 0x06, 0xfe, 0x12, 0x34, 0xfb, 0x2c, 0x27, 0x02, 0x66, 0xd3, 0x05, 0x05, 0xff, 0x1f,
+    0x62, 0xf0, 0x73, 0x9d, 0x2e, 0x4d, 0xa3, 0x2e, 0xc5, 0x79, 0x5a, 0x6f, 0x9c, 0xd6, 0xc8, 0x82,
+    0x0f, 0x0a, 0x78, 0xe1, 0xfd, 0x9c, 0xf1, 0xc4, 0xd5, 0xa3, 0x16, 0xa1, 0x81, 0x17, 0xcb, 0x47,
+    0x35, 0xb0, 0x42, 0xab, 0x1a, 0xb6, 0x3e, 0xfd, 0xeb, 0x5f, 0x48, 0xbf, 0x44, 0x12, 0x12, 0xd7,
+    0x20, 0x6a, 0x69, 0x32, 0x09, 0x09, 0xb8, 0x0f, 0xc9, 0x71, 0x92, 0x7b, 0x37, 0x2c, 0x3f, 0x8b,
+    0x19, 0x3e, 0xbe, 0x5d, 0x5e, 0x04, 0xae, 0x63, 0x55, 0x10, 0x4e, 0xcb, 0x93, 0xf2, 0xf7, 0xb4,
+    0x72, 0xc1, 0x3a, 0x8e, 0x6c, 0xd9, 0x38, 0x23, 0x8d, 0xa5, 0xdb, 0x25, 0xef, 0x54, 0x65, 0x40,
+    0xc0, 0xac, 0x72, 0xc8, 0x37, 0x81, 0x58, 0x74, 0x7d, 0x82, 0xc7, 0x99, 0x86, 0xf9, 0xea, 0xa8,
+    0x98, 0xe3, 0xb4, 0x89, 0xa3, 0x3c, 0x04, 0x3e, 0x95, 0xe9, 0x12, 0xbe, 0x19, 0xed, 0x72, 0xbe,
+    0x79, 0xe0, 0x27, 0xce, 0x28, 0xc8, 0x0c, 0x72, 0xee, 0xe3, 0x71, 0x41, 0xae, 0x91, 0x14, 0x8b,
+    0x91, 0xd9, 0x0d, 0xb4, 0x47, 0x41, 0x6b, 0x54, 0xc0, 0x23, 0xdb, 0x2c, 0x06, 0x86, 0x61, 0x8e,
+    0x67, 0xca, 0x17, 0x98, 0x9c, 0x8b, 0x39, 0x1b, 0xe1, 0x37, 0xc5, 0x1a, 0x4f, 0xa9, 0x1f, 0xe5,
+    0x92, 0xb5, 0x9e, 0xf7, 0xca, 0xb1, 0x46, 0x54, 0x87, 0x13, 0x07, 0xac, 0x26, 0x27, 0x00, 0x3c,
+    0xea, 0x25, 0x1e, 0x5b, 0x96, 0x14, 0x4e, 0xe2, 0x8c, 0x9b, 0x22, 0x49, 0xe5, 0x28, 0xd2, 0xd9,
+    0x56, 0x64, 0x80, 0x9f, 0xb5, 0x10, 0xe4, 0xe3, 0x7f, 0x9f, 0xd7, 0x3a, 0x2b, 0xea, 0x1d, 0xd8,
+    0x51, 0x29, 0xe6, 0x90, 0x68, 0xae, 0x55, 0x83, 0x44, 0x29, 0x60, 0x9b, 0x4c, 0xd4, 0x83, 0xca,
+    0x79, 0xe4, 0x88, 0xc0, 0x88, 0x16, 0x47, 0x10, 0x20, 0x58, 0x60, 0x9b, 0x81, 0xc4, 0xf2, 0x16,
+    0xcc, 0x7d, 0x33, 0x1f, 0x4e, 0x99, 0xd9, 0x1a, 0x9b, 0x40, 0x6e, 0xca, 0xa9, 0x2f, 0x5e, 0xd4,
+    0xb5, 0x7d, 0x4c, 0x7a, 0xa5, 0x1e, 0x17, 0x80, 0x2b, 0x7c, 0xaf, 0x00, 0xac, 0x17, 0xc2, 0x06,
+    0xb0, 0x0d, 0xbb, 0x5f, 0x88, 0xe9, 0x11, 0xbc, 0x32, 0x9a, 0x36, 0x43, 0xa9, 0x23, 0xbb, 0x1c,
+    0x26, 0xc9, 0xda, 0xc9, 0x75, 0x54, 0x65, 0xad, 0x0c, 0x5d, 0xb9, 0x0c, 0xf0, 0x33, 0x98, 0xf1,
+    0x0e, 0x61, 0xfb, 0x59, 0x0b, 0xe5, 0xfe, 0xb8, 0xe2, 0x5a, 0x4c, 0x3d, 0x28, 0x39, 0x53, 0xf2,
+    0x83, 0x72, 0x6c, 0x9b, 0xe4, 0x8a, 0xca, 0x18, 0xec, 0xf4, 0x8e, 0xc6, 0x8a, 0x65, 0xad, 0x3a,
+    0x42, 0x9c, 0xc5, 0x4f, 0xcd, 0x95, 0xd4, 0x2a, 0xa1, 0x4b, 0x78, 0x0f, 0x63, 0xe0, 0xa9, 0x6a,
+    0x96, 0x22, 0xe3, 0x92, 0x5b, 0xdc, 0x8c, 0x67, 0x00, 0x2d, 0x95, 0x6b, 0x1d, 0x54, 0x51, 0x87,
+    0x83, 0x3e, 0x09, 0x96, 0xcf, 0x45, 0xa2, 0xf4, 0x6a, 0x37, 0x9f, 0xa8, 0xb8, 0x06, 0xb1, 0x98,
+    0xfd, 0x9c, 0xb1, 0x7c, 0xca, 0x83, 0x21, 0x71, 0x3e, 0x7f, 0xba, 0xbc, 0x72, 0xda, 0xfa, 0x2b,
+    0xf6, 0x43, 0x99, 0xc8, 0x86, 0xe4, 0xc1, 0xd1, 0x4b, 0x77, 0xae, 0x20, 0x2d, 0x71, 0x00, 0x4e,
+    0x66, 0xe0, 0xaa, 0xca, 0xeb, 0xa2, 0xef, 0x74, 0x1e, 0xcd, 0x24, 0xec, 0x9e, 0x0e, 0xc9, 0x9f,
+    0x2e, 0x3f, 0x7d, 0x84, 0x3d, 0x15, 0x90, 0x89, 0x45, 0xe1, 0xd2, 0x7d, 0x00, 0x5e, 0x1e, 0x5b,
+    0x0d, 0x5b, 0xeb, 0xa5, 0xbe, 0x79, 0xfc, 0xb6, 0x54, 0xaa, 0xa2, 0x6c, 0x14, 0x0c, 0x33, 0x19,
+    0xe3, 0x8e, 0x1f, 0xc1, 0x94, 0x20, 0x2c, 0x1b, 0xa8, 0x75, 0xe2, 0x30, 0x5e, 0x1c, 0xbf, 0xba,
+    0xad, 0x0d, 0xea, 0xb2, 0x56, 0x8e, 0xd8, 0xfd, 0x62, 0x20, 0x27, 0xa5, 0x29, 0xce, 0x7a, 0x25,
+    0x41, 0x6a, 0xb0, 0xb9, 0xf8, 0x5d, 0x71, 0x47, 0x37, 0x93, 0x76, 0x0b, 0x39, 0x1b, 0x35, 0xa6,
+    0x6c, 0x48, 0x82, 0xba, 0x55, 0x69, 0x0f, 0x4c, 0xd7, 0x1b, 0xa3, 0x8e, 0xd3, 0x71, 0x9e, 0xc0,
+    0x54, 0xed, 0x3f, 0xae, 0xc1, 0x06, 0x00, 0xd7, 0xd1, 0x5f, 0xbe, 0x07, 0xe5, 0x56, 0x74, 0xf3,
+    0x0a, 0xae, 0x8f, 0x90, 0x49, 0x45, 0x20, 0x01, 0x30, 0xe9, 0xc2, 0xa0, 0xb7, 0xe1, 0x55, 0x0d,
+    0xc7, 0xb5, 0x68, 0x3f, 0x44, 0x49, 0x51, 0x4e, 0xef, 0x44, 0x66, 0xd1, 0x6b, 0x5c, 0x83, 0x0e,
+    0xc7, 0xb0, 0x41, 0x49, 0xde, 0x10, 0xb7, 0x7c, 0xeb, 0xf6, 0x7b, 0x83, 0x7d, 0x00, 0xe6, 0xe7,
+    0xd1, 0x3d, 0x0b, 0xdc, 0x7e, 0xeb, 0xa5, 0x43, 0xfe, 0xfc, 0xd6, 0x21, 0xc3, 0x72, 0x35, 0x54,
+    0xdf, 0xc0, 0x2b, 0x4a, 0xe0, 0xcb, 0xe8, 0x17, 0x56, 0x6a, 0xb2, 0xda, 0xec, 0x29, 0xbb, 0x97,
+    0xfe, 0xee, 0xde, 0x21, 0x2f, 0x49, 0x0d, 0x16, 0x70, 0x5f, 0x4a, 0xeb, 0x70, 0xfb, 0x07, 0xb8,
+    0xd0, 0x75, 0x9a, 0x32, 0x71, 0x4a, 0x33, 0xe6, 0x16, 0x01, 0x66, 0xf3, 0x4e, 0x56, 0x8a, 0x96,
+    0x15, 0xa6, 0x9c, 0xdd, 0x8a, 0x18, 0x24, 0x0a, 0x29, 0x7c, 0x09, 0x4f, 0xaa, 0x98, 0x71, 0x6a,
+    0xe1, 0xe8, 0x72, 0xca, 0x17, 0xc6, 0x9f, 0xaa, 0xd4, 0x44, 0xd6, 0x4f, 0x04, 0x6c, 0x5f, 0x70,
+    0x28, 0x41, 0x30, 0xfc, 0xe8, 0x73, 0x04, 0x4b, 0xc5, 0x35, 0xe4, 0x16, 0x2f, 0x58, 0x39, 0xdc,
+    0xa8, 0xda, 0x87, 0x3c, 0xbf, 0xd8, 0x61, 0xae, 0x84, 0xab, 0x4e, 0x9d, 0x65, 0x37, 0x3b, 0x4c,
+    0xd4, 0xf4, 0x56, 0xa7, 0x6a, 0x1e, 0x95, 0x7a, 0xa9, 0x14, 0xb3, 0xdc, 0x64, 0x33, 0x78, 0x8c,
+    0x92, 0x8d, 0xb2, 0x0c, 0xf6, 0xcc, 0x29, 0x77, 0x5a, 0x31, 0xf1, 0x54, 0xc2, 0x26, 0xc9, 0xad,
+    0x6f, 0x13, 0x64, 0xec, 0x1f, 0x14, 0xbe, 0x61, 0x01, 0x08, 0x4c, 0xd4, 0xc1, 0x3e, 0xf2, 0xa2,
+    0x94, 0x25, 0x21, 0xe6, 0xe2, 0x1e, 0x29, 0xaa, 0x5f, 0x18, 0x50, 0x75, 0xef, 0x04, 0x3c, 0xe6,
+    0xc2, 0x73, 0x2a, 0x0e, 0xb3, 0x4e, 0x7c, 0xb8, 0xf8, 0x29, 0xe7, 0xfc, 0x27, 0x1e, 0x07, 0xbf,
+    0x0d, 0xfd, 0x85, 0x11, 0x5e, 0x71, 0x4e, 0x3e, 0xc5, 0xc1, 0x56, 0x2e, 0x80, 0x52, 0x61, 0x0e,
+    0x1a, 0x8a, 0x4e, 0x8d, 0xb2, 0x8b, 0xaa, 0x45, 0xa3, 0x3a, 0x42, 0x51, 0xa1, 0xfb, 0x5b, 0x64,
+    0x4a, 0x33, 0x0d, 0x66, 0x9c, 0x1d, 0x00, 0x14, 0x12, 0x48, 0xd8, 0x02, 0x54, 0xad, 0x6c, 0x94,
+    0xed, 0x20, 0x85, 0x79, 0xf4, 0xdb, 0x4a, 0x01, 0x18, 0xdb, 0x85, 0xff, 0x82, 0xbf, 0x42, 0x0a,
+    0x30, 0x51, 0x31, 0x56, 0xf1, 0xbb, 0x1b, 0xd9, 0x9f, 0xdb, 0x20, 0x35, 0x01, 0x00, 0xaa, 0x2a,
+    0xeb, 0x15, 0x0b, 0xd6, 0x4d, 0x43, 0x6a, 0x4e, 0x3f, 0x50, 0x24, 0x3e, 0xe4, 0xbf, 0x3a, 0x69,
+    0x54, 0x8e, 0x4c, 0x01, 0x15, 0x27, 0x24, 0x98, 0xff, 0x99, 0x8f, 0x7a, 0xdd, 0x1d, 0x8a, 0x98,
+    0xf2, 0x70, 0x66, 0x5d, 0x0d, 0x83, 0xe5, 0x71, 0x21, 0x22, 0x65, 0x78, 0x78, 0x6b, 0xcb, 0x36,
+    0x5a, 0x5f, 0x76, 0x69, 0x34, 0x4e, 0xd7, 0xa1, 0x4e, 0xe1, 0x0c, 0x11, 0x52, 0xb6, 0x93, 0x11,
+    0xd3, 0x34, 0xcf, 0xd3, 0x6c, 0xd8, 0xed, 0xde, 0x80, 0x37, 0x9a, 0x4f, 0x3c, 0x9f, 0xcf, 0xba,
+    0xff, 0x00, 0xa7, 0xc4, 0x3b, 0x17, 0x17, 0xdd, 0x7a, 0xf3, 0xb1, 0x0b, 0xc9, 0x04, 0x03, 0xbf,
+    0x9a, 0x39, 0x15, 0x54, 0x39, 0x15, 0x40, 0x3d, 0x22, 0xfb, 0x69, 0x12, 0xd3, 0xe4, 0xb6, 0x36,
+    0x5a, 0xdd, 0xbc, 0x3b, 0xbd, 0x05, 0xb6, 0x38, 0x2a, 0xf0, 0x3a, 0x79, 0xc5, 0xae, 0x3d, 0xc2,
+    0xeb, 0xe3, 0xa7, 0x1a, 0xb3, 0xf2, 0x18, 0xe1, 0xf8, 0x49, 0xe9, 0xd5, 0xf2, 0x06, 0x22, 0xe7,
+    0x79, 0x11, 0x2a, 0xe8, 0x0f, 0x57, 0x1f, 0xde, 0x17, 0x29, 0x62, 0x31, 0x04, 0x9c, 0xb3, 0x24,
+    0x38, 0xc5, 0x93, 0x6e, 0x17, 0xa9, 0x69, 0xed, 0x94, 0x2e, 0x17, 0x09, 0x31, 0xa8, 0xc9, 0xe9,
+    0x97, 0xd3, 0xbd, 0x01, 0x71, 0x2f, 0xce, 0xce, 0xce, 0xda, 0x24, 0xa3, 0x78, 0x08, 0x95, 0x91,
+    0x5f, 0xe2, 0x68, 0xd2, 0x22, 0x3c, 0xb4, 0xdc, 0x0c, 0x0c, 0xa2, 0x44, 0x60, 0x30, 0xca, 0xb1,
+    0xc1, 0x9a, 0x44, 0x21, 0xe4, 0x4e, 0x8d, 0xb2, 0x4e, 0x17, 0xfe, 0xde, 0xc0, 0x9d, 0x2c, 0x73,
+    0x96, 0x29, 0x6d, 0xc1, 0x02, 0x1f, 0x3e, 0x62, 0x55, 0x7f, 0x7f, 0xae, 0xff, 0x21, 0x75, 0x50,
+    0x81, 0x11, 0x57, 0xf6, 0x04, 0x64, 0xc1, 0x0f, 0x3f, 0x47, 0x44, 0x4e, 0xf3, 0xd4, 0x89, 0x12,
+    0x7c, 0x79, 0xf9, 0xd2, 0x28, 0x1c, 0x22, 0xf8, 0xf1, 0x58, 0x8d, 0x7f, 0x8d, 0xbe, 0x29, 0xee,
+    0x0a, 0x0c, 0xb7, 0x0a, 0xc3, 0x2d, 0x60, 0x38, 0x84, 0x1f, 0x9c, 0xa6, 0x56, 0x74, 0xf1, 0x67,
+    0x3c, 0x1e, 0x93, 0x7e, 0x8b, 0xfc, 0x48, 0xdc, 0xde, 0xfd, 0xd9, 0xbb, 0xb7, 0x87, 0x87, 0x7b,
+    0x83, 0x1e, 0x79, 0x41, 0x3a, 0x72, 0xf0, 0x05, 0x0c, 0x49, 0x61, 0xa1, 0xa8, 0x54, 0x12, 0xad,
+    0x66, 0xfd, 0x68, 0x91, 0xdb, 0x92, 0x38, 0xa0, 0xa8, 0x07, 0x51, 0x95, 0x55, 0x83, 0xb4, 0x3e,
+    0x17, 0x9b, 0x6b, 0x17, 0x50, 0x9a, 0xa1, 0x73, 0xc6, 0x5f, 0xd8, 0x06, 0x79, 0x6d, 0xa8, 0x4d,
+    0x4c, 0xb7, 0x4b, 0x8f, 0xc6, 0xf8, 0x8b, 0x4a, 0x85, 0xbf, 0xca, 0x1b, 0xe1, 0x13, 0x54, 0x5f,
+    0x17, 0x81, 0x5d, 0x7a, 0xc8, 0xf6, 0xe1, 0x66, 0x15, 0x51, 0xeb, 0xb5, 0xca, 0x82, 0x43, 0x2e,
+    0x2c, 0xdb, 0x8b, 0x5b, 0x26, 0x49, 0xe2, 0xac, 0x49, 0x86, 0xb6, 0x2d, 0x73, 0x4a, 0xf2, 0xab,
+    0x8b, 0xc5, 0xdb, 0xd7, 0x89, 0x2b, 0xf0, 0xc8, 0xef, 0x16, 0x78, 0x25, 0x0e, 0x0b, 0xbe, 0x8c,
+    0xc2, 0x1b, 0x66, 0x18, 0xc1, 0x59, 0x73, 0x26, 0x5b, 0xab, 0x5c, 0x25, 0xdf, 0x51, 0x43, 0x69,
+    0xdc, 0xcc, 0x83, 0x29, 0xb2, 0x9f, 0x8a, 0x49, 0xb8, 0xcc, 0xf0, 0xd1, 0x30, 0x8a, 0x16, 0x00,
+    0xf3, 0x52, 0xc1, 0xee, 0x60, 0xee, 0x3b, 0x16, 0xd2, 0x79, 0x5c, 0x14, 0x12, 0xa5, 0xa8, 0xb1,
+    0x73, 0x65, 0x24, 0xee, 0xc9, 0x88, 0xfc, 0xb5, 0xf7, 0xad, 0xcc, 0x14, 0x9e, 0xe1, 0x27, 0xb4,
+    0x34, 0x1a, 0x33, 0x01, 0xee, 0xeb, 0x12, 0x3c, 0x8f, 0x0f, 0xe6, 0xa2, 0xe6, 0xca, 0x0b, 0x29,
+    0x60, 0xd5, 0x56, 0xb9, 0x26, 0x67, 0x4e, 0x36, 0x15, 0xd1, 0x66, 0x13, 0xb6, 0x87, 0x25, 0x7d,
+    0xc3, 0x47, 0x36, 0xf9, 0x3e, 0xa2, 0xe9, 0xc2, 0xb8, 0x6e, 0x76, 0x55, 0x00, 0x56, 0x90, 0xe0,
+    0xb9, 0xb4, 0x33, 0x52, 0x34, 0xa0, 0x21, 0x29, 0x9d, 0xc6, 0x53, 0x22, 0x78, 0x63, 0x65, 0x93,
+    0xce, 0x8c, 0x4f, 0x69, 0x12, 0xc4, 0x76, 0xf7, 0xce, 0x04, 0x19, 0xe3, 0x1d, 0x86, 0xd6, 0xb9,
+    0x14, 0xb9, 0xc3, 0x6b, 0xb6, 0x78, 0x44, 0x83, 0x07, 0x95, 0x04, 0xa6, 0x6a, 0x27, 0x33, 0x61,
+    0xb0, 0x13, 0xf2, 0x8c, 0x06, 0xbc, 0xf6, 0x0c, 0xdd, 0x08, 0x4e, 0x92, 0xf3, 0x4b, 0x4a, 0x04,
+    0xea, 0x99, 0x31, 0xa6, 0x52, 0xbe, 0xe6, 0x8b, 0x0a, 0xe4, 0xaa, 0x90, 0x95, 0x44, 0x43, 0x5d,
+    0xe3, 0xd4, 0x93, 0x6f, 0xe9, 0x2e, 0x00, 0x0d, 0x9e, 0xa4, 0x5d, 0xc3, 0xa4, 0xc3, 0x13, 0x21,
+    0xe8, 0xd2, 0xd5, 0x75, 0x1a, 0x6c, 0x88, 0x47, 0xf1, 0xc3, 0xdb, 0x79, 0x18, 0x32, 0xe1, 0xb6,
+    0x0a, 0x6f, 0x8b, 0x8b, 0xbf, 0x04, 0xf4, 0x6f, 0x90, 0xf0, 0x63, 0x74, 0xfc, 0xb6, 0x63, 0xc2,
+    0xe0, 0xfb, 0x42, 0xba, 0x39, 0x39, 0x64, 0x3b, 0xbc, 0x6a, 0x46, 0x9f, 0xd2, 0x00, 0x12, 0x49,
+    0xd0, 0x82, 0xc3, 0x36, 0x54, 0x00, 0x4e, 0xe1, 0x93, 0x2d, 0x8d, 0xba, 0x9f, 0x0a, 0x4d, 0xdf,
+    0xdf, 0x3e, 0xbc, 0xff, 0x01, 0x42, 0x9a, 0xae, 0x45, 0x8d, 0xde, 0xc1, 0xb8, 0xc7, 0xc1, 0xb5,
+    0xbb, 0xba, 0x28, 0x47, 0xd2, 0xda, 0x52, 0x3f, 0x5a, 0x5a, 0xf8, 0x08, 0xa1, 0x24, 0x00, 0xaa,
+    0x6d, 0x99, 0x75, 0x45, 0xad, 0xb5, 0xec, 0x34, 0x03, 0xb8, 0xbf, 0xf3, 0x1c, 0x95, 0xad, 0xb5,
+    0xd2, 0xf9, 0x4a, 0x7d, 0xb4, 0x8c, 0x0f, 0x34, 0x9f, 0x7a, 0xb2, 0xe9, 0xeb, 0xe2, 0x2c, 0x75,
+    0x11, 0xa7, 0x4b, 0xb0, 0x62, 0x81, 0xea, 0xad, 0x45, 0x7e, 0x4f, 0xfa, 0xbd, 0x9e, 0xd5, 0x05,
+    0x43, 0xbb, 0xd7, 0xda, 0xa5, 0xae, 0xd9, 0x1d, 0x4b, 0x44, 0x20, 0xa8, 0xe7, 0x4e, 0xb5, 0x57,
+    0x26, 0xf1, 0xc3, 0xd6, 0xe1, 0x7c, 0x6b, 0x71, 0xb2, 0xaa, 0x7a, 0x76, 0x27, 0x49, 0x66, 0x5e,
+    0xe0, 0x2b, 0xea, 0x41, 0xf9, 0xb3, 0xe0, 0x78, 0x5d, 0x4e, 0xdd, 0x5d, 0xb2, 0x56, 0xaa, 0xb5,
+    0x0b, 0x36, 0x4c, 0x5f, 0x43, 0x62, 0xd1, 0x96, 0x53, 0x5b, 0x35, 0xb2, 0xf7, 0x0a, 0x2f, 0x2c,
+    0x5d, 0xaa, 0xfb, 0x79, 0x28, 0xdf, 0x15, 0xf1, 0x6a, 0xe3, 0x68, 0x19, 0xe3, 0x36, 0x0d, 0x94,
+    0xc2, 0x66, 0x6c, 0x8e, 0x6a, 0x16, 0x6f, 0xd9, 0xd9, 0x36, 0x73, 0x26, 0xfa, 0x7e, 0xa0, 0x53,
+    0x03, 0xad, 0xe7, 0xa3, 0x2a, 0x31, 0xd4, 0xc0, 0xe1, 0x3c, 0x7e, 0x46, 0xde, 0x29, 0x93, 0x5c,
+    0xa0, 0xff, 0x06, 0x0d, 0x41, 0xb5, 0xb4, 0x45, 0x96, 0xb1, 0xfc, 0x2a, 0x9a, 0x31, 0x3e, 0xcf,
+    0x5d, 0xc5, 0x58, 0xe5, 0xf8, 0x1e, 0x71, 0x76, 0x41, 0xf9, 0xf6, 0x7b, 0xc5, 0xae, 0xaf, 0x8a,
+    0xe6, 0x0c, 0x53, 0x0a, 0x14, 0x0c, 0x64, 0xbe, 0xff, 0x15, 0xd9, 0xa8, 0xa6, 0xda, 0x4e, 0x92,
+    0xd1, 0x3d, 0x41, 0x99, 0x56, 0x03, 0xb9, 0x55, 0x96, 0xa4, 0xcd, 0xa9, 0x4b, 0x04, 0xeb, 0xb6,
+    0x19, 0x87, 0xad, 0x62, 0x62, 0xd0, 0xeb, 0x61, 0xa2, 0x8c, 0x5f, 0x41, 0xae, 0x29, 0x88, 0x83,
+    0x5d, 0xc9, 0xa0, 0x87, 0xfe, 0xe9, 0xd3, 0x9f, 0x1d, 0x5b, 0xcb, 0x2d, 0x0d, 0x2a, 0x4b, 0xfc,
+    0x15, 0x5d, 0x2d, 0x84, 0xe9, 0xae, 0x20, 0xc5, 0x56, 0xc7, 0x75, 0x72, 0x9b, 0xe0, 0xcd, 0x39,
+    0xab, 0x87, 0xb8, 0xaa, 0xb1, 0x8a, 0x07, 0x66, 0xb6, 0x64, 0x85, 0x89, 0xaa, 0xb5, 0xfd, 0x3b,
+    0x34, 0x3a, 0x1f, 0x59, 0xbe, 0xe0, 0xe2, 0x76, 0x3b, 0x3d, 0x10, 0x22, 0xce, 0x69, 0x1c, 0xe3,
+    0xd1, 0xc3, 0x10, 0x09, 0x50, 0xeb, 0x83, 0x36, 0xc8, 0x1a, 0x04, 0xbd, 0xc1, 0x73, 0x19, 0x20,
+    0x12, 0x4e, 0x0c, 0xc3, 0x84, 0x86, 0xd8, 0xde, 0x1c, 0x64, 0x6d, 0x08, 0xd4, 0x19, 0xc4, 0x76,
+    0xa3, 0xcf, 0x8d, 0xb5, 0x0a, 0xbb, 0x99, 0x3b, 0xdc, 0x9e, 0x67, 0x85, 0x02, 0xae, 0xe1, 0xef,
+    0xb1, 0x8d, 0xbb, 0xd8, 0x6b, 0x55, 0x54, 0x1a, 0x93, 0x85, 0x77, 0x34, 0xa7, 0xda, 0x3d, 0x9f,
+    0xeb, 0x57, 0x33, 0xc7, 0x0c, 0xeb, 0xcc, 0xdb, 0x75, 0xf4, 0x11, 0x03, 0xfe, 0xa8, 0xff, 0x3d,
+    0xfc, 0x73, 0x1a, 0xcb, 0x8d, 0x67, 0x08, 0x66, 0xa6, 0xa9, 0x94, 0x73, 0xb4, 0xa6, 0xcf, 0x68,
+    0x2e, 0x9f, 0x48, 0x86, 0x64, 0x46, 0x01, 0xf4, 0x60, 0x75, 0xeb, 0x3a, 0xea, 0x68, 0x40, 0x47,
+    0xd7, 0x37, 0x4e, 0xcb, 0xb6, 0x26, 0xbb, 0xeb, 0xa8, 0x50, 0x60, 0x67, 0x57, 0xb7, 0x74, 0x55,
+    0xf0, 0x78, 0x6c, 0x79, 0xaa, 0x12, 0xd0, 0x02, 0x53, 0x4d, 0x58, 0x9d, 0xa7, 0x68, 0xff, 0xa0,
+    0xa6, 0x6a, 0x7f, 0x2a, 0xc7, 0x77, 0xf3, 0x0c, 0x7b, 0x4a, 0x7e, 0xab, 0xec, 0xd4, 0x6f, 0xec,
+    0x14, 0x6c, 0x59, 0xe7, 0x62, 0x86, 0x06, 0xd5, 0xbc, 0xc7, 0xbc, 0x46, 0x9e, 0xbf, 0xde, 0x31,
+    0x8f, 0x9c, 0x56, 0xaf, 0x52, 0xe1, 0xf5, 0x17, 0xd9, 0xb6, 0xf6, 0xaa, 0x49, 0xd4, 0xae, 0xfd,
+    0x58, 0x75, 0xf4, 0x65, 0x9f, 0x76, 0x3c, 0x53, 0xed, 0xe7, 0x7c, 0x0a, 0x05, 0xab, 0xdc, 0x68,
+    0xa5, 0xd5, 0xd5, 0x66, 0x72, 0x25, 0x09, 0x54, 0x38, 0x36, 0xf4, 0x70, 0x35, 0x48, 0xcc, 0x27,
+    0x5a, 0x6f, 0xde, 0xc2, 0xa3, 0xfb, 0xb5, 0xd6, 0x09, 0x57, 0x28, 0xda, 0x24, 0x99, 0xc7, 0x10,
+    0xcd, 0x07, 0xad, 0x6f, 0xb0, 0x55, 0x78, 0xd6, 0xbf, 0xb6, 0xa7, 0x5e, 0xc1, 0xac, 0xd2, 0xa2,
+    0xeb, 0x2f, 0xef, 0x75, 0x99, 0xfc, 0x69, 0xf2, 0x33, 0x88, 0x07, 0xde, 0x5d, 0x5c, 0xb3, 0xda,
+    0x46, 0x33, 0x99, 0x0f, 0xe8, 0x1b, 0x73, 0x31, 0x35, 0xb9, 0xb8, 0xfc, 0xa4, 0xb3, 0x93, 0x16,
+    0xb8, 0x15, 0x79, 0xa5, 0xcf, 0xed, 0x7e, 0x1d, 0x7a, 0xdf, 0xba, 0x37, 0x6d, 0x6c, 0x6a, 0x42,
+    0xbd, 0x0e, 0x6b, 0x33, 0xb7, 0xd7, 0x26, 0xfd, 0xd7, 0xd5, 0xc4, 0x17, 0x33, 0x6c, 0xa7, 0x5e,
+    0x56, 0x77, 0xd0, 0x7d, 0x6a, 0x66, 0x3c, 0x9d, 0xf3, 0xa1, 0x87, 0x9a, 0x2b, 0x0f, 0x05, 0xae,
+    0xef, 0x25, 0xa2, 0x85, 0xff, 0x81, 0x16, 0xec, 0x58, 0x48, 0x86, 0x6c, 0xbc, 0x74, 0x97, 0xc2,
+    0x9f, 0x1a, 0x4d, 0x03, 0xe6, 0x47, 0xf0, 0x66, 0x54, 0x0a, 0x43, 0x43, 0x52, 0x6b, 0xfb, 0xe2,
+    0xc1, 0x43, 0xa5, 0x18, 0x06, 0x4b, 0x83, 0x29, 0xf2, 0x88, 0x7b, 0xa5, 0xcf, 0x2e, 0x81, 0x05,
+    0x9b, 0xf1, 0x3b, 0x56, 0x00, 0x4b, 0x08, 0x94, 0x2f, 0x94, 0x01, 0xfc, 0xd6, 0x92, 0x2f, 0x2c,
+    0x6e, 0xe8, 0x51, 0xda, 0xaa, 0x34, 0xba, 0x50, 0x70, 0x16, 0x28, 0x7a, 0x2b, 0xe5, 0x76, 0x15,
+    0xd4, 0x8e, 0x3a, 0xcc, 0xd3, 0x5d, 0xc8, 0x0d, 0x67, 0x52, 0xe6, 0x0a, 0xc0, 0x7f, 0xca, 0x5e,
+    0xaa, 0x9e, 0x45, 0xde, 0x1e, 0xc0, 0x3f, 0x6d, 0x31, 0x5d, 0xc6, 0x37, 0xe4, 0xef, 0x7c, 0xae,
+    0xb2, 0x85, 0x84, 0x81, 0x83, 0x96, 0xf7, 0xce, 0xac, 0x7b, 0x69, 0x26, 0xdf, 0xf7, 0xaa, 0x5e,
+    0x68, 0x37, 0x2b, 0x94, 0x47, 0xce, 0x90, 0xae, 0xaf, 0x3a, 0xa8, 0x4d, 0xa7, 0x42, 0x9a, 0xe1,
+    0xa2, 0x07, 0x8a, 0x18, 0x02, 0xcf, 0xea, 0x0c, 0xad, 0xfa, 0xa4, 0xb5, 0xe7, 0x46, 0x1a, 0x8f,
+    0x64, 0xd7, 0xde, 0x8d, 0xb5, 0xe6, 0xfe, 0xb8, 0x61, 0x37, 0xe5, 0x6c, 0x51, 0x3d, 0x33, 0xda,
+    0xb0, 0x8b, 0xd5, 0x3b, 0x15, 0x6b, 0x5c, 0xba, 0xb9, 0x49, 0x21, 0x10, 0x42, 0xc9, 0x9b, 0x09,
+    0x0a, 0x14, 0x9f, 0xbc, 0x7f, 0x8f, 0xae, 0x17, 0x5d, 0x71, 0x46, 0xa2, 0xc4, 0x8f, 0xe7, 0x78,
+    0x43, 0x95, 0xfc, 0x35, 0x3a, 0x8f, 0xa0, 0xe2, 0x60, 0x01, 0xe8, 0x6f, 0x04, 0x79, 0x91, 0xdc,
+    0x71, 0x00, 0x9a, 0xd7, 0xe3, 0x41, 0x75, 0x99, 0x13, 0x28, 0xb7, 0x96, 0xb0, 0xa1, 0x60, 0x61,
+    0x71, 0xbc, 0x84, 0x40, 0x2a, 0xd8, 0x1b, 0x75, 0x2d, 0xbf, 0x7e, 0xc1, 0xe5, 0xd9, 0xe6, 0xb0,
+    0xa2, 0x99, 0xe9, 0x48, 0x5a, 0xbf, 0x2f, 0xba, 0x54, 0xd9, 0xf4, 0x75, 0x60, 0xf6, 0xc8, 0x6f,
+    0x16, 0x75, 0x74, 0x33, 0xc6, 0xd1, 0xb7, 0xfa, 0xf0, 0xac, 0xdf, 0x3a, 0xf6, 0xef, 0xaa, 0xb6,
+    0x9a, 0xfe, 0x6a, 0x8a, 0xa4, 0x12, 0x28, 0xd6, 0x8f, 0xb8, 0xfd, 0xfa, 0x51, 0x97, 0xcf, 0xea,
+    0x45, 0x9f, 0x90, 0x9b, 0x45, 0xf4, 0xbd, 0x2e, 0xfb, 0x42, 0x41, 0x7b, 0xa5, 0x16, 0x55, 0x83,
+    0xf6, 0x5a, 0xfa, 0x7e, 0x94, 0x7e, 0x34, 0x6b, 0x15, 0xf7, 0x99, 0xac, 0x4b, 0x1a, 0xb0, 0x56,
+    0x79, 0xdc, 0x38, 0x6a, 0xac, 0x5e, 0x7d, 0x19, 0xe1, 0x5f, 0xac, 0xe8, 0x6b, 0x35, 0x47, 0x5d,
+    0xfd, 0xb7, 0x2a, 0x5d, 0xf5, 0xa7, 0xbf, 0xff, 0x0f, 0x16, 0x89, 0x01, 0xa5, 0x0b, 0x3c, 0x00,
+    0x00,
+};
+
+#endif // RECOVERY_HTML_H
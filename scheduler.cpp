@@ -0,0 +1,140 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "scheduler.h"
+#include "web_server.h"
+
+Scheduler scheduler;
+
+TimerId Scheduler::add(TimerCallback callback) {
+    if (callback == nullptr) {
+        WEB_LOG("Scheduler", "No callback given");
+        return TIMER_INVALID;
+    }
+    if (_timerCount >= SCHEDULER_MAX_TIMERS) {
+        WEB_LOG("Scheduler", "Timer table full (SCHEDULER_MAX_TIMERS = %d)", SCHEDULER_MAX_TIMERS);
+        return TIMER_INVALID;
+    }
+
+    Timer& timer = _timers[_timerCount];
+    timer.callback = callback;
+    timer.deadline = 0;
+    timer.heapPos = -1;
+    return _timerCount++;
+}
+
+void Scheduler::arm(TimerId id, uint32_t delayMs) {
+    armAt(id, millis() + delayMs);
+}
+
+void Scheduler::armAt(TimerId id, uint32_t deadline) {
+    if (id < 0 || id >= _timerCount) return;
+
+    portENTER_CRITICAL(&_mux);
+    Timer& timer = _timers[id];
+    uint32_t previous = timer.deadline;
+    timer.deadline = deadline;
+
+    if (timer.heapPos < 0) {
+        timer.heapPos = _heapSize;
+        _heap[_heapSize++] = id;
+        siftUp(timer.heapPos);
+    } else if ((int32_t)(deadline - previous) < 0) {
+        siftUp(timer.heapPos);
+    } else {
+        siftDown(timer.heapPos);
+    }
+    portEXIT_CRITICAL(&_mux);
+}
+
+void Scheduler::disarm(TimerId id) {
+    if (id < 0 || id >= _timerCount) return;
+    portENTER_CRITICAL(&_mux);
+    if (_timers[id].heapPos >= 0) {
+        removeAt(_timers[id].heapPos);
+    }
+    portEXIT_CRITICAL(&_mux);
+}
+
+bool Scheduler::isArmed(TimerId id) const {
+    if (id < 0 || id >= _timerCount) return false;
+    return _timers[id].heapPos >= 0;
+}
+
+void Scheduler::run() {
+    uint32_t now = millis();
+
+    // Bounded: a callback that re-arms itself with delay 0 runs again next pass,
+    // not in an endless loop here
+    for (uint8_t budget = _heapSize; budget > 0; budget--) {
+        portENTER_CRITICAL(&_mux);
+        if (_heapSize == 0 || !isDue(now, _timers[_heap[0]].deadline)) {
+            portEXIT_CRITICAL(&_mux);
+            break;
+        }
+        uint8_t id = _heap[0];
+        removeAt(0);  // One-shot: callback re-arms if periodic
+        portEXIT_CRITICAL(&_mux);
+
+        _timers[id].callback();  // Outside the lock - callbacks re-arm
+    }
+}
+
+uint32_t Scheduler::msUntilNext() const {
+    portENTER_CRITICAL(&_mux);
+    bool empty = (_heapSize == 0);
+    uint32_t deadline = empty ? 0 : _timers[_heap[0]].deadline;
+    portEXIT_CRITICAL(&_mux);
+    if (empty) return UINT32_MAX;
+
+    int32_t remaining = (int32_t)(deadline - millis());
+    return remaining > 0 ? (uint32_t)remaining : 0;
+}
+
+void Scheduler::swap(uint8_t a, uint8_t b) {
+    uint8_t tmp = _heap[a];
+    _heap[a] = _heap[b];
+    _heap[b] = tmp;
+    _timers[_heap[a]].heapPos = a;
+    _timers[_heap[b]].heapPos = b;
+}
+
+void Scheduler::siftUp(uint8_t pos) {
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!earlier(pos, parent)) break;
+        swap(pos, parent);
+        pos = parent;
+    }
+}
+
+void Scheduler::siftDown(uint8_t pos) {
+    while (true) {
+        uint8_t left = pos * 2 + 1;
+        uint8_t right = left + 1;
+        uint8_t smallest = pos;
+        if (left < _heapSize && earlier(left, smallest)) smallest = left;
+        if (right < _heapSize && earlier(right, smallest)) smallest = right;
+        if (smallest == pos) break;
+        swap(pos, smallest);
+        pos = smallest;
+    }
+}
+
+void Scheduler::removeAt(uint8_t pos) {
+    uint8_t id = _heap[pos];
+    _timers[id].heapPos = -1;
+
+    _heapSize--;
+    if (pos == _heapSize) return;
+
+    // Move last element into the gap and restore heap order
+    _heap[pos] = _heap[_heapSize];
+    _timers[_heap[pos]].heapPos = pos;
+    siftUp(pos);
+    siftDown(_timers[_heap[pos]].heapPos);
+}
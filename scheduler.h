@@ -0,0 +1,76 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Scheduler - Central timer service for periodic subsystems
+// Modules register a callback once (in begin) and arm it with a delay; the main
+// loop only runs callbacks whose deadline has passed. Deadlines live in a
+// fixed-size min-heap, so run() is O(1) when nothing is due and re-arming is
+// O(log n). All comparisons are wrap-safe (millis() rolls over after ~49 days);
+// deadlines must be less than ~24 days ahead.
+//
+// arm/disarm may also be called from the async web handlers (AutoBlink and
+// AutoImpulse re-arm on settings changes); the heap is guarded by a critical
+// section. Callbacks always run on the main loop, outside the lock.
+
+typedef void (*TimerCallback)();
+typedef int8_t TimerId;
+
+#define TIMER_INVALID -1
+
+class Scheduler {
+public:
+    // Register a callback (starts disarmed). Returns TIMER_INVALID when full.
+    TimerId add(TimerCallback callback);
+
+    // (Re)arm to fire once, delayMs from now / at an absolute millis() deadline
+    void arm(TimerId id, uint32_t delayMs);
+    void armAt(TimerId id, uint32_t deadline);
+    void disarm(TimerId id);
+    bool isArmed(TimerId id) const;
+
+    // Run callbacks that are due (call from main loop)
+    void run();
+
+    // Time until the earliest armed deadline (0 if due, UINT32_MAX if none)
+    uint32_t msUntilNext() const;
+
+    // Wrap-safe deadline check for modules that keep their own timestamps
+    static bool isDue(uint32_t now, uint32_t deadline) {
+        return (int32_t)(now - deadline) >= 0;
+    }
+
+private:
+    struct Timer {
+        TimerCallback callback;
+        uint32_t deadline;
+        int8_t heapPos;         // Index in _heap, -1 = disarmed
+    };
+
+    Timer _timers[SCHEDULER_MAX_TIMERS];
+    uint8_t _timerCount = 0;
+    uint8_t _heap[SCHEDULER_MAX_TIMERS];  // Timer IDs ordered by deadline
+    uint8_t _heapSize = 0;
+    mutable portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+    bool earlier(uint8_t a, uint8_t b) const {
+        return (int32_t)(_timers[_heap[a]].deadline - _timers[_heap[b]].deadline) < 0;
+    }
+    void swap(uint8_t a, uint8_t b);
+    void siftUp(uint8_t pos);
+    void siftDown(uint8_t pos);
+    void removeAt(uint8_t pos);
+};
+
+extern Scheduler scheduler;
+
+#endif // SCHEDULER_H
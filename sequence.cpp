@@ -0,0 +1,136 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "sequence.h"
+#include "clip_player.h"
+#include "web_server.h"
+#include <LittleFS.h>
+
+#define IMPULSE_CALL_PREFIX "impulse:"
+#define IMPULSE_CALL_PREFIX_LEN 8
+
+uint32_t msUntilNextTrackStep(const SequenceTrack (&tracks)[SEQUENCE_MAX_TRACKS]) {
+    uint32_t next = UINT32_MAX;
+    unsigned long now = millis();
+    for (const SequenceTrack& track : tracks) {
+        if (!track.active || track.wait == TrackWait::JOIN) continue;
+        if (track.wait == TrackWait::CLIP) {
+            if (!clipPlayer.isPlaying()) return 0;
+            continue;  // Frame deadlines come from the clip player
+        }
+        if (track.wait != TrackWait::TIME) return 0;  // Executing steps or waiting for an animation
+
+        int32_t remaining = (int32_t)(track.timelineMs - now);
+        if (remaining <= 0) return 0;
+        if ((uint32_t)remaining < next) next = remaining;
+    }
+    return next;
+}
+
+// Compile-time validation
+
+struct CompileContext {
+    JsonDocument& doc;
+    JsonObject sequences;
+    const char* source;
+};
+
+static bool compileSteps(CompileContext& ctx, JsonArray steps, uint8_t depth, bool inTrack);
+
+static bool compileError(CompileContext& ctx, const char* message, const char* detail = "") {
+    WEB_LOG("Sequence", "%s: %s%s%s", ctx.source, message, detail[0] ? " " : "", detail);
+    return false;
+}
+
+// Copy /impulses/<name>.json's sequence into the document as sequences["impulse:<name>"]
+static bool inlineImpulse(CompileContext& ctx, const char* callName) {
+    char path[64];
+    snprintf(path, sizeof(path), "/impulses/%s.json", callName + IMPULSE_CALL_PREFIX_LEN);
+
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return compileError(ctx, "called impulse not found:", path);
+    }
+    JsonDocument impulse;
+    DeserializationError error = deserializeJson(impulse, file);
+    file.close();
+    if (error) {
+        return compileError(ctx, "called impulse parse error:", error.c_str());
+    }
+
+    if (ctx.sequences.isNull()) {
+        ctx.sequences = ctx.doc["sequences"].to<JsonObject>();
+    }
+    // Only the steps are copied; the impulse's own named sequences are not visible
+    ctx.sequences[String(callName)] = impulse["sequence"];
+    return true;
+}
+
+static bool compileBlock(CompileContext& ctx, JsonObject step, uint8_t depth, bool inTrack) {
+    if (step.containsKey("repeat")) {
+        return compileSteps(ctx, step["repeat"]["steps"].as<JsonArray>(), depth + 1, inTrack);
+    }
+    if (step.containsKey("call")) {
+        const char* name = step["call"] | "";
+        if (ctx.sequences[name].isNull() &&
+            strncmp(name, IMPULSE_CALL_PREFIX, IMPULSE_CALL_PREFIX_LEN) == 0 &&
+            !inlineImpulse(ctx, name)) {
+            return false;
+        }
+        if (ctx.sequences[name].isNull()) {
+            return compileError(ctx, "unknown call", name);
+        }
+        return compileSteps(ctx, ctx.sequences[name].as<JsonArray>(), depth + 1, inTrack);
+    }
+    if (step.containsKey("choose")) {
+        JsonArray branches = step["choose"].as<JsonArray>();
+        if (branches.size() == 0) {
+            return compileError(ctx, "empty choose");
+        }
+        for (JsonObject branch : branches) {
+            if ((branch["weight"] | 1) <= 0) {
+                return compileError(ctx, "choose weight must be positive");
+            }
+            if (!compileSteps(ctx, branch["steps"].as<JsonArray>(), depth + 1, inTrack)) return false;
+        }
+        return true;
+    }
+    if (step.containsKey("parallel")) {
+        if (inTrack) {
+            return compileError(ctx, "parallel inside a parallel track");
+        }
+        JsonArray tracks = step["parallel"].as<JsonArray>();
+        if (tracks.size() == 0 || tracks.size() > SEQUENCE_MAX_TRACKS - 1) {
+            char limit[8];
+            snprintf(limit, sizeof(limit), "%d", SEQUENCE_MAX_TRACKS - 1);
+            return compileError(ctx, "parallel track count must be 1 to", limit);
+        }
+        for (JsonArray track : tracks) {
+            if (!compileSteps(ctx, track, 1, true)) return false;  // Own cursor per track
+        }
+        return true;
+    }
+    return true;  // Primitive
+}
+
+static bool compileSteps(CompileContext& ctx, JsonArray steps, uint8_t depth, bool inTrack) {
+    if (depth > SEQUENCE_MAX_DEPTH) {
+        return compileError(ctx, "blocks nested too deep (recursive call?)");
+    }
+    if (steps.size() == 0) {
+        return compileError(ctx, "missing or empty steps");
+    }
+    for (JsonObject step : steps) {
+        if (!compileBlock(ctx, step, depth, inTrack)) return false;
+    }
+    return true;
+}
+
+bool compileSequence(JsonDocument& doc, const char* source) {
+    CompileContext ctx = {doc, doc["sequences"].as<JsonObject>(), source};
+    return compileSteps(ctx, doc["sequence"].as<JsonArray>(), 1, false);
+}
@@ -0,0 +1,89 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "prng.h"
+
+// Sequence - Control flow shared by ModePlayer and ImpulsePlayer
+// Besides the primitives (gaze, lids, blink, wait, move) a sequence can hold blocks:
+//   {"repeat": {"count": 3, "steps": [...]}}            count may be {"random": [min, max]}
+//   {"call": "glance"}                                   named sub-sequence from "sequences"
+//   {"call": "impulse:startle"}                          sequence of an impulse file
+//   {"choose": [{"weight": 3, "steps": [...]}, ...]}     one weighted branch per pass
+//   {"parallel": [[...gaze track...], [...lid track...]]}
+//
+// Blocks are walked in place by a cursor with a small frame stack - nothing is
+// unrolled, so memory grows with unique content rather than with played length.
+// The cursor and value resolution live in sequence_cursor.cpp (host-buildable).
+// compileSequence() validates a document once at load time (targets exist,
+// nesting fits the stack, no recursion) and copies called impulse files into
+// the document's "sequences" object.
+
+// What a track is blocked on before its next step
+enum class TrackWait : uint8_t {
+    NONE,
+    TIME,        // Until timelineMs
+    BLINK,       // Until the blink animation ends
+    TRANSITION,  // Until the move / mode-switch transition of moveChannels ends
+    CLIP,        // Until the baked clip ends
+    JOIN         // Main track: until all parallel tracks are done
+};
+
+class SequenceCursor {
+public:
+    void begin(JsonArray steps, int skip = 0);  // skip: leading steps already applied
+    void clear() { _depth = 0; }
+    bool isDone() const { return _depth == 0; }
+
+    // Next primitive or "parallel" step, entering repeat/call/choose blocks on the
+    // way. Null once the outermost array is exhausted.
+    JsonObject next(JsonObject sequences, Prng& rng);
+
+private:
+    struct Frame {
+        JsonArray steps;
+        JsonArrayIterator it;
+        uint16_t repeatsLeft;
+    };
+    Frame _stack[SEQUENCE_MAX_DEPTH];
+    uint8_t _depth = 0;
+
+    void push(JsonArray steps, uint16_t repeatsLeft);
+};
+
+struct SequenceTrack {
+    SequenceCursor cursor;
+    Prng rng;                      // Random values of this track's steps
+    bool active = false;
+    TrackWait wait = TrackWait::NONE;
+    unsigned long timelineMs = 0;  // Scheduled time of the current step (see ModePlayer)
+    uint8_t moveChannels = 0;      // EyeController channels of the move being waited on
+};
+
+// Start a parallel track at the parent's place on the timeline. It draws from its
+// own generator (seeded from the parent's), so the order in which the loop
+// reaches due tracks never changes what either of them draws.
+void startParallelTrack(SequenceTrack& track, SequenceTrack& parent, JsonArray steps, uint32_t stream);
+
+// Step values: plain number or {"random": [min, max]} (uniform / inclusive range).
+// Shared by both players and the repeat count, so every draw goes through rng.
+float resolveValue(Prng& rng, JsonVariant val, float defaultVal = 0);
+int resolveIntValue(Prng& rng, JsonVariant val, int defaultVal = 0);
+
+// Time until the earliest track needs the loop (0 = now, UINT32_MAX = all idle)
+uint32_t msUntilNextTrackStep(const SequenceTrack (&tracks)[SEQUENCE_MAX_TRACKS]);
+
+// Validate a mode/impulse document and inline called impulse files.
+// Logs the first problem found (source = file name for the message).
+bool compileSequence(JsonDocument& doc, const char* source);
+
+#endif // SEQUENCE_H
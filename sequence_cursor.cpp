@@ -0,0 +1,142 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+// Every random draw of sequence playback: block cursor and value resolution.
+// Plain C++ and ArduinoJson only (no millis(), LittleFS or random()), so the
+// host check (make seed-trace) links this file and replays step traces with it.
+
+#include "sequence.h"
+
+float resolveValue(Prng& rng, JsonVariant val, float defaultVal) {
+    if (val.isNull()) {
+        return defaultVal;
+    }
+
+    // Direct numeric value
+    if (val.is<float>() || val.is<int>()) {
+        return val.as<float>();
+    }
+
+    // Random range: {"random": [min, max]}
+    if (val.is<JsonObject>()) {
+        JsonObject obj = val.as<JsonObject>();
+        if (obj.containsKey("random")) {
+            JsonArray range = obj["random"].as<JsonArray>();
+            if (range.size() >= 2) {
+                float minVal = range[0].as<float>();
+                float maxVal = range[1].as<float>();
+                return rng.uniform(minVal, maxVal);
+            }
+        }
+    }
+
+    return defaultVal;
+}
+
+int resolveIntValue(Prng& rng, JsonVariant val, int defaultVal) {
+    if (val.isNull()) {
+        return defaultVal;
+    }
+
+    // Direct numeric value
+    if (val.is<int>()) {
+        return val.as<int>();
+    }
+
+    // Random range: {"random": [min, max]}
+    if (val.is<JsonObject>()) {
+        JsonObject obj = val.as<JsonObject>();
+        if (obj.containsKey("random")) {
+            JsonArray range = obj["random"].as<JsonArray>();
+            if (range.size() >= 2) {
+                int minVal = range[0].as<int>();
+                int maxVal = range[1].as<int>();
+                return rng.range(minVal, maxVal);
+            }
+        }
+    }
+
+    return defaultVal;
+}
+
+void SequenceCursor::begin(JsonArray steps, int skip) {
+    _depth = 0;
+    push(steps, 0);
+    Frame& frame = _stack[0];
+    for (int i = 0; i < skip && frame.it != frame.steps.end(); i++) {
+        ++frame.it;
+    }
+}
+
+void SequenceCursor::push(JsonArray steps, uint16_t repeatsLeft) {
+    if (_depth >= SEQUENCE_MAX_DEPTH || steps.isNull()) return;  // Rejected by compileSequence()
+    Frame& frame = _stack[_depth++];
+    frame.steps = steps;
+    frame.it = steps.begin();
+    frame.repeatsLeft = repeatsLeft;
+}
+
+JsonObject SequenceCursor::next(JsonObject sequences, Prng& rng) {
+    // Each pass pops, restarts a repeat, pushes or returns. Arrays are non-empty
+    // (checked at compile time), so every pass advances an iterator, uses up a
+    // repeat or pops a frame - this ends even after many zero-count repeats in a row.
+    while (_depth > 0) {
+        Frame& frame = _stack[_depth - 1];
+        if (frame.it == frame.steps.end()) {
+            if (frame.repeatsLeft > 0) {
+                frame.repeatsLeft--;
+                frame.it = frame.steps.begin();
+            } else {
+                _depth--;
+            }
+            continue;
+        }
+
+        JsonObject step = (*frame.it).as<JsonObject>();
+        ++frame.it;
+
+        if (step.containsKey("repeat")) {
+            JsonObject block = step["repeat"].as<JsonObject>();
+            int count = constrain(resolveIntValue(rng, block["count"], 1), 0, 65535);
+            if (count > 0) {
+                push(block["steps"].as<JsonArray>(), count - 1);
+            }
+        }
+        else if (step.containsKey("call")) {
+            push(sequences[step["call"].as<const char*>()].as<JsonArray>(), 0);
+        }
+        else if (step.containsKey("choose")) {
+            JsonArray branches = step["choose"].as<JsonArray>();
+            uint32_t total = 0;
+            for (JsonObject branch : branches) {
+                total += branch["weight"] | 1u;
+            }
+            uint32_t pick = rng.below(total);
+            for (JsonObject branch : branches) {
+                uint32_t weight = branch["weight"] | 1u;
+                if (pick < weight) {
+                    push(branch["steps"].as<JsonArray>(), 0);
+                    break;
+                }
+                pick -= weight;
+            }
+        }
+        else {
+            return step;  // Primitive or parallel block
+        }
+    }
+
+    return JsonObject();  // Outermost array exhausted
+}
+
+void startParallelTrack(SequenceTrack& track, SequenceTrack& parent, JsonArray steps, uint32_t stream) {
+    track.cursor.begin(steps);
+    track.rng.seed(parent.rng.next(), stream);
+    track.active = true;
+    track.wait = TrackWait::NONE;
+    track.timelineMs = parent.timelineMs;
+}
@@ -7,6 +7,8 @@
 
 #include "servo_controller.h"
 #include "web_server.h"
+#include "latency_trace.h"
+#include "power_manager.h"
 #include <ESP32Servo.h>
 
 ServoController servoController;
@@ -51,7 +53,7 @@ void ServoController::loop() {
         _centerAllRequested = false;
         // Set all targets to center - don't call centerAll() to avoid any issues
         for (uint8_t i = 0; i < NUM_SERVOS; i++) {
-            _targetPositions[i] = _configs[i].center;
+            setTarget(i, _configs[i].center, 0);
         }
     }
 
@@ -85,10 +87,8 @@ void ServoController::loop() {
 
             if (s1Pending || s2Pending) {
                 // Write both servos of the pair together
-                _positions[s1] = _targetPositions[s1];
-                _positions[s2] = _targetPositions[s2];
-                servos[s1].write(applyInvert(s1, _positions[s1]));
-                servos[s2].write(applyInvert(s2, _positions[s2]));
+                writeServo(s1);
+                writeServo(s2);
                 wroteAnything = true;
                 break;  // Only one pair per tick to avoid watchdog
             }
@@ -100,19 +100,39 @@ void ServoController::loop() {
     }
 }
 
-void ServoController::setPosition(uint8_t index, uint8_t position) {
+void ServoController::setPosition(uint8_t index, uint8_t position, uint32_t originUs) {
     if (index >= NUM_SERVOS) return;
 
     uint8_t constrained = constrainToCalibration(index, position);
-    _targetPositions[index] = constrained;
+    setTarget(index, constrained, originUs);
 }
 
-void ServoController::setPositionRaw(uint8_t index, uint8_t position) {
+void ServoController::setPositionRaw(uint8_t index, uint8_t position, uint32_t originUs) {
     if (index >= NUM_SERVOS) return;
 
     // Constrain to servo physical limits only, not calibration
     uint8_t constrained = constrain(position, 0, 180);
-    _targetPositions[index] = constrained;
+    setTarget(index, constrained, originUs);
+}
+
+void ServoController::setTarget(uint8_t index, uint8_t position, uint32_t originUs) {
+    if (position == _positions[index]) {
+        _targetOrigins[index] = 0;  // Nothing left to write
+    } else if (_targetOrigins[index] == 0) {
+        // Keep the oldest pending origin - latency counts from the first unwritten change
+        _targetOrigins[index] = originUs ? originUs : micros();
+    }
+    _targetPositions[index] = position;
+}
+
+void ServoController::writeServo(uint8_t index) {
+    _positions[index] = _targetPositions[index];
+    servos[index].write(applyInvert(index, _positions[index]));
+
+    if (_targetOrigins[index] != 0) {
+        latencyTrace.recordServoWrite(index, _positions[index], _targetOrigins[index], micros());
+        _targetOrigins[index] = 0;
+    }
 }
 
 uint8_t ServoController::getPosition(uint8_t index) {
@@ -122,6 +142,15 @@ uint8_t ServoController::getPosition(uint8_t index) {
 
 void ServoController::requestCenterAll() {
     _centerAllRequested = true;
+    powerManager.wake();
+}
+
+bool ServoController::hasPendingWrites() const {
+    if (_centerAllRequested) return true;
+    for (uint8_t i = 0; i < NUM_SERVOS; i++) {
+        if (_positions[i] != _targetPositions[i]) return true;
+    }
+    return false;
 }
 
 void ServoController::centerAll() {
@@ -171,6 +200,7 @@ void ServoController::setInvert(uint8_t index, bool invert) {
     uint8_t centerPos = _configs[index].center;
     _positions[index] = centerPos;
     _targetPositions[index] = centerPos;
+    _targetOrigins[index] = 0;
     uint8_t actualPos = applyInvert(index, centerPos);
     servos[index].write(actualPos);
 }
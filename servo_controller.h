@@ -18,14 +18,18 @@ public:
     void loop();
 
     // Position control (0-180, will be constrained to calibration limits)
-    void setPosition(uint8_t index, uint8_t position);
-    void setPositionRaw(uint8_t index, uint8_t position);  // Bypasses calibration limits (for calibration preview)
+    // originUs: micros() when the change was requested (0 = now), for latency tracing
+    void setPosition(uint8_t index, uint8_t position, uint32_t originUs = 0);
+    void setPositionRaw(uint8_t index, uint8_t position, uint32_t originUs = 0);  // Bypasses calibration limits (for calibration preview)
     uint8_t getPosition(uint8_t index);
 
     // Move to center position
     void requestCenterAll();  // Safe to call from async context (deferred to loop)
     void center(uint8_t index);
 
+    // Any target not yet written (loop must keep running)
+    bool hasPendingWrites() const;
+
     // Configuration
     const ServoConfig& getConfig(uint8_t index);
     void setPin(uint8_t index, uint8_t pin);
@@ -39,9 +43,12 @@ private:
     ServoConfig _configs[NUM_SERVOS];
     uint8_t _positions[NUM_SERVOS];
     uint8_t _targetPositions[NUM_SERVOS];
+    uint32_t _targetOrigins[NUM_SERVOS] = {};  // Origin of oldest unwritten change (0 = none)
     volatile bool _centerAllRequested = false;
 
     void centerAll();  // Private - executed in loop()
+    void setTarget(uint8_t index, uint8_t position, uint32_t originUs);
+    void writeServo(uint8_t index);
     uint8_t constrainToCalibration(uint8_t index, uint8_t position);
     uint8_t applyInvert(uint8_t index, uint8_t position);
 };
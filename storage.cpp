@@ -298,6 +298,7 @@ ModeConfig Storage::getModeConfig() {
     config.blinkIntervalMax = prefs.getUShort("mode_blkmax", DEFAULT_BLINK_INTERVAL_MAX);
     config.rememberLastMode = prefs.getBool("mode_remember", false);
     config.mirrorPreview = prefs.getBool("mode_mirror", DEFAULT_MIRROR_PREVIEW);
+    config.transitionMs = prefs.getUShort("mode_trans", DEFAULT_MODE_TRANSITION_MS);
     return config;
 }
 
@@ -308,6 +309,7 @@ void Storage::setModeConfig(const ModeConfig& config) {
     prefs.putUShort("mode_blkmax", config.blinkIntervalMax);
     prefs.putBool("mode_remember", config.rememberLastMode);
     prefs.putBool("mode_mirror", config.mirrorPreview);
+    prefs.putUShort("mode_trans", config.transitionMs);
 }
 
 // Impulse config
@@ -56,6 +56,7 @@ struct ModeConfig {
     uint16_t blinkIntervalMax; // Maximum ms between auto-blinks
     bool rememberLastMode;    // If true, restore last active mode on boot
     bool mirrorPreview;       // Mirror eye preview horizontally (swap left/right perspective)
+    uint16_t transitionMs;    // Crossfade time into the next mode's first pose (0 = snap)
 };
 
 // Maximum number of impulses that can be selected for auto-impulse
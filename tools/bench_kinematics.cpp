@@ -0,0 +1,121 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ *
+ * Host check and benchmark: Q15 vs. float eye kinematics (eye_kinematics.h)
+ * Sweeps gaze x/y/z, coupling, max vergence and lid positions over several
+ * calibrations and compares the servo angles of both paths after the
+ * calibration clamp ServoController applies. Fails if any angle differs by
+ * more than EYE_KINEMATICS_TOLERANCE degrees. Then times one full gaze + lids
+ * transform per path.
+ *
+ *   make bench-kinematics
+ */
+
+#include "eye_kinematics.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+
+#define EYE_KINEMATICS_TOLERANCE 1
+
+struct Calibration {
+    uint8_t min;
+    uint8_t center;
+    uint8_t max;
+};
+
+// Wide, narrow, off-center and degenerate ranges
+static const Calibration CALIBRATIONS[] = {
+    {60, 90, 120}, {0, 90, 180}, {89, 90, 91}, {10, 100, 170}, {45, 47, 150},
+};
+
+static uint8_t clampToCalibration(uint8_t position, const Calibration& cal) {
+    return position < cal.min ? cal.min : (position > cal.max ? cal.max : position);
+}
+
+// Six servo angles (left X/Y/lid, right X/Y/lid, as in config.h)
+static void servosQ15(const EyeGazeInput& in, float lidLeft, float lidRight, const Calibration& cal, uint8_t out[6]) {
+    int32_t eyes[EYE_GAZE_TARGETS];
+    eyeGazeQ15(in, eyes);
+    const int32_t logical[6] = {eyes[EYE_LEFT_X], eyes[EYE_LEFT_Y], eyeToQ15(lidLeft, 100.0f),
+                                eyes[EYE_RIGHT_X], eyes[EYE_RIGHT_Y], eyeToQ15(lidRight, 100.0f)};
+    for (int i = 0; i < 6; i++) {
+        out[i] = clampToCalibration(eyeServoFromQ15(logical[i], cal.min, cal.center, cal.max), cal);
+    }
+}
+
+static void servosFloat(const EyeGazeInput& in, float lidLeft, float lidRight, const Calibration& cal, uint8_t out[6]) {
+    float eyes[EYE_GAZE_TARGETS];
+    eyeGazeFloat(in, eyes);
+    const float logical[6] = {eyes[EYE_LEFT_X], eyes[EYE_LEFT_Y], lidLeft,
+                              eyes[EYE_RIGHT_X], eyes[EYE_RIGHT_Y], lidRight};
+    for (int i = 0; i < 6; i++) {
+        out[i] = clampToCalibration(eyeServoFromLogical(logical[i], cal.min, cal.center, cal.max), cal);
+    }
+}
+
+template <typename Transform>
+static double nsPerTransform(Transform transform, int iterations) {
+    const Calibration& cal = CALIBRATIONS[0];
+    volatile uint8_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        float x = (float)(i % 201) - 100.0f;
+        EyeGazeInput in = {x, -x, x * 0.5f, 0.5f, 50.0f, 50.0f, 0, 0};
+        uint8_t out[6];
+        transform(in, x, -x, cal, out);
+        sink = sink + out[0];
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+int main() {
+    long compared = 0;
+    long differing = 0;
+    int worst = 0;
+
+    for (const Calibration& cal : CALIBRATIONS) {
+        for (float vergence : {0.0f, 30.0f, 50.0f, 100.0f}) {
+            for (float coupling = -1.0f; coupling <= 1.001f; coupling += 0.125f) {
+                for (float x = -100.0f; x <= 100.0f; x += 2.5f) {
+                    for (float y = -100.0f; y <= 100.0f; y += 5.0f) {
+                        for (float z = -100.0f; z <= 100.0f; z += 10.0f) {
+                            EyeGazeInput in = {x, y, z, coupling, vergence, 50.0f, 0, 0};
+                            uint8_t fixed[6], reference[6];
+                            servosQ15(in, x, -y, cal, fixed);
+                            servosFloat(in, x, -y, cal, reference);
+                            for (int i = 0; i < 6; i++) {
+                                int delta = abs((int)fixed[i] - (int)reference[i]);
+                                compared++;
+                                if (delta == 0) continue;
+                                differing++;
+                                if (delta > worst) {
+                                    worst = delta;
+                                    if (delta > EYE_KINEMATICS_TOLERANCE) {
+                                        printf("servo %d off by %d: x=%.1f y=%.1f z=%.1f coupling=%.3f vergence=%.0f cal=%u/%u/%u\n",
+                                               i, delta, x, y, z, coupling, vergence, cal.min, cal.center, cal.max);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    printf("compared %ld servo angles: %.2f%% bit-exact, max |delta| %d deg (tolerance %d)\n",
+           compared, 100.0 * (compared - differing) / compared, worst, EYE_KINEMATICS_TOLERANCE);
+
+    const int iterations = 2000000;
+    printf("\n%-8s %10s\n", "path", "ns/update");
+    printf("%-8s %10.1f\n", "q15", nsPerTransform(servosQ15, iterations));
+    printf("%-8s %10.1f\n", "float", nsPerTransform(servosFloat, iterations));
+
+    return worst > EYE_KINEMATICS_TOLERANCE ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ *
+ * Host benchmark: WebSocket command lookup (ws_commands.h)
+ * Compares the perfect-hash index against the former strcmp chain (a linear
+ * scan in list order) for every command plus an unknown name.
+ *
+ *   make bench-dispatch
+ */
+
+#include "ws_commands.h"
+#include <chrono>
+#include <cstdio>
+
+static int linearLookup(const char* name) {
+    for (size_t i = 0; i < WS_COMMAND_COUNT; i++) {
+        if (strcmp(WS_COMMAND_INFOS[i].name, name) == 0) return (int)i;
+    }
+    return -1;
+}
+
+template <typename Lookup>
+static double nsPerLookup(Lookup lookup, const char* name, int iterations) {
+    volatile int sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        sink = sink + lookup(name);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+int main() {
+    const int iterations = 200000;
+    double hashTotal = 0;
+    double linearTotal = 0;
+    double hashWorst = 0;
+    double linearWorst = 0;
+    int failures = 0;
+
+    printf("%u commands, %u slots, seed %u\n\n",
+           (unsigned)WS_COMMAND_COUNT, (unsigned)WS_COMMAND_SLOTS, (unsigned)WS_COMMAND_INDEX.seed);
+    printf("%-26s %10s %10s\n", "command", "hash ns", "chain ns");
+
+    for (size_t i = 0; i <= WS_COMMAND_COUNT; i++) {
+        const char* name = i < WS_COMMAND_COUNT ? WS_COMMAND_INFOS[i].name : "unknownCommand";
+        int expected = i < WS_COMMAND_COUNT ? (int)i : -1;
+        if (findWsCommand(name) != expected || linearLookup(name) != expected) {
+            printf("MISMATCH: %s\n", name);
+            failures++;
+        }
+
+        double hashNs = nsPerLookup(findWsCommand, name, iterations);
+        double linearNs = nsPerLookup(linearLookup, name, iterations);
+        printf("%-26s %10.1f %10.1f\n", name, hashNs, linearNs);
+
+        hashTotal += hashNs;
+        linearTotal += linearNs;
+        if (hashNs > hashWorst) hashWorst = hashNs;
+        if (linearNs > linearWorst) linearWorst = linearNs;
+    }
+
+    size_t lookups = WS_COMMAND_COUNT + 1;
+    printf("\n%-26s %10.1f %10.1f\n", "mean", hashTotal / lookups, linearTotal / lookups);
+    printf("%-26s %10.1f %10.1f\n", "worst", hashWorst, linearWorst);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ *
+ * Host benchmark: heap churn of the state channel fan-out (ws_buffer_pool.h)
+ * Replays 10 s of channel traffic (motion at 50 Hz, modeState at 5 Hz,
+ * systemState at 1 Hz) to 1 and 8 clients and counts heap allocations:
+ *   copy - client->text(json, len) per client: the library copies the payload
+ *          into a new shared buffer for every client
+ *   pool - serialize once into a pooled buffer, queue a reference per client
+ * Only payload buffers are counted; the library's per-message queue entry is
+ * the same in both paths.
+ *
+ *   make bench-fanout
+ */
+
+#include "ws_buffer_pool.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+static size_t allocCount = 0;
+static size_t allocBytes = 0;
+
+void* operator new(size_t size) {
+    allocCount++;
+    allocBytes += size;
+    void* p = malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// Typical serialized sizes with 6 servos (see WebServer::build*State)
+static const size_t MOTION_BYTES = 190;
+static const size_t MODE_BYTES = 780;
+static const size_t SYSTEM_BYTES = 1400;
+
+static const int TICKS = 500;          // 10 s at 50 Hz
+static const int MAX_CLIENTS = 8;
+static const int QUEUE_DEPTH = 4;      // WS_CLIENT_QUEUE_LIMIT
+
+struct Client {
+    WsSharedBuffer queue[QUEUE_DEPTH * 3];
+    int count = 0;
+};
+
+static char payload[SYSTEM_BYTES];
+
+static WsSharedBuffer copyBuffer(size_t len) {
+    return std::make_shared<std::vector<uint8_t>>((uint8_t*)payload, (uint8_t*)payload + len);
+}
+
+static WsSharedBuffer pooledBuffer(WsBufferPool& pool, size_t len) {
+    WsSharedBuffer buffer = pool.acquire(len + 1);
+    memcpy(buffer->data(), payload, len);
+    buffer->resize(len);
+    return buffer;
+}
+
+static void run(const char* name, int clients, bool pooled) {
+    static Client queues[MAX_CLIENTS];
+    WsBufferPool pool;
+    size_t countBefore = allocCount;
+    size_t bytesBefore = allocBytes;
+
+    for (int tick = 0; tick < TICKS; tick++) {
+        size_t sizes[3];
+        int messages = 0;
+        sizes[messages++] = MOTION_BYTES;
+        if (tick % 10 == 0) sizes[messages++] = MODE_BYTES;
+        if (tick % 50 == 0) sizes[messages++] = SYSTEM_BYTES;
+
+        for (int m = 0; m < messages; m++) {
+            WsSharedBuffer shared = pooled ? pooledBuffer(pool, sizes[m]) : nullptr;
+            for (int c = 0; c < clients; c++) {
+                queues[c].queue[queues[c].count++] = pooled ? shared : copyBuffer(sizes[m]);
+            }
+        }
+
+        // Clients drain their queues between ticks (odd clients one tick late)
+        for (int c = 0; c < clients; c++) {
+            if (c % 2 == 1 && tick % 2 == 0) continue;
+            for (int i = 0; i < queues[c].count; i++) queues[c].queue[i].reset();
+            queues[c].count = 0;
+        }
+    }
+    for (int c = 0; c < clients; c++) {
+        for (int i = 0; i < queues[c].count; i++) queues[c].queue[i].reset();
+        queues[c].count = 0;
+    }
+
+    size_t count = allocCount - countBefore;
+    size_t bytes = allocBytes - bytesBefore;
+    printf("%-6s %7d %12zu %12zu %11.1f %12.0f",
+           name, clients, count, bytes, (double)count / TICKS, (double)bytes / TICKS);
+    if (pooled) {
+        printf("   hits %u, grows %u, misses %u", (unsigned)pool.getHits(),
+               (unsigned)pool.getGrows(), (unsigned)pool.getMisses());
+    }
+    printf("\n");
+}
+
+int main() {
+    memset(payload, 'x', sizeof(payload));
+    printf("%d ticks (10 s), %d pool slots\n\n", TICKS, WS_BUFFER_POOL_SLOTS);
+    printf("%-6s %7s %12s %12s %11s %12s\n", "path", "clients", "allocs", "bytes", "allocs/tick", "bytes/tick");
+    run("copy", 1, false);
+    run("pool", 1, true);
+    run("copy", 8, false);
+    run("pool", 8, true);
+    return 0;
+}
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+#
+# Animatronic Eyes
+# Copyright (c) 2025 Zappo-II
+# Licensed under CC BY-NC-SA 4.0
+# https://github.com/Zappo-II/animatronic-eyes
+#
+# Bake and inspect clips (/clips/*.clip, format described in clip_player.h)
+#
+#   clip_tool.py bake keyframes.csv out.clip [--rate 50]
+#   clip_tool.py dump in.clip [out.csv]
+#   clip_tool.py info in.clip
+#
+# Keyframe CSV: header "time_ms,gazeX,gazeY,gazeZ,coupling,lidLeft,lidRight",
+# one row per keyframe. Empty cells mean "no keyframe for this channel here":
+# every channel is interpolated linearly between its own keyframes and holds
+# its first/last value outside of them (neutral pose if it has none).
+# A dumped clip is a valid keyframe file (one keyframe per frame), so recorded
+# clips can be edited and re-baked.
+
+import argparse
+import csv
+import struct
+import sys
+
+MAGIC = b"AECL"
+VERSION = 1
+CHANNELS = ["gazeX", "gazeY", "gazeZ", "coupling", "lidLeft", "lidRight"]
+SCALE = [100, 100, 100, 10000, 100, 100]        # Integer units per logical unit
+LIMIT = [100, 100, 100, 1, 100, 100]            # Logical range (+/-)
+NEUTRAL = [0, 0, 0, 1, 0, 0]
+MAX_RATE_HZ = 100                               # CLIP_MAX_RATE_HZ
+
+
+def write_varint(out, value):
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError("truncated frame data")
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+
+def encode(frames, rate):
+    out = bytearray(MAGIC)
+    out += struct.pack("<BBHII", VERSION, len(CHANNELS), rate, len(frames), 0)
+    prev = [0] * len(CHANNELS)
+    for frame in frames:
+        for i, value in enumerate(frame):
+            q = int(round(max(-LIMIT[i], min(LIMIT[i], value)) * SCALE[i]))
+            delta = q - prev[i]
+            write_varint(out, delta << 1 if delta >= 0 else (-delta << 1) - 1)  # Zigzag
+            prev[i] = q
+    return bytes(out)
+
+
+def decode(data):
+    if len(data) < 16 or data[:4] != MAGIC:
+        raise ValueError("not a clip file")
+    version, channels, rate, count, _ = struct.unpack_from("<BBHII", data, 4)
+    if version != VERSION or channels != len(CHANNELS):
+        raise ValueError("unsupported clip version %d / %d channels" % (version, channels))
+    pos = 16
+    values = [0] * channels
+    frames = []
+    for _ in range(count):
+        for i in range(channels):
+            zigzag, pos = read_varint(data, pos)
+            values[i] += (zigzag >> 1) ^ -(zigzag & 1)
+        frames.append([v / SCALE[i] for i, v in enumerate(values)])
+    return rate, frames
+
+
+def read_keyframes(path):
+    keys = [[] for _ in CHANNELS]               # Per channel: (time_ms, value)
+    end_ms = 0
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            if not row.get("time_ms", "").strip():
+                continue
+            t = float(row["time_ms"])
+            end_ms = max(end_ms, t)
+            for i, name in enumerate(CHANNELS):
+                cell = (row.get(name) or "").strip()
+                if cell:
+                    keys[i].append((t, float(cell)))
+    for channel in keys:
+        channel.sort()
+    return keys, end_ms
+
+
+def sample(channel, t, default):
+    if not channel:
+        return default
+    if t <= channel[0][0]:
+        return channel[0][1]
+    for (t0, v0), (t1, v1) in zip(channel, channel[1:]):
+        if t <= t1:
+            if t1 == t0:
+                return v1
+            return v0 + (v1 - v0) * (t - t0) / (t1 - t0)
+    return channel[-1][1]
+
+
+def cmd_bake(args):
+    if not 1 <= args.rate <= MAX_RATE_HZ:
+        sys.exit("rate must be 1-%d Hz" % MAX_RATE_HZ)
+    keys, end_ms = read_keyframes(args.input)
+    count = int(end_ms * args.rate / 1000) + 1
+    frames = []
+    for n in range(count):
+        t = n * 1000.0 / args.rate
+        frames.append([sample(keys[i], t, NEUTRAL[i]) for i in range(len(CHANNELS))])
+    data = encode(frames, args.rate)
+    with open(args.output, "wb") as f:
+        f.write(data)
+    print("%s: %d frames @ %d Hz (%.1f s), %d bytes (%.1f bytes/frame)" % (
+        args.output, count, args.rate, count / args.rate, len(data), (len(data) - 16) / count))
+
+
+def cmd_dump(args):
+    with open(args.input, "rb") as f:
+        rate, frames = decode(f.read())
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(["time_ms"] + CHANNELS)
+    for n, frame in enumerate(frames):
+        writer.writerow(["%g" % (n * 1000.0 / rate)] + ["%g" % v for v in frame])
+    if args.output:
+        out.close()
+
+
+def cmd_info(args):
+    with open(args.input, "rb") as f:
+        data = f.read()
+    rate, frames = decode(data)
+    print("%s: %d frames @ %d Hz (%.1f s), %d bytes" % (
+        args.input, len(frames), rate, len(frames) / rate, len(data)))
+    for i, name in enumerate(CHANNELS):
+        column = [frame[i] for frame in frames]
+        print("  %-8s %8.2f .. %8.2f" % (name, min(column), max(column)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Bake and inspect animatronic eyes clips")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    bake = sub.add_parser("bake", help="keyframe CSV -> clip")
+    bake.add_argument("input")
+    bake.add_argument("output")
+    bake.add_argument("--rate", type=int, default=50, help="frames per second (default 50)")
+    bake.set_defaults(func=cmd_bake)
+
+    dump = sub.add_parser("dump", help="clip -> per-frame CSV")
+    dump.add_argument("input")
+    dump.add_argument("output", nargs="?")
+    dump.set_defaults(func=cmd_dump)
+
+    info = sub.add_parser("info", help="clip summary")
+    info.add_argument("input")
+    info.set_defaults(func=cmd_info)
+
+    args = parser.parse_args()
+    try:
+        args.func(args)
+    except (OSError, ValueError) as e:
+        sys.exit(str(e))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,109 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ *
+ * Host round trip: the firmware's delta decoder (ota_delta.h) against a patch
+ * from tools/delta_tool.py. Rebuilds the new image from the old one, feeding
+ * the patch in upload-sized and in odd-sized chunks, and compares the result
+ * byte for byte. Also checks that a patch for another base is rejected before
+ * anything is written and that a truncated patch fails.
+ *
+ *   delta_roundtrip old.bin patch.delta new.bin     (run by make delta)
+ */
+
+#include "ota_delta.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+struct Images {
+    std::vector<uint8_t> source;
+    std::vector<uint8_t> target;
+    size_t maxWrite = 0;
+};
+
+static const char* checkSource(void* context, const OtaDeltaHeader& header) {
+    Images* images = (Images*)context;
+    // The device compares the SHA-256 of the running partition; size is enough here
+    return header.sourceSize == images->source.size() ? nullptr : "Base mismatch";
+}
+
+static bool readSource(void* context, uint32_t offset, uint8_t* buffer, size_t len) {
+    Images* images = (Images*)context;
+    if (offset + len > images->source.size()) return false;
+    memcpy(buffer, images->source.data() + offset, len);
+    return true;
+}
+
+static bool writeTarget(void* context, const uint8_t* data, size_t len) {
+    Images* images = (Images*)context;
+    images->target.insert(images->target.end(), data, data + len);
+    if (len > images->maxWrite) images->maxWrite = len;
+    return true;
+}
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) data.insert(data.end(), buffer, buffer + n);
+    fclose(f);
+    return true;
+}
+
+static bool run(Images& images, const std::vector<uint8_t>& patch, size_t patchLen, size_t chunk, const char** error) {
+    OtaDeltaIo io = { checkSource, readSource, writeTarget, &images };
+    images.target.clear();
+    images.maxWrite = 0;
+    otaDelta.begin(io);
+    for (size_t i = 0; i < patchLen; i += chunk) {
+        size_t n = patchLen - i < chunk ? patchLen - i : chunk;
+        if (!otaDelta.feed(patch.data() + i, n)) break;
+    }
+    bool ok = otaDelta.finish();
+    *error = otaDelta.getError();
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        fprintf(stderr, "usage: %s old.bin patch.delta new.bin\n", argv[0]);
+        return 2;
+    }
+    Images images;
+    std::vector<uint8_t> patch, expected;
+    if (!readFile(argv[1], images.source) || !readFile(argv[2], patch) || !readFile(argv[3], expected)) {
+        fprintf(stderr, "cannot read input files\n");
+        return 2;
+    }
+
+    int failures = 0;
+    const char* error = nullptr;
+    for (size_t chunk : {(size_t)1436, (size_t)1, (size_t)77, patch.size()}) {
+        bool ok = run(images, patch, patch.size(), chunk, &error);
+        bool same = ok && images.target == expected;
+        printf("chunks of %7u: %s (%u bytes, largest write %u)\n", (unsigned)chunk,
+               same ? "OK" : (ok ? "MISMATCH" : error), (unsigned)images.target.size(), (unsigned)images.maxWrite);
+        if (!same) failures++;
+    }
+
+    // Another base: rejected at the header, nothing written
+    std::vector<uint8_t> source = images.source;
+    images.source.push_back(0);
+    bool ok = run(images, patch, patch.size(), 1436, &error);
+    printf("other base:        %s\n", !ok && images.target.empty() ? "rejected" : "NOT REJECTED");
+    if (ok || !images.target.empty()) failures++;
+    images.source = source;
+
+    // Truncated
+    ok = run(images, patch, patch.size() - 1, 1436, &error);
+    printf("truncated:         %s\n", !ok ? error : "NOT DETECTED");
+    if (ok) failures++;
+
+    printf("%s -> %s: %u -> %u bytes (%.1f%%)\n", argv[1], argv[3], (unsigned)expected.size(),
+           (unsigned)patch.size(), 100.0 * patch.size() / expected.size());
+    return failures ? 1 : 0;
+}
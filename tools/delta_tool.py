@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+#
+# Animatronic Eyes
+# Copyright (c) 2025 Zappo-II
+# Licensed under CC BY-NC-SA 4.0
+# https://github.com/Zappo-II/animatronic-eyes
+#
+# Delta firmware patches for /update (format described in ota_delta.h)
+#
+#   delta_tool.py diff old.bin new.bin out.delta
+#   delta_tool.py apply old.bin in.delta out.bin
+#   delta_tool.py info in.delta
+#
+# diff matches the new image against the old one bsdiff-style: an 8-byte seed
+# finds an alignment, which is then followed as long as most bytes agree. Code
+# that moved keeps its alignment; bytes that changed inside it (shifted
+# addresses, small edits) are stored as a sparse diff, runs of equal bytes cost
+# a varint. Whatever has no alignment is inserted literally.
+# The patch is applied again before it is written, so a patch that doesn't
+# reproduce the new image is never produced.
+
+import argparse
+import hashlib
+import re
+import struct
+import sys
+
+MAGIC = b"AEDP"
+VERSION = 1
+HEADER = "<4sB3xI32sI32s"                       # OTA_DELTA_HEADER_BYTES = 80
+CMD_ADD = 0x01
+CMD_INSERT = 0x02
+
+SEED = 8                # Bytes that must match to start an alignment
+INDEX_STEP = 4          # Old image positions indexed (every 4th; the scan tries every new position)
+MIN_ADD = 24            # Shorter alignments are cheaper as literals
+SLACK = 32              # Alignment ends once it scores this far below its best
+BLOCK = 64              # Compared at once while bytes agree
+ZERO_RUN_MIN = 3        # Shorter zero runs stay inside the literal diff bytes
+
+
+def write_varint(out, value):
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError("truncated patch")
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+
+def zigzag(value):
+    return value << 1 if value >= 0 else (-value << 1) - 1
+
+
+def extend(old, new, s, t):
+    # End (in new) of the best alignment starting at old[s] / new[t]: +1 per
+    # equal byte, -1 per differing one, cut where the score peaked
+    n = min(len(old) - s, len(new) - t)
+    i = score = best = best_i = 0
+    while i < n:
+        if i + BLOCK <= n and new[t + i:t + i + BLOCK] == old[s + i:s + i + BLOCK]:
+            i += BLOCK
+            score += BLOCK
+        else:
+            score += 1 if new[t + i] == old[s + i] else -1
+            i += 1
+        if score > best:
+            best = score
+            best_i = i
+        elif score < best - SLACK:
+            break
+    return t + best_i
+
+
+def emit_add(out, offset, old_part, new_part):
+    out.append(CMD_ADD)
+    write_varint(out, zigzag(offset))
+    write_varint(out, len(new_part))
+    diff = bytes((b - a) & 0xFF for a, b in zip(old_part, new_part))
+    zeros = 0
+    pos = 0
+    for run in re.finditer(rb"\x00{%d,}" % ZERO_RUN_MIN, diff):
+        if run.start() > pos:
+            write_varint(out, zeros)
+            write_varint(out, run.start() - pos)
+            out += diff[pos:run.start()]
+            zeros = 0
+        zeros += run.end() - run.start()
+        pos = run.end()
+    if pos < len(diff):
+        write_varint(out, zeros)
+        write_varint(out, len(diff) - pos)
+        out += diff[pos:]
+    elif zeros:
+        write_varint(out, zeros)
+        write_varint(out, 0)
+
+
+def emit_insert(out, data):
+    out.append(CMD_INSERT)
+    write_varint(out, len(data))
+    out += data
+
+
+def diff(old, new):
+    index = {}
+    for j in range(0, len(old) - SEED + 1, INDEX_STEP):
+        index.setdefault(old[j:j + SEED], j)
+
+    out = bytearray(struct.pack(HEADER, MAGIC, VERSION, len(old), hashlib.sha256(old).digest(),
+                                len(new), hashlib.sha256(new).digest()))
+    stats = {"add": 0, "insert": 0, "added": 0, "inserted": 0}
+    t = literal_start = cursor = 0
+    shift = 0                                   # old - new offset of the last alignment
+    while t + SEED <= len(new):
+        seed = new[t:t + SEED]
+        s = t + shift                           # Same alignment as before (code after an edit)
+        if s < 0 or old[s:s + SEED] != seed:
+            s = index.get(seed)
+            if s is None:
+                t += 1
+                continue
+        start, source = t, s
+        while start > literal_start and source > 0 and new[start - 1] == old[source - 1]:
+            start -= 1
+            source -= 1
+        end = extend(old, new, source, start)
+        if end - start < MIN_ADD:
+            t += 1
+            continue
+
+        if literal_start < start:
+            emit_insert(out, new[literal_start:start])
+            stats["insert"] += 1
+            stats["inserted"] += start - literal_start
+        emit_add(out, source - cursor, old[source:source + end - start], new[start:end])
+        stats["add"] += 1
+        stats["added"] += end - start
+        cursor = source + end - start
+        shift = source - start
+        t = literal_start = end
+
+    if literal_start < len(new):
+        emit_insert(out, new[literal_start:])
+        stats["insert"] += 1
+        stats["inserted"] += len(new) - literal_start
+    return bytes(out), stats
+
+
+def parse_header(patch):
+    if len(patch) < struct.calcsize(HEADER):
+        raise ValueError("not a delta patch")
+    magic, version, old_size, old_sha, new_size, new_sha = struct.unpack_from(HEADER, patch)
+    if magic != MAGIC:
+        raise ValueError("not a delta patch")
+    if version != VERSION:
+        raise ValueError("unsupported patch version %d" % version)
+    return old_size, old_sha, new_size, new_sha
+
+
+def apply(old, patch):
+    old_size, old_sha, new_size, new_sha = parse_header(patch)
+    if len(old) != old_size or hashlib.sha256(old).digest() != old_sha:
+        raise ValueError("patch does not apply to this image (base mismatch)")
+    new = bytearray()
+    pos = struct.calcsize(HEADER)
+    cursor = 0
+    while len(new) < new_size:
+        command = patch[pos]
+        pos += 1
+        if command == CMD_ADD:
+            offset, pos = read_varint(patch, pos)
+            length, pos = read_varint(patch, pos)
+            cursor += (offset >> 1) ^ -(offset & 1)
+            end = len(new) + length
+            while len(new) < end:
+                zeros, pos = read_varint(patch, pos)
+                count, pos = read_varint(patch, pos)
+                new += old[cursor:cursor + zeros]
+                cursor += zeros
+                new += bytes((a + b) & 0xFF for a, b in zip(old[cursor:cursor + count], patch[pos:pos + count]))
+                cursor += count
+                pos += count
+        elif command == CMD_INSERT:
+            length, pos = read_varint(patch, pos)
+            new += patch[pos:pos + length]
+            pos += length
+        else:
+            raise ValueError("unknown patch command 0x%02x at %d" % (command, pos - 1))
+    if pos != len(patch) or len(new) != new_size or hashlib.sha256(new).digest() != new_sha:
+        raise ValueError("patch does not reproduce its target")
+    return bytes(new)
+
+
+def read(path):
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def cmd_diff(args):
+    old = read(args.old)
+    new = read(args.new)
+    patch, stats = diff(old, new)
+    if apply(old, patch) != new:
+        raise ValueError("round trip failed")
+    with open(args.output, "wb") as f:
+        f.write(patch)
+    print("%s: %d -> %d bytes (%.1f%%), %d ADD (%d bytes), %d INSERT (%d bytes)" % (
+        args.output, len(new), len(patch), 100.0 * len(patch) / len(new),
+        stats["add"], stats["added"], stats["insert"], stats["inserted"]))
+
+
+def cmd_apply(args):
+    new = apply(read(args.old), read(args.patch))
+    with open(args.output, "wb") as f:
+        f.write(new)
+    print("%s: %d bytes" % (args.output, len(new)))
+
+
+def cmd_info(args):
+    patch = read(args.patch)
+    old_size, old_sha, new_size, new_sha = parse_header(patch)
+    print("%s: %d bytes" % (args.patch, len(patch)))
+    print("  base   %8d bytes  sha256 %s" % (old_size, old_sha.hex()))
+    print("  target %8d bytes  sha256 %s" % (new_size, new_sha.hex()))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Delta firmware patches for animatronic eyes")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    d = sub.add_parser("diff", help="old + new image -> patch (verified by applying it)")
+    d.add_argument("old")
+    d.add_argument("new")
+    d.add_argument("output")
+    d.set_defaults(func=cmd_diff)
+
+    a = sub.add_parser("apply", help="old image + patch -> new image")
+    a.add_argument("old")
+    a.add_argument("patch")
+    a.add_argument("output")
+    a.set_defaults(func=cmd_apply)
+
+    info = sub.add_parser("info", help="patch header")
+    info.add_argument("patch")
+    info.set_defaults(func=cmd_info)
+
+    args = parser.parse_args()
+    try:
+        args.func(args)
+    except (OSError, ValueError, IndexError, struct.error) as e:
+        sys.exit(str(e))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,107 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ *
+ * Host simulation: drift of sequence waits over one hour of millis().
+ * Plays a [gaze, wait 500] loop with a main loop that comes around 1-16 ms
+ * late (and optionally stalls 2 s every 10 minutes, like a file load or OTA
+ * chunk), starting just before the millis() wrap. Compares the previous
+ * scheduling (wait ends at observed time + ms) with the step timeline of
+ * ModePlayer/ImpulsePlayer::runTrack (wait ends at previous deadline + ms,
+ * resync after SEQUENCE_MAX_LATE_MS). Drift = when the Nth wait ended minus
+ * N x 500 ms (stalls the timeline resyncs after are not counted as drift).
+ * Fails if the timeline drifts by more than SEQUENCE_MAX_LATE_MS.
+ *
+ *   make drift-sim
+ */
+
+#include "config.h"
+#include <cstdio>
+#include <cstdint>
+#include <random>
+
+#define SIM_WAIT_MS 500
+#define SIM_HOUR_MS 3600000u
+#define SIM_START_MS 0xFFFF0000u     // ~65 s before millis() wraps
+#define SIM_STALL_EVERY_MS 600000u
+#define SIM_STALL_MS 2000u
+
+// Same comparison as Scheduler::isDue
+static bool isDue(uint32_t now, uint32_t deadline) {
+    return (int32_t)(now - deadline) >= 0;
+}
+
+struct Result {
+    long waits = 0;
+    int32_t driftMs = 0;
+    uint32_t lateMaxMs = 0;
+    int resyncs = 0;
+};
+
+static Result simulate(bool timeline, bool stalls) {
+    std::mt19937 rng(1);  // Same loop latencies for both schedulers
+    std::uniform_int_distribution<int> latency(1, 16);
+
+    uint32_t now = SIM_START_MS;
+    uint32_t nextStall = now + SIM_STALL_EVERY_MS;
+    uint32_t deadline = now;      // Old: observed + ms; timeline: previous deadline + ms
+    uint32_t resyncedMs = 0;      // Time skipped by timeline resyncs (not drift)
+    uint32_t lastEnd = now;
+    bool waiting = false;
+    Result result;
+
+    while (now - SIM_START_MS < SIM_HOUR_MS) {
+        now += latency(rng);
+        if (stalls && isDue(now, nextStall)) {
+            now += SIM_STALL_MS;
+            nextStall += SIM_STALL_EVERY_MS;
+        }
+
+        if (waiting) {
+            if (!isDue(now, deadline)) continue;
+            uint32_t late = now - deadline;
+            if (late > result.lateMaxMs) result.lateMaxMs = late;
+            if (timeline && late > SEQUENCE_MAX_LATE_MS) {
+                resyncedMs += late;
+                deadline = now;
+                result.resyncs++;
+            }
+            waiting = false;
+            result.waits++;
+            lastEnd = now;
+        }
+
+        // gaze (instant), then wait
+        if (timeline) {
+            deadline += SIM_WAIT_MS;
+        } else {
+            deadline = now + SIM_WAIT_MS;
+        }
+        waiting = true;
+    }
+
+    uint32_t stalledMs = timeline ? resyncedMs : 0;
+    result.driftMs = (int32_t)(lastEnd - SIM_START_MS - stalledMs - (uint32_t)result.waits * SIM_WAIT_MS);
+    return result;
+}
+
+int main() {
+    int failures = 0;
+    printf("%-24s %8s %10s %10s %8s\n", "scheduling", "waits", "drift ms", "late max", "resyncs");
+
+    for (bool stalls : {false, true}) {
+        for (bool timeline : {false, true}) {
+            Result r = simulate(timeline, stalls);
+            char label[32];
+            snprintf(label, sizeof(label), "%s%s", timeline ? "timeline" : "millis() + ms", stalls ? " + stalls" : "");
+            printf("%-24s %8ld %10ld %10lu %8d\n", label, r.waits, (long)r.driftMs,
+                   (unsigned long)r.lateMaxMs, r.resyncs);
+            if (timeline && (r.driftMs < 0 || r.driftMs > SEQUENCE_MAX_LATE_MS)) failures++;
+        }
+    }
+
+    printf("%s\n", failures ? "FAILED - timeline drifts" : "OK - timeline does not accumulate drift");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,25 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ *
+ * Host stand-in for the LittleFS mount calls of ui_image_update.cpp.
+ * tools/ui_image_check.cpp implements begin() on its flash mock.
+ */
+
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include <Arduino.h>
+
+class HostLittleFS {
+public:
+    bool begin(bool formatOnFail);
+    void end() { mounted = false; }
+    bool mounted = true;
+};
+
+extern HostLittleFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
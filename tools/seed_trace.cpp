@@ -0,0 +1,508 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ *
+ * Host check: identical seeds replay identical step traces.
+ * Plays the shipped modes and impulses (data/modes, data/impulses) and a block
+ * program (repeat/call/choose/parallel) through the firmware's own cursor,
+ * value resolution and parallel track start (sequence_cursor.cpp), seeded like
+ * ModePlayer::start / ImpulsePlayer::startPlayback. The loop around them
+ * follows ModePlayer::runTrack on a virtual clock whose loop latency, stalls and
+ * blink/impulse timing come from a separate noise generator. Checks that:
+ *   - the same seed gives the same trace, run after run
+ *   - other loop timing never changes a track's trace (auto-blink/auto-impulse
+ *     draws and parallel tracks interleave differently every run)
+ *   - another seed gives another trace
+ * Then times a draw.
+ *
+ *   make seed-trace      (needs ArduinoJson 7 on the host, see Makefile)
+ */
+
+#include "sequence.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <string>
+#include <vector>
+
+// Only Prng::entropy() needs it - the checks below always pass explicit seeds
+uint32_t esp_random() { return (uint32_t)rand() | 1; }
+
+#define TRACE_STEPS 400          // Main track steps per run
+#define TRACE_MAX_MS 36000000u   // Virtual time limit (sequences that end early)
+#define BLINK_EVERY 3            // Noise: one in N loop passes draws an auto-blink interval
+#define PICK_EVERY 5             // Noise: one in N passes draws an auto-impulse pick
+#define TRIGGER_EVERY 40         // Noise: one in N passes triggers an impulse
+#define STALL_EVERY 50           // Noise: one in N passes stalls up to STALL_MAX_MS (file load, web request)
+#define STALL_MAX_MS 400
+#define TIMING_RUNS 48           // Runs with other loop timing per seed
+
+// Exercises every block and the draws inside them
+static const char* BLOCK_PROGRAM = R"({
+  "name": "Blocks", "loop": true,
+  "sequences": {
+    "glance": [{"gaze": {"x": {"random": [-60, 60]}, "y": {"random": [-20, 20]}}}, {"wait": {"random": [200, 900]}}]
+  },
+  "sequence": [
+    {"gaze": {"x": {"random": [-10, 10]}}},
+    {"lids": {"left": {"random": [60, 90]}, "right": {"random": [60, 90]}}},
+    {"repeat": {"count": {"random": [0, 3]}, "steps": [{"call": "glance"}]}},
+    {"choose": [
+      {"weight": 3, "steps": [{"call": "glance"}]},
+      {"steps": [{"move": {"x": {"random": [-40, 40]}, "coupling": {"random": [-1, 1]}, "duration": {"random": [100, 400]}}}]},
+      {"weight": 2, "steps": [{"call": "impulse:startle"}]}
+    ]},
+    {"parallel": [
+      [{"gaze": {"x": {"random": [-30, 30]}}}, {"wait": {"random": [50, 300]}}, {"gaze": {"y": {"random": [-30, 30]}}}, {"wait": 120}],
+      [{"blink": {"random": [80, 200]}}, {"lids": {"left": {"random": [40, 100]}}}, {"wait": {"random": [10, 500]}}],
+      [{"move": {"left": {"random": [0, 100]}, "duration": {"random": [50, 250]}}}, {"wait": {"random": [10, 90]}}]
+    ]},
+    {"blink": 150},
+    {"wait": {"random": [100, 1500]}}
+  ]
+})";
+
+struct Trace {
+    std::string text;
+    int steps = 0;
+
+    void add(const char* format, ...) {
+        char line[96];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(line, sizeof(line), format, args);
+        va_end(args);
+        text += line;
+        text += '\n';
+        steps++;
+    }
+};
+
+static bool readFile(const std::string& path, std::string& text) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) text.append(buffer, n);
+    fclose(f);
+    return true;
+}
+
+// compileSequence() copies called impulse files into "sequences" (it needs LittleFS,
+// so the host does the same from data/impulses)
+static bool inlineCalls(JsonDocument& doc, JsonArray steps, const std::string& dataDir, int depth) {
+    if (depth > SEQUENCE_MAX_DEPTH) return false;
+    for (JsonObject step : steps) {
+        if (step.containsKey("repeat")) {
+            if (!inlineCalls(doc, step["repeat"]["steps"].as<JsonArray>(), dataDir, depth + 1)) return false;
+        } else if (step.containsKey("call")) {
+            std::string name = step["call"] | "";
+            if (doc["sequences"][name].isNull() && name.compare(0, 8, "impulse:") == 0) {
+                std::string text;
+                JsonDocument impulse;
+                if (!readFile(dataDir + "/impulses/" + name.substr(8) + ".json", text) ||
+                    deserializeJson(impulse, text)) {
+                    return false;
+                }
+                if (doc["sequences"].isNull()) doc["sequences"].to<JsonObject>();
+                doc["sequences"][name] = impulse["sequence"];
+            }
+            if (!inlineCalls(doc, doc["sequences"][name].as<JsonArray>(), dataDir, depth + 1)) return false;
+        } else if (step.containsKey("choose")) {
+            for (JsonObject branch : step["choose"].as<JsonArray>()) {
+                if (!inlineCalls(doc, branch["steps"].as<JsonArray>(), dataDir, depth + 1)) return false;
+            }
+        } else if (step.containsKey("parallel")) {
+            for (JsonArray track : step["parallel"].as<JsonArray>()) {
+                if (!inlineCalls(doc, track, dataDir, 1)) return false;
+            }
+        }
+    }
+    return !steps.isNull();
+}
+
+static bool load(JsonDocument& doc, const std::string& text, const std::string& dataDir) {
+    return !deserializeJson(doc, text) && inlineCalls(doc, doc["sequence"].as<JsonArray>(), dataDir, 1);
+}
+
+// ModePlayer / ImpulsePlayer around the firmware's cursor and draws, on a virtual clock
+struct Player {
+    JsonArray sequence;
+    JsonObject sequences;
+    bool loop = false;
+    uint32_t stream = PRNG_STREAM_MODE;
+    SequenceTrack tracks[SEQUENCE_MAX_TRACKS];
+    uint32_t animationEnd[SEQUENCE_MAX_TRACKS] = {};  // Blink / move of a track ends
+    uint32_t joinMs = 0;
+    bool playing = false;
+    Trace trace[SEQUENCE_MAX_TRACKS];                  // Per track: parallel tracks interleave
+
+    void begin(JsonDocument& doc, uint32_t generatorStream) {
+        sequence = doc["sequence"].as<JsonArray>();
+        sequences = doc["sequences"].as<JsonObject>();
+        loop = doc["loop"] | false;
+        stream = generatorStream;
+    }
+
+    void start(uint32_t now, uint32_t mainSeed, int skip) {
+        for (SequenceTrack& track : tracks) {
+            track.active = false;
+            track.cursor.clear();
+        }
+        SequenceTrack& main = tracks[0];
+        main.cursor.begin(sequence, skip);
+        main.rng.seed(mainSeed, stream);
+        main.active = true;
+        main.wait = TrackWait::NONE;
+        main.timelineMs = now;
+        playing = true;
+    }
+
+    void loopPass(uint32_t now) {
+        // Same order as ModePlayer::loop: parallel tracks first, then the main track
+        bool tracksRunning = false;
+        for (int i = 1; i < SEQUENCE_MAX_TRACKS; i++) {
+            if (tracks[i].active) {
+                runTrack(i, now);
+                tracksRunning |= tracks[i].active;
+            }
+        }
+        SequenceTrack& main = tracks[0];
+        if (main.wait == TrackWait::JOIN) {
+            if (tracksRunning) return;
+            main.wait = TrackWait::NONE;
+            main.timelineMs = joinMs;
+        }
+        runTrack(0, now);
+    }
+
+    void runTrack(int index, uint32_t now) {
+        SequenceTrack& track = tracks[index];
+        switch (track.wait) {
+            case TrackWait::TIME:
+                if (!Scheduler_isDue(now, track.timelineMs)) return;
+                if (now - track.timelineMs > SEQUENCE_MAX_LATE_MS) track.timelineMs = now;
+                break;
+            case TrackWait::BLINK:
+            case TrackWait::TRANSITION:
+                if (!Scheduler_isDue(now, animationEnd[index])) return;
+                track.timelineMs = now;
+                break;
+            case TrackWait::JOIN:
+                return;
+            default:
+                break;
+        }
+        track.wait = TrackWait::NONE;
+
+        JsonObject step = track.cursor.next(sequences, track.rng);
+        if (step.isNull()) {
+            finishTrack(index);
+        } else if (step.containsKey("parallel")) {
+            uint8_t next = 1;
+            for (JsonArray steps : step["parallel"].as<JsonArray>()) {
+                if (next >= SEQUENCE_MAX_TRACKS) break;
+                startParallelTrack(tracks[next++], track, steps, stream);
+            }
+            trace[0].add("parallel %u", (unsigned)(next - 1));
+            joinMs = track.timelineMs;
+            track.wait = TrackWait::JOIN;
+        } else {
+            executeStep(step, index, now);
+        }
+    }
+
+    void finishTrack(int index) {
+        SequenceTrack& track = tracks[index];
+        if (index != 0) {
+            track.active = false;
+            if (Scheduler_isDue(track.timelineMs, joinMs)) joinMs = track.timelineMs;
+        } else if (loop) {
+            track.cursor.begin(sequence);
+        } else {
+            track.active = false;
+            playing = false;
+        }
+    }
+
+    // Same draws, in the same order, as ModePlayer::exec* (unset values print as nan)
+    void executeStep(JsonObject step, int index, uint32_t now) {
+        SequenceTrack& track = tracks[index];
+        Trace& out = trace[index];
+        if (step.containsKey("gaze")) {
+            JsonObject p = step["gaze"].as<JsonObject>();
+            float x = resolveValue(track.rng, p["x"], NAN);
+            float y = resolveValue(track.rng, p["y"], NAN);
+            float z = resolveValue(track.rng, p["z"], NAN);
+            out.add("gaze %.3f %.3f %.3f", x, y, z);
+        } else if (step.containsKey("lids")) {
+            JsonObject p = step["lids"].as<JsonObject>();
+            float left = resolveValue(track.rng, p["left"], NAN);
+            float right = resolveValue(track.rng, p["right"], NAN);
+            out.add("lids %.3f %.3f", left, right);
+        } else if (step.containsKey("blink")) {
+            int ms = resolveIntValue(track.rng, step["blink"], 150);
+            out.add("blink %d", ms);
+            animationEnd[index] = now + ms;
+            track.wait = TrackWait::BLINK;
+        } else if (step.containsKey("wait")) {
+            int ms = resolveIntValue(track.rng, step["wait"], 0);
+            out.add("wait %d", ms);
+            if (ms > 0) {
+                track.timelineMs += ms;
+                track.wait = TrackWait::TIME;
+            }
+        } else if (step.containsKey("move")) {
+            JsonObject p = step["move"].as<JsonObject>();
+            float x = NAN, y = NAN, z = NAN, coupling = NAN, left = NAN, right = NAN;
+            if (p.containsKey("x") || p.containsKey("y") || p.containsKey("z")) {
+                x = resolveValue(track.rng, p["x"], NAN);
+                y = resolveValue(track.rng, p["y"], NAN);
+                z = resolveValue(track.rng, p["z"], NAN);
+            }
+            if (p.containsKey("coupling")) coupling = resolveValue(track.rng, p["coupling"], NAN);
+            if (p.containsKey("left") || p.containsKey("right")) {
+                left = resolveValue(track.rng, p["left"], NAN);
+                right = resolveValue(track.rng, p["right"], NAN);
+            }
+            int ms = resolveIntValue(track.rng, p["duration"], 300);
+            out.add("move %.3f %.3f %.3f %.3f %.3f %.3f %d", x, y, z, coupling, left, right, ms);
+            animationEnd[index] = now + (ms > 0 ? ms : 0);
+            track.wait = TrackWait::TRANSITION;
+        } else {
+            out.add("other");  // clip: no draws
+        }
+    }
+
+    static bool Scheduler_isDue(uint32_t now, uint32_t deadline) {
+        return (int32_t)(now - deadline) >= 0;  // Scheduler::isDue
+    }
+};
+
+// ModePlayer::prefetchEntryPose: leading gaze/lids steps on their own stream
+static int entrySteps(Player& player, uint32_t seed) {
+    Prng entry;
+    entry.seed(seed, PRNG_STREAM_MODE_ENTRY);
+    int steps = 0;
+    int count = player.sequence.size();
+    while (steps < count) {
+        JsonObject step = player.sequence[steps].as<JsonObject>();
+        if (step.containsKey("gaze")) {
+            JsonObject p = step["gaze"].as<JsonObject>();
+            float x = resolveValue(entry, p["x"], NAN);
+            float y = resolveValue(entry, p["y"], NAN);
+            float z = resolveValue(entry, p["z"], NAN);
+            player.trace[0].add("entry gaze %.3f %.3f %.3f", x, y, z);
+        } else if (step.containsKey("lids")) {
+            JsonObject p = step["lids"].as<JsonObject>();
+            float left = resolveValue(entry, p["left"], NAN);
+            float right = resolveValue(entry, p["right"], NAN);
+            player.trace[0].add("entry lids %.3f %.3f", left, right);
+        } else {
+            break;
+        }
+        steps++;
+    }
+    return steps >= count ? 0 : steps;
+}
+
+// Everything the device draws in one run
+struct Run {
+    Trace mode[SEQUENCE_MAX_TRACKS];
+    std::vector<Trace> impulses;  // Per triggered impulse, in trigger order
+    Trace blink, pick;
+};
+
+static Run play(JsonDocument& modeDoc, std::vector<JsonDocument*>& impulseDocs, uint32_t seed, uint32_t noiseSeed) {
+    Run run;
+    Player mode;
+    mode.begin(modeDoc, PRNG_STREAM_MODE);
+    mode.start(0, seed, entrySteps(mode, seed));
+
+    Player impulse;
+    Prng impulseRng, blink, pick;  // ImpulsePlayer::_rng, AutoBlink, AutoImpulse
+    impulseRng.seed(seed, PRNG_STREAM_IMPULSE);
+    blink.seed(seed, PRNG_STREAM_AUTO_BLINK);
+    pick.seed(seed, PRNG_STREAM_AUTO_IMPULSE);
+
+    Prng noise;  // Loop timing only - never seen by the players
+    noise.seed(noiseSeed, 0);
+
+    uint32_t now = 0;
+    while (mode.playing && mode.trace[0].steps < TRACE_STEPS && now < TRACE_MAX_MS) {
+        now += 1 + noise.below(16);
+        if (noise.below(STALL_EVERY) == 0) now += noise.below(STALL_MAX_MS);
+        mode.loopPass(now);
+
+        if (noise.below(BLINK_EVERY) == 0) {
+            run.blink.add("interval %d", (int)blink.range(2000, 6000));  // AutoBlink::scheduleNext
+        }
+        if (noise.below(PICK_EVERY) == 0) {
+            uint32_t column = pick.below(4);  // AutoImpulse::pick (alias table)
+            uint32_t coin = pick.below(65536);
+            run.pick.add("pick %u %u interval %d", column, coin, (int)pick.range(30000, 120000));
+        }
+
+        // Impulses run beside the mode; a trigger while one plays is ignored
+        if (impulse.playing) {
+            impulse.loopPass(now);
+            if (!impulse.playing) run.impulses.back() = impulse.trace[0];
+        } else if (!impulseDocs.empty() && noise.below(TRIGGER_EVERY) == 0) {
+            impulse = Player();
+            impulse.begin(*impulseDocs[run.impulses.size() % impulseDocs.size()], PRNG_STREAM_IMPULSE);
+            impulse.start(now, impulseRng.next(), 0);
+            run.impulses.push_back(Trace());
+        }
+    }
+    for (int i = 0; i < SEQUENCE_MAX_TRACKS; i++) run.mode[i] = mode.trace[i];
+    if (impulse.playing) run.impulses.pop_back();  // Unfinished
+    return run;
+}
+
+// Prefix only - runs with other timing stop at other points
+static bool samePrefix(const Trace& a, const Trace& b) {
+    size_t n = a.text.size() < b.text.size() ? a.text.size() : b.text.size();
+    return a.text.compare(0, n, b.text, 0, n) == 0;
+}
+
+static bool sameTracks(const Run& a, const Run& b, bool exact) {
+    for (int i = 0; i < SEQUENCE_MAX_TRACKS; i++) {
+        if (exact ? a.mode[i].text != b.mode[i].text : !samePrefix(a.mode[i], b.mode[i])) return false;
+    }
+    size_t runs = a.impulses.size() < b.impulses.size() ? a.impulses.size() : b.impulses.size();
+    for (size_t i = 0; i < runs; i++) {
+        if (a.impulses[i].text != b.impulses[i].text) return false;
+    }
+    return samePrefix(a.blink, b.blink) && samePrefix(a.pick, b.pick) &&
+           (!exact || a.impulses.size() == b.impulses.size());
+}
+
+static uint32_t fnv1a(const std::string& text) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : text) hash = (hash ^ c) * 16777619u;
+    return hash;
+}
+
+static std::vector<std::string> listJson(const std::string& dir) {
+    std::vector<std::string> names;
+    if (DIR* d = opendir(dir.c_str())) {
+        while (dirent* entry = readdir(d)) {
+            std::string name = entry->d_name;
+            if (name.size() > 5 && name.compare(name.size() - 5, 5, ".json") == 0) names.push_back(name);
+        }
+        closedir(d);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+int main(int argc, char** argv) {
+    std::string dataDir = argc > 1 ? argv[1] : "data";
+    int failures = 0;
+
+    std::vector<JsonDocument*> impulses;
+    for (const std::string& name : listJson(dataDir + "/impulses")) {
+        std::string text;
+        JsonDocument* doc = new JsonDocument();
+        if (!readFile(dataDir + "/impulses/" + name, text) || !load(*doc, text, dataDir)) {
+            printf("FAIL %s: cannot load\n", name.c_str());
+            return 1;
+        }
+        impulses.push_back(doc);
+    }
+
+    std::vector<std::pair<std::string, std::string>> programs;
+    for (const std::string& name : listJson(dataDir + "/modes")) {
+        std::string text;
+        readFile(dataDir + "/modes/" + name, text);
+        programs.push_back({name, text});
+    }
+    programs.push_back({"(blocks)", BLOCK_PROGRAM});
+    if (programs.size() < 2 || impulses.empty()) {
+        printf("FAIL no modes/impulses in %s\n", dataDir.c_str());
+        return 1;
+    }
+
+    const uint32_t seeds[] = {1, 42, 0xDEADBEEF, 0xFFFFFFFF};
+    printf("%-14s %6s %6s %8s %10s\n", "mode", "steps", "tracks", "impulses", "trace");
+    for (auto& program : programs) {
+        JsonDocument doc;
+        if (!load(doc, program.second, dataDir)) {
+            printf("FAIL %s: cannot load\n", program.first.c_str());
+            failures++;
+            continue;
+        }
+
+        for (uint32_t seed : seeds) {
+            Run reference = play(doc, impulses, seed, 1);
+
+            // Same seed, same timing
+            if (!sameTracks(reference, play(doc, impulses, seed, 1), true)) {
+                printf("FAIL %s seed %lu: trace differs between identical runs\n", program.first.c_str(), (unsigned long)seed);
+                failures++;
+            }
+
+            // Same seed, other timing: every track replays its own trace
+            for (uint32_t noiseSeed = 2; noiseSeed < TIMING_RUNS + 2; noiseSeed++) {
+                Run other = play(doc, impulses, seed, noiseSeed);
+                if (other.mode[0].text != reference.mode[0].text || !sameTracks(reference, other, false)) {
+                    printf("FAIL %s seed %lu: trace depends on loop timing (run %lu)\n",
+                           program.first.c_str(), (unsigned long)seed, (unsigned long)noiseSeed);
+                    failures++;
+                    break;
+                }
+            }
+
+            // Another seed must not replay this one
+            if (play(doc, impulses, seed + 1, 1).mode[0].text == reference.mode[0].text) {
+                printf("FAIL %s seed %lu: seed %lu gives the same trace\n",
+                       program.first.c_str(), (unsigned long)seed, (unsigned long)(seed + 1));
+                failures++;
+            }
+
+            if (seed == 42) {
+                int tracks = 0;
+                std::string all;
+                for (const Trace& t : reference.mode) {
+                    if (t.steps) tracks++;
+                    all += t.text;
+                }
+                for (const Trace& t : reference.impulses) all += t.text;
+                printf("%-14s %6d %6d %8u   %08lx\n", program.first.c_str(), reference.mode[0].steps, tracks,
+                       (unsigned)reference.impulses.size(), (unsigned long)fnv1a(all));
+            }
+        }
+    }
+
+    // Streams of one seed are independent sequences
+    Prng a, b;
+    a.seed(42, PRNG_STREAM_MODE);
+    b.seed(42, PRNG_STREAM_AUTO_BLINK);
+    int equal = 0;
+    for (int i = 0; i < 1000; i++) equal += (a.next() == b.next());
+    if (equal > 2) {
+        printf("FAIL streams: %d of 1000 draws equal\n", equal);
+        failures++;
+    }
+
+    // Cost per draw
+    const int iterations = 100000000;
+    Prng rng;
+    rng.seed(42, PRNG_STREAM_MODE);
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    uint32_t sum = 0;
+    for (int i = 0; i < iterations; i++) sum += rng.next();
+    sink = sink + sum;
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    printf("\n%.2f ns/draw (host)\n", std::chrono::duration<double, std::nano>(elapsed).count() / iterations);
+
+    printf("%s\n", failures ? "FAILED" : "OK - identical seeds give identical traces");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,300 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ *
+ * Host check of the /api/upload-ui partition write (ui_image_update.cpp) on a
+ * flash mock: writes only to erased sectors, one sector erased at a time, the
+ * superblock pair last. Uploads the ui.bin from make build-ui (mklittlefs
+ * -b 4096 -s 0x160000) against its manifest:
+ *   - chunk sizes 1 / 1436 (TCP segment) / 4096 / 5000 -> flash equals the image
+ *   - the superblock in either block of the pair (other block blank, swapped)
+ *   - CRC / SHA-256 / size mismatch, oversize image, image larger than the
+ *     partition, truncated and interrupted uploads -> rejected, superblock pair
+ *     never written
+ *   - not a LittleFS image -> rejected before anything is erased, still mounted
+ *
+ *   make ui-image-check     (after make build-ui)
+ *   ui_image_check build/ui.bin "$(python3 tools/ui_tool.py manifest --query build/ui.bin)"
+ */
+
+#include <string>
+#include <vector>
+
+// ui_image_update.cpp logs through web_server.h (AsyncWebServer); keep WEB_LOG only
+#define WEB_SERVER_H
+static std::string hostLog;
+#define WEB_LOG(source, ...) do { \
+        char line[160]; \
+        snprintf(line, sizeof(line), __VA_ARGS__); \
+        hostLog += "  [" source "] "; \
+        hostLog += line; \
+        hostLog += '\n'; \
+    } while (0)
+
+#include "ui_image_update.cpp"
+
+#define UI_PARTITION_SIZE 0x160000  // spiffs partition (mklittlefs -s in build-ui)
+#define PREVIOUS_UI_BYTE 0x5a       // Flash content before the upload
+
+// Flash mock: NOR semantics (writes clear bits), erased-sector tracking
+static std::vector<uint8_t> flash;
+static std::vector<bool> erased;
+static esp_partition_t partition = {ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS,
+                                    0x290000, UI_PARTITION_SIZE, "spiffs"};
+static int erases = 0;
+static size_t maxErase = 0;
+static int writesToUnerased = 0;
+static int writeCallErases = 0;     // Erases within the current UiImageUpdate::write()
+static int maxWriteCallErases = 0;
+static int accepted = 0;            // onAccepted calls
+HostLittleFS LittleFS;
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t, esp_partition_subtype_t, const char*) {
+    return &partition;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* p, size_t offset, size_t size) {
+    if (offset % UI_IMAGE_BLOCK_SIZE || size % UI_IMAGE_BLOCK_SIZE || offset + size > p->size) return ESP_FAIL;
+    memset(&flash[offset], 0xff, size);
+    for (size_t s = offset / UI_IMAGE_BLOCK_SIZE; s < (offset + size) / UI_IMAGE_BLOCK_SIZE; s++) erased[s] = true;
+    erases++;
+    writeCallErases++;
+    if (size > maxErase) maxErase = size;
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t* p, size_t offset, const void* src, size_t size) {
+    if (offset + size > p->size) return ESP_FAIL;
+    const uint8_t* data = (const uint8_t*)src;
+    for (size_t i = 0; i < size; i++) {
+        if (!erased[(offset + i) / UI_IMAGE_BLOCK_SIZE]) writesToUnerased++;
+        flash[offset + i] &= data[i];
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* p, size_t offset, void* dst, size_t size) {
+    if (offset + size > p->size) return ESP_FAIL;
+    memcpy(dst, &flash[offset], size);
+    return ESP_OK;
+}
+
+// Mounts when either block of the pair holds a superblock
+bool HostLittleFS::begin(bool) {
+    mounted = memcmp(&flash[8], "littlefs", 8) == 0 || memcmp(&flash[UI_IMAGE_BLOCK_SIZE + 8], "littlefs", 8) == 0;
+    return mounted;
+}
+
+static void onAccepted() {
+    accepted++;
+}
+
+struct Manifest {
+    size_t size = 0;
+    std::string crc32;
+    std::string sha256;
+};
+
+// Same values as ui_tool.py manifest
+static Manifest manifestOf(const std::vector<uint8_t>& image) {
+    Manifest m;
+    m.size = image.size();
+    char hex[65];
+    snprintf(hex, sizeof(hex), "%08x", esp_rom_crc32_le(0, image.data(), image.size()));
+    m.crc32 = hex;
+    unsigned char digest[32];
+    mbedtls_sha256_context sha;
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts(&sha, 0);
+    mbedtls_sha256_update(&sha, image.data(), image.size());
+    mbedtls_sha256_finish(&sha, digest);
+    mbedtls_sha256_free(&sha);
+    for (int i = 0; i < 32; i++) snprintf(hex + i * 2, 3, "%02x", digest[i]);
+    m.sha256 = hex;
+    return m;
+}
+
+// size=..&crc32=..&sha256=.. (ui_tool.py manifest --query)
+static Manifest parseQuery(const std::string& query) {
+    Manifest m;
+    size_t start = 0;
+    while (start < query.size()) {
+        size_t end = query.find('&', start);
+        if (end == std::string::npos) end = query.size();
+        std::string pair = query.substr(start, end - start);
+        size_t eq = pair.find('=');
+        if (eq != std::string::npos) {
+            std::string key = pair.substr(0, eq), value = pair.substr(eq + 1);
+            if (key == "size") m.size = strtoul(value.c_str(), nullptr, 10);
+            else if (key == "crc32") m.crc32 = value;
+            else if (key == "sha256") m.sha256 = value;
+        }
+        start = end + 1;
+    }
+    return m;
+}
+
+// Upload like the /api/upload-ui handler: begin, write chunks, finish (abort at stopAt)
+static bool upload(const std::vector<uint8_t>& image, size_t chunk, const Manifest& manifest, size_t stopAt = 0) {
+    flash.assign(partition.size, PREVIOUS_UI_BYTE);
+    erased.assign(partition.size / UI_IMAGE_BLOCK_SIZE, false);
+    erases = 0;
+    maxErase = 0;
+    writesToUnerased = 0;
+    maxWriteCallErases = 0;
+    accepted = 0;
+    LittleFS.mounted = true;
+    hostLog.clear();
+
+    if (!uiImageUpdate.begin(manifest.size, manifest.crc32.c_str(), manifest.sha256.c_str(), onAccepted)) {
+        return false;
+    }
+    size_t total = stopAt ? stopAt : image.size();
+    for (size_t offset = 0; offset < total; offset += chunk) {
+        writeCallErases = 0;
+        if (!uiImageUpdate.write(&image[offset], min(chunk, total - offset))) return false;
+        if (writeCallErases > maxWriteCallErases) maxWriteCallErases = writeCallErases;
+    }
+    if (stopAt) {
+        uiImageUpdate.abort("Upload interrupted");
+        return false;
+    }
+    return uiImageUpdate.finish();
+}
+
+static bool headBlank() {
+    for (size_t i = 0; i < UI_IMAGE_BLOCK_SIZE * UI_IMAGE_HEAD_BLOCKS; i++) {
+        if (flash[i] != 0xff) return false;
+    }
+    return true;
+}
+
+static bool hasSuperblock(const std::vector<uint8_t>& image, int block) {
+    return memcmp(&image[block * UI_IMAGE_BLOCK_SIZE + 8], "littlefs", 8) == 0;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char* name) {
+    printf("%-44s %s\n", name, ok ? "ok" : "FAIL");
+    if (!ok) {
+        printf("%s", hostLog.c_str());
+        failures++;
+    }
+}
+
+// Accepted: flash holds the image, mounted, nothing written to unerased flash,
+// no chunk erased more than it wrote (plus the superblock pair)
+static void expectAccepted(const std::vector<uint8_t>& image, size_t chunk, const Manifest& manifest, const char* name) {
+    bool ok = upload(image, chunk, manifest);
+    int eraseLimit = (int)((chunk + UI_IMAGE_BLOCK_SIZE - 1) / UI_IMAGE_BLOCK_SIZE) + 1;
+    ok = ok && memcmp(flash.data(), image.data(), image.size()) == 0 && LittleFS.mounted && accepted == 1 &&
+         writesToUnerased == 0 && maxErase <= UI_IMAGE_BLOCK_SIZE * UI_IMAGE_HEAD_BLOCKS &&
+         maxWriteCallErases <= eraseLimit;
+    check(ok, name);
+}
+
+// Rejected after the header: the superblock pair was never written
+static void expectRejected(const std::vector<uint8_t>& image, const Manifest& manifest, const char* error,
+                           const char* name, size_t stopAt = 0) {
+    bool ok = !upload(image, 1436, manifest, stopAt);
+    ok = ok && strstr(uiImageUpdate.getError(), error) && headBlank() && writesToUnerased == 0 &&
+         !uiImageUpdate.isActive();
+    check(ok, name);
+}
+
+// Rejected before anything is erased: the current UI stays mounted
+static void expectUntouched(const std::vector<uint8_t>& image, const Manifest& manifest, const char* error,
+                            const char* name) {
+    bool ok = !upload(image, 1436, manifest);
+    ok = ok && strstr(uiImageUpdate.getError(), error) && erases == 0 && accepted == 0 && LittleFS.mounted;
+    check(ok, name);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s ui.bin [manifest query]\n", argv[0]);
+        return 2;
+    }
+    std::vector<uint8_t> image;
+    if (FILE* f = fopen(argv[1], "rb")) {
+        uint8_t buffer[4096];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) image.insert(image.end(), buffer, buffer + n);
+        fclose(f);
+    }
+    if (image.size() < UI_IMAGE_BLOCK_SIZE * UI_IMAGE_HEAD_BLOCKS || (!hasSuperblock(image, 0) && !hasSuperblock(image, 1))) {
+        fprintf(stderr, "%s: not a LittleFS image\n", argv[1]);
+        return 2;
+    }
+
+    Manifest manifest = argc > 2 ? parseQuery(argv[2]) : manifestOf(image);
+    Manifest computed = manifestOf(image);
+    if (manifest.size != computed.size || manifest.crc32 != computed.crc32 || manifest.sha256 != computed.sha256) {
+        fprintf(stderr, "Manifest does not match %s (stale ui.bin.json?)\n", argv[1]);
+        return 2;
+    }
+    printf("%s: %zu bytes, %zu blocks, crc32 %s\n\n", argv[1], image.size(), image.size() / UI_IMAGE_BLOCK_SIZE,
+           manifest.crc32.c_str());
+
+    // Chunk sizes: the head boundary falls inside, at and across chunks
+    for (size_t chunk : {(size_t)1, (size_t)1436, (size_t)4096, (size_t)5000}) {
+        char name[48];
+        snprintf(name, sizeof(name), "chunks of %zu bytes", chunk);
+        expectAccepted(image, chunk, manifest, name);
+    }
+    expectAccepted(image, 1436, Manifest(), "no manifest");
+
+    // Superblock in either block of the pair
+    for (int block = 0; block < UI_IMAGE_HEAD_BLOCKS; block++) {
+        if (!hasSuperblock(image, block)) continue;
+        std::vector<uint8_t> single = image;
+        memset(&single[(1 - block) * UI_IMAGE_BLOCK_SIZE], 0xff, UI_IMAGE_BLOCK_SIZE);
+        char name[48];
+        snprintf(name, sizeof(name), "superblock in block %d only", block);
+        expectAccepted(single, 1436, manifestOf(single), name);
+    }
+    std::vector<uint8_t> swapped = image;
+    std::swap_ranges(swapped.begin(), swapped.begin() + UI_IMAGE_BLOCK_SIZE, swapped.begin() + UI_IMAGE_BLOCK_SIZE);
+    expectAccepted(swapped, 1436, manifestOf(swapped), "superblock pair swapped");
+
+    // Rejected once the header checked out
+    Manifest wrong = manifest;
+    wrong.crc32 = "deadbeef";
+    expectRejected(image, wrong, "CRC mismatch", "CRC mismatch");
+    wrong = manifest;
+    wrong.sha256 = std::string(64, '0');
+    expectRejected(image, wrong, "SHA-256 mismatch", "SHA-256 mismatch");
+    wrong = manifest;
+    wrong.size = image.size() - UI_IMAGE_BLOCK_SIZE;
+    expectRejected(image, wrong, "Size mismatch", "size mismatch");
+
+    std::vector<uint8_t> truncated(image.begin(), image.begin() + image.size() / 2);
+    expectRejected(truncated, Manifest(), "Truncated", "truncated, no manifest");
+    expectRejected(truncated, manifest, "Size mismatch", "truncated, manifest");
+    expectRejected(image, manifest, "interrupted", "interrupted upload", image.size() / 3);
+
+    std::vector<uint8_t> oversize = image;
+    oversize.resize(partition.size + UI_IMAGE_BLOCK_SIZE, 0xff);
+    expectRejected(oversize, Manifest(), "larger than partition", "more data than the partition");
+
+    // Rejected before anything is erased
+    wrong = manifest;
+    wrong.size = partition.size + 1;
+    expectUntouched(image, wrong, "larger than partition", "manifest size larger than partition");
+
+    std::vector<uint8_t> foreign = image;
+    memset(&foreign[8], 0, 8);
+    memset(&foreign[UI_IMAGE_BLOCK_SIZE + 8], 0, 8);
+    expectUntouched(foreign, Manifest(), "Not a LittleFS image", "not a LittleFS image");
+
+    uint32_t partitionSize = partition.size;
+    partition.size = (uint32_t)(image.size() / 2) & ~(uint32_t)(UI_IMAGE_BLOCK_SIZE - 1);
+    expectUntouched(image, Manifest(), "does not fit", "image of more blocks than the partition");
+    partition.size = partitionSize;
+
+    printf("\n%s\n", failures ? "FAILED" : "OK - only complete, verified images are committed");
+    return failures ? 1 : 0;
+}
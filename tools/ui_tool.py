@@ -0,0 +1,231 @@
+#!/usr/bin/env python3
+#
+# Animatronic Eyes
+# Copyright (c) 2025 Zappo-II
+# Licensed under CC BY-NC-SA 4.0
+# https://github.com/Zappo-II/animatronic-eyes
+#
+# Pack the web UI for LittleFS, embed the recovery page, measure page loads
+#
+#   ui_tool.py pack data build/ui-data
+#   ui_tool.py recovery tools/recovery.html recovery_html.h
+#   ui_tool.py manifest build/ui.bin [--query]
+#   ui_tool.py measure http://192.168.4.1
+#
+# pack copies the UI into a staging directory for mklittlefs:
+# - index.html, app.js and style.css are stored as .gz only (served with
+#   Content-Encoding: gzip by the firmware)
+# - a build id (hash of the packed assets) is added to version.json; the
+#   firmware derives the assets' ETag from version + build
+# - index.html references app.js / style.css as "?v=<build>", so the browser may
+#   cache those for a year and fetches new ones only after a UI update
+# Everything else (modes, impulses, clips, version.json) is copied unchanged.
+#
+# manifest writes <image>.json (size, crc32, sha256) next to the LittleFS image;
+# /api/upload-ui takes the same values as query parameters (--query prints them)
+# and verifies the upload against them before the image is committed.
+
+import argparse
+import gzip
+import hashlib
+import http.client
+import json
+import os
+import re
+import shutil
+import sys
+import time
+import urllib.parse
+import zlib
+
+COMPRESSED = ["index.html", "app.js", "style.css"]
+FINGERPRINTED = ["app.js", "style.css"]        # Referenced from index.html
+
+
+def gzip_bytes(data):
+    return gzip.compress(data, compresslevel=9, mtime=0)   # Reproducible output
+
+
+def strip_leading_comment(html):
+    # The license header is kept in the source, not in the served page
+    return re.sub(rb"\A\s*<!--.*?-->\s*", b"", html, flags=re.S)
+
+
+def cmd_pack(args):
+    if os.path.exists(args.output):
+        shutil.rmtree(args.output)
+    shutil.copytree(args.input, args.output)
+
+    sources = {}
+    for name in COMPRESSED:
+        with open(os.path.join(args.input, name), "rb") as f:
+            sources[name] = f.read()
+    build = hashlib.sha256(b"".join(sources[n] for n in COMPRESSED)).hexdigest()[:12]
+
+    html = sources["index.html"]
+    for name in FINGERPRINTED:
+        pattern = re.compile(rb'(src|href)="/?' + re.escape(name.encode()) + rb'"')
+        html, count = pattern.subn(rb'\1="' + name.encode() + b"?v=" + build.encode() + b'"', html)
+        if count != 1:
+            sys.exit("index.html: expected one reference to %s, found %d" % (name, count))
+    sources["index.html"] = html
+
+    raw_total = 0
+    gz_total = 0
+    for name in COMPRESSED:
+        packed = gzip_bytes(sources[name])
+        os.remove(os.path.join(args.output, name))
+        with open(os.path.join(args.output, name + ".gz"), "wb") as f:
+            f.write(packed)
+        raw_total += len(sources[name])
+        gz_total += len(packed)
+        print("  %-12s %8d -> %7d bytes (%4.1f%%)" % (
+            name, len(sources[name]), len(packed), 100.0 * len(packed) / len(sources[name])))
+
+    version_path = os.path.join(args.output, "version.json")
+    with open(version_path) as f:
+        version = json.load(f)
+    version["build"] = build
+    with open(version_path, "w") as f:
+        json.dump(version, f, indent=2)
+        f.write("\n")
+
+    print("%s: UI %s build %s, %d -> %d bytes per first load" % (
+        args.output, version.get("version", "?"), build, raw_total, gz_total))
+
+
+def cmd_recovery(args):
+    with open(args.input, "rb") as f:
+        html = strip_leading_comment(f.read())
+    packed = gzip_bytes(html)
+
+    lines = []
+    for i in range(0, len(packed), 16):
+        lines.append("    " + " ".join("0x%02x," % b for b in packed[i:i + 16]))
+    with open(args.output, "w") as f:
+        f.write("/*\n"
+                " * Animatronic Eyes\n"
+                " * Copyright (c) 2025 Zappo-II\n"
+                " * Licensed under CC BY-NC-SA 4.0\n"
+                " * https://github.com/Zappo-II/animatronic-eyes\n"
+                " */\n\n"
+                "// Generated by tools/ui_tool.py from %s (make recovery) - do not edit\n"
+                "// Embedded recovery UI, gzipped (%d -> %d bytes)\n\n"
+                "#ifndef RECOVERY_HTML_H\n"
+                "#define RECOVERY_HTML_H\n\n"
+                "#include <Arduino.h>\n\n"
+                "static const uint8_t RECOVERY_HTML_GZ[] PROGMEM = {\n"
+                "%s\n"
+                "};\n\n"
+                "#endif // RECOVERY_HTML_H\n" % (
+                    args.input, len(html), len(packed), "\n".join(lines)))
+    print("%s: %d -> %d bytes" % (args.output, len(html), len(packed)))
+
+
+def cmd_manifest(args):
+    path = args.image + ".json"
+    if args.query and os.path.exists(path):
+        # The manifest written at build time, so a changed image fails verification
+        with open(path) as f:
+            print(urllib.parse.urlencode(json.load(f)))
+        return
+    with open(args.image, "rb") as f:
+        image = f.read()
+    manifest = {
+        "size": len(image),
+        "crc32": "%08x" % (zlib.crc32(image) & 0xFFFFFFFF),
+        "sha256": hashlib.sha256(image).hexdigest(),
+    }
+    if args.query:
+        print(urllib.parse.urlencode(manifest))
+        return
+    with open(path, "w") as f:
+        json.dump(manifest, f, indent=2)
+        f.write("\n")
+    print("%s.json: %d bytes, crc32 %s" % (args.image, manifest["size"], manifest["crc32"]))
+
+
+def fetch(conn, path, etags, revalidate):
+    headers = {"Accept-Encoding": "gzip"}
+    if revalidate and path in etags:
+        headers["If-None-Match"] = etags[path]
+    start = time.monotonic()
+    conn.request("GET", path, headers=headers)
+    response = conn.getresponse()
+    body = response.read()
+    elapsed = time.monotonic() - start
+    if response.getheader("ETag"):
+        etags[path] = response.getheader("ETag")
+    header_bytes = sum(len(k) + len(v) + 4 for k, v in response.getheaders())
+    return response, body, header_bytes, elapsed
+
+
+def load_page(conn, etags, assets, revalidate, label):
+    # index.html, then the assets - what a browser does on (re)load. assets=None
+    # takes the references from index.html. Returns the referenced assets.
+    start = time.monotonic()
+    response, body, header_bytes, elapsed = fetch(conn, "/", etags, revalidate)
+    rows = [("/", response.status, len(body) + header_bytes, elapsed, response.getheader("Cache-Control"))]
+    if assets is None:
+        html = gzip.decompress(body) if response.getheader("Content-Encoding") == "gzip" else body
+        refs = re.findall(rb'(?:src|href)="/?((?:app\.js|style\.css)[^"]*)"', html)
+        assets = ["/" + r.decode() for r in refs]
+    for path in assets:
+        response, body, header_bytes, elapsed = fetch(conn, path, etags, revalidate)
+        rows.append((path, response.status, len(body) + header_bytes, elapsed, response.getheader("Cache-Control")))
+    total_ms = (time.monotonic() - start) * 1000
+
+    print(label)
+    for path, status, size, elapsed, cache in rows:
+        print("  %-28s %3d %8d bytes %7.1f ms  %s" % (path, status, size, elapsed * 1000, cache or "-"))
+    print("  %-28s     %8d bytes %7.1f ms" % ("total", sum(row[2] for row in rows), total_ms))
+    return assets
+
+
+def cmd_measure(args):
+    url = urllib.parse.urlparse(args.url if "://" in args.url else "http://" + args.url)
+    etags = {}
+    conn = http.client.HTTPConnection(url.hostname, url.port or 80, timeout=30)
+    assets = load_page(conn, etags, None, False, "First load (empty cache):")
+
+    # Reload: index.html revalidates (304 when unchanged); fingerprinted assets
+    # ("?v=<build>") stay in the browser cache and are not requested at all
+    conn = http.client.HTTPConnection(url.hostname, url.port or 80, timeout=30)
+    cached = [path for path in assets if "?v=" in path]
+    load_page(conn, etags, [path for path in assets if path not in cached], True,
+              "Reload (%d cached assets not requested):" % len(cached))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack and measure the animatronic eyes web UI")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    pack = sub.add_parser("pack", help="UI directory -> LittleFS staging directory")
+    pack.add_argument("input")
+    pack.add_argument("output")
+    pack.set_defaults(func=cmd_pack)
+
+    recovery = sub.add_parser("recovery", help="recovery page -> gzipped PROGMEM header")
+    recovery.add_argument("input")
+    recovery.add_argument("output")
+    recovery.set_defaults(func=cmd_recovery)
+
+    manifest = sub.add_parser("manifest", help="LittleFS image -> size/crc32/sha256 manifest")
+    manifest.add_argument("image")
+    manifest.add_argument("--query", action="store_true",
+                          help="print the manifest (existing one if present) as /api/upload-ui query string")
+    manifest.set_defaults(func=cmd_manifest)
+
+    measure = sub.add_parser("measure", help="first load and reload bytes/time of a device")
+    measure.add_argument("url")
+    measure.set_defaults(func=cmd_measure)
+
+    args = parser.parse_args()
+    try:
+        args.func(args)
+    except (OSError, ValueError, KeyError, http.client.HTTPException) as e:
+        sys.exit(str(e))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,254 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "ui_image_update.h"
+#include "web_server.h"
+#include <LittleFS.h>
+#include <esp_rom_crc.h>
+#include <stdarg.h>
+
+UiImageUpdate uiImageUpdate;
+
+static const size_t HEAD_BYTES = UI_IMAGE_BLOCK_SIZE * UI_IMAGE_HEAD_BLOCKS;
+
+static uint32_t readLe32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t readBe32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+bool UiImageUpdate::begin(size_t expectedSize, const char* crc32Hex, const char* sha256Hex,
+                          void (*onAccepted)()) {
+    release();
+    _onAccepted = onAccepted;
+    _error[0] = '\0';
+    _received = 0;
+    _erasedTo = 0;
+    _imageSize = 0;
+    _maxChunkUs = 0;
+    _unmounted = false;
+    _complete = false;
+    _active = true;
+
+    _expectedSize = expectedSize;
+    _checkCrc = crc32Hex && crc32Hex[0];
+    _expectedCrc = _checkCrc ? strtoul(crc32Hex, nullptr, 16) : 0;
+    _checkSha = sha256Hex && sha256Hex[0];
+    _expectedSha[0] = '\0';
+    if (_checkSha) {
+        if (strlen(sha256Hex) != 64) return fail("Invalid sha256 in manifest");
+        for (int i = 0; i <= 64; i++) _expectedSha[i] = tolower((unsigned char)sha256Hex[i]);
+    }
+
+    _partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, NULL);
+    if (!_partition) return fail("SPIFFS partition not found");
+    WEB_LOG("OTA", "Found partition: %s at 0x%x, size: 0x%x",
+        _partition->label, _partition->address, _partition->size);
+
+    if (_expectedSize > _partition->size) {
+        return fail("Image (%u bytes) larger than partition", (unsigned)_expectedSize);
+    }
+
+    _head = (uint8_t*)malloc(HEAD_BYTES);
+    if (!_head) return fail("Out of memory");
+
+    _crc = 0;
+    mbedtls_sha256_init(&_sha);
+    mbedtls_sha256_starts(&_sha, 0);
+
+    if (!_checkCrc && !_checkSha) {
+        WEB_LOG("OTA", "No manifest - image checked by superblock and mount only");
+    }
+    return true;
+}
+
+bool UiImageUpdate::write(const uint8_t* data, size_t len) {
+    if (!_active || _error[0]) return false;
+    uint32_t startUs = micros();
+
+    if (_received + len > _partition->size) {
+        return fail("Image larger than partition (0x%x)", _partition->size);
+    }
+
+    _crc = esp_rom_crc32_le(_crc, data, len);
+    mbedtls_sha256_update(&_sha, data, len);
+
+    // Superblock pair: held back until the rest is verified
+    if (_received < HEAD_BYTES) {
+        size_t n = min(len, HEAD_BYTES - _received);
+        memcpy(_head + _received, data, n);
+        _received += n;
+        data += n;
+        len -= n;
+
+        if (_received == HEAD_BYTES) {
+            if (!checkHead()) return false;
+            if (_onAccepted) _onAccepted();
+
+            // Image looks right: from here on the old filesystem is gone.
+            // Its superblock pair is erased first, so an interrupted upload
+            // leaves an unmountable partition, never a half-written one
+            LittleFS.end();
+            _unmounted = true;
+            WEB_LOG("OTA", "LittleFS unmounted, writing %u byte image", _imageSize);
+            esp_err_t err = esp_partition_erase_range(_partition, 0, HEAD_BYTES);
+            if (err != ESP_OK) return fail("Failed to erase: %s", esp_err_to_name(err));
+            _erasedTo = HEAD_BYTES;
+        }
+    }
+
+    if (len > 0) {
+        if (!program(_received, data, len)) return false;
+        _received += len;
+    }
+
+    uint32_t elapsedUs = micros() - startUs;
+    if (elapsedUs > _maxChunkUs) _maxChunkUs = elapsedUs;
+    return true;
+}
+
+bool UiImageUpdate::finish() {
+    if (!_active) return false;
+
+    if (_received < HEAD_BYTES) return fail("Image too small (%u bytes)", (unsigned)_received);
+    if (_expectedSize && _received != _expectedSize) {
+        return fail("Size mismatch: got %u, manifest %u", (unsigned)_received, (unsigned)_expectedSize);
+    }
+    if (_received < _imageSize) {
+        return fail("Truncated image: got %u of %u bytes", (unsigned)_received, _imageSize);
+    }
+    if (_checkCrc && _crc != _expectedCrc) {
+        return fail("CRC mismatch: %08x, manifest %08x", _crc, _expectedCrc);
+    }
+    if (_checkSha) {
+        uint8_t digest[32];
+        char hex[65];
+        mbedtls_sha256_finish(&_sha, digest);
+        for (int i = 0; i < 32; i++) snprintf(hex + i * 2, 3, "%02x", digest[i]);
+        if (strcmp(hex, _expectedSha) != 0) return fail("SHA-256 mismatch");
+    }
+
+    // Everything else is in place and verified: commit the superblock pair
+    if (!program(0, _head, HEAD_BYTES)) return false;
+
+    if (!LittleFS.begin(false)) return fail("Image written but does not mount");
+
+    WEB_LOG("OTA", "Filesystem image verified: %u bytes, CRC %08x, longest chunk %u ms",
+        (unsigned)_received, _crc, _maxChunkUs / 1000);
+    release();
+    _complete = true;
+    return true;
+}
+
+void UiImageUpdate::abort(const char* error) {
+    if (!_active) return;
+    fail("%s", error);
+}
+
+bool UiImageUpdate::fail(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(_error, sizeof(_error), format, args);
+    va_end(args);
+
+    WEB_LOG("OTA", "ERROR: %s%s", _error, _unmounted ? " (partition left without a filesystem)" : "");
+    release();
+    return false;
+}
+
+bool UiImageUpdate::checkHead() {
+    // The superblock is in whichever block of the pair has the newer revision
+    const uint8_t* superblock = nullptr;
+    uint32_t revision = 0;
+    uint32_t version = 0, blockSize = 0, blockCount = 0;
+    for (int i = 0; i < UI_IMAGE_HEAD_BLOCKS; i++) {
+        const uint8_t* block = _head + i * UI_IMAGE_BLOCK_SIZE;
+        uint32_t v, size, count;
+        if (!readSuperblock(block, v, size, count)) continue;
+        uint32_t rev = readLe32(block);
+        if (!superblock || (int32_t)(rev - revision) > 0) {
+            superblock = block;
+            revision = rev;
+            version = v;
+            blockSize = size;
+            blockCount = count;
+        }
+    }
+    if (!superblock) return fail("Not a LittleFS image");
+
+    if ((version >> 16) != 2) return fail("Unsupported LittleFS version %u.%u", version >> 16, version & 0xffff);
+    if (blockSize != UI_IMAGE_BLOCK_SIZE) return fail("Block size %u, expected %u", blockSize, UI_IMAGE_BLOCK_SIZE);
+    if ((uint64_t)blockSize * blockCount > _partition->size || blockCount < UI_IMAGE_HEAD_BLOCKS) {
+        return fail("Image of %u blocks does not fit partition", blockCount);
+    }
+    _imageSize = blockSize * blockCount;
+    return true;
+}
+
+bool UiImageUpdate::readSuperblock(const uint8_t* block, uint32_t& version, uint32_t& blockSize, uint32_t& blockCount) {
+    // LittleFS v2 metadata block: [revision:4] then big-endian tags, each XORed
+    // with the previous one (the first with 0xffffffff) and followed by its data.
+    // The superblock's name tag ("littlefs") always comes first, its inline
+    // struct (version, block_size, block_count, ...) follows in the same commit.
+    if (memcmp(block + 8, "littlefs", 8) != 0) return false;
+
+    uint32_t previous = 0xffffffff;
+    size_t offset = 4;
+    while (offset + 4 <= UI_IMAGE_BLOCK_SIZE) {
+        uint32_t tag = readBe32(block + offset) ^ previous;
+        if (tag & 0x80000000) return false;                // Invalid tag
+        uint16_t type = (tag >> 20) & 0x7ff;
+        uint16_t id = (tag >> 10) & 0x3ff;
+        uint16_t size = tag & 0x3ff;
+        if ((type & 0x700) == 0x500) return false;         // CRC: end of commit, no struct
+        offset += 4;
+        if (type == 0x201 && id == 0) {                    // Inline struct of the superblock
+            if (size < 12 || offset + 12 > UI_IMAGE_BLOCK_SIZE) return false;
+            version = readLe32(block + offset);
+            blockSize = readLe32(block + offset + 4);
+            blockCount = readLe32(block + offset + 8);
+            return true;
+        }
+        if (size != 0x3ff) offset += size;                 // 0x3ff: deleted, no data
+        previous = tag;
+    }
+    return false;
+}
+
+bool UiImageUpdate::program(size_t offset, const uint8_t* data, size_t len) {
+    // Erase one sector at a time, just ahead of what is written
+    while (_erasedTo < offset + len) {
+        esp_err_t err = esp_partition_erase_range(_partition, _erasedTo, UI_IMAGE_BLOCK_SIZE);
+        if (err != ESP_OK) return fail("Erase failed at 0x%x: %s", (unsigned)_erasedTo, esp_err_to_name(err));
+        _erasedTo += UI_IMAGE_BLOCK_SIZE;
+    }
+
+    esp_err_t err = esp_partition_write(_partition, offset, data, len);
+    if (err != ESP_OK) return fail("Write failed at 0x%x: %s", (unsigned)offset, esp_err_to_name(err));
+
+    // Read back and compare
+    uint8_t check[256];
+    for (size_t done = 0; done < len; done += sizeof(check)) {
+        size_t n = min(len - done, sizeof(check));
+        err = esp_partition_read(_partition, offset + done, check, n);
+        if (err != ESP_OK || memcmp(check, data + done, n) != 0) {
+            return fail("Verify failed at 0x%x", (unsigned)(offset + done));
+        }
+    }
+    return true;
+}
+
+void UiImageUpdate::release() {
+    if (_head) {
+        free(_head);
+        _head = nullptr;
+        mbedtls_sha256_free(&_sha);
+    }
+    _active = false;
+}
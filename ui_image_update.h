@@ -0,0 +1,81 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef UI_IMAGE_UPDATE_H
+#define UI_IMAGE_UPDATE_H
+
+#include <Arduino.h>
+#include <esp_partition.h>
+#include <mbedtls/sha256.h>
+#include "config.h"
+
+// UI Image Update - Verified LittleFS image write for /api/upload-ui
+// The image (ui.bin from make build-ui) goes straight into the spiffs partition:
+// - The first UI_IMAGE_HEAD_BLOCKS blocks (the LittleFS superblock pair) are held
+//   back in RAM. Once they are in, the superblock is checked (magic, block size,
+//   block count vs. partition); a non-LittleFS image is rejected before anything
+//   is erased and the current UI stays mounted.
+// - Every other block is erased just ahead of the write pointer, one sector at a
+//   time, so no chunk handler blocks for more than one erase. Each write is read
+//   back and compared.
+// - A running CRC32 (and SHA-256) of the upload is compared against the manifest
+//   (size / crc32 / sha256 query parameters of the request, see ui.bin.json).
+// - Only then the superblock pair is written - an interrupted or mismatching
+//   upload never leaves a mountable half-written filesystem - and the result is
+//   test-mounted before the device reboots.
+//
+// Async context only (one upload at a time, the upload handler's chunks).
+
+class UiImageUpdate {
+public:
+    // Manifest values are optional: expectedSize 0 / nullptr = not checked.
+    // onAccepted runs once the image header checks out, right before the current
+    // filesystem is unmounted (stop whatever reads LittleFS); a rejected image
+    // never calls it.
+    bool begin(size_t expectedSize, const char* crc32Hex, const char* sha256Hex,
+               void (*onAccepted)() = nullptr);
+    bool write(const uint8_t* data, size_t len);  // Next chunk; false once failed
+    bool finish();                                // Verify, commit superblock, test mount
+    void abort(const char* error);                // Upload interrupted
+    bool isActive() const { return _active; }
+    bool isComplete() const { return _complete; }  // Last finish() succeeded
+    const char* getError() const { return _error; }
+
+private:
+    const esp_partition_t* _partition = nullptr;
+    bool _active = false;
+    bool _unmounted = false;     // LittleFS released, erasing started
+    bool _complete = false;
+    char _error[64] = "";
+    void (*_onAccepted)() = nullptr;
+
+    uint8_t* _head = nullptr;    // Superblock pair, written last
+    size_t _received = 0;
+    size_t _erasedTo = 0;        // Sectors below this offset are erased
+    uint32_t _imageSize = 0;     // From the superblock
+    uint32_t _maxChunkUs = 0;    // Longest write() (erase + write + read-back)
+
+    // Manifest
+    size_t _expectedSize = 0;
+    bool _checkCrc = false;
+    uint32_t _expectedCrc = 0;
+    bool _checkSha = false;
+    char _expectedSha[65] = "";
+
+    uint32_t _crc = 0;
+    mbedtls_sha256_context _sha;
+
+    bool fail(const char* format, ...);
+    bool checkHead();
+    static bool readSuperblock(const uint8_t* block, uint32_t& version, uint32_t& blockSize, uint32_t& blockCount);
+    bool program(size_t offset, const uint8_t* data, size_t len);
+    void release();
+};
+
+extern UiImageUpdate uiImageUpdate;
+
+#endif // UI_IMAGE_UPDATE_H
@@ -32,20 +32,22 @@ void UpdateChecker::begin() {
         }
     }
 
+    _timer = scheduler.add([]() { updateChecker.onTimer(); });
     if (_enabled) {
-        _nextCheckTime = millis() + UPDATE_CHECK_BOOT_DELAY_MS + random(UPDATE_CHECK_JITTER_MS);
+        scheduler.arm(_timer, UPDATE_CHECK_BOOT_DELAY_MS + random(UPDATE_CHECK_JITTER_MS));
     }
 }
 
-void UpdateChecker::loop() {
-    if (!_enabled && !_checkInProgress) return;
-    if (shouldCheck()) performCheck();
-}
+void UpdateChecker::onTimer() {
+    if (!_enabled || _checkInProgress) return;  // Re-armed by setEnabled()
+
+    // Check is due but no network yet - try again later
+    if (!wifiManager.isConnected()) {
+        scheduler.arm(_timer, UPDATE_CHECK_WIFI_RETRY_MS);
+        return;
+    }
 
-bool UpdateChecker::shouldCheck() {
-    if (_checkInProgress) return false;
-    if (!wifiManager.isConnected()) return false;
-    return millis() >= _nextCheckTime;
+    performCheck();
 }
 
 void UpdateChecker::checkNow() {
@@ -120,14 +122,14 @@ void UpdateChecker::scheduleNextCheck() {
     unsigned long intervalMs = getIntervalMs();
 
     if (intervalMs == 0) {
-        // Boot-only mode - set far future
-        _nextCheckTime = 0xFFFFFFFF;
+        // Boot-only mode - no further checks
+        scheduler.disarm(_timer);
         return;
     }
 
     // Add random jitter to prevent thundering herd
     unsigned long jitter = random(UPDATE_CHECK_JITTER_MS);
-    _nextCheckTime = millis() + intervalMs + jitter;
+    scheduler.arm(_timer, intervalMs + jitter);
 
     WEB_LOG("UpdateChecker", "Next check in %lu ms", intervalMs + jitter);
 }
@@ -182,7 +184,9 @@ void UpdateChecker::setEnabled(bool enabled) {
 
     if (enabled && !_bootCheckDone) {
         // Schedule check soon
-        _nextCheckTime = millis() + UPDATE_CHECK_BOOT_DELAY_MS;
+        scheduler.arm(_timer, UPDATE_CHECK_BOOT_DELAY_MS);
+    } else if (enabled && !scheduler.isArmed(_timer)) {
+        scheduleNextCheck();
     }
 }
 
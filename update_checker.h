@@ -11,11 +11,13 @@
 #include <Arduino.h>
 #include "config.h"
 #include "storage.h"
+#include "scheduler.h"
+
+// Update Checker - Periodic GitHub version check (scheduler timer, no per-loop polling)
 
 class UpdateChecker {
 public:
     void begin();
-    void loop();
 
     // Manual trigger (always allowed, not admin-protected)
     void checkNow();
@@ -36,7 +38,7 @@ private:
     bool _updateAvailable = false;
     char _availableVersion[16] = "";
     unsigned long _lastCheckTime = 0;
-    unsigned long _nextCheckTime = 0;
+    TimerId _timer = TIMER_INVALID;
     bool _checkInProgress = false;
     bool _bootCheckDone = false;
 
@@ -46,7 +48,7 @@ private:
 
     void performCheck();
     void scheduleNextCheck();
-    bool shouldCheck();
+    void onTimer();
     unsigned long getIntervalMs() const;
     bool isNewerVersion(const char* remote, const char* local);
 };
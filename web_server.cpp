@@ -6,6 +6,8 @@
  */
 
 #include "web_server.h"
+#include "ws_flat_message.h"
+#include "ws_reassembly.h"
 #include "config.h"
 #include "storage.h"
 #include "wifi_manager.h"
@@ -16,391 +18,138 @@
 #include "mode_manager.h"
 #include "mode_player.h"
 #include "impulse_player.h"
+#include "clip_player.h"
 #include "auto_impulse.h"
 #include "update_checker.h"
+#include "latency_trace.h"
+#include "power_manager.h"
+#include "content_index.h"
+#include "backup.h"
+#include "ui_image_update.h"
+#include "ota_delta.h"
+#include "sequence.h"
+#include "recovery_html.h"  // Embedded recovery UI (gzipped, always available even if LittleFS is corrupted)
 
 #include <ESPAsyncWebServer.h>
 #include <stdarg.h>
 #include <ArduinoJson.h>
 #include <LittleFS.h>
 #include <Update.h>
-#include <esp_partition.h>
+#include <esp_ota_ops.h>
+#include <esp_task_wdt.h>
+#include <mbedtls/sha256.h>
 
 WebServer webServer;
 
-// Filesystem update state (file scope for lambda access)
-static const esp_partition_t* fsUpdatePartition = nullptr;
-static bool fsUpdateError = false;
-static String fsUpdateErrorMsg = "";
+// UI upload auth tracking
+static bool uiUploadAuthFailed = false;
 
 // Firmware update auth tracking
 static bool fwUpdateAuthFailed = false;
 
-// Restore auth tracking
-static bool restoreAuthFailed = false;
+// Delta firmware update (ota_delta.h): the running app partition is the source,
+// the rebuilt image is written through Update like a full upload
+static bool fwDeltaUpdate = false;
+static const char* fwUpdateError = nullptr;
+static bool fwDeltaShaActive = false;
+static mbedtls_sha256_context fwDeltaSha;  // Of the rebuilt image
 
-// Embedded recovery UI - always available even if LittleFS is corrupted
-static const char RECOVERY_HTML[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-<meta charset="UTF-8">
-<meta name="viewport" content="width=device-width, initial-scale=1.0">
-<title>Animatronic Eyes - Recovery</title>
-<style>
-*{box-sizing:border-box;margin:0;padding:0}
-body{font-family:-apple-system,BlinkMacSystemFont,"Segoe UI",Roboto,sans-serif;background:#1a1a2e;color:#eee;min-height:100vh;padding:20px}
-.container{max-width:600px;margin:0 auto}
-h1{color:#e94560;margin-bottom:10px;font-size:1.5em}
-.subtitle{color:#888;margin-bottom:30px}
-.card{background:#16213e;border-radius:12px;padding:20px;margin-bottom:20px}
-.card h2{color:#e94560;font-size:1.1em;margin-bottom:15px;display:flex;align-items:center;gap:8px}
-.warning{background:#e9456020;border:1px solid #e94560;border-radius:8px;padding:15px;margin-bottom:20px;font-size:0.9em}
-.warning strong{color:#e94560}
-.info{background:#0f3460;border-radius:8px;padding:15px;margin-bottom:15px;font-size:0.9em}
-.info code{background:#1a1a2e;padding:2px 6px;border-radius:4px;font-size:0.85em}
-label{display:block;margin-bottom:8px;color:#aaa;font-size:0.9em}
-input[type="file"]{width:100%;padding:12px;background:#0f3460;border:2px dashed #e94560;border-radius:8px;color:#eee;margin-bottom:15px;cursor:pointer}
-input[type="file"]:hover{background:#1a4080}
-.btn{display:inline-block;padding:12px 24px;border:none;border-radius:8px;font-size:1em;cursor:pointer;transition:all 0.2s}
-.btn-primary{background:#e94560;color:#fff}
-.btn-primary:hover{background:#ff6b6b}
-.btn-primary:disabled{background:#666;cursor:not-allowed}
-.btn-secondary{background:#0f3460;color:#eee;margin-left:10px}
-.btn-secondary:hover{background:#1a4080}
-.progress{display:none;margin-top:15px}
-.progress-bar{height:20px;background:#0f3460;border-radius:10px;overflow:hidden}
-.progress-fill{height:100%;background:#e94560;width:0%;transition:width 0.3s}
-.progress-text{text-align:center;margin-top:8px;font-size:0.9em;color:#aaa}
-.status{margin-top:15px;padding:10px;border-radius:8px;display:none}
-.status.success{display:block;background:#2e7d3220;border:1px solid #2e7d32;color:#4caf50}
-.status.error{display:block;background:#e9456020;border:1px solid #e94560;color:#e94560}
-.version-info{display:flex;justify-content:space-between;padding:10px;background:#0f3460;border-radius:8px;margin-bottom:15px;font-size:0.9em}
-.version-info span:first-child{color:#888}
-a{color:#e94560}
-</style>
-</head>
-<body>
-<div class="container">
-<h1>Recovery Mode</h1>
-<p class="subtitle">Upload firmware or UI files</p>
-
-<div class="warning" id="status-banner" style="display:none">
-<strong id="status-title">Status:</strong> <span id="status-message">Loading...</span>
-</div>
-
-<div class="info" style="margin-bottom:20px">
-<strong>Note:</strong> This recovery page is shown when the main UI cannot be loaded safely.
-</div>
-
-<div class="card">
-<h2>System Info</h2>
-<div class="version-info"><span>Firmware</span><span id="fw-version">-</span></div>
-<div class="version-info"><span>Min UI Required</span><span id="min-ui-version">-</span></div>
-<div class="version-info"><span>UI Version</span><span id="ui-version">-</span></div>
-<div class="version-info"><span>UI Requires Firmware</span><span id="ui-min-fw">-</span></div>
-<div class="version-info"><span>Free Heap</span><span id="free-heap">-</span></div>
-<div class="version-info" id="update-row" style="display:none;color:#f39c12"><span>Update Available</span><span id="update-version">-</span></div>
-</div>
-
-<div class="warning" id="lock-banner" style="display:none">
-<strong>Admin Lock Active:</strong> Some actions are disabled.
-<div style="margin-top:10px;display:flex;gap:8px;align-items:center;flex-wrap:wrap">
-<input type="password" id="pin-input" placeholder="Enter PIN" maxlength="6" inputmode="numeric" style="width:100px;padding:8px;border-radius:4px;border:1px solid #e94560;background:#0f3460;color:#eee">
-<button class="btn btn-primary" onclick="unlock()" style="padding:8px 16px">Unlock</button>
-<span style="color:#888;font-size:0.85em">or connect via AP (192.168.4.1)</span>
-</div>
-<div id="pin-error" style="color:#ff6b6b;margin-top:8px;font-size:0.9em"></div>
-</div>
-
-<div class="card">
-<h2>Actions</h2>
-<div style="display:flex;flex-wrap:wrap;gap:10px">
-<button class="btn btn-secondary" onclick="location.href='/'">Go to Main UI</button>
-<button class="btn btn-secondary" onclick="downloadBackup()" id="backup-btn">Download Backup</button>
-<button class="btn btn-secondary" onclick="reboot()" id="reboot-btn">Reboot</button>
-</div>
-</div>
-
-<div class="card">
-<h2>Upload Firmware (.bin)</h2>
-<div class="info">Upload a new firmware binary to update the device.<br>
-Create with: <code>Sketch → Export Compiled Binary</code> in Arduino IDE.<br>
-Use the main .bin file (not bootloader/partitions), e.g. <code>animatronic-eyes.ino.bin</code></div>
-<form id="fw-form">
-<input type="file" id="fw-file" accept=".bin">
-<button type="submit" class="btn btn-primary" id="fw-btn">Upload Firmware</button>
-</form>
-<div class="progress" id="fw-progress">
-<div class="progress-bar"><div class="progress-fill" id="fw-fill"></div></div>
-<div class="progress-text" id="fw-text">0%</div>
-</div>
-<div class="status" id="fw-status"></div>
-</div>
-
-<div class="card">
-<h2>Upload UI Files (.bin)</h2>
-<div class="info">
-Upload a LittleFS image containing UI files.<br>
-Create with: <code id="mklittlefs-cmd">mklittlefs -c data/ -p 256 -b 4096 -s ... ui.bin</code>
-</div>
-<form id="ui-form">
-<input type="file" id="ui-file" accept=".bin">
-<button type="submit" class="btn btn-primary" id="ui-btn">Upload UI</button>
-</form>
-<div class="progress" id="ui-progress">
-<div class="progress-bar"><div class="progress-fill" id="ui-fill"></div></div>
-<div class="progress-text" id="ui-text">0%</div>
-</div>
-<div class="status" id="ui-status"></div>
-</div>
-
-<div class="card danger-zone">
-<h2>Danger Zone</h2>
-<div class="info">These actions cannot be undone.</div>
-<div style="display:flex;flex-wrap:wrap;gap:10px">
-<button class="btn btn-secondary" onclick="wipeUI()" id="wipe-btn" style="background:#c0392b">Wipe UI Files</button>
-<button class="btn btn-secondary" onclick="factoryReset()" style="background:#c0392b">Factory Reset</button>
-</div>
-</div>
-</div>
-
-<script>
-let isLocked = false;
-let lockoutSeconds = 0;
-
-async function checkAdminStatus() {
-  try {
-    const r = await fetch('/api/admin-status');
-    const d = await r.json();
-    isLocked = d.locked;
-    lockoutSeconds = d.lockoutSeconds || 0;
-    if (isLocked) {
-      document.getElementById('lock-banner').style.display = 'block';
-      // Disable protected controls
-      ['fw-btn', 'ui-btn', 'backup-btn', 'wipe-btn'].forEach(id => {
-        const el = document.getElementById(id);
-        if (el) { el.disabled = true; el.style.opacity = '0.5'; el.style.cursor = 'not-allowed'; }
-      });
-      // Also disable file inputs
-      ['fw-file', 'ui-file'].forEach(id => {
-        const el = document.getElementById(id);
-        if (el) { el.disabled = true; el.style.opacity = '0.5'; }
-      });
-    }
-    // Reboot: allowed when locked, blocked only when rate limited
-    const rebootBtn = document.getElementById('reboot-btn');
-    if (rebootBtn && lockoutSeconds > 0) {
-      rebootBtn.disabled = true;
-      rebootBtn.style.opacity = '0.5';
-      rebootBtn.style.cursor = 'not-allowed';
-    }
-  } catch(e) { console.error('Admin status check failed:', e); }
-}
-
-async function unlock() {
-  const pin = document.getElementById('pin-input').value;
-  const errEl = document.getElementById('pin-error');
-  errEl.textContent = '';
-  if (!pin) { errEl.textContent = 'Enter PIN'; return; }
-  try {
-    const r = await fetch('/api/unlock', {
-      method: 'POST',
-      headers: {'Content-Type': 'application/json'},
-      body: JSON.stringify({pin})
-    });
-    if (r.ok) {
-      location.reload();
-    } else {
-      errEl.textContent = await r.text();
-    }
-  } catch(e) { errEl.textContent = 'Request failed'; }
-}
-
-async function loadInfo() {
-  try {
-    const r = await fetch('/api/version');
-    const d = await r.json();
-    document.getElementById('fw-version').textContent = d.version || '-';
-    document.getElementById('min-ui-version').textContent = d.minUiVersion || '-';
-    document.getElementById('ui-version').textContent = d.uiVersion || 'Not installed';
-    document.getElementById('ui-min-fw').textContent = d.uiMinFirmware || '-';
-    document.getElementById('free-heap').textContent = d.freeHeap ? (d.freeHeap/1024).toFixed(1)+' KB' : '-';
-    if (d.partitionSize) {
-      const hex = '0x' + d.partitionSize.toString(16).toUpperCase();
-      document.getElementById('mklittlefs-cmd').textContent = 'mklittlefs -c data/ -p 256 -b 4096 -s ' + hex + ' ui.bin';
-    }
-    // Show status banner with appropriate message
-    const banner = document.getElementById('status-banner');
-    const title = document.getElementById('status-title');
-    const msg = document.getElementById('status-message');
-    const status = d.uiStatus;
-    if (status === 'missing') {
-      banner.style.display = 'block';
-      title.textContent = 'UI Missing:';
-      msg.textContent = 'No UI files found. Upload a UI image below.';
-    } else if (status === 'fw_too_old') {
-      banner.style.display = 'block';
-      title.textContent = 'Firmware Too Old:';
-      msg.textContent = 'UI requires firmware ' + d.uiMinFirmware + ' but device has ' + d.version + '. Upload newer firmware below.';
-    } else if (status === 'ui_too_old') {
-      banner.style.display = 'block';
-      title.textContent = 'UI Too Old:';
-      msg.textContent = 'Firmware requires UI ' + d.minUiVersion + ' but device has ' + d.uiVersion + '. Upload newer UI below.';
-    }
-    // Show update available if cached
-    if (d.updateAvailable && d.updateVersion) {
-      document.getElementById('update-row').style.display = 'flex';
-      const link = document.createElement('a');
-      link.href = 'https://github.com/Zappo-II/animatronic-eyes/releases';
-      link.target = '_blank';
-      link.textContent = 'v' + d.updateVersion;
-      link.style.color = '#f39c12';
-      const span = document.getElementById('update-version');
-      span.innerHTML = '';
-      span.appendChild(link);
-    }
-  } catch(e) { console.error(e); }
-}
-
-function upload(formId, fileId, endpoint, progressId, fillId, textId, statusId, btnId) {
-  const form = document.getElementById(formId);
-  const fileInput = document.getElementById(fileId);
-  const progress = document.getElementById(progressId);
-  const fill = document.getElementById(fillId);
-  const text = document.getElementById(textId);
-  const status = document.getElementById(statusId);
-  const btn = document.getElementById(btnId);
-
-  form.onsubmit = async (e) => {
-    e.preventDefault();
-    const file = fileInput.files[0];
-    if (!file) { alert('Select a file first'); return; }
-
-    btn.disabled = true;
-    progress.style.display = 'block';
-    status.className = 'status';
-    status.style.display = 'none';
-
-    let uploadComplete = false;
-    let handled = false;
-
-    const xhr = new XMLHttpRequest();
-    xhr.open('POST', endpoint, true);
-
-    xhr.upload.onprogress = (e) => {
-      if (e.lengthComputable) {
-        const pct = Math.round((e.loaded / e.total) * 100);
-        fill.style.width = pct + '%';
-        if (pct === 100) {
-          uploadComplete = true;
-          text.textContent = 'Processing...';
-        } else {
-          text.textContent = pct + '%';
-        }
-      }
-    };
-
-    const showSuccess = () => {
-      if (handled) return;
-      handled = true;
-      btn.disabled = false;
-      status.className = 'status success';
-      status.textContent = 'Upload successful! Device will restart...';
-      setTimeout(() => location.href = '/', 4000);
-    };
-
-    const showError = (msg) => {
-      if (handled) return;
-      handled = true;
-      btn.disabled = false;
-      status.className = 'status error';
-      status.textContent = 'Upload failed: ' + msg;
-    };
-
-    xhr.onload = () => {
-      if (xhr.status === 200 && xhr.responseText === 'OK') {
-        showSuccess();
-      } else {
-        showError(xhr.responseText || 'Unknown error');
-      }
-    };
-
-    xhr.onerror = () => {
-      if (uploadComplete) {
-        showSuccess();
-      } else {
-        showError('Network error');
-      }
-    };
-
-    // Fallback: if upload reached 100% and no response after 2s, assume success
-    setTimeout(() => {
-      if (uploadComplete && !handled) showSuccess();
-    }, 2000);
-
-    const formData = new FormData();
-    formData.append('file', file, file.name);
-    xhr.send(formData);
-  };
-}
-
-async function reboot() {
-  if (!confirm('Reboot device?')) return;
-  fetch('/api/reboot', {method:'POST'}).catch(() => {});
-  alert('Device rebooting...');
-  setTimeout(() => location.href = '/', 3000);
-}
-
-async function downloadBackup() {
-  if (isLocked) { alert('Admin lock active. Connect via AP to unlock.'); return; }
-  try {
-    const r = await fetch('/api/backup');
-    if (!r.ok) throw new Error(await r.text());
-    const backup = await r.json();
-    const blob = new Blob([JSON.stringify(backup, null, 2)], {type: 'application/json'});
-    const url = URL.createObjectURL(blob);
-    const ts = new Date().toISOString().replace(/[:.]/g, '-').slice(0, 19);
-    const fn = 'animatronic-eyes-' + (backup.device || 'unknown') + '-' + ts + '.json';
-    const a = document.createElement('a');
-    a.href = url; a.download = fn;
-    document.body.appendChild(a); a.click();
-    document.body.removeChild(a);
-    URL.revokeObjectURL(url);
-    alert('Backup downloaded');
-  } catch(e) { alert('Backup failed: ' + e.message); }
-}
-
-async function wipeUI() {
-  if (isLocked) { alert('Admin lock active. Connect via AP to unlock.'); return; }
-  if (!confirm('Wipe all UI files? You will need to upload a new UI image.')) return;
-  try {
-    const r = await fetch('/api/wipe-ui', {method:'POST'});
-    if (r.ok) {
-      alert('UI files wiped.');
-      location.href = '/';
-    } else {
-      alert('Wipe failed: ' + await r.text());
+static void endDeltaSha() {
+    if (fwDeltaShaActive) {
+        mbedtls_sha256_free(&fwDeltaSha);
+        fwDeltaShaActive = false;
     }
-  } catch(e) { alert('Wipe request failed'); }
 }
 
-async function factoryReset() {
-  if (!confirm('Factory reset will erase ALL settings including WiFi credentials. Continue?')) return;
-  if (!confirm('Are you really sure? This cannot be undone!')) return;
-  fetch('/api/factory-reset', {method:'POST'}).catch(() => {});
-  alert('Factory reset complete. Device rebooting...');
-  setTimeout(() => location.href = '/', 3000);
+// Servo activity stops once an upload is accepted (flash erase current, files
+// about to be replaced) - a rejected upload leaves the device running
+static void stopMotionForUpload() {
+    autoBlink.pause();
+    autoImpulse.pause();
+    impulsePlayer.stop();
+    modeManager.requestMode(Mode::NONE);
+    ledStatus.veryFastBlink();  // OTA indicator
+}
+
+static const char* deltaBegin(void* context, const OtaDeltaHeader& header) {
+    const esp_partition_t* running = esp_ota_get_running_partition();
+    if (!running || header.sourceSize > running->size) return "Base mismatch (running firmware is not the patch base)";
+
+    // The patch only applies to the exact image it was made from
+    uint8_t buffer[OTA_DELTA_BUFFER_BYTES];
+    uint8_t digest[32];
+    mbedtls_sha256_context sha;
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts(&sha, 0);
+    for (uint32_t offset = 0; offset < header.sourceSize; offset += sizeof(buffer)) {
+        size_t n = min((size_t)(header.sourceSize - offset), sizeof(buffer));
+        if (esp_partition_read(running, offset, buffer, n) != ESP_OK) {
+            mbedtls_sha256_free(&sha);
+            return "Cannot read running firmware";
+        }
+        mbedtls_sha256_update(&sha, buffer, n);
+        if ((offset & 0xFFFF) == 0) esp_task_wdt_reset();
+    }
+    mbedtls_sha256_finish(&sha, digest);
+    mbedtls_sha256_free(&sha);
+    if (memcmp(digest, header.sourceSha256, sizeof(digest)) != 0) {
+        return "Base mismatch (running firmware is not the patch base)";
+    }
+
+    WEB_LOG("OTA", "Delta base verified, rebuilding %u byte image", header.targetSize);
+    if (!Update.begin(header.targetSize)) {
+        Update.printError(Serial);
+        return "Update.begin failed";
+    }
+    stopMotionForUpload();
+    endDeltaSha();
+    mbedtls_sha256_init(&fwDeltaSha);
+    mbedtls_sha256_starts(&fwDeltaSha, 0);
+    fwDeltaShaActive = true;
+    return nullptr;
+}
+
+static bool deltaRead(void* context, uint32_t offset, uint8_t* buffer, size_t len) {
+    return esp_partition_read(esp_ota_get_running_partition(), offset, buffer, len) == ESP_OK;
+}
+
+static bool deltaWrite(void* context, const uint8_t* data, size_t len) {
+    mbedtls_sha256_update(&fwDeltaSha, data, len);
+    bool ok = Update.write((uint8_t*)data, len) == len;
+    // One patch chunk can expand to many flash sectors (long unchanged runs)
+    esp_task_wdt_reset();
+    return ok;
+}
+
+static void deltaUpdateFailed(const char* error) {
+    fwUpdateError = error;
+    WEB_LOG("OTA", "Delta update failed: %s", error);
+    if (Update.isRunning()) Update.abort();
+    endDeltaSha();
+}
+
+static bool finishDeltaUpdate() {
+    if (!otaDelta.finish()) {
+        deltaUpdateFailed(otaDelta.getError());
+        return false;
+    }
+    uint8_t digest[32];
+    mbedtls_sha256_finish(&fwDeltaSha, digest);
+    endDeltaSha();
+    if (memcmp(digest, otaDelta.getHeader().targetSha256, sizeof(digest)) != 0) {
+        deltaUpdateFailed("Rebuilt image does not match patch (SHA-256)");
+        return false;
+    }
+    return true;
 }
 
-upload('fw-form', 'fw-file', '/update', 'fw-progress', 'fw-fill', 'fw-text', 'fw-status', 'fw-btn');
-upload('ui-form', 'ui-file', '/api/upload-ui', 'ui-progress', 'ui-fill', 'ui-text', 'ui-status', 'ui-btn');
-loadInfo();
-checkAdminStatus();
-</script>
-</body>
-</html>
-)rawliteral";
+// Restore auth tracking
+static bool restoreAuthFailed = false;
+
+// Mode a restore stopped - resumed when the restore fails (success reboots)
+static Mode restorePrevMode = Mode::NONE;
+static char restorePrevAutoMode[32] = "";
+
 
 static AsyncWebServer server(HTTP_PORT);
 static AsyncWebSocket ws(WEBSOCKET_PATH);
@@ -431,21 +180,30 @@ void WebServer::begin() {
     setupWebSocket();
     setupRoutes();
 
+    _broadcastTimer = scheduler.add([]() { webServer.onBroadcastTimer(); });
+    scheduler.arm(_broadcastTimer, WS_BROADCAST_INTERVAL_MS);
+
     server.begin();
     WEB_LOG("WebServer", "Started on port %d", HTTP_PORT);
 }
 
+// UI assets are stored as <name>.gz by make build-ui (tools/ui_tool.py pack);
+// plain files (e.g. a data/ directory flashed as is) work too
+static bool uiFileExists(const char* path) {
+    return LittleFS.exists(path) || LittleFS.exists(String(path) + ".gz");
+}
+
 bool WebServer::checkUIFiles() {
     // Check for required UI files
-    if (!LittleFS.exists("/index.html")) {
+    if (!uiFileExists("/index.html")) {
         WEB_LOG("WebServer", "Missing: index.html");
         return false;
     }
-    if (!LittleFS.exists("/style.css")) {
+    if (!uiFileExists("/style.css")) {
         WEB_LOG("WebServer", "Missing: style.css");
         return false;
     }
-    if (!LittleFS.exists("/app.js")) {
+    if (!uiFileExists("/app.js")) {
         WEB_LOG("WebServer", "Missing: app.js");
         return false;
     }
@@ -459,6 +217,7 @@ bool WebServer::checkUIFiles() {
 void WebServer::loadUIVersionInfo() {
     _uiVersion = "unknown";
     _uiMinFirmware = "";
+    _uiEtag = "";
 
     if (!LittleFS.exists("/version.json")) {
         return;
@@ -483,6 +242,13 @@ void WebServer::loadUIVersionInfo() {
     const char* minFirmware = doc["minFirmware"];
     _uiVersion = version ? String(version) : "unknown";
     _uiMinFirmware = minFirmware ? String(minFirmware) : "";
+
+    // Build id from make build-ui (hash of the packed assets): strong validator for
+    // every UI asset. Without it (unpacked UI) assets are sent without ETag.
+    const char* build = doc["build"];
+    if (version && build) {
+        _uiEtag = "\"" + _uiVersion + "-" + build + "\"";
+    }
 }
 
 // Helper to parse version into components
@@ -552,32 +318,95 @@ String WebServer::getUIStatus() {
 }
 
 void WebServer::serveRecoveryPage(AsyncWebServerRequest* request) {
-    request->send_P(200, "text/html", RECOVERY_HTML);
+    AsyncWebServerResponse* response = request->beginResponse(200, "text/html", RECOVERY_HTML_GZ, sizeof(RECOVERY_HTML_GZ));
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("Cache-Control", "no-store");
+    request->send(response);
 }
 
-void WebServer::loop() {
-    ws.cleanupClients();
+void WebServer::serveUiAsset(AsyncWebServerRequest* request, const char* path, const char* contentType) {
+    // index.html is revalidated on every load (304 while the UI is unchanged);
+    // app.js/style.css requested as "?v=<build>" (see tools/ui_tool.py) are cached
+    // for UI_ASSET_MAX_AGE_S - a UI update changes the URL, not the cached copy
+    String cacheControl = "no-cache";
+    if (_uiEtag.length() > 0 && request->hasParam("v")) {
+        cacheControl = "public, max-age=" + String(UI_ASSET_MAX_AGE_S) + ", immutable";
+    }
+
+    AsyncWebServerResponse* response;
+    if (_uiEtag.length() > 0 && request->hasHeader("If-None-Match") &&
+        request->header("If-None-Match").indexOf(_uiEtag) >= 0) {
+        response = request->beginResponse(304);
+    } else {
+        String gzPath = String(path) + ".gz";
+        if (LittleFS.exists(gzPath)) {
+            response = request->beginResponse(LittleFS, gzPath, contentType);
+            response->addHeader("Content-Encoding", "gzip");
+        } else {
+            response = request->beginResponse(LittleFS, path, contentType);
+        }
+    }
+    if (_uiEtag.length() > 0) response->addHeader("ETag", _uiEtag);
+    response->addHeader("Cache-Control", cacheControl);
+    request->send(response);
+}
 
-    // Handle deferred broadcast requests from async context
-    if (_broadcastRequested) {
+void WebServer::loop() {
+    // Handle deferred broadcast and snapshot requests from async context
+    // (periodic channel updates run from the scheduler timer)
+    if (_broadcastRequested || _snapshotRequested) {
+        uint8_t forced = _broadcastRequested ? (WS_CHANNEL_MODE | WS_CHANNEL_SYSTEM) : 0;
         _broadcastRequested = false;
+        _snapshotRequested = false;
         if (ws.count() > 0) {
-            broadcastState();
+            scheduler.arm(_broadcastTimer, publishChannels(forced));
         }
-        _lastBroadcast = millis();
-        return;
     }
 
-    if (millis() - _lastBroadcast > WS_BROADCAST_INTERVAL_MS) {
-        _lastBroadcast = millis();
+    if (_seedRequested) {
+        _seedRequested = false;
+        applySeed(_requestedSeed);
+    }
+
+    // Modes/impulses changed (saveMode / saveImpulse): refresh every client's lists
+    if (_contentGeneration != contentIndex.getGeneration()) {
+        _contentGeneration = contentIndex.getGeneration();
         if (ws.count() > 0) {
-            broadcastState();
+            ws.textAll(contentIndex.getModesMessage());
+            ws.textAll(contentIndex.getImpulsesMessage());
         }
     }
 }
 
+void WebServer::applySeed(uint32_t seed) {
+    // Reseed every generator from the same seed (each uses its own stream)
+    modePlayer.setSeed(seed);
+    impulsePlayer.setSeed(seed);
+    autoBlink.setSeed(seed);
+    autoImpulse.setSeed(seed);
+    autoBlink.resetTimer();
+    autoImpulse.resetTimer();
+
+    // Replay the running auto mode from the top with the new seed
+    if (modeManager.getCurrentMode() == Mode::AUTO) {
+        modeManager.requestAutoMode(modeManager.getCurrentAutoModeName());
+    }
+    WEB_LOG("Control", "Random seed: %lu%s", (unsigned long)seed, seed ? "" : " (hardware)");
+}
+
+void WebServer::onBroadcastTimer() {
+    ws.cleanupClients();
+    if (ws.count() > 0) {
+        scheduler.arm(_broadcastTimer, publishChannels(0));
+    } else {
+        // No clients: housekeeping only (a new client gets a snapshot on connect)
+        scheduler.arm(_broadcastTimer, WS_BROADCAST_IDLE_INTERVAL_MS);
+    }
+}
+
 void WebServer::requestBroadcast() {
     _broadcastRequested = true;
+    powerManager.wake();
 }
 
 void WebServer::setupWebSocket() {
@@ -589,19 +418,42 @@ void WebServer::setupWebSocket() {
                 WEB_LOG("WS", "Total clients: %u", ws.count());
                 sendAvailableLists(client);  // Send available modes/impulses to new client
                 sendAdminState(client);      // Send per-client admin lock state
-                requestBroadcast();          // Defer state broadcast to main loop
+                addSubscriber(client);       // Default channels until the UI subscribes (snapshot from main loop)
                 break;
             case WS_EVT_DISCONNECT:
                 WEB_LOG("WS", "Client #%u disconnected", client->id());
                 WEB_LOG("WS", "Total clients: %u", ws.count());
+                removeSubscriber(client->id());
+                wsReassembler.release(client->id());
                 // Don't remove auth - keep IP authenticated for page reloads and recovery UI
                 // Entry will expire naturally via timeout
                 break;
             case WS_EVT_DATA: {
                 AwsFrameInfo* info = (AwsFrameInfo*)arg;
-                if (info->final && info->index == 0 && info->len == len && info->opcode == WS_TEXT) {
-                    data[len] = 0;
-                    handleWebSocketMessage((char*)data, client);
+                if (info->message_opcode != WS_TEXT) break;
+
+                // Whole message in one piece: dispatch straight from the frame
+                bool first = info->num == 0 && info->index == 0;
+                bool last = info->final && info->index + len == info->len;
+                if (first && last) {
+                    dispatchWebSocketMessage((const char*)data, len, client);
+                    break;
+                }
+
+                // Fragmented, or split across TCP packets: reassemble (ws_reassembly.h)
+                const char* message = nullptr;
+                size_t messageLen = 0;
+                switch (wsReassembler.append(client->id(), data, len, first, last, millis(), message, messageLen)) {
+                    case WsChunkResult::COMPLETE:
+                        dispatchWebSocketMessage(message, messageLen, client);
+                        wsReassembler.release(client->id());
+                        break;
+                    case WsChunkResult::DROPPED:
+                        WEB_LOG("WS", "Client #%u: message dropped (over %u bytes or no reassembly slot)",
+                                client->id(), WS_REASSEMBLY_MAX_BYTES);
+                        break;
+                    case WsChunkResult::PENDING:
+                        break;
                 }
                 break;
             }
@@ -635,13 +487,21 @@ void WebServer::setupRoutes() {
         }
 
         // Soft warnings or OK → serve UI
-        if (LittleFS.exists("/index.html")) {
-            request->send(LittleFS, "/index.html", "text/html");
+        if (uiFileExists("/index.html")) {
+            serveUiAsset(request, "/index.html", "text/html");
         } else {
             serveRecoveryPage(request);
         }
     });
 
+    // Packed UI assets (gzip + ETag + Cache-Control, see serveUiAsset)
+    server.on("/app.js", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        serveUiAsset(request, "/app.js", "application/javascript");
+    });
+    server.on("/style.css", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        serveUiAsset(request, "/style.css", "text/css");
+    });
+
     // OTA firmware upload
     server.on("/update", HTTP_POST,
         [this](AsyncWebServerRequest* request) {
@@ -650,8 +510,12 @@ void WebServer::setupRoutes() {
                 request->send(403, "text/plain", "FAIL: Admin lock active");
                 return;
             }
-            bool success = !Update.hasError();
-            request->send(200, "text/plain", success ? "OK" : "FAIL");
+            bool success = !Update.hasError() && !fwUpdateError;
+            if (fwUpdateError) {
+                request->send(200, "text/plain", String("FAIL: ") + fwUpdateError);
+            } else {
+                request->send(200, "text/plain", success ? "OK" : "FAIL");
+            }
             if (success) {
                 WEB_LOG("OTA", "Firmware update success, signaling reboot...");
                 storage.setRebootRequired(true);
@@ -669,20 +533,34 @@ void WebServer::setupRoutes() {
                     fwUpdateAuthFailed = true;
                     return;
                 }
-                WEB_LOG("OTA", "Starting firmware update: %s", filename.c_str());
-                // Stop all servo activity during upload
-                autoBlink.pause();
-                autoImpulse.pause();
-                impulsePlayer.stop();
-                modeManager.setMode(Mode::NONE);
-                ledStatus.veryFastBlink();  // OTA indicator
-                if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
+                fwUpdateError = nullptr;
+                fwDeltaUpdate = OtaDelta::isPatch(data, len);
+                WEB_LOG("OTA", "Starting firmware update: %s%s", filename.c_str(), fwDeltaUpdate ? " (delta)" : "");
+                // Servo activity stops once the upload is accepted - a delta for another
+                // base is refused in deltaBegin with the eyes still running
+                if (fwDeltaUpdate) {
+                    // Update.begin() once the patch header is checked (deltaBegin)
+                    OtaDeltaIo io = { deltaBegin, deltaRead, deltaWrite, nullptr };
+                    otaDelta.begin(io);
+                } else if (Update.begin(UPDATE_SIZE_UNKNOWN)) {
+                    stopMotionForUpload();
+                } else {
                     Update.printError(Serial);
                 }
             }
-            if (fwUpdateAuthFailed || !Update.isRunning()) return;  // Skip if auth failed or not started
-            if (Update.write(data, len) != len) {
-                Update.printError(Serial);
+            if (fwUpdateAuthFailed) return;
+            if (fwDeltaUpdate) {
+                if (fwUpdateError) return;
+                if (!otaDelta.feed(data, len)) {
+                    deltaUpdateFailed(otaDelta.getError());
+                    return;
+                }
+                if (final && !finishDeltaUpdate()) return;
+            } else {
+                if (!Update.isRunning()) return;  // Not started
+                if (Update.write(data, len) != len) {
+                    Update.printError(Serial);
+                }
             }
             if (final) {
                 if (Update.end(true)) {
@@ -694,11 +572,15 @@ void WebServer::setupRoutes() {
         }
     );
 
-    // LittleFS filesystem upload - direct partition write (bypasses Update library issues)
+    // LittleFS filesystem upload - direct partition write, verified (ui_image_update.h)
+    // Optional manifest as query parameters: ?size=<bytes>&crc32=<hex>&sha256=<hex>
     server.on("/api/upload-ui", HTTP_POST,
         [this](AsyncWebServerRequest* request) {
-            WEB_LOG("OTA", "Upload done - error: %d, partition: %p", fsUpdateError, fsUpdatePartition);
-            if (!fsUpdateError && fsUpdatePartition != nullptr) {
+            if (uiUploadAuthFailed) {
+                request->send(403, "text/plain", "FAIL: Admin lock active");
+                return;
+            }
+            if (uiImageUpdate.isComplete()) {
                 request->send(200, "text/plain", "OK");
                 WEB_LOG("OTA", "Filesystem update success, signaling reboot...");
                 storage.setRebootRequired(true);
@@ -706,72 +588,49 @@ void WebServer::setupRoutes() {
                 delay(500);
                 ESP.restart();
             } else {
-                String msg = "FAIL: " + (fsUpdateErrorMsg.length() > 0 ? fsUpdateErrorMsg : "Unknown error");
+                uiImageUpdate.abort("Upload incomplete");
+                const char* error = uiImageUpdate.getError();
+                String msg = "FAIL: " + String(error[0] ? error : "Unknown error");
                 WEB_LOG("OTA", "%s", msg.c_str());
                 request->send(500, "text/plain", msg);
+                contentIndex.requestRebuild();  // Partition may be rewritten (or still the old one)
             }
         },
         [this](AsyncWebServerRequest* request, String filename, size_t index, uint8_t* data, size_t len, bool final) {
             if (index == 0) {
+                uiUploadAuthFailed = false;
                 // Auth check at start of upload
                 if (!isHttpRequestAuthorized(request)) {
                     WEB_LOG("Admin", "UI upload blocked: not authorized");
-                    fsUpdateError = true;
-                    fsUpdateErrorMsg = "Admin lock active";
+                    uiUploadAuthFailed = true;
                     // Don't send response here - let completion handler do it
                     return;
                 }
                 WEB_LOG("OTA", "Starting filesystem update: %s (%u bytes)", filename.c_str(), request->contentLength());
-                // Stop all servo activity during upload
-                autoBlink.pause();
-                autoImpulse.pause();
-                impulsePlayer.stop();
-                modeManager.setMode(Mode::NONE);
-                ledStatus.veryFastBlink();
-                fsUpdateError = false;
-                fsUpdateErrorMsg = "";
-                fsUpdatePartition = nullptr;
-
-                // Find the spiffs partition
-                fsUpdatePartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, NULL);
-                if (!fsUpdatePartition) {
-                    WEB_LOG("OTA", "ERROR: SPIFFS partition not found");
-                    fsUpdateError = true;
-                    fsUpdateErrorMsg = "SPIFFS partition not found";
-                    return;
-                }
-
-                WEB_LOG("OTA", "Found partition: %s at 0x%x, size: 0x%x",
-                    fsUpdatePartition->label, fsUpdatePartition->address, fsUpdatePartition->size);
 
-                // Unmount LittleFS before writing
-                LittleFS.end();
-                WEB_LOG("OTA", "LittleFS unmounted");
-
-                // Erase the partition
-                esp_err_t err = esp_partition_erase_range(fsUpdatePartition, 0, fsUpdatePartition->size);
-                if (err != ESP_OK) {
-                    WEB_LOG("OTA", "ERROR: Failed to erase partition: %s", esp_err_to_name(err));
-                    fsUpdateError = true;
-                    fsUpdateErrorMsg = "Failed to erase: " + String(esp_err_to_name(err));
-                    return;
-                }
-                WEB_LOG("OTA", "Partition erased");
+                // Servo activity stops once the image header checks out (not for rejected uploads)
+                const AsyncWebParameter* size = request->getParam("size");
+                const AsyncWebParameter* crc32 = request->getParam("crc32");
+                const AsyncWebParameter* sha256 = request->getParam("sha256");
+                uiImageUpdate.begin(size ? strtoul(size->value().c_str(), nullptr, 10) : 0,
+                                    crc32 ? crc32->value().c_str() : nullptr,
+                                    sha256 ? sha256->value().c_str() : nullptr,
+                                    []() {
+                                        stopMotionForUpload();
+                                        impulsePlayer.invalidateCache();  // Impulse files are about to be replaced
+                                    });
+                request->onDisconnect([]() {
+                    uiImageUpdate.abort("Upload interrupted");
+                });
             }
 
-            if (fsUpdateError || !fsUpdatePartition) return;
+            if (uiUploadAuthFailed || !uiImageUpdate.isActive()) return;
 
-            // Write data to partition
-            esp_err_t err = esp_partition_write(fsUpdatePartition, index, data, len);
-            if (err != ESP_OK) {
-                WEB_LOG("OTA", "ERROR: Write failed at 0x%x: %s", index, esp_err_to_name(err));
-                fsUpdateError = true;
-                fsUpdateErrorMsg = "Write failed: " + String(esp_err_to_name(err));
-                return;
-            }
+            // Erase-ahead, write and read-back per chunk; superblock held back
+            if (!uiImageUpdate.write(data, len)) return;
 
             if (final) {
-                WEB_LOG("OTA", "Filesystem write complete: %u bytes", index + len);
+                uiImageUpdate.finish();
             }
         }
     );
@@ -805,11 +664,59 @@ void WebServer::setupRoutes() {
         doc["updateAvailable"] = updateChecker.isUpdateAvailable();
         doc["updateVersion"] = updateChecker.getAvailableVersion();
 
+        // Power saving stats (idle current itself needs an external meter)
+        JsonObject power = doc["power"].to<JsonObject>();
+        power["cpuMhz"] = getCpuFrequencyMhz();
+        power["dfs"] = powerManager.isDfsActive();
+        power["lightSleep"] = powerManager.isLightSleepEnabled();
+        power["idlePct"] = powerManager.getIdlePercent();
+        power["wakeLatencyUs"] = powerManager.getWakeLatencyAvgUs();
+        power["wakeLatencyMaxUs"] = powerManager.getWakeLatencyMaxUs();
+
+        // Shared WebSocket message buffers (allocBytes stays flat once the pool is warm)
+        JsonObject wsBuffers = doc["wsBuffers"].to<JsonObject>();
+        wsBuffers["slots"] = WS_BUFFER_POOL_SLOTS;
+        wsBuffers["inUse"] = wsBufferPool.getSlotsInUse();
+        wsBuffers["hits"] = wsBufferPool.getHits();
+        wsBuffers["grows"] = wsBufferPool.getGrows();
+        wsBuffers["misses"] = wsBufferPool.getMisses();
+        wsBuffers["allocBytes"] = wsBufferPool.getAllocBytes();
+
+        // WebSocket parse time: in-place hot commands vs. ArduinoJson (histograms in /api/trace)
+        JsonObject wsParse = doc["wsParse"].to<JsonObject>();
+        wsParse["fastCount"] = latencyTrace.getParseCount(ParsePath::FAST);
+        wsParse["fastAvgUs"] = latencyTrace.getParseAvgUs(ParsePath::FAST);
+        wsParse["fullCount"] = latencyTrace.getParseCount(ParsePath::FULL);
+        wsParse["fullAvgUs"] = latencyTrace.getParseAvgUs(ParsePath::FULL);
+
+        // Incoming messages that arrived in pieces (ws_reassembly.h)
+        JsonObject wsReassembly = doc["wsReassembly"].to<JsonObject>();
+        wsReassembly["slots"] = WS_REASSEMBLY_SLOTS;
+        wsReassembly["maxBytes"] = WS_REASSEMBLY_MAX_BYTES;
+        wsReassembly["inUse"] = wsReassembler.getSlotsInUse();
+        wsReassembly["completed"] = wsReassembler.getCompleted();
+        wsReassembly["oversized"] = wsReassembler.getOversized();
+        wsReassembly["noSlot"] = wsReassembler.getNoSlot();
+        wsReassembly["expired"] = wsReassembler.getExpired();
+
         String response;
         serializeJson(doc, response);
         request->send(200, "application/json", response);
     });
 
+    // Latency trace - Chrome trace-event JSON (open in chrome://tracing or ui.perfetto.dev)
+    // ?clear=1 resets the ring buffer and histograms after export
+    server.on("/api/trace", HTTP_GET, [](AsyncWebServerRequest* request) {
+        // Rendered piece by piece from the ring while the response is sent (latency_trace.h)
+        std::shared_ptr<TraceExport> trace = std::make_shared<TraceExport>(latencyTrace, request->hasParam("clear"));
+        AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+            [trace](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+                return trace->fill(buffer, maxLen);
+            });
+        response->addHeader("Content-Disposition", "attachment; filename=\"animatronic-eyes-trace.json\"");
+        request->send(response);
+    });
+
     // API endpoint for reboot (blocked only when rate limited)
     server.on("/api/reboot", HTTP_POST, [this](AsyncWebServerRequest* request) {
         if (!checkRateLimit(request->client()->remoteIP())) {
@@ -893,15 +800,16 @@ void WebServer::setupRoutes() {
         WEB_LOG("WebServer", "Wiping UI files...");
 
         bool success = true;
-        if (LittleFS.exists("/index.html")) success &= LittleFS.remove("/index.html");
-        if (LittleFS.exists("/style.css")) success &= LittleFS.remove("/style.css");
-        if (LittleFS.exists("/app.js")) success &= LittleFS.remove("/app.js");
+        for (const char* path : {"/index.html", "/style.css", "/app.js", "/index.html.gz", "/style.css.gz", "/app.js.gz"}) {
+            if (LittleFS.exists(path)) success &= LittleFS.remove(path);
+        }
         if (LittleFS.exists("/version.json")) success &= LittleFS.remove("/version.json");
 
         if (success) {
             _uiFilesValid = false;
             _uiVersion = "unknown";
             _uiMinFirmware = "";
+            _uiEtag = "";
             WEB_LOG("WebServer", "UI files wiped successfully");
             request->send(200, "text/plain", "OK");
         } else {
@@ -930,140 +838,15 @@ void WebServer::setupRoutes() {
         }
         WEB_LOG("WebServer", "Backup requested");
 
-        JsonDocument doc;
-        doc["version"] = FIRMWARE_VERSION;
-        doc["type"] = "animatronic-eyes-backup";
-
-        // Device ID
-        uint64_t chipId = ESP.getEfuseMac();
-        char deviceId[8];
-        snprintf(deviceId, sizeof(deviceId), "%06X", (uint32_t)(chipId & 0xFFFFFF));
-        doc["device"] = deviceId;
-
-        // Config section
-        JsonObject config = doc["config"].to<JsonObject>();
-
-        // Servo config
-        JsonArray servos = config["servo"].to<JsonArray>();
-        for (int i = 0; i < NUM_SERVOS; i++) {
-            ServoConfig sc = storage.getServoConfig(i);
-            JsonObject s = servos.add<JsonObject>();
-            s["pin"] = sc.pin;
-            s["min"] = sc.min;
-            s["center"] = sc.center;
-            s["max"] = sc.max;
-            s["invert"] = sc.invert;
-        }
-
-        // WiFi config
-        JsonObject wifi = config["wifi"].to<JsonObject>();
-        for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
-            WifiNetwork net = storage.getWifiNetwork(i);
-            if (net.configured) {
-                JsonObject netObj = wifi[String("network") + String(i)].to<JsonObject>();
-                netObj["ssid"] = net.ssid;
-                netObj["password"] = net.password;
-            }
-        }
-        WifiTiming timing = storage.getWifiTiming();
-        JsonObject wifiTiming = wifi["timing"].to<JsonObject>();
-        wifiTiming["graceMs"] = timing.graceMs;
-        wifiTiming["retries"] = timing.retries;
-        wifiTiming["retryDelayMs"] = timing.retryDelayMs;
-        wifiTiming["apScanMs"] = timing.apScanMs;
-        wifiTiming["keepAP"] = timing.keepAP;
-
-        // AP config
-        ApConfig apConfig = storage.getApConfig();
-        JsonObject ap = config["ap"].to<JsonObject>();
-        ap["ssidPrefix"] = apConfig.ssidPrefix;
-        ap["password"] = apConfig.password;
-
-        // LED config
-        LedConfig ledConfig = storage.getLedConfig();
-        JsonObject led = config["led"].to<JsonObject>();
-        led["enabled"] = ledConfig.enabled;
-        led["pin"] = ledConfig.pin;
-        led["brightness"] = ledConfig.brightness;
-
-        // mDNS config
-        MdnsConfig mdnsConfig = storage.getMdnsConfig();
-        JsonObject mdns = config["mdns"].to<JsonObject>();
-        mdns["enabled"] = mdnsConfig.enabled;
-        mdns["hostname"] = mdnsConfig.hostname;
-
-        // Mode config
-        ModeConfig modeConfig = storage.getModeConfig();
-        JsonObject mode = config["mode"].to<JsonObject>();
-        mode["default"] = modeConfig.defaultMode;
-        mode["autoBlink"] = modeConfig.autoBlink;
-        mode["blinkIntervalMin"] = modeConfig.blinkIntervalMin;
-        mode["blinkIntervalMax"] = modeConfig.blinkIntervalMax;
-        mode["rememberLastMode"] = modeConfig.rememberLastMode;
-        mode["mirrorPreview"] = modeConfig.mirrorPreview;
-
-        // Impulse config
-        ImpulseConfig impulseConfig = storage.getImpulseConfig();
-        JsonObject impulse = config["impulse"].to<JsonObject>();
-        impulse["autoImpulse"] = impulseConfig.autoImpulse;
-        impulse["impulseIntervalMin"] = impulseConfig.impulseIntervalMin;
-        impulse["impulseIntervalMax"] = impulseConfig.impulseIntervalMax;
-        impulse["impulseSelection"] = impulseConfig.impulseSelection;
-
-        // Modes section - read all mode files from /modes/
-        JsonObject modes = doc["modes"].to<JsonObject>();
-        File root = LittleFS.open("/modes");
-        if (root && root.isDirectory()) {
-            File file = root.openNextFile();
-            while (file) {
-                if (!file.isDirectory()) {
-                    String name = file.name();
-                    if (name.endsWith(".json")) {
-                        JsonDocument modeDoc;
-                        DeserializationError err = deserializeJson(modeDoc, file);
-                        if (!err) {
-                            // Remove .json extension for key
-                            String key = name.substring(0, name.length() - 5);
-                            modes[key] = modeDoc.as<JsonObject>();
-                        }
-                    }
-                }
-                file = root.openNextFile();
-            }
-            root.close();
-        }
-
-        // Impulses section - read all impulse files from /impulses/
-        JsonObject impulses = doc["impulses"].to<JsonObject>();
-        root = LittleFS.open("/impulses");
-        if (root && root.isDirectory()) {
-            File file = root.openNextFile();
-            while (file) {
-                if (!file.isDirectory()) {
-                    String name = file.name();
-                    if (name.endsWith(".json")) {
-                        JsonDocument impulseDoc;
-                        DeserializationError err = deserializeJson(impulseDoc, file);
-                        if (!err) {
-                            // Remove .json extension for key
-                            String key = name.substring(0, name.length() - 5);
-                            impulses[key] = impulseDoc.as<JsonObject>();
-                        }
-                    }
-                }
-                file = root.openNextFile();
-            }
-            root.close();
-        }
-
-        String output;
-        serializeJsonPretty(doc, output);
-
-        AsyncWebServerResponse* response = request->beginResponse(200, "application/json", output);
+        // Streamed as it is produced (backup.h): heap use doesn't grow with the
+        // number or size of mode/impulse files
+        std::shared_ptr<BackupWriter> writer = std::make_shared<BackupWriter>();
+        AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+            [writer](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+                return writer->fill(buffer, maxLen);
+            });
         response->addHeader("Content-Disposition", "attachment; filename=\"animatronic-eyes-backup.json\"");
         request->send(response);
-
-        WEB_LOG("WebServer", "Backup sent (%d bytes)", output.length());
     });
 
     // Restore endpoint - upload and apply backup
@@ -1073,11 +856,22 @@ void WebServer::setupRoutes() {
                 request->send(403, "application/json", "{\"success\":false,\"error\":\"Admin lock active\"}");
                 return;
             }
+            if (restoreParser.getError()) {
+                // Sections before the error have been applied; the previous mode is running again
+                JsonDocument doc;
+                doc["success"] = false;
+                doc["error"] = restoreParser.getError();
+                doc["detail"] = "Sections before the error were applied (config takes effect after reboot). "
+                                "Mode files are only replaced when valid. Fix the backup and restore again.";
+                String response;
+                serializeJson(doc, response);
+                request->send(400, "application/json", response);
+                return;
+            }
             request->send(200, "application/json", "{\"success\":true}");
         },
         nullptr,
         [this](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
-            static String body;
             if (index == 0) {
                 restoreAuthFailed = false;
                 // Auth check - uses WebSocket session IP correlation
@@ -1086,184 +880,313 @@ void WebServer::setupRoutes() {
                     restoreAuthFailed = true;
                     return;
                 }
-                body = "";
                 WEB_LOG("WebServer", "Restore started (%u bytes)", total);
-                modeManager.setMode(Mode::NONE);  // Stop servos during restore
+                restorePrevMode = modeManager.getCurrentMode();
+                strncpy(restorePrevAutoMode, modeManager.getCurrentAutoModeName(), sizeof(restorePrevAutoMode) - 1);
+                restorePrevAutoMode[sizeof(restorePrevAutoMode) - 1] = '\0';
+                modeManager.requestMode(Mode::NONE);  // Stop servos during restore
+                impulsePlayer.invalidateCache();   // Impulse files may be replaced
+                restoreParser.begin();
             }
 
             if (restoreAuthFailed) return;
 
-            // Accumulate body
-            for (size_t i = 0; i < len; i++) {
-                body += (char)data[i];
-            }
+            // Sections are applied as they complete (backup.h) - no whole-body copy
+            restoreParser.feed(data, len);
 
             if (index + len == total) {
-                // Parse JSON
-                JsonDocument doc;
-                DeserializationError error = deserializeJson(doc, body);
-
-                if (error) {
-                    WEB_LOG("WebServer", "Restore failed: JSON parse error");
+                bool ok = restoreParser.finish();
+                restoreParser.end();
+                contentIndex.requestRebuild();
+                if (!ok) {
+                    WEB_LOG("WebServer", "Restore failed: %s", restoreParser.getError());
+                    // Don't leave the device frozen in Mode NONE
+                    if (restorePrevMode == Mode::FOLLOW) {
+                        modeManager.requestMode(Mode::FOLLOW);
+                    } else if (restorePrevMode == Mode::AUTO) {
+                        modeManager.requestAutoMode(restorePrevAutoMode);
+                    }
                     return;
                 }
 
-                // Validate backup type
-                if (doc["type"] != "animatronic-eyes-backup") {
-                    WEB_LOG("WebServer", "Restore failed: Invalid backup type");
-                    return;
-                }
+                WEB_LOG("WebServer", "Restore complete, signaling reboot...");
+                storage.setRebootRequired(true);
+                webServer.broadcastState();  // Notify UI before reboot
+                delay(500);
+                ESP.restart();
+            }
+        }
+    );
 
-                WEB_LOG("WebServer", "Restoring backup from version %s", doc["version"].as<const char*>());
-
-                // Restore servo config
-                JsonArray servos = doc["config"]["servo"].as<JsonArray>();
-                for (size_t i = 0; i < servos.size() && i < NUM_SERVOS; i++) {
-                    JsonObject s = servos[i];
-                    storage.setServoPin(i, s["pin"] | DEFAULT_PIN_LEFT_EYE_X);
-                    storage.setServoCalibration(i,
-                        s["min"] | DEFAULT_SERVO_MIN,
-                        s["center"] | DEFAULT_SERVO_CENTER,
-                        s["max"] | DEFAULT_SERVO_MAX);
-                    storage.setServoInvert(i, s["invert"] | false);
-                }
+    // Serve static files from LittleFS (CSS, JS, etc.)
+    // MUST be last - catches all unmatched routes
+    server.serveStatic("/", LittleFS, "/");
+}
 
-                // Restore WiFi config
-                JsonObject wifi = doc["config"]["wifi"].as<JsonObject>();
-                for (int i = 0; i < WIFI_MAX_NETWORKS; i++) {
-                    String key = "network" + String(i);
-                    if (wifi.containsKey(key)) {
-                        JsonObject net = wifi[key].as<JsonObject>();
-                        storage.setWifiNetwork(i,
-                            net["ssid"] | "",
-                            net["password"] | "");
-                    }
-                }
-                if (wifi.containsKey("timing")) {
-                    JsonObject t = wifi["timing"].as<JsonObject>();
-                    WifiTiming timing;
-                    timing.graceMs = t["graceMs"] | DEFAULT_WIFI_GRACE_MS;
-                    timing.retries = t["retries"] | DEFAULT_WIFI_RETRIES;
-                    timing.retryDelayMs = t["retryDelayMs"] | DEFAULT_WIFI_RETRY_DELAY_MS;
-                    timing.apScanMs = t["apScanMs"] | DEFAULT_WIFI_AP_SCAN_MS;
-                    timing.keepAP = t["keepAP"] | DEFAULT_WIFI_KEEP_AP;
-                    storage.setWifiTiming(timing);
-                }
+void WebServer::broadcastState() {
+    // Sent by the main loop (the buffer pool is main-loop only); callers before a
+    // reboot delay long enough for the next pass
+    for (WsSubscriber& sub : _subscribers) {
+        if (sub.clientId != 0) sub.snapshotPending = true;
+    }
+    _snapshotRequested = true;
+    powerManager.wake();
+}
 
-                // Restore AP config
-                if (doc["config"].containsKey("ap")) {
-                    JsonObject ap = doc["config"]["ap"].as<JsonObject>();
-                    ApConfig apConfig;
-                    strncpy(apConfig.ssidPrefix, ap["ssidPrefix"] | DEFAULT_AP_SSID_PREFIX, sizeof(apConfig.ssidPrefix) - 1);
-                    strncpy(apConfig.password, ap["password"] | DEFAULT_AP_PASSWORD, sizeof(apConfig.password) - 1);
-                    storage.setApConfig(apConfig);
-                }
+// ============================================================================
+// State Channels
+// ============================================================================
+// Clients subscribe to what their open tab shows ("subscribe" command):
+//   motion      eye pose + servo positions, at the client's rate (up to WS_MOTION_MAX_HZ)
+//   modeState   mode / impulse / clip state, when its content changes
+//   systemState wifi, system, update, calibration - every WS_SYSTEM_INTERVAL_MS and
+//               after commands (requestBroadcast); doubles as the UI heartbeat
+// Each message is built at most once per tick into a pooled buffer (ws_buffer_pool.h)
+// and that one buffer is queued to every client that needs it.
+// A new subscription starts with a snapshot of every subscribed channel.
+
+static uint32_t hashJson(const WsSharedBuffer& json) {
+    uint32_t h = 2166136261u;  // FNV-1a
+    for (uint8_t c : *json) {
+        h = (h ^ c) * 16777619u;
+    }
+    return h;
+}
 
-                // Restore LED config
-                if (doc["config"].containsKey("led")) {
-                    JsonObject led = doc["config"]["led"].as<JsonObject>();
-                    LedConfig ledConfig;
-                    ledConfig.enabled = led["enabled"] | DEFAULT_LED_ENABLED;
-                    ledConfig.pin = led["pin"] | DEFAULT_LED_PIN;
-                    ledConfig.brightness = led["brightness"] | DEFAULT_LED_BRIGHTNESS;
-                    storage.setLedConfig(ledConfig);
-                }
+// Serialize once into a pooled buffer shared by all recipients (main loop only)
+static WsSharedBuffer serializePooled(const JsonDocument& doc) {
+    if (doc.overflowed()) return nullptr;
+    size_t len = measureJson(doc);
+    WsSharedBuffer buffer = wsBufferPool.acquire(len + 1);  // serializeJson adds a terminator
+    buffer->resize(serializeJson(doc, (char*)buffer->data(), len + 1));
+    return buffer;
+}
 
-                // Restore mDNS config
-                if (doc["config"].containsKey("mdns")) {
-                    JsonObject mdns = doc["config"]["mdns"].as<JsonObject>();
-                    MdnsConfig mdnsConfig;
-                    mdnsConfig.enabled = mdns["enabled"] | DEFAULT_MDNS_ENABLED;
-                    strncpy(mdnsConfig.hostname, mdns["hostname"] | DEFAULT_MDNS_HOSTNAME, sizeof(mdnsConfig.hostname) - 1);
-                    storage.setMdnsConfig(mdnsConfig);
-                }
+// Same, into a right-sized one-off buffer (async context, where the pool can't be used)
+static WsSharedBuffer serializeShared(const JsonDocument& doc) {
+    if (doc.overflowed()) return nullptr;
+    size_t len = measureJson(doc);
+    WsSharedBuffer buffer = std::make_shared<std::vector<uint8_t>>(len + 1);
+    buffer->resize(serializeJson(doc, (char*)buffer->data(), len + 1));
+    return buffer;
+}
 
-                // Restore Mode config
-                if (doc["config"].containsKey("mode")) {
-                    JsonObject mode = doc["config"]["mode"].as<JsonObject>();
-                    ModeConfig modeConfig;
-                    strncpy(modeConfig.defaultMode, mode["default"] | DEFAULT_MODE, sizeof(modeConfig.defaultMode) - 1);
-                    modeConfig.autoBlink = mode["autoBlink"] | DEFAULT_AUTO_BLINK;
-                    modeConfig.blinkIntervalMin = mode["blinkIntervalMin"] | DEFAULT_BLINK_INTERVAL_MIN;
-                    modeConfig.blinkIntervalMax = mode["blinkIntervalMax"] | DEFAULT_BLINK_INTERVAL_MAX;
-                    modeConfig.rememberLastMode = mode["rememberLastMode"] | false;
-                    modeConfig.mirrorPreview = mode["mirrorPreview"] | DEFAULT_MIRROR_PREVIEW;
-                    storage.setModeConfig(modeConfig);
-                }
+void WebServer::addSubscriber(AsyncWebSocketClient* client) {
+    // Reuse a free slot, or one left behind by a client that is gone
+    WsSubscriber* slot = nullptr;
+    for (WsSubscriber& sub : _subscribers) {
+        if (sub.clientId == 0 || !ws.client(sub.clientId)) {
+            slot = &sub;
+            break;
+        }
+    }
+    if (!slot) {
+        WEB_LOG("WS", "Client #%u: no subscription slot, state not sent", client->id());
+        return;
+    }
+    *slot = {};
+    slot->channels = WS_CHANNEL_ALL;
+    slot->motionIntervalMs = 1000 / WS_MOTION_DEFAULT_HZ;
+    slot->effectiveIntervalMs = slot->motionIntervalMs;
+    slot->lastMotionMs = millis();
+    slot->snapshotPending = true;
+    slot->clientId = client->id();  // Last: the main loop skips the slot until now
+    _snapshotRequested = true;
+    powerManager.wake();
+}
 
-                // Restore mode files
-                if (doc.containsKey("modes")) {
-                    // Ensure /modes directory exists
-                    if (!LittleFS.exists("/modes")) {
-                        LittleFS.mkdir("/modes");
-                    }
+void WebServer::removeSubscriber(uint32_t clientId) {
+    WsSubscriber* sub = findSubscriber(clientId);
+    if (sub) sub->clientId = 0;
+}
 
-                    JsonObject modes = doc["modes"].as<JsonObject>();
-                    for (JsonPair kv : modes) {
-                        char path[64];
-                        snprintf(path, sizeof(path), "/modes/%s.json", kv.key().c_str());
-                        File file = LittleFS.open(path, "w");
-                        if (file) {
-                            serializeJson(kv.value(), file);
-                            file.close();
-                            WEB_LOG("WebServer", "Restored mode: %s", kv.key().c_str());
-                        }
-                    }
-                }
+WsSubscriber* WebServer::findSubscriber(uint32_t clientId) {
+    for (WsSubscriber& sub : _subscribers) {
+        if (sub.clientId == clientId) return &sub;
+    }
+    return nullptr;
+}
 
-                // Restore Impulse config
-                if (doc["config"].containsKey("impulse")) {
-                    JsonObject impulse = doc["config"]["impulse"].as<JsonObject>();
-                    ImpulseConfig impulseConfig;
-                    impulseConfig.autoImpulse = impulse["autoImpulse"] | DEFAULT_AUTO_IMPULSE;
-                    impulseConfig.impulseIntervalMin = impulse["impulseIntervalMin"] | DEFAULT_IMPULSE_INTERVAL_MIN;
-                    impulseConfig.impulseIntervalMax = impulse["impulseIntervalMax"] | DEFAULT_IMPULSE_INTERVAL_MAX;
-                    strncpy(impulseConfig.impulseSelection, impulse["impulseSelection"] | DEFAULT_IMPULSE_SELECTION, sizeof(impulseConfig.impulseSelection) - 1);
-                    storage.setImpulseConfig(impulseConfig);
-                }
+uint32_t WebServer::publishChannels(uint8_t forced) {
+    WsSharedBuffer motion;
+    WsSharedBuffer system;
+    unsigned long now = millis();
+
+    // Mode state is polled every tick but only sent when it changed
+    // (an unsent buffer goes straight back to the pool). Without a mode
+    // subscriber it is not built at all
+    bool modeSubscribed = false;
+    for (const WsSubscriber& sub : _subscribers) {
+        if (sub.clientId != 0 && (sub.channels & WS_CHANNEL_MODE)) modeSubscribed = true;
+    }
+    WsSharedBuffer mode;
+    bool modeChanged = false;
+    if (modeSubscribed) {
+        mode = buildModeState();
+        uint32_t modeHash = mode ? hashJson(mode) : 0;
+        modeChanged = mode && modeHash != _modeStateHash;
+        _modeStateHash = modeHash;
+    } else {
+        _modeStateHash = 0;
+    }
 
-                // Restore impulse files
-                if (doc.containsKey("impulses")) {
-                    // Ensure /impulses directory exists
-                    if (!LittleFS.exists("/impulses")) {
-                        LittleFS.mkdir("/impulses");
-                    }
+    bool systemDue = Scheduler::isDue(now, _lastSystemMs + WS_SYSTEM_INTERVAL_MS);
+    if (systemDue || (forced & WS_CHANNEL_SYSTEM)) {
+        _lastSystemMs = now;
+        systemDue = true;
+    }
 
-                    JsonObject impulses = doc["impulses"].as<JsonObject>();
-                    for (JsonPair kv : impulses) {
-                        char path[64];
-                        snprintf(path, sizeof(path), "/impulses/%s.json", kv.key().c_str());
-                        File file = LittleFS.open(path, "w");
-                        if (file) {
-                            serializeJson(kv.value(), file);
-                            file.close();
-                            WEB_LOG("WebServer", "Restored impulse: %s", kv.key().c_str());
-                        }
-                    }
-                }
+    uint32_t nextMs = WS_BROADCAST_INTERVAL_MS;
+    for (WsSubscriber& sub : _subscribers) {
+        if (sub.clientId == 0) continue;
+        AsyncWebSocketClient* client = ws.client(sub.clientId);
+        if (!client || client->status() != WS_CONNECTED) continue;
 
-                WEB_LOG("WebServer", "Restore complete, signaling reboot...");
-                storage.setRebootRequired(true);
-                webServer.broadcastState();  // Notify UI before reboot
-                body = "";  // Free memory
-                delay(500);
-                ESP.restart();
-            }
+        uint8_t fresh = sub.snapshotPending ? WS_CHANNEL_ALL : forced;
+        sub.snapshotPending = false;
+        if (systemDue) fresh |= WS_CHANNEL_SYSTEM;
+        if (modeChanged) fresh |= WS_CHANNEL_MODE;
+        if (Scheduler::isDue(now, sub.lastMotionMs + sub.effectiveIntervalMs)) fresh |= WS_CHANNEL_MOTION;
+        fresh &= sub.channels;
+        if (fresh & WS_CHANNEL_MOTION) sub.lastMotionMs = now;  // Frame slot used, sent or not
+
+        if (sub.channels & WS_CHANNEL_MOTION) {
+            int32_t remaining = (int32_t)(sub.lastMotionMs + sub.effectiveIntervalMs - now);
+            nextMs = min(nextMs, (uint32_t)max(remaining, (int32_t)1));
         }
-    );
 
-    // Serve static files from LittleFS (CSS, JS, etc.)
-    // MUST be last - catches all unmatched routes
-    server.serveStatic("/", LittleFS, "/");
+        // Held-back channels go out with whatever is current once the queue drains
+        uint8_t due = fresh | sub.pendingChannels;
+        if (due == 0) continue;
+
+        // Backpressure: a client that is behind gets nothing new queued. Every
+        // skipped update is superseded by the next one, so only the newest is kept
+        size_t depth = client->queueLen();
+        sub.queueDepth = depth;
+        if (depth >= WS_CLIENT_QUEUE_LIMIT || !client->canSend()) {
+            if (sub.pendingChannels == 0) sub.heldSinceMs = now;
+            sub.pendingChannels = due;
+            sub.dropped += __builtin_popcount(fresh);
+            sub.effectiveIntervalMs = min(sub.effectiveIntervalMs * 2, 1000 / WS_MOTION_MIN_HZ);
+            continue;
+        }
+        if (sub.pendingChannels != 0) {
+            sub.lagMaxMs = max(sub.lagMaxMs, (uint32_t)(now - sub.heldSinceMs));
+            sub.pendingChannels = 0;
+        }
+
+        if (due & WS_CHANNEL_SYSTEM) {
+            if (!system) system = buildSystemState();
+            sendToSubscriber(sub, client, system);
+        }
+        if (due & WS_CHANNEL_MODE) {
+            sendToSubscriber(sub, client, mode);
+        }
+        if (due & WS_CHANNEL_MOTION) {
+            if (!motion) motion = buildMotionState();
+            sendToSubscriber(sub, client, motion);
+        }
+
+        // Adaptive rate: a queue that did not drain since the last tick halves the
+        // motion rate, an empty one wins a quarter of it back per send
+        if (depth > WS_CLIENT_QUEUE_TARGET) {
+            sub.effectiveIntervalMs = min(sub.effectiveIntervalMs * 2, 1000 / WS_MOTION_MIN_HZ);
+        } else if (depth == 0 && sub.effectiveIntervalMs > sub.motionIntervalMs) {
+            sub.effectiveIntervalMs = max(sub.effectiveIntervalMs * 3 / 4, (int)sub.motionIntervalMs);
+        }
+    }
+    return nextMs;
 }
 
-void WebServer::broadcastState() {
-    // Use static buffer to avoid stack allocation in async context
-    static char jsonBuffer[2048];  // Includes eye controller, mode system, and impulse state
+void WebServer::sendToSubscriber(WsSubscriber& sub, AsyncWebSocketClient* client, const WsSharedBuffer& json) {
+    if (!json) return;
+    client->text(json);  // Queues a reference, no copy
+    sub.avgMessageBytes = (sub.avgMessageBytes * 7 + json->size()) / 8;
+}
+
+WsSharedBuffer WebServer::buildMotionState() {
+    static JsonDocument doc;
+
+    doc.clear();
+    doc["type"] = "motion";
+
+    JsonObject eye = doc["eye"].to<JsonObject>();
+    eye["gazeX"] = eyeController.getGazeX();
+    eye["gazeY"] = eyeController.getGazeY();
+    eye["gazeZ"] = eyeController.getGazeZ();
+    eye["lidLeft"] = eyeController.getLidLeft();
+    eye["lidRight"] = eyeController.getLidRight();
+    eye["coupling"] = eyeController.getCoupling();
+
+    // Servo positions in servo order (calibration comes with systemState)
+    JsonArray pos = doc["pos"].to<JsonArray>();
+    for (uint8_t i = 0; i < NUM_SERVOS; i++) {
+        pos.add(servoController.getPosition(i));
+    }
+
+    if (clipPlayer.isPlaying()) {
+        doc["clipFrame"] = clipPlayer.getFrame();
+    }
+
+    return serializePooled(doc);
+}
+
+WsSharedBuffer WebServer::buildModeState() {
+    static JsonDocument doc;
+
+    doc.clear();
+    doc["type"] = "modeState";
+
+    // Eye Controller settings (pose is on the motion channel)
+    JsonObject eye = doc["eye"].to<JsonObject>();
+    eye["maxVergence"] = eyeController.getMaxVergence();
+    eye["mirrorPreview"] = storage.getModeConfig().mirrorPreview;
+    eye["idleMotion"] = eyeController.isIdleMotionActive();
+
+    // Mode System state
+    JsonObject modeState = doc["mode"].to<JsonObject>();
+    modeState["current"] = modeManager.getCurrentModeName();
+    char loading[32];
+    modeManager.getPendingAutoModeName(loading, sizeof(loading));
+    modeState["loading"] = loading;                               // "" = no switch pending
+    modeState["loadUs"] = modePlayer.getLoadUs();                 // Parse + compile time of current mode
+    modeState["seed"] = modePlayer.getSeed();                     // Replay with setSeed
+    modeState["isAuto"] = (modeManager.getCurrentMode() == Mode::AUTO);
+    modeState["autoBlink"] = autoBlink.isEnabled();         // Config setting
+    modeState["autoBlinkActive"] = autoBlink.isActive();    // Effective state (considers pause/override)
+    modeState["autoBlinkPaused"] = autoBlink.isPaused();
+    modeState["blinkIntervalMin"] = autoBlink.getIntervalMin();
+    modeState["blinkIntervalMax"] = autoBlink.getIntervalMax();
+    // NOTE: Available modes sent once on connect via sendAvailableLists()
+
+    // Impulse System state
+    JsonObject impulseState = doc["impulse"].to<JsonObject>();
+    impulseState["playing"] = impulsePlayer.isPlaying();
+    impulseState["pending"] = impulsePlayer.isPending();
+    impulseState["current"] = impulsePlayer.getCurrentImpulseName();
+    impulseState["preloaded"] = impulsePlayer.getPreloadedName();
+    impulseState["autoImpulse"] = autoImpulse.isEnabled();
+    impulseState["autoImpulseActive"] = autoImpulse.isActive();
+    impulseState["impulseIntervalMin"] = autoImpulse.getIntervalMin();
+    impulseState["impulseIntervalMax"] = autoImpulse.getIntervalMax();
+    impulseState["impulseSelection"] = autoImpulse.getSelection();
+    // NOTE: Available impulses sent once on connect via sendAvailableLists()
+
+    // Baked clip playback / recording (frame is on the motion channel)
+    JsonObject clipState = doc["clip"].to<JsonObject>();
+    clipState["playing"] = clipPlayer.isPlaying();
+    clipState["name"] = clipPlayer.getClipName();
+    clipState["frames"] = clipPlayer.getFrameCount();
+    clipState["recording"] = clipPlayer.isRecording();
+
+    return serializePooled(doc);
+}
+
+WsSharedBuffer WebServer::buildSystemState() {
     static JsonDocument doc;
 
     doc.clear();
-    doc["type"] = "state";
+    doc["type"] = "systemState";
 
     // Device ID (derived from chip ID, same as AP suffix)
     uint64_t chipId = ESP.getEfuseMac();
@@ -1315,40 +1238,40 @@ void WebServer::broadcastState() {
         servo["pin"] = config.pin;
     }
 
-    // Eye Controller state
+    // WebSocket clients: subscription and backpressure stats
+    JsonArray clients = doc["clients"].to<JsonArray>();
+    unsigned long now = millis();
+    for (const WsSubscriber& sub : _subscribers) {
+        AsyncWebSocketClient* client = sub.clientId ? ws.client(sub.clientId) : nullptr;
+        if (!client) continue;
+        JsonObject entry = clients.add<JsonObject>();
+        entry["id"] = sub.clientId;
+        entry["ip"] = client->remoteIP().toString();
+        entry["channels"] = sub.channels;
+        entry["motionHz"] = (sub.channels & WS_CHANNEL_MOTION) ? 1000 / sub.effectiveIntervalMs : 0;
+        entry["queue"] = sub.queueDepth;
+        entry["queueBytes"] = sub.queueDepth * sub.avgMessageBytes;  // Estimate
+        entry["dropped"] = sub.dropped;
+        entry["lagMs"] = sub.pendingChannels ? now - sub.heldSinceMs : 0;
+        entry["lagMaxMs"] = sub.lagMaxMs;
+    }
+
+    // Idle motion cost (changes every tick, so not part of the mode channel)
     JsonObject eye = doc["eye"].to<JsonObject>();
-    eye["gazeX"] = eyeController.getGazeX();
-    eye["gazeY"] = eyeController.getGazeY();
-    eye["gazeZ"] = eyeController.getGazeZ();
-    eye["lidLeft"] = eyeController.getLidLeft();
-    eye["lidRight"] = eyeController.getLidRight();
-    eye["coupling"] = eyeController.getCoupling();
-    eye["maxVergence"] = eyeController.getMaxVergence();
-    eye["mirrorPreview"] = storage.getModeConfig().mirrorPreview;
-
-    // Mode System state
-    JsonObject modeState = doc["mode"].to<JsonObject>();
-    modeState["current"] = modeManager.getCurrentModeName();
-    modeState["isAuto"] = (modeManager.getCurrentMode() == Mode::AUTO);
-    modeState["autoBlink"] = autoBlink.isEnabled();         // Config setting
-    modeState["autoBlinkActive"] = autoBlink.isActive();    // Effective state (considers pause/override)
-    modeState["autoBlinkPaused"] = autoBlink.isPaused();
-    modeState["blinkIntervalMin"] = autoBlink.getIntervalMin();
-    modeState["blinkIntervalMax"] = autoBlink.getIntervalMax();
-    // NOTE: Available modes sent once on connect via sendAvailableLists()
-
-    // Impulse System state
-    JsonObject impulseState = doc["impulse"].to<JsonObject>();
-    impulseState["playing"] = impulsePlayer.isPlaying();
-    impulseState["pending"] = impulsePlayer.isPending();
-    impulseState["current"] = impulsePlayer.getCurrentImpulseName();
-    impulseState["preloaded"] = impulsePlayer.getPreloadedName();
-    impulseState["autoImpulse"] = autoImpulse.isEnabled();
-    impulseState["autoImpulseActive"] = autoImpulse.isActive();
-    impulseState["impulseIntervalMin"] = autoImpulse.getIntervalMin();
-    impulseState["impulseIntervalMax"] = autoImpulse.getIntervalMax();
-    impulseState["impulseSelection"] = autoImpulse.getSelection();
-    // NOTE: Available impulses sent once on connect via sendAvailableLists()
+    eye["idleTickUs"] = eyeController.getIdleTickUs();
+    eye["idleTickMaxUs"] = eyeController.getIdleTickMaxUs();
+
+    // Wait lateness and impulse cache/latency counters (change almost every step,
+    // so they would defeat the mode channel's change detection)
+    JsonObject modeStats = doc["mode"].to<JsonObject>();
+    modeStats["lateMs"] = modePlayer.getLateMs();                 // Wait lateness (timeline, no accumulation)
+    modeStats["lateMaxMs"] = modePlayer.getLateMaxMs();
+    JsonObject impulseStats = doc["impulse"].to<JsonObject>();
+    impulseStats["cacheHits"] = impulsePlayer.getCacheHits();
+    impulseStats["cacheMisses"] = impulsePlayer.getCacheMisses();
+    impulseStats["cacheBytes"] = impulsePlayer.getCacheBytes();
+    impulseStats["triggerLatencyUs"] = impulsePlayer.getTriggerLatencyUs();        // Trigger to first step
+    impulseStats["triggerLatencyMaxUs"] = impulsePlayer.getTriggerLatencyMaxUs();
 
     // Update Check state
     JsonObject updateState = doc["update"].to<JsonObject>();
@@ -1359,10 +1282,7 @@ void WebServer::broadcastState() {
     updateState["enabled"] = updateChecker.isEnabled();
     updateState["interval"] = updateChecker.getInterval();
 
-    size_t len = serializeJson(doc, jsonBuffer, sizeof(jsonBuffer));
-    if (len > 0 && len < sizeof(jsonBuffer)) {
-        ws.textAll(jsonBuffer, len);
-    }
+    return serializePooled(doc);
 }
 
 void WebServer::sendConfigToClient(AsyncWebSocketClient* client) {
@@ -1420,6 +1340,7 @@ void WebServer::sendConfigToClient(AsyncWebSocketClient* client) {
     mode["blinkIntervalMax"] = modeConfig.blinkIntervalMax;
     mode["rememberLastMode"] = modeConfig.rememberLastMode;
     mode["mirrorPreview"] = modeConfig.mirrorPreview;
+    mode["transitionMs"] = modeConfig.transitionMs;
 
     // Impulse config
     ImpulseConfig impulseConfig = storage.getImpulseConfig();
@@ -1437,41 +1358,14 @@ void WebServer::sendConfigToClient(AsyncWebSocketClient* client) {
 
 void WebServer::sendAvailableLists(AsyncWebSocketClient* client) {
     // Send available modes and impulses to a specific client (on connect)
-    // This replaces sending them in every state broadcast
-    char jsonBuffer[512];
-    JsonDocument doc;
-
-    // Send available modes
-    doc.clear();
-    doc["type"] = "availableModes";
-    JsonArray modes = doc["modes"].to<JsonArray>();
-    modes.add("follow");  // Always available
-    int modeCount = modeManager.getAvailableModeCount();
-    for (int i = 0; i < modeCount; i++) {
-        char name[32];
-        if (modeManager.getAvailableModeName(i, name, sizeof(name))) {
-            modes.add(name);
-        }
+    // Messages are pre-serialized by the content index - no LittleFS access here
+    const String& modes = contentIndex.getModesMessage();
+    if (modes.length() > 0) {
+        client->text(modes);
     }
-    size_t len = serializeJson(doc, jsonBuffer, sizeof(jsonBuffer));
-    if (len > 0 && len < sizeof(jsonBuffer)) {
-        client->text(jsonBuffer, len);
-    }
-
-    // Send available impulses
-    doc.clear();
-    doc["type"] = "availableImpulses";
-    JsonArray impulses = doc["impulses"].to<JsonArray>();
-    int impulseCount = impulsePlayer.getAvailableImpulseCount();
-    for (int i = 0; i < impulseCount; i++) {
-        char name[32];
-        if (impulsePlayer.getAvailableImpulseName(i, name, sizeof(name))) {
-            impulses.add(name);
-        }
-    }
-    len = serializeJson(doc, jsonBuffer, sizeof(jsonBuffer));
-    if (len > 0 && len < sizeof(jsonBuffer)) {
-        client->text(jsonBuffer, len);
+    const String& impulses = contentIndex.getImpulsesMessage();
+    if (impulses.length() > 0) {
+        client->text(impulses);
     }
 }
 
@@ -1511,10 +1405,10 @@ void WebServer::broadcastLog(const String& logLine) {
     doc["type"] = "log";
     doc["line"] = logLine;
 
-    char buffer[LOG_LINE_MAX_LEN + 32];
-    size_t len = serializeJson(doc, buffer, sizeof(buffer));
-    if (len > 0 && len < sizeof(buffer)) {
-        ws.textAll(buffer, len);
+    // One buffer for all clients (WEB_LOG runs in any task, so not pooled)
+    WsSharedBuffer buffer = serializeShared(doc);
+    if (buffer) {
+        ws.textAll(buffer);
     }
 }
 
@@ -1531,10 +1425,10 @@ void WebServer::sendLogHistory(AsyncWebSocketClient* client) {
         lines.add(_logBuffer[idx]);
     }
 
-    char buffer[4096];  // Larger buffer for history
-    size_t len = serializeJson(doc, buffer, sizeof(buffer));
-    if (len > 0 && len < sizeof(buffer)) {
-        client->text(buffer, len);
+    // Serialized straight into the buffer the library queues (no 4 KB stack copy)
+    WsSharedBuffer buffer = serializeShared(doc);
+    if (buffer) {
+        client->text(buffer);
     }
 }
 
@@ -1570,7 +1464,7 @@ bool WebServer::isHttpRequestAuthorized(AsyncWebServerRequest* request) {
     for (int i = 0; i < _authClientCount; i++) {
         if (_authClients[i].ip == requestIP && _authClients[i].authenticated) {
             // Check timeout
-            if (_authClients[i].unlockTime > 0 && millis() > _authClients[i].unlockTime) {
+            if (_authClients[i].unlockTime > 0 && Scheduler::isDue(millis(), _authClients[i].unlockTime)) {
                 _authClients[i].authenticated = false;
                 continue;
             }
@@ -1601,7 +1495,7 @@ bool WebServer::isClientAuthenticated(AsyncWebSocketClient* client) {
                 return false;
             }
             // Check timeout (0 = no timeout for AP clients)
-            if (_authClients[i].unlockTime > 0 && millis() > _authClients[i].unlockTime) {
+            if (_authClients[i].unlockTime > 0 && Scheduler::isDue(millis(), _authClients[i].unlockTime)) {
                 _authClients[i].authenticated = false;
                 return false;
             }
@@ -1635,7 +1529,7 @@ int WebServer::getRemainingSeconds(AsyncWebSocketClient* client) {
             if (_authClients[i].unlockTime == 0) {
                 return 0;  // No timeout
             }
-            int remaining = (_authClients[i].unlockTime - millis()) / 1000;
+            int32_t remaining = (int32_t)(_authClients[i].unlockTime - millis()) / 1000;  // Wrap-safe
             return remaining > 0 ? remaining : 0;
         }
     }
@@ -1716,11 +1610,11 @@ bool WebServer::checkRateLimit(IPAddress ip) {
     // Returns true if allowed, false if rate limited
     for (int i = 0; i < _rateLimitCount; i++) {
         if (_rateLimits[i].ip == ip) {
-            if (_rateLimits[i].lockoutUntil > 0 && millis() < _rateLimits[i].lockoutUntil) {
+            if (_rateLimits[i].lockoutUntil > 0 && !Scheduler::isDue(millis(), _rateLimits[i].lockoutUntil)) {
                 return false;  // Still locked out
             }
             // Lockout expired, reset
-            if (_rateLimits[i].lockoutUntil > 0 && millis() >= _rateLimits[i].lockoutUntil) {
+            if (_rateLimits[i].lockoutUntil > 0 && Scheduler::isDue(millis(), _rateLimits[i].lockoutUntil)) {
                 _rateLimits[i].failedAttempts = 0;
                 _rateLimits[i].lockoutUntil = 0;
             }
@@ -1762,7 +1656,7 @@ int WebServer::getRateLimitSeconds(IPAddress ip) {
     // Returns seconds remaining in lockout, or 0 if not locked out
     for (int i = 0; i < _rateLimitCount; i++) {
         if (_rateLimits[i].ip == ip) {
-            if (_rateLimits[i].lockoutUntil > 0 && millis() < _rateLimits[i].lockoutUntil) {
+            if (_rateLimits[i].lockoutUntil > 0 && !Scheduler::isDue(millis(), _rateLimits[i].lockoutUntil)) {
                 return (_rateLimits[i].lockoutUntil - millis()) / 1000;
             }
         }
@@ -1782,7 +1676,13 @@ void WebServer::clearFailedAttempts(IPAddress ip) {
 
 void WebServer::sendAdminState(AsyncWebSocketClient* client) {
     // Send per-client admin lock state
-    char buffer[256];
+    WsSharedBuffer buffer = buildAdminState(client);
+    if (buffer) {
+        client->text(buffer);
+    }
+}
+
+WsSharedBuffer WebServer::buildAdminState(AsyncWebSocketClient* client) {
     JsonDocument doc;
 
     doc["type"] = "adminState";
@@ -1792,17 +1692,17 @@ void WebServer::sendAdminState(AsyncWebSocketClient* client) {
     doc["remainingSeconds"] = getRemainingSeconds(client);
     doc["lockoutSeconds"] = getRateLimitSeconds(client->remoteIP());  // Rate limit lockout
 
-    size_t len = serializeJson(doc, buffer, sizeof(buffer));
-    if (len > 0 && len < sizeof(buffer)) {
-        client->text(buffer, len);
-    }
+    return serializeShared(doc);
 }
 
 void WebServer::broadcastAdminStateToIP(IPAddress ip) {
     // Send admin state to ALL connected clients from the same IP
+    // (auth is per IP, so one message serves them all)
+    WsSharedBuffer buffer;
     for (auto& c : ws.getClients()) {
         if (c.status() == WS_CONNECTED && c.remoteIP() == ip) {
-            sendAdminState(&c);
+            if (!buffer) buffer = buildAdminState(&c);
+            if (buffer) c.text(buffer);
         }
     }
 }
@@ -1825,11 +1725,26 @@ void WebServer::sendAdminBlocked(AsyncWebSocketClient* client, const char* comma
 // WebSocket Message Handler
 // ============================================================================
 
-void WebServer::handleWebSocketMessage(const char* data, AsyncWebSocketClient* client) {
+void WebServer::dispatchWebSocketMessage(const char* data, size_t len, AsyncWebSocketClient* client) {
+    // Origin timestamp travels with every servo target this command changes
+    _commandOriginUs = micros();
+    _commandType[0] = '\0';
+    eyeController.setCommandOrigin(_commandOriginUs);
+    if (!handleFastCommand(data, len, client)) {
+        handleWebSocketMessage(data, len, client);
+    }
+    eyeController.setCommandOrigin(0);
+    latencyTrace.recordCommand(_commandType, _commandOriginUs, micros() - _commandOriginUs);
+    powerManager.wake();  // Main loop writes the new servo targets
+}
+
+void WebServer::handleWebSocketMessage(const char* data, size_t len, AsyncWebSocketClient* client) {
     // Static to avoid stack allocation on every message (reduces stack pressure in async context)
     static JsonDocument doc;
     doc.clear();
-    DeserializationError error = deserializeJson(doc, data);
+    uint32_t parseStartUs = micros();
+    DeserializationError error = deserializeJson(doc, data, len);
+    latencyTrace.recordParse(ParsePath::FULL, micros() - parseStartUs);
 
     if (error) {
         WEB_LOG("WS", "JSON parse error: %s", error.c_str());
@@ -1838,678 +1753,853 @@ void WebServer::handleWebSocketMessage(const char* data, AsyncWebSocketClient* c
 
     const char* type = doc["type"];
     if (!type) return;
+    strncpy(_commandType, type, sizeof(_commandType) - 1);
+    _commandType[sizeof(_commandType) - 1] = '\0';
 
-    if (strcmp(type, "setServo") == 0) {
-        uint8_t index = doc["index"];
-        uint8_t position = doc["position"];
-        servoController.setPosition(index, position);
+    int index = findWsCommand(type);
+    if (index < 0) {
+        WEB_LOG("WS", "Unknown command: %s", type);
+        return;
     }
-    else if (strcmp(type, "setCalibration") == 0) {
-        if (isClientLocked(client)) {
-            WEB_LOG("Admin", "setCalibration blocked: client locked");
-            sendAdminBlocked(client, "setCalibration");
-            return;
-        }
-        uint8_t index = doc["index"];
-        uint8_t min = doc["min"];
-        uint8_t center = doc["center"];
-        uint8_t max = doc["max"];
 
-        // Clamp to 0-180
-        min = constrain(min, 0, 180);
-        center = constrain(center, 0, 180);
-        max = constrain(max, 0, 180);
+    // Admin gating is table-driven (WsCommandGate in ws_commands.h)
+    const WsCommandInfo& command = WS_COMMAND_INFOS[index];
+    if (command.gate == WS_ADMIN && isClientLocked(client)) {
+        WEB_LOG("Admin", "%s blocked: client locked", type);
+        sendAdminBlocked(client, type);
+        return;
+    }
 
-        // Enforce min < center < max
-        if (min >= center) min = (center > 0) ? center - 1 : 0;
-        if (max <= center) max = (center < 180) ? center + 1 : 180;
-        if (min >= center) center = min + 1;
-        if (max <= center) center = max - 1;
+    (this->*_commandHandlers[index])(doc, client);
 
-        servoController.setCalibration(index, min, center, max);
+    // Request broadcast from main loop. Coalescible commands (gaze/servo streams)
+    // ride the periodic broadcast instead of forcing one per message.
+    if (!(command.flags & (WS_REPLIES | WS_COALESCE))) {
+        requestBroadcast();
     }
-    else if (strcmp(type, "setPin") == 0) {
-        if (isClientLocked(client)) {
-            WEB_LOG("Admin", "setPin blocked: client locked");
-            sendAdminBlocked(client, "setPin");
-            return;
-        }
-        uint8_t index = doc["index"];
-        uint8_t pin = doc["pin"];
-        servoController.setPin(index, pin);
-    }
-    else if (strcmp(type, "setInvert") == 0) {
-        if (isClientLocked(client)) {
-            WEB_LOG("Admin", "setInvert blocked: client locked");
-            sendAdminBlocked(client, "setInvert");
-            return;
-        }
-        uint8_t index = doc["index"];
-        bool invert = doc["invert"];
-        servoController.setInvert(index, invert);
-    }
-    else if (strcmp(type, "centerAll") == 0) {
-        servoController.requestCenterAll();
-    }
-    // Eye Controller commands
-    else if (strcmp(type, "setGaze") == 0) {
-        float x = doc["x"] | 0.0f;
-        float y = doc["y"] | 0.0f;
-        float z = doc["z"] | 100.0f;
-        eyeController.setGaze(x, y, z);
-    }
-    else if (strcmp(type, "setLids") == 0) {
-        float left = doc["left"] | 100.0f;
-        float right = doc["right"] | 100.0f;
-        eyeController.setLids(left, right);
-        autoBlink.resetTimer();  // Prevent auto-blink from fighting with manual lid control
-    }
-    else if (strcmp(type, "blink") == 0) {
-        unsigned int duration = doc["duration"] | 0;  // 0 = scaled based on lid position
-        eyeController.startBlink(duration);
-        autoBlink.resetTimer();
-        WEB_LOG("Control", "Blink");
+}
+
+bool WebServer::handleFastCommand(const char* data, size_t len, AsyncWebSocketClient* client) {
+    // Hot motion commands straight from the frame (ws_flat_message.h). Returns false
+    // before doing anything when the message needs the full parser.
+    WsFlatMessage msg;
+    uint32_t parseStartUs = micros();
+    if (!parseFlatMessage(data, len, msg) || msg.typeLen >= sizeof(_commandType)) return false;
+    uint32_t parseUs = micros() - parseStartUs;
+
+    char type[sizeof(_commandType)];
+    memcpy(type, msg.type, msg.typeLen);
+    type[msg.typeLen] = '\0';
+    int index = findWsCommand(type);
+    if (index < 0 || WS_COMMAND_INFOS[index].gate != WS_OPEN) return false;
+
+    switch (index) {
+        case WS_CMD_SetGaze:
+            applyGaze(msg.getFloat("x", 0.0f), msg.getFloat("y", 0.0f), msg.getFloat("z", 100.0f));
+            break;
+        case WS_CMD_SetLids:
+            applyLids(msg.getFloat("left", 100.0f), msg.getFloat("right", 100.0f));
+            break;
+        case WS_CMD_SetServo: {
+            int32_t servo, position;
+            if (!msg.getInt("index", 0, 255, 0, servo) || !msg.getInt("position", 0, 255, 0, position)) return false;
+            applyServo(servo, position);
+            break;
+        }
+        case WS_CMD_Blink:
+        case WS_CMD_BlinkLeft:
+        case WS_CMD_BlinkRight: {
+            int32_t duration;
+            if (!msg.getInt("duration", 0, INT32_MAX, 0, duration)) return false;
+            applyBlink((WsCommandId)index, duration);
+            break;
+        }
+        default:
+            return false;  // Not a hot command
+    }
+
+    memcpy(_commandType, type, msg.typeLen + 1);
+    latencyTrace.recordParse(ParsePath::FAST, parseUs);
+    if (!(WS_COMMAND_INFOS[index].flags & (WS_REPLIES | WS_COALESCE))) {
+        requestBroadcast();
     }
-    else if (strcmp(type, "blinkLeft") == 0) {
-        unsigned int duration = doc["duration"] | 0;  // 0 = scaled based on lid position
+    return true;
+}
+
+const WebServer::CommandHandler WebServer::_commandHandlers[] = {
+#define WS_COMMAND_HANDLER(handler, name, gate, flags) &WebServer::cmd##handler,
+    WS_COMMANDS(WS_COMMAND_HANDLER)
+#undef WS_COMMAND_HANDLER
+};
+
+// ============================================================================
+// Servo Commands
+// ============================================================================
+
+void WebServer::cmdSetServo(JsonDocument& doc, AsyncWebSocketClient* client) {
+    applyServo(doc["index"], doc["position"]);
+}
+
+void WebServer::applyServo(uint8_t index, uint8_t position) {
+    servoController.setPosition(index, position, _commandOriginUs);
+}
+
+void WebServer::cmdSetCalibration(JsonDocument& doc, AsyncWebSocketClient* client) {
+    uint8_t index = doc["index"];
+    uint8_t min = doc["min"];
+    uint8_t center = doc["center"];
+    uint8_t max = doc["max"];
+
+    // Clamp to 0-180
+    min = constrain(min, 0, 180);
+    center = constrain(center, 0, 180);
+    max = constrain(max, 0, 180);
+
+    // Enforce min < center < max
+    if (min >= center) min = (center > 0) ? center - 1 : 0;
+    if (max <= center) max = (center < 180) ? center + 1 : 180;
+    if (min >= center) center = min + 1;
+    if (max <= center) center = max - 1;
+
+    servoController.setCalibration(index, min, center, max);
+}
+
+void WebServer::cmdSetPin(JsonDocument& doc, AsyncWebSocketClient* client) {
+    uint8_t index = doc["index"];
+    uint8_t pin = doc["pin"];
+    servoController.setPin(index, pin);
+}
+
+void WebServer::cmdSetInvert(JsonDocument& doc, AsyncWebSocketClient* client) {
+    uint8_t index = doc["index"];
+    bool invert = doc["invert"];
+    servoController.setInvert(index, invert);
+}
+
+void WebServer::cmdCenterAll(JsonDocument& doc, AsyncWebSocketClient* client) {
+    servoController.requestCenterAll();
+}
+
+// ============================================================================
+// Eye Controller Commands
+// ============================================================================
+
+// Hot commands: the JSON handlers and handleFastCommand() share the apply*() bodies
+
+void WebServer::cmdSetGaze(JsonDocument& doc, AsyncWebSocketClient* client) {
+    applyGaze(doc["x"] | 0.0f, doc["y"] | 0.0f, doc["z"] | 100.0f);
+}
+
+void WebServer::applyGaze(float x, float y, float z) {
+    eyeController.setGaze(x, y, z);
+}
+
+void WebServer::cmdSetLids(JsonDocument& doc, AsyncWebSocketClient* client) {
+    applyLids(doc["left"] | 100.0f, doc["right"] | 100.0f);
+}
+
+void WebServer::applyLids(float left, float right) {
+    eyeController.setLids(left, right);
+    autoBlink.resetTimer();  // Prevent auto-blink from fighting with manual lid control
+}
+
+void WebServer::cmdBlink(JsonDocument& doc, AsyncWebSocketClient* client) {
+    applyBlink(WS_CMD_Blink, doc["duration"] | 0);  // 0 = scaled based on lid position
+}
+
+void WebServer::cmdBlinkLeft(JsonDocument& doc, AsyncWebSocketClient* client) {
+    applyBlink(WS_CMD_BlinkLeft, doc["duration"] | 0);
+}
+
+void WebServer::cmdBlinkRight(JsonDocument& doc, AsyncWebSocketClient* client) {
+    applyBlink(WS_CMD_BlinkRight, doc["duration"] | 0);
+}
+
+void WebServer::applyBlink(WsCommandId command, unsigned int duration) {
+    if (command == WS_CMD_BlinkLeft) {
         eyeController.startBlinkLeft(duration);
-        autoBlink.resetTimer();
         WEB_LOG("Control", "Wink left");
-    }
-    else if (strcmp(type, "blinkRight") == 0) {
-        unsigned int duration = doc["duration"] | 0;  // 0 = scaled based on lid position
+    } else if (command == WS_CMD_BlinkRight) {
         eyeController.startBlinkRight(duration);
-        autoBlink.resetTimer();
         WEB_LOG("Control", "Wink right");
+    } else {
+        eyeController.startBlink(duration);
+        WEB_LOG("Control", "Blink");
     }
-    else if (strcmp(type, "setCoupling") == 0) {
-        float value = doc["value"] | 1.0f;
-        eyeController.setCoupling(value);
-    }
-    else if (strcmp(type, "setVergence") == 0) {
-        float max = doc["max"] | 30.0f;
-        eyeController.setMaxVergence(max);
-    }
-    else if (strcmp(type, "centerEyes") == 0) {
-        eyeController.center();
-    }
-    else if (strcmp(type, "reapplyEyeState") == 0) {
-        // Re-apply current Eye Controller state to servos
-        // Used when returning to Control tab from Calibration
-        eyeController.reapply();
-    }
-    // Mode System commands
-    else if (strcmp(type, "setMode") == 0) {
-        const char* mode = doc["mode"];
-        if (mode) {
-            if (strcmp(mode, "follow") == 0) {
-                modeManager.setMode(Mode::FOLLOW);
-                WEB_LOG("Control", "Mode: Follow");
-            } else {
-                if (modeManager.setAutoMode(mode)) {
-                    WEB_LOG("Control", "Mode: Auto (%s)", mode);
-                } else {
-                    WEB_LOG("Control", "Failed to load mode: %s", mode);
-                }
-            }
+    autoBlink.resetTimer();
+}
+
+void WebServer::cmdSetCoupling(JsonDocument& doc, AsyncWebSocketClient* client) {
+    float value = doc["value"] | 1.0f;
+    eyeController.setCoupling(value);
+}
+
+void WebServer::cmdSetVergence(JsonDocument& doc, AsyncWebSocketClient* client) {
+    float max = doc["max"] | 30.0f;
+    eyeController.setMaxVergence(max);
+}
+
+void WebServer::cmdCenterEyes(JsonDocument& doc, AsyncWebSocketClient* client) {
+    eyeController.center();
+}
+
+void WebServer::cmdReapplyEyeState(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Re-apply current Eye Controller state to servos
+    // Used when returning to Control tab from Calibration
+    eyeController.reapply();
+}
+
+// ============================================================================
+// Mode System Commands
+// ============================================================================
+
+void WebServer::cmdSetMode(JsonDocument& doc, AsyncWebSocketClient* client) {
+    const char* mode = doc["mode"];
+    if (mode) {
+        // Both switch in the main loop, between steps
+        if (strcmp(mode, "follow") == 0) {
+            modeManager.requestMode(Mode::FOLLOW);
+            WEB_LOG("Control", "Mode: Follow");
+        } else {
+            // Loaded in the background; the switch happens when it's ready
+            modeManager.requestAutoMode(mode);
+            WEB_LOG("Control", "Mode: Auto (%s) loading", mode);
         }
     }
-    else if (strcmp(type, "setAutoBlink") == 0) {
-        bool enabled = doc["enabled"] | true;
-        autoBlink.setEnabled(enabled);
-        // Save to config
-        ModeConfig config = storage.getModeConfig();
-        config.autoBlink = enabled;
-        storage.setModeConfig(config);
-        WEB_LOG("Mode", "Auto-blink %s", enabled ? "enabled" : "disabled");
+}
+
+void WebServer::cmdSetSeed(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Reproducible randomness for debugging a show (0 = back to hardware entropy)
+    _requestedSeed = doc["seed"] | 0u;
+    _seedRequested = true;
+}
+
+void WebServer::cmdSetAutoBlink(JsonDocument& doc, AsyncWebSocketClient* client) {
+    bool enabled = doc["enabled"] | true;
+    autoBlink.setEnabled(enabled);
+    // Save to config
+    ModeConfig config = storage.getModeConfig();
+    config.autoBlink = enabled;
+    storage.setModeConfig(config);
+    WEB_LOG("Mode", "Auto-blink %s", enabled ? "enabled" : "disabled");
+}
+
+void WebServer::cmdSetRememberLastMode(JsonDocument& doc, AsyncWebSocketClient* client) {
+    bool enabled = doc["enabled"] | false;
+    ModeConfig config = storage.getModeConfig();
+    config.rememberLastMode = enabled;
+    // When enabling remember, also save current mode as default
+    if (enabled) {
+        const char* currentMode = modeManager.getCurrentModeName();
+        strncpy(config.defaultMode, currentMode, sizeof(config.defaultMode) - 1);
+        config.defaultMode[sizeof(config.defaultMode) - 1] = '\0';
+        WEB_LOG("Mode", "Remember last mode enabled, saving current mode: %s", currentMode);
+    }
+    storage.setModeConfig(config);
+    WEB_LOG("Mode", "Remember last mode %s", enabled ? "enabled" : "disabled");
+}
+
+void WebServer::cmdSetMirrorPreview(JsonDocument& doc, AsyncWebSocketClient* client) {
+    bool enabled = doc["enabled"] | false;
+    ModeConfig config = storage.getModeConfig();
+    config.mirrorPreview = enabled;
+    storage.setModeConfig(config);
+    WEB_LOG("Eye", "Mirror preview %s", enabled ? "enabled" : "disabled");
+}
+
+void WebServer::cmdSetModeTransition(JsonDocument& doc, AsyncWebSocketClient* client) {
+    int ms = doc["ms"] | DEFAULT_MODE_TRANSITION_MS;
+    ModeConfig config = storage.getModeConfig();
+    config.transitionMs = constrain(ms, 0, MAX_MODE_TRANSITION_MS);
+    storage.setModeConfig(config);
+    WEB_LOG("Mode", "Mode transition set to %d ms", config.transitionMs);
+}
+
+void WebServer::cmdPauseAutoBlink(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Temporary pause for calibration - pauses ALL automated control
+    bool paused = doc["paused"] | false;
+    if (paused) {
+        autoBlink.pause();
+        autoImpulse.pause();
+        modePlayer.pause();
+        WEB_LOG("Calibration", "Entering calibration mode");
+    } else {
+        autoBlink.resume();
+        autoImpulse.resume();
+        modePlayer.resume();
+        WEB_LOG("Calibration", "Exiting calibration mode");
     }
-    else if (strcmp(type, "setRememberLastMode") == 0) {
-        bool enabled = doc["enabled"] | false;
-        ModeConfig config = storage.getModeConfig();
-        config.rememberLastMode = enabled;
-        // When enabling remember, also save current mode as default
-        if (enabled) {
-            const char* currentMode = modeManager.getCurrentModeName();
-            strncpy(config.defaultMode, currentMode, sizeof(config.defaultMode) - 1);
-            config.defaultMode[sizeof(config.defaultMode) - 1] = '\0';
-            WEB_LOG("Mode", "Remember last mode enabled, saving current mode: %s", currentMode);
-        }
-        storage.setModeConfig(config);
-        WEB_LOG("Mode", "Remember last mode %s", enabled ? "enabled" : "disabled");
+}
+
+void WebServer::cmdPauseModePlayer(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Pause mode player during manual control interaction (auto modes only)
+    bool paused = doc["paused"] | false;
+    if (paused) {
+        modePlayer.pause();
+    } else {
+        modePlayer.resume();
+    }
+}
+
+void WebServer::cmdSetAutoBlinkOverride(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Runtime override (for Follow mode toggle) - doesn't affect config
+    if (doc.containsKey("enabled")) {
+        bool enabled = doc["enabled"];
+        autoBlink.setRuntimeOverride(enabled);
+        WEB_LOG("Control", "Auto-blink: %s", enabled ? "on" : "off");
+    } else {
+        autoBlink.clearRuntimeOverride();
+        WEB_LOG("Control", "Auto-blink: default");
+    }
+}
+
+void WebServer::cmdSetAutoImpulseOverride(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Runtime override (for Follow mode toggle) - doesn't affect config
+    if (doc.containsKey("enabled")) {
+        bool enabled = doc["enabled"];
+        autoImpulse.setRuntimeOverride(enabled);
+        WEB_LOG("Control", "Auto-impulse: %s", enabled ? "on" : "off");
+    } else {
+        autoImpulse.clearRuntimeOverride();
+        WEB_LOG("Control", "Auto-impulse: default");
     }
-    else if (strcmp(type, "setMirrorPreview") == 0) {
-        bool enabled = doc["enabled"] | false;
+}
+
+void WebServer::cmdSetBlinkInterval(JsonDocument& doc, AsyncWebSocketClient* client) {
+    uint16_t minMs = doc["min"] | DEFAULT_BLINK_INTERVAL_MIN;
+    uint16_t maxMs = doc["max"] | DEFAULT_BLINK_INTERVAL_MAX;
+    autoBlink.setInterval(minMs, maxMs);
+    // Save to config
+    ModeConfig config = storage.getModeConfig();
+    config.blinkIntervalMin = minMs;
+    config.blinkIntervalMax = maxMs;
+    storage.setModeConfig(config);
+    WEB_LOG("Mode", "Blink interval set to %d-%d ms", minMs, maxMs);
+}
+
+void WebServer::cmdSetDefaultMode(JsonDocument& doc, AsyncWebSocketClient* client) {
+    const char* mode = doc["mode"];
+    if (mode) {
         ModeConfig config = storage.getModeConfig();
-        config.mirrorPreview = enabled;
+        strncpy(config.defaultMode, mode, sizeof(config.defaultMode) - 1);
+        config.defaultMode[sizeof(config.defaultMode) - 1] = '\0';
         storage.setModeConfig(config);
-        WEB_LOG("Eye", "Mirror preview %s", enabled ? "enabled" : "disabled");
-    }
-    else if (strcmp(type, "pauseAutoBlink") == 0) {
-        // Temporary pause for calibration - pauses ALL automated control
-        bool paused = doc["paused"] | false;
-        if (paused) {
-            autoBlink.pause();
-            autoImpulse.pause();
-            modePlayer.pause();
-            WEB_LOG("Calibration", "Entering calibration mode");
-        } else {
-            autoBlink.resume();
-            autoImpulse.resume();
-            modePlayer.resume();
-            WEB_LOG("Calibration", "Exiting calibration mode");
-        }
-    }
-    else if (strcmp(type, "pauseModePlayer") == 0) {
-        // Pause mode player during manual control interaction (auto modes only)
-        bool paused = doc["paused"] | false;
-        if (paused) {
-            modePlayer.pause();
-        } else {
-            modePlayer.resume();
-        }
+        WEB_LOG("Mode", "Default startup mode set to: %s", mode);
     }
-    else if (strcmp(type, "setAutoBlinkOverride") == 0) {
-        // Runtime override (for Follow mode toggle) - doesn't affect config
-        if (doc.containsKey("enabled")) {
-            bool enabled = doc["enabled"];
-            autoBlink.setRuntimeOverride(enabled);
-            WEB_LOG("Control", "Auto-blink: %s", enabled ? "on" : "off");
+}
+
+void WebServer::cmdGetAvailableModes(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Send list of available modes to client (cached by the content index)
+    client->text(contentIndex.getModesMessage());
+}
+
+void WebServer::cmdSaveMode(JsonDocument& doc, AsyncWebSocketClient* client) {
+    saveSequenceFile("/modes", doc, client);
+}
+
+void WebServer::saveSequenceFile(const char* dir, JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Bulk upload of a whole mode/impulse file in one (usually reassembled) message:
+    // {"type": "saveMode", "name": "curious", "content": {"name": "Curious", "sequence": [...]}}
+    const char* name = doc["name"] | "";
+    JsonObject content = doc["content"];
+    char path[64];
+    snprintf(path, sizeof(path), "%s/%s.json", dir, name);
+
+    const char* error = nullptr;
+    if (name[0] == '\0' || strlen(name) >= sizeof(ContentEntry::name) || strpbrk(name, "/.")) {
+        error = "invalid name";
+    } else if (content.isNull()) {
+        error = "missing content";
+    } else {
+        // Validate a copy: compileSequence() inlines called impulses into the document
+        JsonDocument check;
+        check.set(content);
+        if (!compileSequence(check, path)) error = "invalid sequence";
+    }
+
+    if (!error) {
+        if (!LittleFS.exists(dir)) {
+            LittleFS.mkdir(dir);
+        }
+        // Write next to the live file and rename over it once complete, so a full
+        // filesystem never truncates a working mode and the loader task never
+        // reads a half-written one (LittleFS rename replaces the target atomically)
+        char tempPath[72];
+        snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+        File file = LittleFS.open(tempPath, "w");
+        size_t expected = measureJson(content);
+        size_t written = file ? serializeJson(content, file) : 0;
+        if (file) file.close();
+        if (written != expected) {
+            error = "write failed";
+        } else if (!LittleFS.rename(tempPath, path)) {
+            error = "rename failed";
+        }
+        if (error) {
+            LittleFS.remove(tempPath);
         } else {
-            autoBlink.clearRuntimeOverride();
-            WEB_LOG("Control", "Auto-blink: default");
+            WEB_LOG("WebServer", "Saved %s (%u bytes)", path, (unsigned)written);
+            contentIndex.requestRebuild();
         }
     }
-    else if (strcmp(type, "setAutoImpulseOverride") == 0) {
-        // Runtime override (for Follow mode toggle) - doesn't affect config
-        if (doc.containsKey("enabled")) {
-            bool enabled = doc["enabled"];
-            autoImpulse.setRuntimeOverride(enabled);
-            WEB_LOG("Control", "Auto-impulse: %s", enabled ? "on" : "off");
-        } else {
-            autoImpulse.clearRuntimeOverride();
-            WEB_LOG("Control", "Auto-impulse: default");
-        }
+    if (error) {
+        WEB_LOG("WebServer", "Not saved: %s (%s)", path, error);
     }
-    else if (strcmp(type, "setBlinkInterval") == 0) {
-        uint16_t minMs = doc["min"] | DEFAULT_BLINK_INTERVAL_MIN;
-        uint16_t maxMs = doc["max"] | DEFAULT_BLINK_INTERVAL_MAX;
-        autoBlink.setInterval(minMs, maxMs);
-        // Save to config
-        ModeConfig config = storage.getModeConfig();
-        config.blinkIntervalMin = minMs;
-        config.blinkIntervalMax = maxMs;
-        storage.setModeConfig(config);
-        WEB_LOG("Mode", "Blink interval set to %d-%d ms", minMs, maxMs);
-    }
-    else if (strcmp(type, "setDefaultMode") == 0) {
-        const char* mode = doc["mode"];
-        if (mode) {
-            ModeConfig config = storage.getModeConfig();
-            strncpy(config.defaultMode, mode, sizeof(config.defaultMode) - 1);
-            config.defaultMode[sizeof(config.defaultMode) - 1] = '\0';
-            storage.setModeConfig(config);
-            WEB_LOG("Mode", "Default startup mode set to: %s", mode);
-        }
+
+    JsonDocument reply;
+    reply["type"] = "contentSaved";
+    reply["path"] = path;
+    reply["ok"] = error == nullptr;
+    if (error) reply["error"] = error;
+    char buffer[160];
+    size_t len = serializeJson(reply, buffer, sizeof(buffer));
+    if (len > 0 && len < sizeof(buffer)) {
+        client->text(buffer, len);
     }
-    else if (strcmp(type, "getAvailableModes") == 0) {
-        // Send list of available modes to client
-        JsonDocument response;
-        response["type"] = "availableModes";
-        JsonArray modes = response["modes"].to<JsonArray>();
-        modes.add("follow");  // Always available
-        int count = modeManager.getAvailableModeCount();
-        for (int i = 0; i < count; i++) {
-            char name[32];
-            if (modeManager.getAvailableModeName(i, name, sizeof(name))) {
-                modes.add(name);
-            }
+}
+
+// ============================================================================
+// Impulse System Commands
+// ============================================================================
+
+void WebServer::cmdTriggerImpulse(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Trigger impulse (uses preloaded or loads specified name)
+    const char* name = doc["name"];
+    if (name && strlen(name) > 0) {
+        WEB_LOG("Control", "Impulse triggered: %s", name);
+        if (!impulsePlayer.triggerByName(name)) {
+            WEB_LOG("Control", "Impulse trigger failed: %s", name);
         }
-        String output;
-        serializeJson(response, output);
-        client->text(output);
-        return;  // Don't request broadcast, we sent our own response
-    }
-    // Impulse System commands
-    else if (strcmp(type, "triggerImpulse") == 0) {
-        // Trigger impulse (uses preloaded or loads specified name)
-        const char* name = doc["name"];
-        if (name && strlen(name) > 0) {
-            WEB_LOG("Control", "Impulse triggered: %s", name);
-            if (!impulsePlayer.triggerByName(name)) {
-                WEB_LOG("Control", "Impulse trigger failed: %s", name);
-            }
-        } else {
-            // Trigger preloaded impulse
-            WEB_LOG("Control", "Impulse triggered");
-            if (!impulsePlayer.trigger()) {
-                WEB_LOG("Control", "Impulse trigger failed");
-            }
+    } else {
+        // Trigger preloaded impulse
+        WEB_LOG("Control", "Impulse triggered");
+        if (!impulsePlayer.trigger()) {
+            WEB_LOG("Control", "Impulse trigger failed");
         }
-        autoImpulse.resetTimer();  // Reset auto-impulse timer
     }
-    else if (strcmp(type, "setAutoImpulse") == 0) {
-        bool enabled = doc["enabled"] | true;
-        autoImpulse.setEnabled(enabled);
+    autoImpulse.resetTimer();  // Reset auto-impulse timer
+}
+
+void WebServer::cmdSetAutoImpulse(JsonDocument& doc, AsyncWebSocketClient* client) {
+    bool enabled = doc["enabled"] | true;
+    autoImpulse.setEnabled(enabled);
+    // Save to config
+    ImpulseConfig config = storage.getImpulseConfig();
+    config.autoImpulse = enabled;
+    storage.setImpulseConfig(config);
+    WEB_LOG("Impulse", "Auto-impulse %s", enabled ? "enabled" : "disabled");
+}
+
+void WebServer::cmdSetImpulseInterval(JsonDocument& doc, AsyncWebSocketClient* client) {
+    uint32_t minMs = doc["min"] | DEFAULT_IMPULSE_INTERVAL_MIN;
+    uint32_t maxMs = doc["max"] | DEFAULT_IMPULSE_INTERVAL_MAX;
+    autoImpulse.setInterval(minMs, maxMs);
+    // Save to config
+    ImpulseConfig config = storage.getImpulseConfig();
+    config.impulseIntervalMin = minMs;
+    config.impulseIntervalMax = maxMs;
+    storage.setImpulseConfig(config);
+    WEB_LOG("Impulse", "Impulse interval set to %lu-%lu ms", minMs, maxMs);
+}
+
+void WebServer::cmdSetImpulseSelection(JsonDocument& doc, AsyncWebSocketClient* client) {
+    const char* selection = doc["selection"];
+    if (selection) {
+        autoImpulse.setSelection(selection);
         // Save to config
         ImpulseConfig config = storage.getImpulseConfig();
-        config.autoImpulse = enabled;
+        strncpy(config.impulseSelection, selection, sizeof(config.impulseSelection) - 1);
+        config.impulseSelection[sizeof(config.impulseSelection) - 1] = '\0';
         storage.setImpulseConfig(config);
-        WEB_LOG("Impulse", "Auto-impulse %s", enabled ? "enabled" : "disabled");
+        WEB_LOG("Impulse", "Impulse selection updated: %s", selection);
     }
-    else if (strcmp(type, "setImpulseInterval") == 0) {
-        uint32_t minMs = doc["min"] | DEFAULT_IMPULSE_INTERVAL_MIN;
-        uint32_t maxMs = doc["max"] | DEFAULT_IMPULSE_INTERVAL_MAX;
-        autoImpulse.setInterval(minMs, maxMs);
-        // Save to config
-        ImpulseConfig config = storage.getImpulseConfig();
-        config.impulseIntervalMin = minMs;
-        config.impulseIntervalMax = maxMs;
-        storage.setImpulseConfig(config);
-        WEB_LOG("Impulse", "Impulse interval set to %lu-%lu ms", minMs, maxMs);
-    }
-    else if (strcmp(type, "setImpulseSelection") == 0) {
-        const char* selection = doc["selection"];
-        if (selection) {
-            autoImpulse.setSelection(selection);
-            // Save to config
-            ImpulseConfig config = storage.getImpulseConfig();
-            strncpy(config.impulseSelection, selection, sizeof(config.impulseSelection) - 1);
-            config.impulseSelection[sizeof(config.impulseSelection) - 1] = '\0';
-            storage.setImpulseConfig(config);
-            WEB_LOG("Impulse", "Impulse selection updated: %s", selection);
-        }
+}
+
+void WebServer::cmdGetAvailableImpulses(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Send list of available impulses to client (cached by the content index)
+    client->text(contentIndex.getImpulsesMessage());
+}
+
+void WebServer::cmdSaveImpulse(JsonDocument& doc, AsyncWebSocketClient* client) {
+    saveSequenceFile("/impulses", doc, client);
+}
+
+// ============================================================================
+// Clip Commands
+// ============================================================================
+
+// File access happens in clipPlayer.loop()
+
+void WebServer::cmdPlayClip(JsonDocument& doc, AsyncWebSocketClient* client) {
+    const char* name = doc["name"] | "";
+    if (name[0] != '\0' && !strchr(name, '/')) {
+        clipPlayer.requestPlay(name);
     }
-    else if (strcmp(type, "getAvailableImpulses") == 0) {
-        // Send list of available impulses to client
-        JsonDocument response;
-        response["type"] = "availableImpulses";
-        JsonArray impulses = response["impulses"].to<JsonArray>();
-        int count = impulsePlayer.getAvailableImpulseCount();
-        for (int i = 0; i < count; i++) {
-            char name[32];
-            if (impulsePlayer.getAvailableImpulseName(i, name, sizeof(name))) {
-                impulses.add(name);
-            }
-        }
-        String output;
-        serializeJson(response, output);
-        client->text(output);
-        return;  // Don't request broadcast, we sent our own response
-    }
-    // Legacy setWifi (uses network 0)
-    else if (strcmp(type, "setWifi") == 0) {
-        if (isClientLocked(client)) {
-            WEB_LOG("Admin", "setWifi blocked: client locked");
-            sendAdminBlocked(client, "setWifi");
-            return;
-        }
-        const char* ssid = doc["ssid"];
-        const char* password = doc["password"];
-        if (ssid && password) {
-            if (storage.setWifiNetwork(0, ssid, password)) {
-                wifiManager.connectToNetwork(0);
-            } else {
-                WEB_LOG("WS", "Failed to save WiFi credentials");
-            }
-        }
+}
+
+void WebServer::cmdStopClip(JsonDocument& doc, AsyncWebSocketClient* client) {
+    clipPlayer.requestStop();  // Also ends a recording early (saves what was recorded)
+}
+
+void WebServer::cmdRecordClip(JsonDocument& doc, AsyncWebSocketClient* client) {
+    const char* name = doc["name"] | "";
+    uint32_t seconds = doc["seconds"] | 10u;
+    if (name[0] != '\0' && !strchr(name, '/') && seconds > 0) {
+        clipPlayer.requestRecord(name, seconds * 1000);
     }
-    // New multi-network commands
-    else if (strcmp(type, "setWifiNetwork") == 0) {
-        if (isClientLocked(client)) {
-            WEB_LOG("Admin", "setWifiNetwork blocked: client locked");
-            sendAdminBlocked(client, "setWifiNetwork");
-            return;
+}
+
+// ============================================================================
+// State Channel Commands
+// ============================================================================
+
+void WebServer::cmdSubscribe(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // {"type": "subscribe", "channels": ["motion", "mode", "system"], "motionHz": 20}
+    WsSubscriber* sub = findSubscriber(client->id());
+    if (!sub) return;
+
+    uint8_t channels = 0;
+    for (JsonVariant channel : doc["channels"].as<JsonArray>()) {
+        const char* name = channel | "";
+        if (strcmp(name, "motion") == 0) channels |= WS_CHANNEL_MOTION;
+        else if (strcmp(name, "mode") == 0) channels |= WS_CHANNEL_MODE;
+        else if (strcmp(name, "system") == 0) channels |= WS_CHANNEL_SYSTEM;
+    }
+    int motionHz = constrain(doc["motionHz"] | WS_MOTION_DEFAULT_HZ, 1, WS_MOTION_MAX_HZ);
+
+    sub->channels = channels;
+    sub->motionIntervalMs = 1000 / motionHz;
+    sub->effectiveIntervalMs = max(sub->effectiveIntervalMs, sub->motionIntervalMs);  // Keep an active backoff
+    sub->snapshotPending = true;  // Channels the client did not have yet start from a full message
+    _snapshotRequested = true;
+    powerManager.wake();
+}
+
+// ============================================================================
+// Network Commands
+// ============================================================================
+
+// Legacy setWifi (uses network 0)
+void WebServer::cmdSetWifi(JsonDocument& doc, AsyncWebSocketClient* client) {
+    const char* ssid = doc["ssid"];
+    const char* password = doc["password"];
+    if (ssid && password) {
+        if (storage.setWifiNetwork(0, ssid, password)) {
+            wifiManager.connectToNetwork(0);
+        } else {
+            WEB_LOG("WS", "Failed to save WiFi credentials");
         }
-        uint8_t index = doc["index"];
-        const char* ssid = doc["ssid"];
-        const char* password = doc["password"];
-        if (ssid && password && index < WIFI_MAX_NETWORKS) {
-            if (storage.setWifiNetwork(index, ssid, password)) {
-                WEB_LOG("Config", "WiFi network %d saved: %s", index, ssid);
-                // If setting primary and not connected, try to connect
-                if (index == 0 && !wifiManager.isConnected()) {
-                    wifiManager.connectToNetwork(0);
-                }
-            } else {
-                WEB_LOG("Config", "Failed to save WiFi network %d", index);
+    }
+}
+
+// New multi-network commands
+void WebServer::cmdSetWifiNetwork(JsonDocument& doc, AsyncWebSocketClient* client) {
+    uint8_t index = doc["index"];
+    const char* ssid = doc["ssid"];
+    const char* password = doc["password"];
+    if (ssid && password && index < WIFI_MAX_NETWORKS) {
+        if (storage.setWifiNetwork(index, ssid, password)) {
+            WEB_LOG("Config", "WiFi network %d saved: %s", index, ssid);
+            // If setting primary and not connected, try to connect
+            if (index == 0 && !wifiManager.isConnected()) {
+                wifiManager.connectToNetwork(0);
             }
+        } else {
+            WEB_LOG("Config", "Failed to save WiFi network %d", index);
         }
     }
-    else if (strcmp(type, "clearWifiNetwork") == 0) {
-        if (isClientLocked(client)) {
-            WEB_LOG("Admin", "clearWifiNetwork blocked: client locked");
-            sendAdminBlocked(client, "clearWifiNetwork");
-            return;
-        }
-        uint8_t index = doc["index"];
-        if (index < WIFI_MAX_NETWORKS) {
-            storage.clearWifiNetwork(index);
-            WEB_LOG("Config", "WiFi network %d cleared", index);
-        }
+}
+
+void WebServer::cmdClearWifiNetwork(JsonDocument& doc, AsyncWebSocketClient* client) {
+    uint8_t index = doc["index"];
+    if (index < WIFI_MAX_NETWORKS) {
+        storage.clearWifiNetwork(index);
+        WEB_LOG("Config", "WiFi network %d cleared", index);
     }
-    else if (strcmp(type, "setWifiTiming") == 0) {
-        if (isClientLocked(client)) {
-            WEB_LOG("Admin", "setWifiTiming blocked: client locked");
-            sendAdminBlocked(client, "setWifiTiming");
-            return;
-        }
-        WifiTiming timing;
-        timing.graceMs = doc["grace"].as<uint16_t>() * 1000;  // UI sends seconds
-        timing.retries = doc["retries"];
-        timing.retryDelayMs = doc["retryDelay"].as<uint16_t>() * 1000;
-        timing.apScanMs = doc["apScan"].as<uint32_t>() * 60000;  // UI sends minutes
-        timing.keepAP = doc["keepAP"] | true;
-
-        // Validate ranges
-        timing.graceMs = constrain(timing.graceMs, 1000, 10000);
-        timing.retries = constrain(timing.retries, 1, 10);
-        timing.retryDelayMs = constrain(timing.retryDelayMs, 5000, 60000);
-        timing.apScanMs = constrain(timing.apScanMs, 60000, 1800000);
-
-        storage.setWifiTiming(timing);
-    }
-    else if (strcmp(type, "setKeepAP") == 0) {
-        if (isClientLocked(client)) {
-            WEB_LOG("Admin", "setKeepAP blocked: client locked");
-            sendAdminBlocked(client, "setKeepAP");
-            return;
-        }
-        bool enabled = doc["enabled"];
-        WifiTiming timing = storage.getWifiTiming();
-        timing.keepAP = enabled;
-        storage.setWifiTiming(timing);
-    }
-    else if (strcmp(type, "setLed") == 0) {
-        if (isClientLocked(client)) {
-            WEB_LOG("Admin", "setLed blocked: client locked");
-            sendAdminBlocked(client, "setLed");
-            return;
-        }
-        LedConfig config;
-        config.enabled = doc["enabled"] | true;
-        config.pin = doc["pin"] | DEFAULT_LED_PIN;
-        config.brightness = doc["brightness"] | DEFAULT_LED_BRIGHTNESS;
-        storage.setLedConfig(config);
-        ledStatus.setEnabled(config.enabled);
-        ledStatus.setPin(config.pin);
-        ledStatus.setBrightness(config.brightness);
-    }
-    else if (strcmp(type, "setMdns") == 0) {
-        if (isClientLocked(client)) {
-            WEB_LOG("Admin", "setMdns blocked: client locked");
-            sendAdminBlocked(client, "setMdns");
-            return;
-        }
-        MdnsConfig config;
-        config.enabled = doc["enabled"] | true;
-        const char* hostname = doc["hostname"];
-        if (hostname) {
-            strncpy(config.hostname, hostname, sizeof(config.hostname) - 1);
-            config.hostname[sizeof(config.hostname) - 1] = '\0';
-        } else {
-            strncpy(config.hostname, DEFAULT_MDNS_HOSTNAME, sizeof(config.hostname) - 1);
-        }
-        storage.setMdnsConfig(config);
-        WEB_LOG("Config", "mDNS config saved: %s (reboot required)", config.hostname);
-    }
-    else if (strcmp(type, "leaveNetwork") == 0) {
-        // Legacy: clears all credentials and starts AP
-        wifiManager.disconnect();
-    }
-    else if (strcmp(type, "resetConnection") == 0) {
-        // New: drop connection, trigger reconnect cycle (keeps credentials)
-        WEB_LOG("WiFi", "Connection reset requested");
-        wifiManager.resetConnection();
-    }
-    else if (strcmp(type, "scanNetworks") == 0) {
-        WEB_LOG("WiFi", "Network scan started");
-        String networks = wifiManager.scanNetworks();
-        // Send scan results back to requesting client
-        String response = "{\"type\":\"networkList\",\"networks\":" + networks + "}";
-        client->text(response);
-        return;  // Don't request broadcast, we sent our own response
-    }
-    else if (strcmp(type, "getConfig") == 0) {
-        sendConfigToClient(client);
-        return;  // Don't request broadcast, we sent config directly
-    }
-    else if (strcmp(type, "getLogHistory") == 0) {
-        sendLogHistory(client);
-        return;  // Don't request broadcast, we sent logs directly
-    }
-    else if (strcmp(type, "previewCalibration") == 0) {
-        // Move servo to position for live preview (doesn't save)
-        // Uses setPositionRaw to bypass calibration limits during calibration
-        uint8_t index = doc["index"];
-        uint8_t position = doc["position"];
-        if (index < NUM_SERVOS) {
-            servoController.setPositionRaw(index, position);
-        }
+}
+
+void WebServer::cmdSetWifiTiming(JsonDocument& doc, AsyncWebSocketClient* client) {
+    WifiTiming timing;
+    timing.graceMs = doc["grace"].as<uint16_t>() * 1000;  // UI sends seconds
+    timing.retries = doc["retries"];
+    timing.retryDelayMs = doc["retryDelay"].as<uint16_t>() * 1000;
+    timing.apScanMs = doc["apScan"].as<uint32_t>() * 60000;  // UI sends minutes
+    timing.keepAP = doc["keepAP"] | true;
+
+    // Validate ranges
+    timing.graceMs = constrain(timing.graceMs, 1000, 10000);
+    timing.retries = constrain(timing.retries, 1, 10);
+    timing.retryDelayMs = constrain(timing.retryDelayMs, 5000, 60000);
+    timing.apScanMs = constrain(timing.apScanMs, 60000, 1800000);
+
+    storage.setWifiTiming(timing);
+}
+
+void WebServer::cmdSetKeepAP(JsonDocument& doc, AsyncWebSocketClient* client) {
+    bool enabled = doc["enabled"];
+    WifiTiming timing = storage.getWifiTiming();
+    timing.keepAP = enabled;
+    storage.setWifiTiming(timing);
+}
+
+void WebServer::cmdSetLed(JsonDocument& doc, AsyncWebSocketClient* client) {
+    LedConfig config;
+    config.enabled = doc["enabled"] | true;
+    config.pin = doc["pin"] | DEFAULT_LED_PIN;
+    config.brightness = doc["brightness"] | DEFAULT_LED_BRIGHTNESS;
+    storage.setLedConfig(config);
+    ledStatus.setEnabled(config.enabled);
+    ledStatus.setPin(config.pin);
+    ledStatus.setBrightness(config.brightness);
+}
+
+void WebServer::cmdSetMdns(JsonDocument& doc, AsyncWebSocketClient* client) {
+    MdnsConfig config;
+    config.enabled = doc["enabled"] | true;
+    const char* hostname = doc["hostname"];
+    if (hostname) {
+        strncpy(config.hostname, hostname, sizeof(config.hostname) - 1);
+        config.hostname[sizeof(config.hostname) - 1] = '\0';
+    } else {
+        strncpy(config.hostname, DEFAULT_MDNS_HOSTNAME, sizeof(config.hostname) - 1);
     }
-    else if (strcmp(type, "saveAllCalibration") == 0) {
-        // Protected: requires admin unlock
-        if (!isClientAuthenticated(client)) {
-            WEB_LOG("Admin", "saveAllCalibration blocked: not authenticated");
-            sendAdminBlocked(client, "saveAllCalibration");
-            return;
-        }
-        // Save all servo calibration at once
-        JsonArray servos = doc["servos"];
-        for (JsonObject servo : servos) {
-            uint8_t index = servo["index"];
-            if (index >= NUM_SERVOS) continue;
-
-            uint8_t pin = servo["pin"];
-            uint8_t min = servo["min"];
-            uint8_t center = servo["center"];
-            uint8_t max = servo["max"];
-            bool invert = servo["invert"];
-
-            // Apply clamping rules (no push/pull)
-            min = constrain(min, 0, 180);
-            center = constrain(center, 0, 180);
-            max = constrain(max, 0, 180);
-
-            // Clamp values to valid ranges
-            if (min > center) min = center;
-            if (max < center) max = center;
-
-            // Get current config to check what actually changed
-            const ServoConfig& current = servoController.getConfig(index);
-
-            // Only update pin if changed (avoids unnecessary detach/reattach)
-            if (current.pin != pin) {
-                servoController.setPin(index, pin);
-            }
+    storage.setMdnsConfig(config);
+    WEB_LOG("Config", "mDNS config saved: %s (reboot required)", config.hostname);
+}
 
-            // Always update calibration (cheap operation, no servo write)
-            servoController.setCalibration(index, min, center, max);
+void WebServer::cmdLeaveNetwork(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Legacy: clears all credentials and starts AP
+    wifiManager.disconnect();
+}
 
-            // Only update invert if changed (avoids unnecessary servo write)
-            if (current.invert != invert) {
-                servoController.setInvert(index, invert);
-            }
-        }
-        WEB_LOG("Calibration", "Calibration saved for %d servos", servos.size());
+void WebServer::cmdResetConnection(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // New: drop connection, trigger reconnect cycle (keeps credentials)
+    WEB_LOG("WiFi", "Connection reset requested");
+    wifiManager.resetConnection();
+}
+
+void WebServer::cmdScanNetworks(JsonDocument& doc, AsyncWebSocketClient* client) {
+    WEB_LOG("WiFi", "Network scan started");
+    String networks = wifiManager.scanNetworks();
+    // Send scan results back to requesting client
+    String response = "{\"type\":\"networkList\",\"networks\":" + networks + "}";
+    client->text(response);
+}
+
+void WebServer::cmdGetConfig(JsonDocument& doc, AsyncWebSocketClient* client) {
+    sendConfigToClient(client);
+}
+
+void WebServer::cmdGetLogHistory(JsonDocument& doc, AsyncWebSocketClient* client) {
+    sendLogHistory(client);
+}
+
+void WebServer::cmdPreviewCalibration(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Move servo to position for live preview (doesn't save)
+    // Uses setPositionRaw to bypass calibration limits during calibration
+    uint8_t index = doc["index"];
+    uint8_t position = doc["position"];
+    if (index < NUM_SERVOS) {
+        servoController.setPositionRaw(index, position, _commandOriginUs);
     }
-    else if (strcmp(type, "resetCalibration") == 0) {
-        // Protected: requires admin unlock
-        if (!isClientAuthenticated(client)) {
-            WEB_LOG("Admin", "resetCalibration blocked: not authenticated");
-            sendAdminBlocked(client, "resetCalibration");
-            return;
+}
+
+void WebServer::cmdSaveAllCalibration(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Save all servo calibration at once
+    JsonArray servos = doc["servos"];
+    for (JsonObject servo : servos) {
+        uint8_t index = servo["index"];
+        if (index >= NUM_SERVOS) continue;
+
+        uint8_t pin = servo["pin"];
+        uint8_t min = servo["min"];
+        uint8_t center = servo["center"];
+        uint8_t max = servo["max"];
+        bool invert = servo["invert"];
+
+        // Apply clamping rules (no push/pull)
+        min = constrain(min, 0, 180);
+        center = constrain(center, 0, 180);
+        max = constrain(max, 0, 180);
+
+        // Clamp values to valid ranges
+        if (min > center) min = center;
+        if (max < center) max = center;
+
+        // Get current config to check what actually changed
+        const ServoConfig& current = servoController.getConfig(index);
+
+        // Only update pin if changed (avoids unnecessary detach/reattach)
+        if (current.pin != pin) {
+            servoController.setPin(index, pin);
         }
-        // Reset all servos to factory default calibration
-        for (int i = 0; i < NUM_SERVOS; i++) {
-            servoController.setCalibration(i, DEFAULT_SERVO_MIN, DEFAULT_SERVO_CENTER, DEFAULT_SERVO_MAX);
-            servoController.setInvert(i, false);
+
+        // Always update calibration (cheap operation, no servo write)
+        servoController.setCalibration(index, min, center, max);
+
+        // Only update invert if changed (avoids unnecessary servo write)
+        if (current.invert != invert) {
+            servoController.setInvert(index, invert);
         }
-        WEB_LOG("Calibration", "Calibration reset to factory defaults");
-        requestBroadcast();  // Send updated state to clients
     }
-    else if (strcmp(type, "reboot") == 0) {
-        // Blocked only when rate limited (allows reboot when locked)
-        if (!checkRateLimit(client->remoteIP())) {
-            WEB_LOG("WebServer", "Reboot blocked: rate limited");
-            return;
-        }
-        WEB_LOG("WebServer", "Reboot requested via WebSocket");
-        delay(500);
-        ESP.restart();
+    WEB_LOG("Calibration", "Calibration saved for %d servos", servos.size());
+}
+
+void WebServer::cmdResetCalibration(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Reset all servos to factory default calibration
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        servoController.setCalibration(i, DEFAULT_SERVO_MIN, DEFAULT_SERVO_CENTER, DEFAULT_SERVO_MAX);
+        servoController.setInvert(i, false);
     }
-    else if (strcmp(type, "setApConfig") == 0) {
-        // Protected: requires admin unlock
-        if (!isClientAuthenticated(client)) {
-            WEB_LOG("Admin", "setApConfig blocked: not authenticated");
-            sendAdminBlocked(client, "setApConfig");
-            return;
-        }
-        ApConfig config;
-        const char* prefix = doc["ssidPrefix"];
-        const char* password = doc["password"];
+    WEB_LOG("Calibration", "Calibration reset to factory defaults");
+    requestBroadcast();  // Send updated state to clients
+}
 
-        if (prefix) {
-            strncpy(config.ssidPrefix, prefix, sizeof(config.ssidPrefix) - 1);
-            config.ssidPrefix[sizeof(config.ssidPrefix) - 1] = '\0';
-        } else {
-            strncpy(config.ssidPrefix, DEFAULT_AP_SSID_PREFIX, sizeof(config.ssidPrefix) - 1);
-        }
+void WebServer::cmdReboot(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Blocked only when rate limited (allows reboot when locked)
+    if (!checkRateLimit(client->remoteIP())) {
+        WEB_LOG("WebServer", "Reboot blocked: rate limited");
+        return;
+    }
+    WEB_LOG("WebServer", "Reboot requested via WebSocket");
+    delay(500);
+    ESP.restart();
+}
 
-        if (password) {
-            strncpy(config.password, password, sizeof(config.password) - 1);
-            config.password[sizeof(config.password) - 1] = '\0';
-        } else {
-            strncpy(config.password, DEFAULT_AP_PASSWORD, sizeof(config.password) - 1);
-        }
+void WebServer::cmdSetApConfig(JsonDocument& doc, AsyncWebSocketClient* client) {
+    ApConfig config;
+    const char* prefix = doc["ssidPrefix"];
+    const char* password = doc["password"];
 
-        storage.setApConfig(config);  // This sets rebootRequired flag
-        WEB_LOG("Config", "AP config saved: %s (reboot required)", config.ssidPrefix);
-    }
-    else if (strcmp(type, "clearRebootFlag") == 0) {
-        storage.clearRebootRequired();
+    if (prefix) {
+        strncpy(config.ssidPrefix, prefix, sizeof(config.ssidPrefix) - 1);
+        config.ssidPrefix[sizeof(config.ssidPrefix) - 1] = '\0';
+    } else {
+        strncpy(config.ssidPrefix, DEFAULT_AP_SSID_PREFIX, sizeof(config.ssidPrefix) - 1);
     }
-    else if (strcmp(type, "factoryReset") == 0) {
-        // Protected: requires admin unlock
-        if (!isClientAuthenticated(client)) {
-            WEB_LOG("Admin", "factoryReset blocked: not authenticated");
-            sendAdminBlocked(client, "factoryReset");
-            return;
-        }
-        WEB_LOG("WebServer", "Factory reset requested via WebSocket");
-        ledStatus.strobe();  // Visual indicator
-        storage.factoryReset();
-        delay(500);
-        ESP.restart();
+
+    if (password) {
+        strncpy(config.password, password, sizeof(config.password) - 1);
+        config.password[sizeof(config.password) - 1] = '\0';
+    } else {
+        strncpy(config.password, DEFAULT_AP_PASSWORD, sizeof(config.password) - 1);
     }
-    // ========================================================================
-    // Admin Auth Commands
-    // ========================================================================
-    else if (strcmp(type, "adminAuth") == 0) {
-        const char* pin = doc["pin"];
-        if (!pin) {
-            WEB_LOG("Admin", "Auth failed: no PIN provided");
-            sendAdminState(client);
-            return;
-        }
 
-        // Check rate limit
-        if (!checkRateLimit(client->remoteIP())) {
-            WEB_LOG("Admin", "Auth failed: rate limited");
-            sendAdminState(client);
-            return;
-        }
+    storage.setApConfig(config);  // This sets rebootRequired flag
+    WEB_LOG("Config", "AP config saved: %s (reboot required)", config.ssidPrefix);
+}
 
-        // Verify PIN
-        String storedPin = storage.getAdminPin();
-        if (storedPin.length() > 0 && storedPin == pin) {
-            IPAddress clientIP = client->remoteIP();
-            authenticateClient(client);
-            clearFailedAttempts(clientIP);
-            WEB_LOG("Admin", "IP %s unlocked", clientIP.toString().c_str());
-            broadcastAdminStateToIP(clientIP);  // Notify all tabs from same IP
-        } else {
-            WEB_LOG("Admin", "Auth failed: wrong PIN from %s", client->remoteIP().toString().c_str());
-            recordFailedAttempt(client->remoteIP());
-            sendAdminState(client);
-        }
+void WebServer::cmdClearRebootFlag(JsonDocument& doc, AsyncWebSocketClient* client) {
+    storage.clearRebootRequired();
+}
+
+void WebServer::cmdFactoryReset(JsonDocument& doc, AsyncWebSocketClient* client) {
+    WEB_LOG("WebServer", "Factory reset requested via WebSocket");
+    ledStatus.strobe();  // Visual indicator
+    storage.factoryReset();
+    delay(500);
+    ESP.restart();
+}
+
+// ============================================================================
+// Admin Auth Commands
+// ============================================================================
+
+void WebServer::cmdAdminAuth(JsonDocument& doc, AsyncWebSocketClient* client) {
+    const char* pin = doc["pin"];
+    if (!pin) {
+        WEB_LOG("Admin", "Auth failed: no PIN provided");
+        sendAdminState(client);
+        return;
+    }
+
+    // Check rate limit
+    if (!checkRateLimit(client->remoteIP())) {
+        WEB_LOG("Admin", "Auth failed: rate limited");
+        sendAdminState(client);
+        return;
     }
-    else if (strcmp(type, "adminLock") == 0) {
+
+    // Verify PIN
+    String storedPin = storage.getAdminPin();
+    if (storedPin.length() > 0 && storedPin == pin) {
         IPAddress clientIP = client->remoteIP();
-        lockClient(client);
-        WEB_LOG("Admin", "IP %s locked", clientIP.toString().c_str());
+        authenticateClient(client);
+        clearFailedAttempts(clientIP);
+        WEB_LOG("Admin", "IP %s unlocked", clientIP.toString().c_str());
         broadcastAdminStateToIP(clientIP);  // Notify all tabs from same IP
+    } else {
+        WEB_LOG("Admin", "Auth failed: wrong PIN from %s", client->remoteIP().toString().c_str());
+        recordFailedAttempt(client->remoteIP());
+        sendAdminState(client);
     }
-    else if (strcmp(type, "setAdminPin") == 0) {
-        const char* pin = doc["pin"];
-        if (!pin) {
-            WEB_LOG("Admin", "Set PIN failed: no PIN provided");
-            return;
-        }
+}
 
-        // Must be unlocked OR no PIN configured (first-time setup)
-        if (!isClientAuthenticated(client) && storage.hasAdminPin()) {
-            WEB_LOG("Admin", "Set PIN failed: not authenticated");
-            return;
-        }
+void WebServer::cmdAdminLock(JsonDocument& doc, AsyncWebSocketClient* client) {
+    IPAddress clientIP = client->remoteIP();
+    lockClient(client);
+    WEB_LOG("Admin", "IP %s locked", clientIP.toString().c_str());
+    broadcastAdminStateToIP(clientIP);  // Notify all tabs from same IP
+}
 
-        if (storage.setAdminPin(pin)) {
-            WEB_LOG("Admin", "Admin PIN set");
-            // Re-authenticate this client with new PIN
-            authenticateClient(client);
-            sendAdminState(client);
-        } else {
-            WEB_LOG("Admin", "Set PIN failed: invalid format (must be 4-6 digits)");
-        }
+void WebServer::cmdSetAdminPin(JsonDocument& doc, AsyncWebSocketClient* client) {
+    const char* pin = doc["pin"];
+    if (!pin) {
+        WEB_LOG("Admin", "Set PIN failed: no PIN provided");
+        return;
     }
-    else if (strcmp(type, "clearAdminPin") == 0) {
-        // Must be unlocked to clear PIN
-        if (!isClientAuthenticated(client)) {
-            WEB_LOG("Admin", "Clear PIN failed: not authenticated");
-            return;
-        }
 
-        storage.clearAdminPin();
-        WEB_LOG("Admin", "Admin PIN cleared");
-        sendAdminState(client);
+    // Must be unlocked OR no PIN configured (first-time setup)
+    if (!isClientAuthenticated(client) && storage.hasAdminPin()) {
+        WEB_LOG("Admin", "Set PIN failed: not authenticated");
+        return;
     }
-    else if (strcmp(type, "getAdminState") == 0) {
+
+    if (storage.setAdminPin(pin)) {
+        WEB_LOG("Admin", "Admin PIN set");
+        // Re-authenticate this client with new PIN
+        authenticateClient(client);
         sendAdminState(client);
+    } else {
+        WEB_LOG("Admin", "Set PIN failed: invalid format (must be 4-6 digits)");
     }
-    // ========================================================================
-    // Update Check Commands
-    // ========================================================================
-    else if (strcmp(type, "checkForUpdate") == 0) {
-        // Always allowed (read-only action)
-        WEB_LOG("Update", "Manual update check requested");
-        updateChecker.checkNow();
-    }
-    else if (strcmp(type, "setUpdateCheckEnabled") == 0) {
-        // Protected: requires admin unlock
-        if (!isClientAuthenticated(client)) {
-            WEB_LOG("Admin", "setUpdateCheckEnabled blocked: not authenticated");
-            sendAdminBlocked(client, "setUpdateCheckEnabled");
-            return;
-        }
-        bool enabled = doc["enabled"] | true;
-        updateChecker.setEnabled(enabled);
-        WEB_LOG("Update", "Update check %s", enabled ? "enabled" : "disabled");
-    }
-    else if (strcmp(type, "setUpdateCheckInterval") == 0) {
-        // Protected: requires admin unlock
-        if (!isClientAuthenticated(client)) {
-            WEB_LOG("Admin", "setUpdateCheckInterval blocked: not authenticated");
-            sendAdminBlocked(client, "setUpdateCheckInterval");
-            return;
-        }
-        uint8_t interval = doc["interval"] | 1;
-        if (interval > 2) interval = 1;  // Validate: 0, 1, or 2
-        updateChecker.setInterval(interval);
-        WEB_LOG("Update", "Update check interval set to %d", interval);
-    }
-    else {
-        WEB_LOG("WS", "Unknown command: %s", type);
+}
+
+void WebServer::cmdClearAdminPin(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Must be unlocked to clear PIN
+    if (!isClientAuthenticated(client)) {
+        WEB_LOG("Admin", "Clear PIN failed: not authenticated");
+        return;
     }
 
-    // Request broadcast from main loop
-    requestBroadcast();
+    storage.clearAdminPin();
+    WEB_LOG("Admin", "Admin PIN cleared");
+    sendAdminState(client);
+}
+
+void WebServer::cmdGetAdminState(JsonDocument& doc, AsyncWebSocketClient* client) {
+    sendAdminState(client);
+}
+
+// ============================================================================
+// Update Check Commands
+// ============================================================================
+
+void WebServer::cmdCheckForUpdate(JsonDocument& doc, AsyncWebSocketClient* client) {
+    // Always allowed (read-only action)
+    WEB_LOG("Update", "Manual update check requested");
+    updateChecker.checkNow();
+}
+
+void WebServer::cmdSetUpdateCheckEnabled(JsonDocument& doc, AsyncWebSocketClient* client) {
+    bool enabled = doc["enabled"] | true;
+    updateChecker.setEnabled(enabled);
+    WEB_LOG("Update", "Update check %s", enabled ? "enabled" : "disabled");
+}
+
+void WebServer::cmdSetUpdateCheckInterval(JsonDocument& doc, AsyncWebSocketClient* client) {
+    uint8_t interval = doc["interval"] | 1;
+    if (interval > 2) interval = 1;  // Validate: 0, 1, or 2
+    updateChecker.setInterval(interval);
+    WEB_LOG("Update", "Update check interval set to %d", interval);
 }
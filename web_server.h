@@ -10,6 +10,10 @@
 
 #include <Arduino.h>
 #include <IPAddress.h>
+#include <ArduinoJson.h>
+#include "scheduler.h"
+#include "ws_commands.h"
+#include "ws_buffer_pool.h"
 
 // Forward declarations
 class AsyncWebServerRequest;
@@ -30,6 +34,31 @@ struct ClientAuthState {
     bool isAPClient;
 };
 
+// State channels a client can subscribe to (see WebServer::onBroadcastTimer)
+enum WsChannel : uint8_t {
+    WS_CHANNEL_MOTION = 1 << 0,   // Eye pose + servo positions, at the client's motion rate
+    WS_CHANNEL_MODE = 1 << 1,     // Mode / impulse / clip state, on change
+    WS_CHANNEL_SYSTEM = 1 << 2,   // WiFi, system, update, calibration: 1 Hz and on request
+    WS_CHANNEL_ALL = WS_CHANNEL_MOTION | WS_CHANNEL_MODE | WS_CHANNEL_SYSTEM
+};
+
+struct WsSubscriber {
+    uint32_t clientId;             // 0 = free slot
+    uint8_t channels;              // WsChannel mask
+    uint16_t motionIntervalMs;     // Subscribed rate
+    uint16_t effectiveIntervalMs;  // After adaptive backoff (>= motionIntervalMs)
+    unsigned long lastMotionMs;
+    volatile bool snapshotPending; // Send every subscribed channel on the next tick
+
+    // Backpressure
+    uint8_t pendingChannels;       // Held back while the client's queue is full (0 = in sync)
+    unsigned long heldSinceMs;     // First held-back update (valid while pendingChannels != 0)
+    uint8_t queueDepth;            // Messages queued at the last tick
+    uint16_t avgMessageBytes;      // Running average, for the queued-bytes estimate
+    uint32_t dropped;              // Updates skipped or merged into a newer one
+    uint32_t lagMaxMs;             // Longest time held back
+};
+
 struct RateLimitEntry {
     IPAddress ip;
     uint8_t failedAttempts;
@@ -52,11 +81,35 @@ public:
     void sendLogHistory(AsyncWebSocketClient* client);   // Send buffered logs to new client
 
 private:
-    unsigned long _lastBroadcast = 0;
+    TimerId _broadcastTimer = TIMER_INVALID;
     volatile bool _broadcastRequested = false;  // Flag for deferred broadcast
+    void onBroadcastTimer();                    // Channel broadcasts (scheduler)
+
+    // State channel subscriptions (slots written by async handlers, read by the main loop)
+    WsSubscriber _subscribers[WS_MAX_SUBSCRIBERS] = {};
+    volatile bool _snapshotRequested = false;  // A subscriber waits for its first messages
+    uint32_t _modeStateHash = 0;               // Last mode channel content sent
+    unsigned long _lastSystemMs = 0;
+    void addSubscriber(AsyncWebSocketClient* client);
+    void removeSubscriber(uint32_t clientId);
+    WsSubscriber* findSubscriber(uint32_t clientId);
+    uint32_t publishChannels(uint8_t forced);  // Send what is due, returns ms until the next tick
+    void sendToSubscriber(WsSubscriber& sub, AsyncWebSocketClient* client, const WsSharedBuffer& json);
+    WsSharedBuffer buildMotionState();
+    WsSharedBuffer buildModeState();
+    WsSharedBuffer buildSystemState();
+    volatile bool _seedRequested = false;       // Deferred setSeed (generators are main-loop only)
+    volatile uint32_t _requestedSeed = 0;
+    uint32_t _contentGeneration = 0;            // Content index generation last sent to clients
+    void applySeed(uint32_t seed);
     bool _uiFilesValid = false;
     String _uiVersion = "";
     String _uiMinFirmware = "";
+    String _uiEtag = "";                        // "<version>-<build>" from version.json (packed UI only)
+
+    // Latency tracing: arrival time and type of the WebSocket command being handled
+    uint32_t _commandOriginUs = 0;
+    char _commandType[32] = "";
 
     // Log ring buffer
     String _logBuffer[LOG_BUFFER_SIZE];
@@ -65,15 +118,35 @@ private:
 
     void setupRoutes();
     void setupWebSocket();
-    void broadcastState();
+    void broadcastState();   // Every channel to every subscriber, now
     void broadcastLog(const String& logLine);
-    void handleWebSocketMessage(const char* data, AsyncWebSocketClient* client);
+    void dispatchWebSocketMessage(const char* data, size_t len, AsyncWebSocketClient* client);  // Complete text message
+    void handleWebSocketMessage(const char* data, size_t len, AsyncWebSocketClient* client);
+    void saveSequenceFile(const char* dir, JsonDocument& doc, AsyncWebSocketClient* client);  // saveMode / saveImpulse
+    bool handleFastCommand(const char* data, size_t len, AsyncWebSocketClient* client);  // false = use handleWebSocketMessage
+
+    // Typed bodies of the hot commands (shared by both parse paths)
+    void applyServo(uint8_t index, uint8_t position);
+    void applyGaze(float x, float y, float z);
+    void applyLids(float left, float right);
+    void applyBlink(WsCommandId command, unsigned int duration);
+
+    // Command handlers, one per WS_COMMANDS entry (dispatched by findWsCommand index)
+    typedef void (WebServer::*CommandHandler)(JsonDocument& doc, AsyncWebSocketClient* client);
+    static const CommandHandler _commandHandlers[];
+#define WS_COMMAND_DECLARE(handler, name, gate, flags) \
+    void cmd##handler(JsonDocument& doc, AsyncWebSocketClient* client);
+    WS_COMMANDS(WS_COMMAND_DECLARE)
+#undef WS_COMMAND_DECLARE
+
     void sendConfigToClient(AsyncWebSocketClient* client);
     void sendAvailableLists(AsyncWebSocketClient* client);  // Send available modes/impulses on connect
     void sendAdminState(AsyncWebSocketClient* client);      // Send per-client admin lock state
+    WsSharedBuffer buildAdminState(AsyncWebSocketClient* client);
     void broadcastAdminStateToIP(IPAddress ip);             // Send admin state to all clients from same IP
     void sendAdminBlocked(AsyncWebSocketClient* client, const char* command);  // Notify client command was blocked
     void serveRecoveryPage(AsyncWebServerRequest* request);
+    void serveUiAsset(AsyncWebServerRequest* request, const char* path, const char* contentType);  // Packed UI file
 
     // Admin auth helpers
     bool isAPClient(AsyncWebSocketClient* client);
@@ -0,0 +1,59 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "ws_buffer_pool.h"
+
+WsBufferPool wsBufferPool;
+
+WsSharedBuffer WsBufferPool::acquire(size_t len) {
+    int fit = -1;    // Free slot with the smallest capacity >= len
+    int grow = -1;   // Free slot with the largest capacity < len
+    int empty = -1;  // Slot never used
+    for (int i = 0; i < WS_BUFFER_POOL_SLOTS; i++) {
+        if (!_slots[i]) {
+            if (empty < 0) empty = i;
+            continue;
+        }
+        if (_slots[i].use_count() != 1) continue;  // Still queued to a client
+        size_t capacity = _slots[i]->capacity();
+        if (capacity >= len) {
+            if (fit < 0 || capacity < _slots[fit]->capacity()) fit = i;
+        } else if (grow < 0 || capacity > _slots[grow]->capacity()) {
+            grow = i;
+        }
+    }
+
+    int slot = fit >= 0 ? fit : (empty >= 0 ? empty : grow);
+    if (slot < 0) {
+        _misses++;
+        _allocBytes += len;
+        return std::make_shared<std::vector<uint8_t>>(len);
+    }
+
+    if (!_slots[slot]) _slots[slot] = std::make_shared<std::vector<uint8_t>>();
+    std::vector<uint8_t>& buffer = *_slots[slot];
+    if (buffer.capacity() < len) {
+        // Round up so a message that grows by a few bytes doesn't reallocate again
+        size_t capacity = (len + WS_BUFFER_POOL_GRANULE - 1) / WS_BUFFER_POOL_GRANULE * WS_BUFFER_POOL_GRANULE;
+        buffer.clear();  // Nothing to carry over into the new allocation
+        buffer.reserve(capacity);
+        _grows++;
+        _allocBytes += capacity;
+    } else {
+        _hits++;
+    }
+    buffer.resize(len);
+    return _slots[slot];
+}
+
+uint8_t WsBufferPool::getSlotsInUse() const {
+    uint8_t inUse = 0;
+    for (const WsSharedBuffer& slot : _slots) {
+        if (slot && slot.use_count() > 1) inUse++;
+    }
+    return inUse;
+}
@@ -0,0 +1,52 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef WS_BUFFER_POOL_H
+#define WS_BUFFER_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <memory>
+#include <vector>
+#include "config.h"
+
+// WebSocket Buffer Pool - Reused, reference-counted payloads for state fan-out
+// A message is serialized once into a pooled buffer and the same buffer is queued
+// to every client (AsyncWebSocketClient::text(AsyncWebSocketSharedBuffer) only
+// takes a reference). A slot is free again when no queued message references it
+// (use_count() == 1, the pool's own reference), so in steady state broadcasting
+// allocates nothing: no per-client copies, no per-message heap churn.
+//
+// Main loop only (no locking). Plain C++ (same type as AsyncWebSocketSharedBuffer),
+// so tools/bench_ws_fanout.cpp can measure it on the host.
+
+typedef std::shared_ptr<std::vector<uint8_t>> WsSharedBuffer;
+
+class WsBufferPool {
+public:
+    // Buffer of exactly len bytes to serialize into. Taken from a free slot when
+    // possible (best fit, else the largest free slot grows); when every slot is
+    // still queued somewhere a one-off buffer is allocated (counted as a miss).
+    WsSharedBuffer acquire(size_t len);
+
+    uint8_t getSlotsInUse() const;        // Slots referenced by queued messages
+    uint32_t getHits() const { return _hits; }
+    uint32_t getGrows() const { return _grows; }
+    uint32_t getMisses() const { return _misses; }
+    uint32_t getAllocBytes() const { return _allocBytes; }  // Heap allocated by the pool so far
+
+private:
+    WsSharedBuffer _slots[WS_BUFFER_POOL_SLOTS];
+    uint32_t _hits = 0;
+    uint32_t _grows = 0;
+    uint32_t _misses = 0;
+    uint32_t _allocBytes = 0;
+};
+
+extern WsBufferPool wsBufferPool;
+
+#endif // WS_BUFFER_POOL_H
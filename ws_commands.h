@@ -0,0 +1,171 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef WS_COMMANDS_H
+#define WS_COMMANDS_H
+
+#include <stdint.h>
+#include <string.h>
+
+// WebSocket Commands - Table of every client -> server command
+// One entry per command: handler suffix (WebServer::cmd<Handler>), "type" string,
+// admin gate and flags. The same list declares the handlers (web_server.h), builds
+// the handler table (web_server.cpp) and the name index below.
+//
+// Names are resolved with a perfect hash built at compile time: one FNV-1a pass
+// over the name, one table read, one strcmp - no matter where the command sits
+// in the list. Plain C++ (no Arduino headers), so tools/bench_ws_dispatch.cpp
+// can measure it on the host.
+
+// Who may run a command
+enum WsCommandGate : uint8_t {
+    WS_OPEN,        // Any client
+    WS_ADMIN,       // Locked clients get adminBlocked (checked by the dispatcher)
+    WS_SELF_AUTH    // Runs while locked; the handler authorizes itself (PIN, first-time setup, rate limit)
+};
+
+enum WsCommandFlags : uint8_t {
+    WS_COALESCE = 1 << 0,   // High-rate, latest value wins: no immediate broadcast (periodic one carries it)
+    WS_REPLIES = 1 << 1     // Answers the sender directly: no state broadcast
+};
+
+// X(Handler, "type", gate, flags)
+#define WS_COMMANDS(X) \
+    /* Servo / calibration */ \
+    X(SetServo,                "setServo",                WS_OPEN,      WS_COALESCE) \
+    X(SetCalibration,          "setCalibration",          WS_ADMIN,     0) \
+    X(SetPin,                  "setPin",                  WS_ADMIN,     0) \
+    X(SetInvert,               "setInvert",               WS_ADMIN,     0) \
+    X(CenterAll,               "centerAll",               WS_OPEN,      0) \
+    /* Eye Controller */ \
+    X(SetGaze,                 "setGaze",                 WS_OPEN,      WS_COALESCE) \
+    X(SetLids,                 "setLids",                 WS_OPEN,      WS_COALESCE) \
+    X(Blink,                   "blink",                   WS_OPEN,      0) \
+    X(BlinkLeft,               "blinkLeft",               WS_OPEN,      0) \
+    X(BlinkRight,              "blinkRight",              WS_OPEN,      0) \
+    X(SetCoupling,             "setCoupling",             WS_OPEN,      WS_COALESCE) \
+    X(SetVergence,             "setVergence",             WS_OPEN,      WS_COALESCE) \
+    X(CenterEyes,              "centerEyes",              WS_OPEN,      0) \
+    X(ReapplyEyeState,         "reapplyEyeState",         WS_OPEN,      0) \
+    /* Mode System */ \
+    X(SetMode,                 "setMode",                 WS_OPEN,      0) \
+    X(SetSeed,                 "setSeed",                 WS_OPEN,      0) \
+    X(SetAutoBlink,            "setAutoBlink",            WS_OPEN,      0) \
+    X(SetRememberLastMode,     "setRememberLastMode",     WS_OPEN,      0) \
+    X(SetMirrorPreview,        "setMirrorPreview",        WS_OPEN,      0) \
+    X(SetModeTransition,       "setModeTransition",       WS_OPEN,      0) \
+    X(PauseAutoBlink,          "pauseAutoBlink",          WS_OPEN,      0) \
+    X(PauseModePlayer,         "pauseModePlayer",         WS_OPEN,      0) \
+    X(SetAutoBlinkOverride,    "setAutoBlinkOverride",    WS_OPEN,      0) \
+    X(SetAutoImpulseOverride,  "setAutoImpulseOverride",  WS_OPEN,      0) \
+    X(SetBlinkInterval,        "setBlinkInterval",        WS_OPEN,      0) \
+    X(SetDefaultMode,          "setDefaultMode",          WS_OPEN,      0) \
+    X(GetAvailableModes,       "getAvailableModes",       WS_OPEN,      WS_REPLIES) \
+    X(SaveMode,                "saveMode",                WS_ADMIN,     WS_REPLIES) \
+    /* Impulse System */ \
+    X(TriggerImpulse,          "triggerImpulse",          WS_OPEN,      0) \
+    X(SetAutoImpulse,          "setAutoImpulse",          WS_OPEN,      0) \
+    X(SetImpulseInterval,      "setImpulseInterval",      WS_OPEN,      0) \
+    X(SetImpulseSelection,     "setImpulseSelection",     WS_OPEN,      0) \
+    X(GetAvailableImpulses,    "getAvailableImpulses",    WS_OPEN,      WS_REPLIES) \
+    X(SaveImpulse,             "saveImpulse",             WS_ADMIN,     WS_REPLIES) \
+    /* Baked clips */ \
+    X(PlayClip,                "playClip",                WS_OPEN,      0) \
+    X(StopClip,                "stopClip",                WS_OPEN,      0) \
+    X(RecordClip,              "recordClip",              WS_ADMIN,     0) \
+    /* State channels */ \
+    X(Subscribe,               "subscribe",               WS_OPEN,      WS_REPLIES) \
+    /* Network */ \
+    X(SetWifi,                 "setWifi",                 WS_ADMIN,     0) \
+    X(SetWifiNetwork,          "setWifiNetwork",          WS_ADMIN,     0) \
+    X(ClearWifiNetwork,        "clearWifiNetwork",        WS_ADMIN,     0) \
+    X(SetWifiTiming,           "setWifiTiming",           WS_ADMIN,     0) \
+    X(SetKeepAP,               "setKeepAP",               WS_ADMIN,     0) \
+    X(SetLed,                  "setLed",                  WS_ADMIN,     0) \
+    X(SetMdns,                 "setMdns",                 WS_ADMIN,     0) \
+    X(LeaveNetwork,            "leaveNetwork",            WS_OPEN,      0) \
+    X(ResetConnection,         "resetConnection",         WS_OPEN,      0) \
+    X(ScanNetworks,            "scanNetworks",            WS_OPEN,      WS_REPLIES) \
+    X(GetConfig,               "getConfig",               WS_OPEN,      WS_REPLIES) \
+    X(GetLogHistory,           "getLogHistory",           WS_OPEN,      WS_REPLIES) \
+    X(PreviewCalibration,      "previewCalibration",      WS_OPEN,      WS_COALESCE) \
+    X(SaveAllCalibration,      "saveAllCalibration",      WS_ADMIN,     0) \
+    X(ResetCalibration,        "resetCalibration",        WS_ADMIN,     0) \
+    X(Reboot,                  "reboot",                  WS_SELF_AUTH, 0) \
+    X(SetApConfig,             "setApConfig",             WS_ADMIN,     0) \
+    X(ClearRebootFlag,         "clearRebootFlag",         WS_OPEN,      0) \
+    X(FactoryReset,            "factoryReset",            WS_ADMIN,     0) \
+    /* Admin */ \
+    X(AdminAuth,               "adminAuth",               WS_SELF_AUTH, 0) \
+    X(AdminLock,               "adminLock",               WS_OPEN,      0) \
+    X(SetAdminPin,             "setAdminPin",             WS_SELF_AUTH, 0) \
+    X(ClearAdminPin,           "clearAdminPin",           WS_SELF_AUTH, 0) \
+    X(GetAdminState,           "getAdminState",           WS_OPEN,      0) \
+    /* Update check */ \
+    X(CheckForUpdate,          "checkForUpdate",          WS_OPEN,      0) \
+    X(SetUpdateCheckEnabled,   "setUpdateCheckEnabled",   WS_ADMIN,     0) \
+    X(SetUpdateCheckInterval,  "setUpdateCheckInterval",  WS_ADMIN,     0)
+
+struct WsCommandInfo {
+    const char* name;
+    WsCommandGate gate;
+    uint8_t flags;
+};
+
+// Command ids in table order (WS_CMD_SetGaze, ...) for code that handles specific commands
+#define WS_COMMAND_ID(handler, name, gate, flags) WS_CMD_##handler,
+enum WsCommandId : uint8_t { WS_COMMANDS(WS_COMMAND_ID) };
+#undef WS_COMMAND_ID
+
+#define WS_COMMAND_INFO(handler, name, gate, flags) {name, gate, flags},
+constexpr WsCommandInfo WS_COMMAND_INFOS[] = { WS_COMMANDS(WS_COMMAND_INFO) };
+#undef WS_COMMAND_INFO
+
+constexpr size_t WS_COMMAND_COUNT = sizeof(WS_COMMAND_INFOS) / sizeof(WS_COMMAND_INFOS[0]);
+constexpr size_t WS_COMMAND_SLOTS = 512;  // Power of two, ~8x the command count keeps the seed search short
+static_assert(WS_COMMAND_COUNT < 255, "slot table stores index + 1 in a byte");
+static_assert(WS_COMMAND_SLOTS >= 4 * WS_COMMAND_COUNT, "grow WS_COMMAND_SLOTS");
+
+constexpr uint32_t wsCommandHash(const char* name, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    while (*name) {
+        h = (h ^ (uint8_t)*name++) * 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+struct WsCommandIndex {
+    uint32_t seed;
+    uint8_t slots[WS_COMMAND_SLOTS];   // Command index + 1, 0 = empty
+};
+
+// First seed that maps every name to its own slot
+constexpr WsCommandIndex buildWsCommandIndex() {
+    for (uint32_t seed = 0; seed < 10000; seed++) {
+        WsCommandIndex index = {seed, {}};
+        bool collision = false;
+        for (size_t i = 0; i < WS_COMMAND_COUNT && !collision; i++) {
+            uint32_t slot = wsCommandHash(WS_COMMAND_INFOS[i].name, seed) & (WS_COMMAND_SLOTS - 1);
+            collision = index.slots[slot] != 0;
+            index.slots[slot] = i + 1;
+        }
+        if (!collision) return index;
+    }
+    return {UINT32_MAX, {}};
+}
+
+constexpr WsCommandIndex WS_COMMAND_INDEX = buildWsCommandIndex();
+static_assert(WS_COMMAND_INDEX.seed != UINT32_MAX, "no collision-free seed - grow WS_COMMAND_SLOTS");
+
+// Command index, or -1 for unknown names
+inline int findWsCommand(const char* name) {
+    uint8_t entry = WS_COMMAND_INDEX.slots[wsCommandHash(name, WS_COMMAND_INDEX.seed) & (WS_COMMAND_SLOTS - 1)];
+    if (entry == 0 || strcmp(WS_COMMAND_INFOS[entry - 1].name, name) != 0) return -1;
+    return entry - 1;
+}
+
+#endif // WS_COMMANDS_H
@@ -0,0 +1,130 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "ws_flat_message.h"
+#include <string.h>
+
+static const float POW10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f};
+
+static const char* skipSpace(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+    return p;
+}
+
+// "..." without escapes; p points at the opening quote
+static const char* parseString(const char* p, const char* end, const char*& str, uint8_t& len) {
+    const char* start = ++p;
+    while (p < end && *p != '"') {
+        if (*p == '\\' || (uint8_t)*p < 0x20) return nullptr;
+        p++;
+    }
+    if (p >= end || p - start > 255) return nullptr;
+    str = start;
+    len = p - start;
+    return p + 1;
+}
+
+// -?digits(.digits)? with at most 9 significant digits (fits int32 exactly)
+static const char* parseNumber(const char* p, const char* end, WsFlatMessage::Field& field) {
+    bool negative = p < end && *p == '-';
+    if (negative) p++;
+
+    uint32_t mantissa = 0;
+    uint8_t digits = 0;
+    uint8_t fraction = 0;
+    bool point = false;
+    for (; p < end; p++) {
+        if (*p >= '0' && *p <= '9') {
+            if (++digits > 9) return nullptr;
+            mantissa = mantissa * 10 + (*p - '0');
+            if (point) fraction++;
+        } else if (*p == '.' && !point) {
+            point = true;
+        } else {
+            break;
+        }
+    }
+    if (digits == 0 || (point && fraction == 0)) return nullptr;
+    if (p < end && (*p == 'e' || *p == 'E')) return nullptr;
+
+    int32_t value = negative ? -(int32_t)mantissa : (int32_t)mantissa;
+    field.integer = !point;
+    field.intValue = value;
+    field.value = (float)value / POW10[fraction];
+    return p;
+}
+
+bool parseFlatMessage(const char* data, size_t len, WsFlatMessage& out) {
+    const char* p = data;
+    const char* end = data + len;
+    out.type = nullptr;
+    out.typeLen = 0;
+    out.fieldCount = 0;
+
+    p = skipSpace(p, end);
+    if (p >= end || *p != '{') return false;
+    p = skipSpace(p + 1, end);
+    if (p < end && *p == '}') return false;  // {} has no type
+
+    while (true) {
+        const char* key;
+        uint8_t keyLen;
+        if (p >= end || *p != '"' || !(p = parseString(p, end, key, keyLen))) return false;
+        p = skipSpace(p, end);
+        if (p >= end || *p != ':') return false;
+        p = skipSpace(p + 1, end);
+        if (p >= end) return false;
+
+        if (*p == '"') {
+            // The only string value taken is the command type
+            if (keyLen != 4 || memcmp(key, "type", 4) != 0 || out.type) return false;
+            if (!(p = parseString(p, end, out.type, out.typeLen))) return false;
+        } else {
+            if (out.fieldCount >= WS_FLAT_MAX_FIELDS) return false;
+            WsFlatMessage::Field& field = out.fields[out.fieldCount];
+            if (!(p = parseNumber(p, end, field))) return false;
+            field.key = key;
+            field.keyLen = keyLen;
+            out.fieldCount++;
+        }
+
+        p = skipSpace(p, end);
+        if (p >= end) return false;
+        if (*p == '}') break;
+        if (*p != ',') return false;
+        p = skipSpace(p + 1, end);
+    }
+
+    // Only whitespace (or the terminator some senders include) may follow
+    p = skipSpace(p + 1, end);
+    while (p < end && *p == '\0') p++;
+    return p == end && out.type != nullptr;
+}
+
+const WsFlatMessage::Field* WsFlatMessage::find(const char* key) const {
+    size_t len = strlen(key);
+    for (uint8_t i = 0; i < fieldCount; i++) {
+        if (fields[i].keyLen == len && memcmp(fields[i].key, key, len) == 0) return &fields[i];
+    }
+    return nullptr;
+}
+
+float WsFlatMessage::getFloat(const char* key, float fallback) const {
+    const Field* field = find(key);
+    return field ? field->value : fallback;
+}
+
+bool WsFlatMessage::getInt(const char* key, int32_t min, int32_t max, int32_t fallback, int32_t& out) const {
+    const Field* field = find(key);
+    if (!field) {
+        out = fallback;
+        return true;
+    }
+    if (!field->integer || field->intValue < min || field->intValue > max) return false;
+    out = field->intValue;
+    return true;
+}
@@ -0,0 +1,51 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef WS_FLAT_MESSAGE_H
+#define WS_FLAT_MESSAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// WebSocket Flat Message - In-place tokenizer for the hot motion commands
+// setGaze, setLids, setServo and blink* arrive many times per second as tiny flat
+// objects, e.g. {"type":"setGaze","x":10,"y":5,"z":0}. parseFlatMessage() reads
+// such a message straight from the WebSocket frame: no JsonDocument, no string
+// copies - the type and keys point into the frame, numbers are converted in place.
+//
+// It only accepts what those commands send: one object, a "type" string and
+// numeric fields. Anything else (nesting, arrays, escapes, other strings,
+// true/false/null, exponents, more than WS_FLAT_MAX_FIELDS fields) returns false
+// and the message takes the full ArduinoJson path.
+
+#define WS_FLAT_MAX_FIELDS 6
+
+struct WsFlatMessage {
+    struct Field {
+        const char* key;      // Not terminated
+        uint8_t keyLen;
+        bool integer;         // Written without fraction
+        int32_t intValue;     // Valid if integer
+        float value;
+    };
+
+    const char* type;         // Not terminated
+    uint8_t typeLen;
+    uint8_t fieldCount;
+    Field fields[WS_FLAT_MAX_FIELDS];
+
+    const Field* find(const char* key) const;
+    float getFloat(const char* key, float fallback) const;
+    // Integer field in [min, max] (fallback if absent). False if it is fractional or
+    // out of range - the caller then leaves the message to ArduinoJson.
+    bool getInt(const char* key, int32_t min, int32_t max, int32_t fallback, int32_t& out) const;
+};
+
+// Parse len bytes (no terminator needed). False = not a flat message, use ArduinoJson.
+bool parseFlatMessage(const char* data, size_t len, WsFlatMessage& out);
+
+#endif // WS_FLAT_MESSAGE_H
@@ -0,0 +1,100 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#include "ws_reassembly.h"
+#include <stdlib.h>
+#include <string.h>
+
+WsReassembler wsReassembler;
+
+WsChunkResult WsReassembler::append(uint32_t clientId, const uint8_t* data, size_t len, bool first, bool last,
+                                    uint32_t nowMs, const char*& message, size_t& messageLen) {
+    Slot* slot = find(clientId);
+    if (first) {
+        // A client starting over abandons its unfinished message
+        if (!slot) slot = claim(clientId, nowMs);
+        if (!slot) {
+            _noSlot++;
+            return WsChunkResult::DROPPED;
+        }
+        slot->discarding = false;
+        slot->length = 0;
+    } else if (!slot) {
+        return WsChunkResult::PENDING;  // Rest of a message that was dropped
+    }
+
+    slot->lastChunkMs = nowMs;
+    if (slot->discarding) {
+        if (last) slot->used = false;
+        return WsChunkResult::PENDING;
+    }
+
+    if (slot->length + len > WS_REASSEMBLY_MAX_BYTES) {
+        _oversized++;
+        slot->discarding = true;
+        if (last) slot->used = false;
+        return WsChunkResult::DROPPED;
+    }
+
+    memcpy(slot->buffer + slot->length, data, len);
+    slot->length += len;
+    if (!last) return WsChunkResult::PENDING;
+
+    _completed++;
+    message = (const char*)slot->buffer;
+    messageLen = slot->length;
+    return WsChunkResult::COMPLETE;
+}
+
+void WsReassembler::release(uint32_t clientId) {
+    Slot* slot = find(clientId);
+    if (slot) slot->used = false;
+}
+
+uint8_t WsReassembler::getSlotsInUse() const {
+    uint8_t count = 0;
+    for (const Slot& slot : _slots) {
+        if (slot.used) count++;
+    }
+    return count;
+}
+
+WsReassembler::Slot* WsReassembler::find(uint32_t clientId) {
+    for (Slot& slot : _slots) {
+        if (slot.used && slot.clientId == clientId) return &slot;
+    }
+    return nullptr;
+}
+
+WsReassembler::Slot* WsReassembler::claim(uint32_t clientId, uint32_t nowMs) {
+    // Free slot first, else the stalest one past the timeout
+    Slot* free = nullptr;
+    Slot* stale = nullptr;
+    for (Slot& slot : _slots) {
+        if (!slot.used) {
+            if (!free || (slot.buffer && !free->buffer)) free = &slot;  // Prefer an allocated buffer
+        } else if (nowMs - slot.lastChunkMs >= WS_REASSEMBLY_TIMEOUT_MS &&
+                   (!stale || (int32_t)(slot.lastChunkMs - stale->lastChunkMs) < 0)) {
+            stale = &slot;
+        }
+    }
+
+    Slot* slot = free;
+    if (!slot && stale) {
+        _expired++;
+        slot = stale;
+    }
+    if (!slot) return nullptr;
+
+    if (!slot->buffer) {
+        slot->buffer = (uint8_t*)malloc(WS_REASSEMBLY_MAX_BYTES);
+        if (!slot->buffer) return nullptr;
+    }
+    slot->used = true;
+    slot->clientId = clientId;
+    return slot;
+}
@@ -0,0 +1,72 @@
+/*
+ * Animatronic Eyes
+ * Copyright (c) 2025 Zappo-II
+ * Licensed under CC BY-NC-SA 4.0
+ * https://github.com/Zappo-II/animatronic-eyes
+ */
+
+#ifndef WS_REASSEMBLY_H
+#define WS_REASSEMBLY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+// WebSocket Reassembly - Bounded buffers for messages that arrive in pieces
+// AsyncWebSocket hands WS_EVT_DATA over as it comes off the wire: a message can be
+// split into several frames (fragmentation) and a frame into several TCP chunks.
+// Messages that arrive whole are dispatched straight from the frame; everything
+// else is collected here and dispatched once complete.
+//
+// WS_REASSEMBLY_SLOTS messages can be in flight at once (one per client), each
+// up to WS_REASSEMBLY_MAX_BYTES. A slot's buffer is allocated on first use and
+// kept. A message over the limit is discarded up to its last chunk; a message
+// whose next chunk doesn't arrive within WS_REASSEMBLY_TIMEOUT_MS loses its slot
+// to the next client that needs one.
+//
+// Async context only (AsyncTCP task, no locking). Plain C++: the caller maps
+// AwsFrameInfo to first/last and passes the time.
+
+enum class WsChunkResult : uint8_t {
+    PENDING,    // Stored (or skipped), more to come
+    COMPLETE,   // Message complete: dispatch it, then release()
+    DROPPED     // Message rejected just now (too large, no slot, out of memory)
+};
+
+class WsReassembler {
+public:
+    // first: first chunk of the message's first frame, last: final chunk of its
+    // final frame. On COMPLETE, message/messageLen point to the whole message.
+    WsChunkResult append(uint32_t clientId, const uint8_t* data, size_t len, bool first, bool last,
+                         uint32_t nowMs, const char*& message, size_t& messageLen);
+    void release(uint32_t clientId);  // After dispatching, and on disconnect
+
+    uint8_t getSlotsInUse() const;
+    uint32_t getCompleted() const { return _completed; }
+    uint32_t getOversized() const { return _oversized; }
+    uint32_t getNoSlot() const { return _noSlot; }
+    uint32_t getExpired() const { return _expired; }
+
+private:
+    struct Slot {
+        bool used;
+        bool discarding;      // Over the limit: skip the rest of the message
+        uint32_t clientId;
+        uint32_t lastChunkMs;
+        size_t length;
+        uint8_t* buffer;      // WS_REASSEMBLY_MAX_BYTES once allocated
+    };
+
+    Slot _slots[WS_REASSEMBLY_SLOTS] = {};
+    uint32_t _completed = 0;
+    uint32_t _oversized = 0;
+    uint32_t _noSlot = 0;
+    uint32_t _expired = 0;
+
+    Slot* find(uint32_t clientId);
+    Slot* claim(uint32_t clientId, uint32_t nowMs);
+};
+
+extern WsReassembler wsReassembler;
+
+#endif // WS_REASSEMBLY_H